@@ -14,6 +14,9 @@
 #define ORIONGLAD_IMPLEMENTATION
 #include "orionglad.h"
 
+#include <stdlib.h>
+#include <string.h>
+
 // ======================================================================================
 // *****                   INTERNAL HELPER FUNCTIONS AND STRUCTURES                 *****
 // ======================================================================================
@@ -41,7 +44,7 @@ typedef struct {
 _orionBoundBufferTypes _oriCurrentBuffers = { 0 };
 
 /**
- * @brief a struct to hold the currently-bound GL texture objects
+ * @brief a struct to hold the GL texture objects currently bound to one texture unit
  * 
  */
 typedef struct {
@@ -57,13 +60,54 @@ typedef struct {
     GLuint t2dMultisample;
     GLuint t2dMultisampleArray;
 } _orionBoundTexTypes;
-_orionBoundTexTypes _oriCurrentTextures = { 0 };
+
+/**
+ * @brief the number of texture units whose bindings are tracked
+ */
+#define _ORI_TRACKED_TEXTURE_UNITS 192
+
+/**
+ * @brief the GL texture objects currently bound to each texture unit
+ */
+_orionBoundTexTypes _oriCurrentTextures[_ORI_TRACKED_TEXTURE_UNITS] = { { 0 } };
+
+/**
+ * @brief the active texture unit (starting from 0, not from \c GL_TEXTURE0)
+ */
+GLuint _oriActiveTextureUnit = 0;
+
+/**
+ * @brief every texture target that is tracked
+ */
+static const GLenum _oriTextureTargets[] = {
+    GL_TEXTURE_1D, GL_TEXTURE_2D, GL_TEXTURE_3D, GL_TEXTURE_1D_ARRAY, GL_TEXTURE_2D_ARRAY, GL_TEXTURE_RECTANGLE,
+    GL_TEXTURE_CUBE_MAP, GL_TEXTURE_CUBE_MAP_ARRAY, GL_TEXTURE_BUFFER, GL_TEXTURE_2D_MULTISAMPLE, GL_TEXTURE_2D_MULTISAMPLE_ARRAY
+};
+
+/**
+ * @brief the GL sampler object currently bound to each texture unit
+ */
+GLuint _oriCurrentSamplers[_ORI_TRACKED_TEXTURE_UNITS] = { 0 };
+
+/**
+ * @brief the GL framebuffer objects currently bound for drawing and reading
+ */
+GLuint _oriCurrentDrawFramebuffer = 0;
+GLuint _oriCurrentReadFramebuffer = 0;
 
 /**
  * @brief the currently-bound GL vertex array object
  */
 GLuint _oriCurrentVertexArray = 0;
 
+/**
+ * @brief the GL buffer object bound to \c GL_ELEMENT_ARRAY_BUFFER in each vertex array object, indexed by its name
+ * @details The element array buffer binding is part of a vertex array's state, so it is restored from here when a vertex
+ * array is bound, rather than being queried. The array grows to fit the largest name that is recorded.
+ */
+GLuint *_oriVertexArrayElementBuffers = NULL;
+GLuint _oriVertexArrayElementBuffersSize = 0;
+
 /**
  * @brief the currently-used GL shader program object
  */
@@ -111,40 +155,76 @@ GLuint *_oriCurrentBufferPtrAt(GLenum target) {
 }
 
 /**
- * @brief return a pointer to a value in the public struct of currently-bound textures that corresponds to the OpenGL equivalent \c (target).
- * @warning Be aware that this function can be very dangerous if not used properly: if the given target is not a valid OpenGL texture target, \b a \b null \b pointer \b will \b be \b returned!
+ * @brief return a pointer to a value in the public struct of textures currently bound to texture unit \c unit that corresponds to the OpenGL equivalent \c (target).
+ * @warning Be aware that this function can be very dangerous if not used properly: if the given target is not a valid OpenGL texture target, or the bindings of \c unit are not tracked, \b a \b null \b pointer \b will \b be \b returned!
  * 
+ * @param unit the texture unit (starting from 0, not from \c GL_TEXTURE0)
  * @param target the OpenGL target
  */
-GLuint *_oriCurrentTexturePtrAt(GLenum target) {
+GLuint *_oriCurrentTexturePtrAt(GLuint unit, GLenum target) {
+    if (unit >= _ORI_TRACKED_TEXTURE_UNITS) {
+        return 0;
+    }
+    _orionBoundTexTypes *textures = &_oriCurrentTextures[unit];
+
     switch (target) {
         case GL_TEXTURE_1D:
-            return &(_oriCurrentTextures.t1d);
+            return &(textures->t1d);
         case GL_TEXTURE_2D:
-            return &(_oriCurrentTextures.t2d);
+            return &(textures->t2d);
         case GL_TEXTURE_3D:
-            return &(_oriCurrentTextures.t3d);
+            return &(textures->t3d);
         case GL_TEXTURE_1D_ARRAY:
-            return &(_oriCurrentTextures.t1dArray);
+            return &(textures->t1dArray);
         case GL_TEXTURE_2D_ARRAY:
-            return &(_oriCurrentTextures.t2dArray);
+            return &(textures->t2dArray);
         case GL_TEXTURE_RECTANGLE:
-            return &(_oriCurrentTextures.rectangle);
+            return &(textures->rectangle);
         case GL_TEXTURE_CUBE_MAP:
-            return &(_oriCurrentTextures.cubeMap);
+            return &(textures->cubeMap);
         case GL_TEXTURE_CUBE_MAP_ARRAY:
-            return &(_oriCurrentTextures.cubeMapArray);
+            return &(textures->cubeMapArray);
         case GL_TEXTURE_BUFFER:
-            return &(_oriCurrentTextures.buffer);
+            return &(textures->buffer);
         case GL_TEXTURE_2D_MULTISAMPLE:
-            return &(_oriCurrentTextures.t2dMultisample);
+            return &(textures->t2dMultisample);
         case GL_TEXTURE_2D_MULTISAMPLE_ARRAY:
-            return &(_oriCurrentTextures.t2dMultisample);
+            return &(textures->t2dMultisampleArray);
         default:
             return 0;
     }
 }
 
+/**
+ * @brief record the GL buffer object bound to \c GL_ELEMENT_ARRAY_BUFFER in the vertex array object of name \c array
+ * 
+ * @param array the name of the vertex array
+ * @param buffer the name of the buffer object
+ */
+void _oriRecordElementBuffer(GLuint array, GLuint buffer) {
+    if (array >= _oriVertexArrayElementBuffersSize) {
+        if (!buffer) {
+            return;
+        }
+
+        GLuint size = _oriVertexArrayElementBuffersSize ? _oriVertexArrayElementBuffersSize : 64;
+        while (size <= array) {
+            size *= 2;
+        }
+
+        GLuint *records = realloc(_oriVertexArrayElementBuffers, size * sizeof(GLuint));
+        if (!records) {
+            return;
+        }
+        memset(&records[_oriVertexArrayElementBuffersSize], 0, (size - _oriVertexArrayElementBuffersSize) * sizeof(GLuint));
+
+        _oriVertexArrayElementBuffers = records;
+        _oriVertexArrayElementBuffersSize = size;
+    }
+
+    _oriVertexArrayElementBuffers[array] = buffer;
+}
+
 // ======================================================================================
 // *****                          PUBLIC ORIONGLAD INTERFACE                        *****
 // ======================================================================================
@@ -224,7 +304,7 @@ const GLenum orion_glGetBufferTarget(GLuint buffer) {
 // ======================================================================================
 
 /**
- * @brief the current GL texture that is bound to \c target
+ * @brief the current GL texture that is bound to \c target of the active texture unit
  * @details It is recommended to refer to this as opposed to calling glGetx functions for better performance.
  * 
  * @param target the target to query
@@ -232,13 +312,76 @@ const GLenum orion_glGetBufferTarget(GLuint buffer) {
  * @ingroup orionglad
  */
 const GLuint orion_glCurrentTextureAt(GLenum target) {
-    if (!_oriCurrentTexturePtrAt(target)) {
+    if (!_oriCurrentTexturePtrAt(_oriActiveTextureUnit, target)) {
+        return 0;
+    }
+    return *(_oriCurrentTexturePtrAt(_oriActiveTextureUnit, target));
+}
+
+/**
+ * @brief the current GL texture that is bound to \c target of texture unit \c unit
+ * @details It is recommended to refer to this as opposed to calling glGetx functions for better performance.
+ * 
+ * @param unit the texture unit to query (starting from 0, not from \c GL_TEXTURE0)
+ * @param target the target to query
+ * 
+ * @return \c GL_INVALID_INDEX if the bindings of \c unit are not tracked.
+ * 
+ * @ingroup orionglad
+ */
+const GLuint orion_glCurrentTextureAtUnit(GLuint unit, GLenum target) {
+    if (unit >= _ORI_TRACKED_TEXTURE_UNITS) {
+        return GL_INVALID_INDEX;
+    }
+    if (!_oriCurrentTexturePtrAt(unit, target)) {
         return 0;
     }
-    return *(_oriCurrentTexturePtrAt(target));
+    return *(_oriCurrentTexturePtrAt(unit, target));
+}
+
+/**
+ * @brief the active texture unit (starting from 0, not from \c GL_TEXTURE0)
+ * @details It is recommended to refer to this as opposed to calling glGetx functions for better performance.
+ * 
+ * @ingroup orionglad
+ */
+const GLuint orion_glActiveTextureUnit() {
+    return _oriActiveTextureUnit;
+}
+
+/**
+ * @brief bind textures to a sequence of consecutive texture units with \c glBindTextures (OpenGL 4.4)
+ * @details \c glBindTextures is not overridden, as the target of each texture can't be known from its name; this
+ * records each binding at the given target. A texture of 0 unbinds every target of its unit, as with \c glBindTextures.
+ * 
+ * @param first specifies the first texture unit to which a texture is bound
+ * @param count specifies the number of textures to bind
+ * @param targets specifies the target of each texture
+ * @param textures specifies an array of the names of the textures to bind
+ * 
+ * @ingroup orionglad
+ */
+void orion_glBindTextures(GLuint first, GLsizei count, const GLenum *targets, const GLuint *textures) {
+    for (GLsizei i = 0; i < count; i++) {
+        if (textures[i]) {
+            if (_oriCurrentTexturePtrAt(first + i, targets[i])) {
+                *(_oriCurrentTexturePtrAt(first + i, targets[i])) = textures[i];
+            }
+            continue;
+        }
+
+        for (unsigned int t = 0; t < sizeof(_oriTextureTargets) / sizeof(GLenum); t++) {
+            if (_oriCurrentTexturePtrAt(first + i, _oriTextureTargets[t])) {
+                *(_oriCurrentTexturePtrAt(first + i, _oriTextureTargets[t])) = 0;
+            }
+        }
+    }
+
+    glBindTextures(first, count, textures);
 }
+
 /**
- * @brief get the target of the given texture
+ * @brief get the target of the given texture in the active texture unit
  * @details E.g, if texture \c tex is bound at \c GL_TEXTURE_2D, then \c GL_TEXTURE_2D will be returned.
  * 
  * @param tex specifies the name of the texture to query
@@ -248,29 +391,34 @@ const GLuint orion_glCurrentTextureAt(GLenum target) {
  * @ingroup orionglad
  */
 const GLenum orion_glGetTextureTarget(GLuint tex) {
+    if (_oriActiveTextureUnit >= _ORI_TRACKED_TEXTURE_UNITS) {
+        return 0;
+    }
+    _orionBoundTexTypes *textures = &_oriCurrentTextures[_oriActiveTextureUnit];
+
     // unfortunately if-else has to be used here as the queried values are not constant
     // otherwise, I would normally use switch-case.
-    if (tex == _oriCurrentTextures.t1d) {
+    if (tex == textures->t1d) {
         return GL_TEXTURE_1D;
-    } else if (tex == _oriCurrentTextures.t2d) {
+    } else if (tex == textures->t2d) {
         return GL_TEXTURE_2D;
-    } else if (tex == _oriCurrentTextures.t3d) {
+    } else if (tex == textures->t3d) {
         return GL_TEXTURE_3D;
-    } else if (tex == _oriCurrentTextures.t1dArray) {
+    } else if (tex == textures->t1dArray) {
         return GL_TEXTURE_1D_ARRAY;
-    } else if (tex == _oriCurrentTextures.t2dArray) {
+    } else if (tex == textures->t2dArray) {
         return GL_TEXTURE_2D_ARRAY;
-    } else if (tex == _oriCurrentTextures.rectangle) {
+    } else if (tex == textures->rectangle) {
         return GL_TEXTURE_RECTANGLE;
-    } else if (tex == _oriCurrentTextures.cubeMap) {
+    } else if (tex == textures->cubeMap) {
         return GL_TEXTURE_CUBE_MAP;
-    } else if (tex == _oriCurrentTextures.cubeMapArray) {
+    } else if (tex == textures->cubeMapArray) {
         return GL_TEXTURE_CUBE_MAP_ARRAY;
-    } else if (tex == _oriCurrentTextures.buffer) {
+    } else if (tex == textures->buffer) {
         return GL_TEXTURE_BUFFER;
-    } else if (tex == _oriCurrentTextures.t2dMultisample) {
+    } else if (tex == textures->t2dMultisample) {
         return GL_TEXTURE_2D_MULTISAMPLE;
-    } else if (tex == _oriCurrentTextures.t2dMultisampleArray) {
+    } else if (tex == textures->t2dMultisampleArray) {
         return GL_TEXTURE_2D_MULTISAMPLE_ARRAY;
     } else {
         // texture is not bound
@@ -278,6 +426,51 @@ const GLenum orion_glGetTextureTarget(GLuint tex) {
     }
 }
 
+// ======================================================================================
+// *****                       ADDED FUNCTIONALITY :: SAMPLERS                      *****
+// ======================================================================================
+
+/**
+ * @brief the current GL sampler object that is bound to texture unit \c unit
+ * @details It is recommended to refer to this as opposed to calling glGetx functions for better performance.
+ * 
+ * @param unit the texture unit to query (starting from 0, not from \c GL_TEXTURE0)
+ * 
+ * @return \c GL_INVALID_INDEX if the bindings of \c unit are not tracked.
+ * 
+ * @ingroup orionglad
+ */
+const GLuint orion_glCurrentSamplerAt(GLuint unit) {
+    if (unit >= _ORI_TRACKED_TEXTURE_UNITS) {
+        return GL_INVALID_INDEX;
+    }
+    return _oriCurrentSamplers[unit];
+}
+
+// ======================================================================================
+// *****                     ADDED FUNCTIONALITY :: FRAMEBUFFERS                    *****
+// ======================================================================================
+
+/**
+ * @brief the current GL framebuffer object that is bound to \c target
+ * @details It is recommended to refer to this as opposed to calling glGetx functions for better performance.
+ * 
+ * @param target the target to query; \c GL_FRAMEBUFFER is treated as \c GL_DRAW_FRAMEBUFFER
+ * 
+ * @ingroup orionglad
+ */
+const GLuint orion_glCurrentFramebufferAt(GLenum target) {
+    switch (target) {
+        case GL_FRAMEBUFFER:
+        case GL_DRAW_FRAMEBUFFER:
+            return _oriCurrentDrawFramebuffer;
+        case GL_READ_FRAMEBUFFER:
+            return _oriCurrentReadFramebuffer;
+        default:
+            return 0;
+    }
+}
+
 // ======================================================================================
 // *****                    ADDED FUNCTIONALITY :: VERTEX ARRAYS                    *****
 // ======================================================================================
@@ -306,6 +499,31 @@ const GLuint orion_glCurrentShaderProgram() {
     return _oriCurrentShaderProgram;
 }
 
+// ======================================================================================
+// *****                        ADDED FUNCTIONALITY :: STATE                        *****
+// ======================================================================================
+
+/**
+ * @brief forget every tracked binding, and free the memory used to track them
+ * @details This is called by oriTerminate(), as the bindings belong to a context that no longer exists.
+ * 
+ * @ingroup orionglad
+ */
+void orion_glResetState() {
+    free(_oriVertexArrayElementBuffers);
+    _oriVertexArrayElementBuffers = NULL;
+    _oriVertexArrayElementBuffersSize = 0;
+
+    memset(&_oriCurrentBuffers, 0, sizeof(_oriCurrentBuffers));
+    memset(_oriCurrentTextures, 0, sizeof(_oriCurrentTextures));
+    memset(_oriCurrentSamplers, 0, sizeof(_oriCurrentSamplers));
+    _oriActiveTextureUnit = 0;
+    _oriCurrentDrawFramebuffer = 0;
+    _oriCurrentReadFramebuffer = 0;
+    _oriCurrentVertexArray = 0;
+    _oriCurrentShaderProgram = 0;
+}
+
 // ======================================================================================
 // *****                      OVERRIDES OF EXISTING GL FUNCTIONS                    *****
 // ======================================================================================
@@ -328,9 +546,54 @@ void orion_gladoverride_glBindBuffer(GLenum target, GLuint buffer) {
     }
     *(_oriCurrentBufferPtrAt(target)) = buffer;
 
+    // the element array buffer binding is part of the bound vertex array's state
+    if (target == GL_ELEMENT_ARRAY_BUFFER) {
+        _oriRecordElementBuffer(_oriCurrentVertexArray, buffer);
+    }
+
     glBindBuffer(target, buffer);
 }
 
+/**
+ * @brief binds a range of a GL buffer object of name \c buffer to an indexed buffer target
+ * @details This also binds \c buffer to the generic binding point \c target.
+ * 
+ * @param target specifies the target of the bind operation
+ * @param index specifies the index of the binding point within \c target
+ * @param buffer specifies the name of a buffer object
+ * @param offset the starting offset in basic machine units into the buffer object
+ * @param size the amount of data in machine units that can be read from the buffer object while used as an indexed target
+ * 
+ * @ingroup orionglad
+ */
+void orion_gladoverride_glBindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) {
+    if (!_oriCurrentBufferPtrAt(target)) {
+        return;
+    }
+    *(_oriCurrentBufferPtrAt(target)) = buffer;
+
+    glBindBufferRange(target, index, buffer, offset, size);
+}
+
+/**
+ * @brief binds a GL buffer object of name \c buffer to an indexed buffer target
+ * @details This also binds \c buffer to the generic binding point \c target.
+ * 
+ * @param target specifies the target of the bind operation
+ * @param index specifies the index of the binding point within \c target
+ * @param buffer specifies the name of a buffer object
+ * 
+ * @ingroup orionglad
+ */
+void orion_gladoverride_glBindBufferBase(GLenum target, GLuint index, GLuint buffer) {
+    if (!_oriCurrentBufferPtrAt(target)) {
+        return;
+    }
+    *(_oriCurrentBufferPtrAt(target)) = buffer;
+
+    glBindBufferBase(target, index, buffer);
+}
+
 /**
  * @brief deletes named buffer objects
  * 
@@ -344,9 +607,9 @@ void orion_gladoverride_glDeleteBuffers(GLsizei n, const GLuint *buffers) {
         // get the target of each buffer
         GLenum _target = orion_glGetBufferTarget(buffers[i]);
 
-        // make sure target is valid (it should be anyway, but better safe than sorry)
+        // if the buffer isn't bound anywhere then there is nothing to reset (but it must still be deleted)
         if (_oriCurrentBufferPtrAt(_target) == 0) {
-            return;
+            continue;
         }
 
         // set the corresponding CurrentBuffer value to 0 if the deleted buffer was bound
@@ -354,6 +617,17 @@ void orion_gladoverride_glDeleteBuffers(GLsizei n, const GLuint *buffers) {
         if (*(_oriCurrentBufferPtrAt(_target)) == buffers[i]) {
             *(_oriCurrentBufferPtrAt(_target)) = 0;
         }
+
+        // a deleted buffer is detached from the bound vertex array
+        // it is also forgotten by the others, as its name may be reused
+        if (_oriCurrentBuffers.elementArrayBuffer == buffers[i]) {
+            _oriCurrentBuffers.elementArrayBuffer = 0;
+        }
+        for (GLuint array = 0; array < _oriVertexArrayElementBuffersSize; array++) {
+            if (_oriVertexArrayElementBuffers[array] == buffers[i]) {
+                _oriVertexArrayElementBuffers[array] = 0;
+            }
+        }
     }
 
     glDeleteBuffers(n, buffers);
@@ -372,10 +646,14 @@ void orion_gladoverride_glDeleteBuffers(GLsizei n, const GLuint *buffers) {
  * @ingroup orionglad
  */
 void orion_gladoverride_glBindTexture(GLenum target, GLuint texture) {
-    if (!_oriCurrentTexturePtrAt(target)) {
+    // make sure the target is valid (unit 0 is always tracked)
+    if (!_oriCurrentTexturePtrAt(0, target)) {
         return;
     }
-    *(_oriCurrentTexturePtrAt(target)) = texture;
+    // the bindings of units past the tracked ones are not recorded, but are still made
+    if (_oriCurrentTexturePtrAt(_oriActiveTextureUnit, target)) {
+        *(_oriCurrentTexturePtrAt(_oriActiveTextureUnit, target)) = texture;
+    }
 
     glBindTexture(target, texture);
 }
@@ -389,23 +667,135 @@ void orion_gladoverride_glBindTexture(GLenum target, GLuint texture) {
  * @ingroup orionglad
  */
 void orion_gladoverride_glDeleteTextures(GLsizei n, const GLuint *textures) {
-    for (unsigned int i = 0; i < n; i++) {
-        // get the target of each buffer
-        GLenum _target = orion_glGetTextureTarget(textures[i]);
+    for (GLsizei i = 0; i < n; i++) {
+        // set every binding of the deleted texture to 0, in every unit
+        // this mimics OpenGL's behaviour: a deleted texture is unbound from every unit it was bound to
+        for (unsigned int unit = 0; unit < _ORI_TRACKED_TEXTURE_UNITS; unit++) {
+            for (unsigned int t = 0; t < sizeof(_oriTextureTargets) / sizeof(GLenum); t++) {
+                GLuint *current = _oriCurrentTexturePtrAt(unit, _oriTextureTargets[t]);
+                if (*current == textures[i]) {
+                    *current = 0;
+                }
+            }
+        }
+    }
 
-        // make sure target is valid (it should be anyway, but better safe than sorry)
-        if (_oriCurrentTexturePtrAt(_target) == 0) {
-            return;
+    glDeleteTextures(n, textures);
+}
+
+/**
+ * @brief select the active texture unit
+ * 
+ * @param texture specifies which texture unit to make active (\c GL_TEXTURE0 + the index of the unit)
+ * 
+ * @ingroup orionglad
+ */
+void orion_gladoverride_glActiveTexture(GLenum texture) {
+    _oriActiveTextureUnit = texture - GL_TEXTURE0;
+    glActiveTexture(texture);
+}
+
+// ======================================================================================
+// *****                            OVERRIDES :: SAMPLERS                           *****
+// ======================================================================================
+
+/**
+ * @brief bind a named sampler to a texture unit
+ * 
+ * @param unit specifies the index of the texture unit to which the sampler is bound
+ * @param sampler specifies the name of a sampler
+ * 
+ * @ingroup orionglad
+ */
+void orion_gladoverride_glBindSampler(GLuint unit, GLuint sampler) {
+    if (unit < _ORI_TRACKED_TEXTURE_UNITS) {
+        _oriCurrentSamplers[unit] = sampler;
+    }
+
+    glBindSampler(unit, sampler);
+}
+
+/**
+ * @brief bind one or more named samplers to a sequence of consecutive texture units
+ * 
+ * @param first specifies the first texture unit to which a sampler is bound
+ * @param count specifies the number of samplers to bind
+ * @param samplers specifies an array of the names of the samplers to bind, or NULL to unbind all of the units
+ * 
+ * @ingroup orionglad
+ */
+void orion_gladoverride_glBindSamplers(GLuint first, GLsizei count, const GLuint *samplers) {
+    for (GLsizei i = 0; i < count && first + i < _ORI_TRACKED_TEXTURE_UNITS; i++) {
+        _oriCurrentSamplers[first + i] = samplers ? samplers[i] : 0;
+    }
+
+    glBindSamplers(first, count, samplers);
+}
+
+/**
+ * @brief deletes named samplers
+ * 
+ * @param count the number of samplers to be deleted
+ * @param samplers specifies an array of samplers to be deleted
+ * 
+ * @ingroup orionglad
+ */
+void orion_gladoverride_glDeleteSamplers(GLsizei count, const GLuint *samplers) {
+    for (GLsizei i = 0; i < count; i++) {
+        // a deleted sampler is unbound from every unit it was bound to
+        for (unsigned int unit = 0; unit < _ORI_TRACKED_TEXTURE_UNITS; unit++) {
+            if (_oriCurrentSamplers[unit] == samplers[i]) {
+                _oriCurrentSamplers[unit] = 0;
+            }
         }
+    }
 
-        // set the corresponding CurrentBuffer value to 0 if the deleted buffer was bound
-        // this mimics OpenGL's behaviour: the target of the given buffer is set to 0 (absence of buffer) if it was bound
-        if (*(_oriCurrentTexturePtrAt(_target)) == textures[i]) {
-            *(_oriCurrentTexturePtrAt(_target)) = 0;
+    glDeleteSamplers(count, samplers);
+}
+
+// ======================================================================================
+// *****                          OVERRIDES :: FRAMEBUFFERS                         *****
+// ======================================================================================
+
+/**
+ * @brief bind a named framebuffer object to a framebuffer target
+ * 
+ * @param target specifies the target to which the framebuffer is bound (\c GL_FRAMEBUFFER binds it to both \c GL_DRAW_FRAMEBUFFER and \c GL_READ_FRAMEBUFFER)
+ * @param framebuffer specifies the name of a framebuffer object
+ * 
+ * @ingroup orionglad
+ */
+void orion_gladoverride_glBindFramebuffer(GLenum target, GLuint framebuffer) {
+    if (target == GL_FRAMEBUFFER || target == GL_DRAW_FRAMEBUFFER) {
+        _oriCurrentDrawFramebuffer = framebuffer;
+    }
+    if (target == GL_FRAMEBUFFER || target == GL_READ_FRAMEBUFFER) {
+        _oriCurrentReadFramebuffer = framebuffer;
+    }
+
+    glBindFramebuffer(target, framebuffer);
+}
+
+/**
+ * @brief deletes named framebuffer objects
+ * 
+ * @param n the number of framebuffer objects to be deleted
+ * @param framebuffers specifies an array of framebuffer objects to be deleted
+ * 
+ * @ingroup orionglad
+ */
+void orion_gladoverride_glDeleteFramebuffers(GLsizei n, const GLuint *framebuffers) {
+    for (GLsizei i = 0; i < n; i++) {
+        // a deleted framebuffer that was bound reverts to the default framebuffer
+        if (_oriCurrentDrawFramebuffer == framebuffers[i]) {
+            _oriCurrentDrawFramebuffer = 0;
+        }
+        if (_oriCurrentReadFramebuffer == framebuffers[i]) {
+            _oriCurrentReadFramebuffer = 0;
         }
     }
 
-    glDeleteTextures(n, textures);
+    glDeleteFramebuffers(n, framebuffers);
 }
 
 // ======================================================================================
@@ -414,6 +804,7 @@ void orion_gladoverride_glDeleteTextures(GLsizei n, const GLuint *textures) {
 
 /**
  * @brief binds a GL vertex array object of name \c array
+ * @details The element array buffer binding is part of the vertex array's state, so the one recorded for \c array is restored.
  * 
  * @param array the name of the vertex array
  * 
@@ -421,9 +812,28 @@ void orion_gladoverride_glDeleteTextures(GLsizei n, const GLuint *textures) {
  */
 void orion_gladoverride_glBindVertexArray(GLuint array) {
     _oriCurrentVertexArray = array;
+    _oriCurrentBuffers.elementArrayBuffer = array < _oriVertexArrayElementBuffersSize ? _oriVertexArrayElementBuffers[array] : 0;
+
     glBindVertexArray(array);
 }
 
+/**
+ * @brief binds a GL buffer object of name \c buffer to the element array buffer binding of the vertex array \c vaobj
+ * 
+ * @param vaobj the name of the vertex array
+ * @param buffer the name of a buffer object
+ * 
+ * @ingroup orionglad
+ */
+void orion_gladoverride_glVertexArrayElementBuffer(GLuint vaobj, GLuint buffer) {
+    _oriRecordElementBuffer(vaobj, buffer);
+    if (_oriCurrentVertexArray == vaobj) {
+        _oriCurrentBuffers.elementArrayBuffer = buffer;
+    }
+
+    glVertexArrayElementBuffer(vaobj, buffer);
+}
+
 /**
  * @brief deletes named vertex array objects
  * 
@@ -437,7 +847,11 @@ void orion_gladoverride_glDeleteVertexArrays(GLsizei n, const GLuint *arrays) {
         // if the vao was bound, set the current bound vao to 0
         if (_oriCurrentVertexArray == arrays[i]) { 
             _oriCurrentVertexArray = 0;
+            _oriCurrentBuffers.elementArrayBuffer = 0;
         }
+
+        // the name may be reused for a new vertex array, which has no element array buffer
+        _oriRecordElementBuffer(arrays[i], 0);
     }
 
     glDeleteVertexArrays(n, arrays);
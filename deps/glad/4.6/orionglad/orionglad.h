@@ -63,7 +63,7 @@ const GLenum orion_glGetBufferTarget(GLuint buffer);
 // ======================================================================================
 
 /**
- * @brief the current GL texture that is bound to \c target
+ * @brief the current GL texture that is bound to \c target of the active texture unit
  * @details It is recommended to refer to this as opposed to calling glGetx functions for better performance.
  * 
  * @param target the target to query
@@ -73,7 +73,28 @@ const GLenum orion_glGetBufferTarget(GLuint buffer);
 const GLuint orion_glCurrentTextureAt(GLenum target);
 
 /**
- * @brief get the target of the given texture
+ * @brief the current GL texture that is bound to \c target of texture unit \c unit
+ * @details It is recommended to refer to this as opposed to calling glGetx functions for better performance.
+ * 
+ * @param unit the texture unit to query (starting from 0, not from \c GL_TEXTURE0)
+ * @param target the target to query
+ * 
+ * @return \c GL_INVALID_INDEX if the bindings of \c unit are not tracked.
+ * 
+ * @ingroup orionglad
+ */
+const GLuint orion_glCurrentTextureAtUnit(GLuint unit, GLenum target);
+
+/**
+ * @brief the active texture unit (starting from 0, not from \c GL_TEXTURE0)
+ * @details It is recommended to refer to this as opposed to calling glGetx functions for better performance.
+ * 
+ * @ingroup orionglad
+ */
+const GLuint orion_glActiveTextureUnit();
+
+/**
+ * @brief get the target of the given texture in the active texture unit
  * @details E.g, if texture \c tex is bound at \c GL_TEXTURE_2D, then \c GL_TEXTURE_2D will be returned.
  * 
  * @param tex specifies the name of the texture to query
@@ -84,6 +105,50 @@ const GLuint orion_glCurrentTextureAt(GLenum target);
  */
 const GLenum orion_glGetTextureTarget(GLuint tex);
 
+/**
+ * @brief bind textures to a sequence of consecutive texture units with \c glBindTextures (OpenGL 4.4)
+ * @details \c glBindTextures is not overridden, as the target of each texture can't be known from its name; this
+ * records each binding at the given target. A texture of 0 unbinds every target of its unit, as with \c glBindTextures.
+ * 
+ * @param first specifies the first texture unit to which a texture is bound
+ * @param count specifies the number of textures to bind
+ * @param targets specifies the target of each texture
+ * @param textures specifies an array of the names of the textures to bind
+ * 
+ * @ingroup orionglad
+ */
+void orion_glBindTextures(GLuint first, GLsizei count, const GLenum *targets, const GLuint *textures);
+
+// ======================================================================================
+// *****                       ADDED FUNCTIONALITY :: SAMPLERS                      *****
+// ======================================================================================
+
+/**
+ * @brief the current GL sampler object that is bound to texture unit \c unit
+ * @details It is recommended to refer to this as opposed to calling glGetx functions for better performance.
+ * 
+ * @param unit the texture unit to query (starting from 0, not from \c GL_TEXTURE0)
+ * 
+ * @return \c GL_INVALID_INDEX if the bindings of \c unit are not tracked.
+ * 
+ * @ingroup orionglad
+ */
+const GLuint orion_glCurrentSamplerAt(GLuint unit);
+
+// ======================================================================================
+// *****                     ADDED FUNCTIONALITY :: FRAMEBUFFERS                    *****
+// ======================================================================================
+
+/**
+ * @brief the current GL framebuffer object that is bound to \c target
+ * @details It is recommended to refer to this as opposed to calling glGetx functions for better performance.
+ * 
+ * @param target the target to query; \c GL_FRAMEBUFFER is treated as \c GL_DRAW_FRAMEBUFFER
+ * 
+ * @ingroup orionglad
+ */
+const GLuint orion_glCurrentFramebufferAt(GLenum target);
+
 // ======================================================================================
 // *****                    ADDED FUNCTIONALITY :: VERTEX ARRAYS                    *****
 // ======================================================================================
@@ -108,6 +173,18 @@ const GLuint orion_glCurrentVertexArray();
  */
 const GLuint orion_glCurrentShaderProgram();
 
+// ======================================================================================
+// *****                        ADDED FUNCTIONALITY :: STATE                        *****
+// ======================================================================================
+
+/**
+ * @brief forget every tracked binding, and free the memory used to track them
+ * @details This is called by oriTerminate(), as the bindings belong to a context that no longer exists.
+ * 
+ * @ingroup orionglad
+ */
+void orion_glResetState();
+
 // ======================================================================================
 // *****                     OVERRIDES OF EXISTING GL FUNCTIONS                     *****
 // ======================================================================================
@@ -128,6 +205,32 @@ const GLuint orion_glCurrentShaderProgram();
  */
 void orion_gladoverride_glBindBuffer(GLenum target, GLuint buffer);
 
+/**
+ * @brief binds a range of a GL buffer object of name \c buffer to an indexed buffer target
+ * @details This also binds \c buffer to the generic binding point \c target.
+ * 
+ * @param target specifies the target of the bind operation
+ * @param index specifies the index of the binding point within \c target
+ * @param buffer specifies the name of a buffer object
+ * @param offset the starting offset in basic machine units into the buffer object
+ * @param size the amount of data in machine units that can be read from the buffer object while used as an indexed target
+ * 
+ * @ingroup orionglad
+ */
+void orion_gladoverride_glBindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+
+/**
+ * @brief binds a GL buffer object of name \c buffer to an indexed buffer target
+ * @details This also binds \c buffer to the generic binding point \c target.
+ * 
+ * @param target specifies the target of the bind operation
+ * @param index specifies the index of the binding point within \c target
+ * @param buffer specifies the name of a buffer object
+ * 
+ * @ingroup orionglad
+ */
+void orion_gladoverride_glBindBufferBase(GLenum target, GLuint index, GLuint buffer);
+
 /**
  * @brief deletes named buffer objects
  * 
@@ -162,6 +265,74 @@ void orion_gladoverride_glBindTexture(GLenum target, GLuint texture);
  */
 void orion_gladoverride_glDeleteTextures(GLsizei n, const GLuint *textures);
 
+/**
+ * @brief select the active texture unit
+ * 
+ * @param texture specifies which texture unit to make active (\c GL_TEXTURE0 + the index of the unit)
+ * 
+ * @ingroup orionglad
+ */
+void orion_gladoverride_glActiveTexture(GLenum texture);
+
+// ======================================================================================
+// *****                            OVERRIDES :: SAMPLERS                           *****
+// ======================================================================================
+
+/**
+ * @brief bind a named sampler to a texture unit
+ * 
+ * @param unit specifies the index of the texture unit to which the sampler is bound
+ * @param sampler specifies the name of a sampler
+ * 
+ * @ingroup orionglad
+ */
+void orion_gladoverride_glBindSampler(GLuint unit, GLuint sampler);
+
+/**
+ * @brief bind one or more named samplers to a sequence of consecutive texture units
+ * 
+ * @param first specifies the first texture unit to which a sampler is bound
+ * @param count specifies the number of samplers to bind
+ * @param samplers specifies an array of the names of the samplers to bind, or NULL to unbind all of the units
+ * 
+ * @ingroup orionglad
+ */
+void orion_gladoverride_glBindSamplers(GLuint first, GLsizei count, const GLuint *samplers);
+
+/**
+ * @brief deletes named samplers
+ * 
+ * @param count the number of samplers to be deleted
+ * @param samplers specifies an array of samplers to be deleted
+ * 
+ * @ingroup orionglad
+ */
+void orion_gladoverride_glDeleteSamplers(GLsizei count, const GLuint *samplers);
+
+// ======================================================================================
+// *****                          OVERRIDES :: FRAMEBUFFERS                         *****
+// ======================================================================================
+
+/**
+ * @brief bind a named framebuffer object to a framebuffer target
+ * 
+ * @param target specifies the target to which the framebuffer is bound (\c GL_FRAMEBUFFER binds it to both \c GL_DRAW_FRAMEBUFFER and \c GL_READ_FRAMEBUFFER)
+ * @param framebuffer specifies the name of a framebuffer object
+ * 
+ * @ingroup orionglad
+ */
+void orion_gladoverride_glBindFramebuffer(GLenum target, GLuint framebuffer);
+
+/**
+ * @brief deletes named framebuffer objects
+ * 
+ * @param n the number of framebuffer objects to be deleted
+ * @param framebuffers specifies an array of framebuffer objects to be deleted
+ * 
+ * @ingroup orionglad
+ */
+void orion_gladoverride_glDeleteFramebuffers(GLsizei n, const GLuint *framebuffers);
+
 // ======================================================================================
 // *****                          OVERRIDES :: VERTEX ARRAYS                        *****
 // ======================================================================================
@@ -175,6 +346,16 @@ void orion_gladoverride_glDeleteTextures(GLsizei n, const GLuint *textures);
  */
 void orion_gladoverride_glBindVertexArray(GLuint array);
 
+/**
+ * @brief binds a GL buffer object of name \c buffer to the element array buffer binding of the vertex array \c vaobj
+ * 
+ * @param vaobj the name of the vertex array
+ * @param buffer the name of a buffer object
+ * 
+ * @ingroup orionglad
+ */
+void orion_gladoverride_glVertexArrayElementBuffer(GLuint vaobj, GLuint buffer);
+
 /**
  * @brief deletes named vertex array objects
  * 
@@ -220,6 +401,10 @@ void orion_gladoverride_glDeleteProgram(GLuint program);
 #   define oriCurrentShaderProgram orion_glCurrentShaderProgram
 #   define oriCurrentBufferAt orion_glCurrentBufferAt
 #   define oriCurrentTextureAt orion_glCurrentTextureAt
+#   define oriCurrentTextureAtUnit orion_glCurrentTextureAtUnit
+#   define oriActiveTextureUnit orion_glActiveTextureUnit
+#   define oriCurrentSamplerAt orion_glCurrentSamplerAt
+#   define oriCurrentFramebufferAt orion_glCurrentFramebufferAt
 #endif
 
 // ======================================================================================
@@ -232,12 +417,21 @@ void orion_gladoverride_glDeleteProgram(GLuint program);
 #   undef glBindBuffer
 #   define glBindBuffer orion_gladoverride_glBindBuffer
 
+#   undef glBindBufferRange
+#   define glBindBufferRange orion_gladoverride_glBindBufferRange
+
+#   undef glBindBufferBase
+#   define glBindBufferBase orion_gladoverride_glBindBufferBase
+
 #   undef glDeleteBuffers
 #   define glDeleteBuffers orion_gladoverride_glDeleteBuffers
 
 #   undef glBindVertexArray
 #   define glBindVertexArray orion_gladoverride_glBindVertexArray
 
+#   undef glVertexArrayElementBuffer
+#   define glVertexArrayElementBuffer orion_gladoverride_glVertexArrayElementBuffer
+
 #   undef glDeleteVertexArrays
 #   define glDeleteVertexArrays orion_gladoverride_glDeleteVertexArrays
 
@@ -252,6 +446,24 @@ void orion_gladoverride_glDeleteProgram(GLuint program);
 
 #   undef glDeleteTextures
 #   define glDeleteTextures orion_gladoverride_glDeleteTextures
+
+#   undef glActiveTexture
+#   define glActiveTexture orion_gladoverride_glActiveTexture
+
+#   undef glBindSampler
+#   define glBindSampler orion_gladoverride_glBindSampler
+
+#   undef glBindSamplers
+#   define glBindSamplers orion_gladoverride_glBindSamplers
+
+#   undef glDeleteSamplers
+#   define glDeleteSamplers orion_gladoverride_glDeleteSamplers
+
+#   undef glBindFramebuffer
+#   define glBindFramebuffer orion_gladoverride_glBindFramebuffer
+
+#   undef glDeleteFramebuffers
+#   define glDeleteFramebuffers orion_gladoverride_glDeleteFramebuffers
 #endif
 
 /** @endcond */
@@ -42,6 +42,7 @@ extern "C" {
 #endif
 
 #include <stdbool.h>
+#include <stddef.h>
 
 #include <glad/4.6/glad.h>
 #include <glad/4.6/orionglad/orionglad.h>
@@ -106,6 +107,102 @@ void oriDebugFlags(const unsigned int source, const unsigned int type, const uns
  */
 void oriSetFlag(unsigned int flag, int value);
 
+// ======================================================================================
+// *****                           ORION HEADLESS CONTEXTS                          *****
+// ======================================================================================
+
+/**
+ * @brief An opaque OpenGL context that is not attached to a window (see oriCreateHeadlessContext()).
+ * 
+ * @note All instances of oriHeadlessContext will be freed with oriTerminate().
+ * 
+ * @ingroup meta
+ */
+typedef struct oriHeadlessContext oriHeadlessContext;
+
+/**
+ * @brief The backend of a headless context that was created with EGL, with a pbuffer surface as its default framebuffer.
+ * 
+ * @sa oriGetHeadlessContextBackend()
+ * 
+ * @ingroup meta
+ */
+#define ORION_HEADLESS_EGL_PBUFFER 0x01
+
+/**
+ * @brief The backend of a headless context that was created with EGL, with no surface (so it has no default framebuffer).
+ * 
+ * @sa oriGetHeadlessContextBackend()
+ * 
+ * @ingroup meta
+ */
+#define ORION_HEADLESS_EGL_SURFACELESS 0x02
+
+/**
+ * @brief The backend of a headless context that was created with OSMesa, whose default framebuffer is in memory.
+ * 
+ * @sa oriGetHeadlessContextBackend()
+ * 
+ * @ingroup meta
+ */
+#define ORION_HEADLESS_OSMESA 0x03
+
+/**
+ * @brief Allocate and initialise an OpenGL context that is not attached to a window, make it current, and load OpenGL
+ * for it.
+ * @details This lets Orion run without a display server (e.g. on CI machines and render farm nodes). EGL is used first:
+ * with a pbuffer surface of the given size if possible (so the context has a default framebuffer), or with no surface at
+ * all otherwise (render into an oriFramebuffer in that case). Mesa's surfaceless platform is used if it is available, so
+ * no display or GPU is needed, and software rendering with llvmpipe works. If EGL can't be used, OSMesa is used instead,
+ * which renders the default framebuffer into memory.
+ * 
+ * Set the environment variable @c ORION_HEADLESS_BACKEND to @c egl or @c osmesa to only try that backend. Any other value
+ * is warned about, and every backend is tried.
+ * 
+ * EGL and OSMesa are loaded when this function is called, so neither is needed to build or run Orion otherwise. Headless
+ * contexts are only supported on Unix-like systems.
+ * 
+ * Call oriInitialise() first, with the same OpenGL version. Like windows, headless contexts are freed with oriTerminate(),
+ * after every other Orion object.
+ * 
+ * @param version the OpenGL version of the context, e.g. 450. Contexts of 3.2 and above use the core profile.
+ * @param width the width of the default framebuffer.
+ * @param height the height of the default framebuffer.
+ * @return NULL if neither backend could create a context.
+ * 
+ * @ingroup meta
+ */
+oriHeadlessContext *oriCreateHeadlessContext(const unsigned int version, const unsigned int width, const unsigned int height);
+
+/**
+ * @brief Destroy and free memory for the given headless context.
+ * @details Free every Orion object that was created in the context first (or call oriTerminate(), which does so).
+ * 
+ * @param context the headless context to free.
+ * 
+ * @ingroup meta
+ */
+void oriFreeHeadlessContext(oriHeadlessContext *context);
+
+/**
+ * @brief Make the given headless context current on the calling thread.
+ * 
+ * @param context the headless context to make current.
+ * 
+ * @ingroup meta
+ */
+void oriMakeHeadlessContextCurrent(oriHeadlessContext *context);
+
+/**
+ * @brief Return the backend of the given headless context: @c ORION_HEADLESS_EGL_PBUFFER,
+ * @c ORION_HEADLESS_EGL_SURFACELESS or @c ORION_HEADLESS_OSMESA.
+ * 
+ * @param context the headless context to inspect.
+ * 
+ * @ingroup meta
+ */
+unsigned int oriGetHeadlessContextBackend(oriHeadlessContext *context);
+
 // ======================================================================================
 // *****                        ORION FLAGS (for oriSetFlag())                      *****
 // ======================================================================================
@@ -119,6 +216,26 @@ void oriSetFlag(unsigned int flag, int value);
  */
 #define ORION_DEBUG_CONTEXT 0x01
 
+// ======================================================================================
+// *****                                ORION LIMITS                                *****
+// ======================================================================================
+
+/**
+ * @brief The number of vertex attributes that can be described by an oriVertexLayout.
+ * @details This is the minimum value of @c GL_MAX_VERTEX_ATTRIBS required by the OpenGL specification.
+ * 
+ * @ingroup vertexspec
+ */
+#define ORION_MAX_VERTEX_ATTRIBS 16
+
+/**
+ * @brief The number of vertex buffer binding points that can be described by an oriVertexLayout.
+ * @details This is the minimum value of @c GL_MAX_VERTEX_ATTRIB_BINDINGS required by the OpenGL specification.
+ * 
+ * @ingroup vertexspec
+ */
+#define ORION_MAX_VERTEX_BINDINGS 16
+
 // ======================================================================================
 // *****                          ORION CALLBACK FUNCTIONS                          *****
 // ======================================================================================
@@ -185,6 +302,32 @@ void oriSetGLDebugMessageCallback(oriGLDebugMessageCallback callback);
  */
 typedef struct oriShader oriShader;
 
+/**
+ * @brief An opaque set of shader sources that is compiled into a separate, specialised program for every combination of defines.
+ * 
+ * @note All instances of oriShaderFamily will be freed with oriTerminate().
+ * 
+ * @ingroup shaders
+ */
+typedef struct oriShaderFamily oriShaderFamily;
+
+/**
+ * @brief A handle to an active uniform in an oriShader, resolved once with oriGetUniformHandle().
+ * @details A handle of -1 refers to no uniform; setting it does nothing.
+ * 
+ * @ingroup shaders
+ */
+typedef int oriUniformHandle;
+
+/**
+ * @brief An opaque uniform buffer object laid out to match a uniform block in a shader program.
+ * 
+ * @note All instances of oriUniformBlock will be freed with oriTerminate().
+ * 
+ * @ingroup shaders
+ */
+typedef struct oriUniformBlock oriUniformBlock;
+
 /**
  * @brief An opaque OpenGL buffer object.
  * 
@@ -194,6 +337,39 @@ typedef struct oriShader oriShader;
  */
 typedef struct oriBuffer oriBuffer;
 
+/**
+ * @brief An opaque, persistently-mapped OpenGL buffer object split into per-frame regions.
+ * 
+ * @note All instances of oriStreamBuffer will be freed with oriTerminate().
+ * 
+ * @ingroup buffers
+ */
+typedef struct oriStreamBuffer oriStreamBuffer;
+
+/**
+ * @brief An opaque collection of large OpenGL buffer objects that smaller allocations are sub-allocated from.
+ * 
+ * @note All instances of oriBufferHeap will be freed with oriTerminate().
+ * 
+ * @ingroup buffers
+ */
+typedef struct oriBufferHeap oriBufferHeap;
+
+/**
+ * @brief A range of a buffer object that was sub-allocated from an oriBufferHeap.
+ * 
+ * @sa oriBufferHeapAlloc()
+ * 
+ * @ingroup buffers
+ */
+typedef struct oriBufferAllocation {
+    oriBuffer *buffer;      ///< the buffer that the range is in.
+    unsigned int offset;    ///< the offset of the range into @c buffer, in bytes.
+    unsigned int size;      ///< the size of the range, in bytes (at least the size that was requested).
+
+    void *block;            ///< internal; used by oriBufferHeapFree().
+} oriBufferAllocation;
+
 /**
  * @brief An opaque OpenGL vertex array object.
  * 
@@ -203,6 +379,24 @@ typedef struct oriBuffer oriBuffer;
  */
 typedef struct oriVertexArray oriVertexArray;
 
+/**
+ * @brief An opaque description of every vertex attribute and vertex buffer binding point of a vertex array.
+ * 
+ * @note All instances of oriVertexLayout will be freed with oriTerminate().
+ * 
+ * @ingroup vertexspec
+ */
+typedef struct oriVertexLayout oriVertexLayout;
+
+/**
+ * @brief An opaque list of indexed draw commands that are submitted together with multi-draw indirect.
+ * 
+ * @note All instances of oriDrawBatch will be freed with oriTerminate().
+ * 
+ * @ingroup drawing
+ */
+typedef struct oriDrawBatch oriDrawBatch;
+
 /**
  * @brief An opaque OpenGL texture object.
  * 
@@ -212,6 +406,121 @@ typedef struct oriVertexArray oriVertexArray;
  */
 typedef struct oriTexture oriTexture;
 
+/**
+ * @brief An opaque ring of pixel unpack buffer regions that texture uploads are staged in.
+ * 
+ * @note All instances of oriTextureUploader will be freed with oriTerminate().
+ * 
+ * @ingroup textures
+ */
+typedef struct oriTextureUploader oriTextureUploader;
+
+/**
+ * @brief An opaque texture that many smaller images are packed into.
+ * 
+ * @note All instances of oriAtlas will be freed with oriTerminate().
+ * 
+ * @ingroup textures
+ */
+typedef struct oriAtlas oriAtlas;
+
+/**
+ * @brief The place of an image that was packed into an oriAtlas.
+ * 
+ * @sa oriAtlasInsert()
+ * 
+ * @ingroup textures
+ */
+typedef struct oriAtlasRegion {
+    unsigned int x;         ///< the x position of the image in the atlas texture, in texels (not including its padding).
+    unsigned int y;         ///< the y position of the image in the atlas texture, in texels (not including its padding).
+    unsigned int width;     ///< the width of the image, in texels.
+    unsigned int height;    ///< the height of the image, in texels.
+    unsigned int layer;     ///< the layer of the atlas texture that the image is in (always 0 for 2D textures).
+
+    float u0;               ///< the texture coordinate of the left edge of the image.
+    float v0;               ///< the texture coordinate of the edge of the image at its first row.
+    float u1;               ///< the texture coordinate of the right edge of the image.
+    float v1;               ///< the texture coordinate of the edge of the image after its last row.
+} oriAtlasRegion;
+
+/**
+ * @brief An opaque collection of array textures that same-sized 2D images are given layers of.
+ * 
+ * @note All instances of oriTexturePool will be freed with oriTerminate().
+ * 
+ * @ingroup textures
+ */
+typedef struct oriTexturePool oriTexturePool;
+
+/**
+ * @brief A layer of an array texture that was allocated from an oriTexturePool.
+ * 
+ * @sa oriTexturePoolAlloc()
+ * 
+ * @ingroup textures
+ */
+typedef struct oriTextureLayer {
+    oriTexture *texture;    ///< the @c GL_TEXTURE_2D_ARRAY that the layer is in.
+    unsigned int layer;     ///< the index of the layer in @c texture.
+
+    void *array;            ///< internal; used by oriTexturePoolFree().
+} oriTextureLayer;
+
+/**
+ * @brief An opaque OpenGL sampler object, shared between every texture that is sampled the same way.
+ * 
+ * @note All instances of oriSampler are owned by Orion, and will be freed with oriTerminate().
+ * 
+ * @sa oriGetSampler()
+ * 
+ * @ingroup textures
+ */
+typedef struct oriSampler oriSampler;
+
+/**
+ * @brief The sampling parameters of an oriSampler.
+ * 
+ * @sa oriInitSamplerState()
+ * 
+ * @ingroup textures
+ */
+typedef struct oriSamplerState {
+    unsigned int minFilter;     ///< @c GL_TEXTURE_MIN_FILTER, e.g. @c GL_LINEAR_MIPMAP_LINEAR.
+    unsigned int magFilter;     ///< @c GL_TEXTURE_MAG_FILTER, e.g. @c GL_LINEAR.
+    unsigned int wrapS;         ///< @c GL_TEXTURE_WRAP_S, e.g. @c GL_CLAMP_TO_EDGE.
+    unsigned int wrapT;         ///< @c GL_TEXTURE_WRAP_T.
+    unsigned int wrapR;         ///< @c GL_TEXTURE_WRAP_R.
+
+    float minLod;               ///< @c GL_TEXTURE_MIN_LOD.
+    float maxLod;               ///< @c GL_TEXTURE_MAX_LOD.
+    float lodBias;              ///< @c GL_TEXTURE_LOD_BIAS.
+    float maxAnisotropy;        ///< @c GL_TEXTURE_MAX_ANISOTROPY; 1 disables anisotropic filtering.
+
+    unsigned int compareMode;   ///< @c GL_TEXTURE_COMPARE_MODE, e.g. @c GL_COMPARE_REF_TO_TEXTURE for shadow maps.
+    unsigned int compareFunc;   ///< @c GL_TEXTURE_COMPARE_FUNC, e.g. @c GL_LEQUAL.
+
+    float borderColor[4];       ///< @c GL_TEXTURE_BORDER_COLOR, used by @c GL_CLAMP_TO_BORDER.
+} oriSamplerState;
+
+/**
+ * @brief An opaque OpenGL framebuffer object.
+ * 
+ * @note All instances of oriFramebuffer will be freed with oriTerminate().
+ * 
+ * @ingroup framebuffers
+ */
+typedef struct oriFramebuffer oriFramebuffer;
+
+/**
+ * @brief An opaque collection of render targets that are reused between render passes.
+ * 
+ * @note All instances of oriRenderTargetPool will be freed with oriTerminate().
+ * 
+ * @ingroup framebuffers
+ */
+typedef struct oriRenderTargetPool oriRenderTargetPool;
+
 // ======================================================================================
 // *****                          ORION TEXTURE FUNCTIONS                           *****
 // ======================================================================================
@@ -270,6 +579,8 @@ void oriFreeTexture(oriTexture *texture);
 
 /**
  * @brief Bind a given texture to the specified target.
+ * @details If the base level of the texture has been changed with oriUploadTexSubImage(), its mipmaps are regenerated first.
+ * Nothing is done if the texture is already bound to @c unit, and the active texture unit is only changed if it has to be.
  * 
  * @param texture the texture to bind.
  * @param unit the texture image unit to bind the texture to.
@@ -278,6 +589,19 @@ void oriFreeTexture(oriTexture *texture);
  */
 void oriBindTexture(oriTexture *texture, unsigned int unit);
 
+/**
+ * @brief Bind textures to a range of consecutive texture units.
+ * @details From OpenGL 4.4, the textures are bound with one call to @c glBindTextures. Below 4.4, each texture is bound
+ * with oriBindTexture(). Either way, textures that are already bound to their unit are not bound again.
+ * 
+ * @param first the texture image unit to bind the first texture to.
+ * @param count the number of textures to bind.
+ * @param textures the textures to bind. An entry can be NULL to leave its unit unchanged.
+ * 
+ * @ingroup textures
+ */
+void oriBindTextures(unsigned int first, unsigned int count, oriTexture **textures);
+
 /**
  * @brief Return the OpenGL handle to the given texture structure.
  * 
@@ -322,8 +646,52 @@ void oriGetTextureProperty(oriTexture *texture, unsigned int *type, unsigned int
  */
 void oriUploadTexImage(oriTexture *texture, unsigned int dataType, const void *data, unsigned int width, unsigned int height, unsigned int depth, unsigned int imageFormat);
 
+/**
+ * @brief Update a region of one level of the given texture's image, without reallocating its storage or regenerating its mipmaps.
+ * 
+ * @details The source data can be a sub-rectangle of a larger image in memory, without being repacked: give the width of the
+ * whole image as @c rowLength, and the position of the sub-rectangle in it as @c skipPixels and @c skipRows. Each row of
+ * the source image must start on a 4-byte boundary, as with any other upload (see @c GL_UNPACK_ALIGNMENT).
+ * 
+ * Mipmaps are not regenerated here, so many regions can be updated at the cost of a single regeneration. If the base
+ * level is changed, the mipmaps are regenerated when the texture is next bound with oriBindTexture(), or they can be
+ * regenerated explicitly with oriGenerateTextureMipmap(). Uploading to any other level clears the pending regeneration,
+ * so that mipmap levels can also be supplied by the caller. Textures without mipmaps (rectangle textures, and immutable
+ * textures with a single level) are never regenerated, and neither is anything before OpenGL 3.0.
+ * 
+ * @param texture the texture object to update. Its storage must already be allocated (e.g. with oriCreateTextureImmutable() or oriUploadTexImage()).
+ * @param level the mipmap level to update.
+ * @param xoffset the x coordinate of the region in the texture.
+ * @param yoffset the y coordinate of the region in the texture (or the first layer, for 1D array textures).
+ * @param zoffset the z coordinate of the region in the texture (or the first layer, for array textures, or the face, for cube maps).
+ * @param width the width of the region.
+ * @param height the height of the region. Set to 1 if the texture is 1D.
+ * @param depth the depth of the region. Set to 1 if the texture is not 3D, an array of 2D textures or a cube map.
+ * @param imageFormat the format of the source image (e.g. @c GL_RGBA).
+ * @param dataType the GL type of the given data (e.g. GL_UNSIGNED_BYTE if @c data is an unsigned char array)
+ * @param data the image data to use.
+ * @param rowLength the width, in pixels, of the whole source image. Set to 0 if the rows of the source image are @c width pixels wide.
+ * @param skipPixels the number of pixels to skip at the start of each row of the source image.
+ * @param skipRows the number of rows to skip at the start of the source image.
+ * 
+ * @ingroup textures
+ */
+void oriUploadTexSubImage(oriTexture *texture, unsigned int level, unsigned int xoffset, unsigned int yoffset, unsigned int zoffset, unsigned int width, unsigned int height, unsigned int depth, unsigned int imageFormat, unsigned int dataType, const void *data, unsigned int rowLength, unsigned int skipPixels, unsigned int skipRows);
+
+/**
+ * @brief Regenerate every mipmap level of the given texture from its base level.
+ * 
+ * @param texture the texture to update.
+ * 
+ * @ingroup textures
+ */
+void oriGenerateTextureMipmap(oriTexture *texture);
+
 /**
  * @brief Set a parameter for the given texture.
+ * @details Below OpenGL 4.5, the texture is bound to set the parameter (and the previous binding is restored). To sample
+ * many textures the same way, consider sharing an oriSampler (see oriGetSampler()) instead of setting the sampling
+ * parameters of each texture.
  * 
  * @param texture the texture to update.
  * @param param the texture parameter to set.
@@ -335,6 +703,9 @@ void oriSetTextureParameteri(oriTexture *texture, unsigned int param, int val);
 
 /**
  * @brief Set a parameter for the given texture.
+ * @details Below OpenGL 4.5, the texture is bound to set the parameter (and the previous binding is restored). To sample
+ * many textures the same way, consider sharing an oriSampler (see oriGetSampler()) instead of setting the sampling
+ * parameters of each texture.
  * 
  * @param texture the texture to update.
  * @param param the texture parameter to set.
@@ -365,124 +736,1169 @@ int oriGetTextureParameteri(oriTexture *texture, unsigned int param);
 float oriGetTextureParameterf(oriTexture *texture, unsigned int param);
 
 // ======================================================================================
-// *****                           ORION BUFFER FUNCTIONS                           *****
+// *****                           ORION SAMPLER FUNCTIONS                          *****
 // ======================================================================================
 
 /**
- * @brief Allocate and initialise a new oriBuffer structure.
+ * @brief Initialise the given sampler state with OpenGL's default sampling parameters.
  * 
- * @ingroup buffers
+ * @param state the sampler state to initialise.
+ * 
+ * @ingroup textures
  */
-oriBuffer *oriCreateBuffer();
+void oriInitSamplerState(oriSamplerState *state);
 
 /**
- * @brief Destroy and free memory for the given buffer.
+ * @brief Return a sampler object with the given sampling parameters.
+ * @details Samplers are shared: the first call with a set of parameters creates a sampler, and every later call with the
+ * same parameters returns that same sampler. Binding a sampler to a texture unit with oriBindSampler() overrides the
+ * sampling parameters of the texture bound to the unit, so textures can share a few samplers instead of each having its
+ * parameters set with oriSetTextureParameteri().
  * 
- * @param buffer the buffer to free
+ * The anisotropy is limited to @c GL_MAX_TEXTURE_MAX_ANISOTROPY, and is ignored if anisotropic filtering is not supported.
  * 
- * @ingroup buffers
+ * Samplers are owned by Orion, and are only freed with oriTerminate().
+ * 
+ * @param state the sampling parameters. Initialise it with oriInitSamplerState() before changing the parameters you need.
+ * 
+ * @ingroup textures
  */
-void oriFreeBuffer(oriBuffer *buffer);
+oriSampler *oriGetSampler(const oriSamplerState *state);
 
 /**
- * @brief Bind the given buffer.
+ * @brief Bind the given sampler to a texture unit.
+ * @details The bind is skipped if the sampler is already bound to the unit.
  * 
- * @param buffer the buffer to bind.
- * @param target the OpenGL buffer target to bind the buffer to.
+ * @param sampler the sampler to bind, or NULL to unbind the sampler that is bound to @c unit.
+ * @param unit the texture unit to bind the sampler to (starting from 0, not from @c GL_TEXTURE0).
  * 
- * @ingroup buffers
+ * @ingroup textures
  */
-void oriBindBuffer(oriBuffer *buffer, unsigned int target);
+void oriBindSampler(oriSampler *sampler, unsigned int unit);
 
 /**
- * @brief Return the OpenGL handle to the given buffer struct.
+ * @brief Return the OpenGL handle of the given sampler.
  * 
- * @param buffer the buffer to inspect.
+ * @param sampler the sampler to inspect.
  * 
- * @ingroup buffers
+ * @ingroup textures
  */
-unsigned int oriGetBufferHandle(oriBuffer *buffer);
+unsigned int oriGetSamplerHandle(oriSampler *sampler);
 
 /**
- * @brief Set data in a given oriBuffer structure.
+ * @brief Return the sampling parameters of the given sampler into @c state.
+ * @details The parameters are stored when the sampler is created, so OpenGL is not queried. Parameters that have no effect
+ * (e.g. the border colour, when no wrap mode is @c GL_CLAMP_TO_BORDER) are reset to their defaults.
  * 
- * @param buffer the buffer to copy data into.
- * @param data the data to copy in @c buffer.
- * @param size the size of the given data.
- * @param usage the usage of the buffer.
+ * @param sampler the sampler to inspect.
+ * @param state the sampler state to write the parameters into.
  * 
- * @ingroup buffers
+ * @ingroup textures
  */
-void oriSetBufferData(oriBuffer *buffer, const void *data, const unsigned int size, const unsigned int usage);
+void oriGetSamplerState(oriSampler *sampler, oriSamplerState *state);
+
+/**
+ * @brief Return statistics about sampler objects into the specified variables.
+ * 
+ * @details If you don't want to recieve a statistic, pass NULL as the argument.
+ * 
+ * @param samplers the number of samplers that have been created.
+ * @param bindsIssued the number of sampler binds that were issued to OpenGL with oriBindSampler().
+ * @param bindsSkipped the number of sampler binds that were skipped because the sampler was already bound.
+ * 
+ * @ingroup textures
+ */
+void oriGetSamplerStats(unsigned int *samplers, unsigned long *bindsIssued, unsigned long *bindsSkipped);
 
 // ======================================================================================
-// *****                     ORION VERTEX SPECIFICATION FUNCTIONS                   *****
+// *****                       ORION TEXTURE UPLOADER FUNCTIONS                     *****
 // ======================================================================================
 
 /**
- * @brief Allocate and initialise a new oriVertexArray structure.
+ * @brief Allocate and initialise a new oriTextureUploader structure.
  * 
- * @ingroup vertexspec
+ * @details A texture uploader stages texture uploads in a persistently-mapped pixel unpack buffer (see oriStreamBuffer),
+ * so that queueing an upload with oriQueueTexSubImage() is just a copy into mapped memory, and never waits for the driver.
+ * The queued uploads are issued from the buffer by oriFlushTextureUploads(), once per frame; the GPU then copies the data
+ * into the textures asynchronously, and each region of the buffer is only reused once the GPU has finished with it.
+ * 
+ * @param regionSize the maximum size, in bytes, of the image data that can be queued in one frame.
+ * @param regionCount the number of regions (typically the number of frames that can be in flight, e.g. 3).
+ * 
+ * @ingroup textures
  */
-oriVertexArray *oriCreateVertexArray();
+oriTextureUploader *oriCreateTextureUploader(const unsigned int regionSize, const unsigned int regionCount);
 
 /**
- * @brief Destroy and free memory for the given vertex array.
+ * @brief Destroy and free memory for the given texture uploader. Uploads that have been queued but not flushed are discarded.
  * 
- * @param va the vertex array to free.
+ * @param uploader the texture uploader to free.
  * 
- * @ingroup vertexspec
+ * @ingroup textures
  */
-void oriFreeVertexArray(oriVertexArray *va);
+void oriFreeTextureUploader(oriTextureUploader *uploader);
 
 /**
- * @brief Bind a vertex array.
+ * @brief Queue an update of a region of one level of a texture's image, to be issued by the next call to oriFlushTextureUploads().
  * 
- * @param va the vertex array to bind.
+ * @details The data is copied into the uploader's pixel unpack buffer straight away, so it can be freed as soon as this
+ * returns. Nothing else is done until the uploads are flushed; see oriUploadTexSubImage() for how the region is specified
+ * and how mipmaps are regenerated.
  * 
- * @ingroup vertexspec
+ * This never blocks: if the image data doesn't fit in what is left of this frame's region, or if the GPU is still reading
+ * from the region that would be used next, nothing is queued and false is returned, so the upload can be retried next frame.
+ * 
+ * @note The texture must not be freed before the upload is flushed.
+ * 
+ * @param uploader the texture uploader to queue the upload in.
+ * @param texture the texture object to update.
+ * @param level the mipmap level to update.
+ * @param xoffset the x coordinate of the region in the texture.
+ * @param yoffset the y coordinate of the region in the texture.
+ * @param zoffset the z coordinate of the region in the texture.
+ * @param width the width of the region.
+ * @param height the height of the region. Set to 1 if the texture is 1D.
+ * @param depth the depth of the region. Set to 1 if the texture is not 3D, an array of 2D textures or a cube map.
+ * @param imageFormat the format of the source image (e.g. @c GL_RGBA).
+ * @param dataType the GL type of the given data (e.g. GL_UNSIGNED_BYTE if @c data is an unsigned char array)
+ * @param data the image data to use, tightly packed (i.e. with no padding at the end of each row).
+ * @return true if the upload was queued.
+ * 
+ * @ingroup textures
  */
-void oriBindVertexArray(oriVertexArray *va);
+bool oriQueueTexSubImage(oriTextureUploader *uploader, oriTexture *texture, unsigned int level, unsigned int xoffset, unsigned int yoffset, unsigned int zoffset, unsigned int width, unsigned int height, unsigned int depth, unsigned int imageFormat, unsigned int dataType, const void *data);
 
 /**
- * @brief Return the OpenGL handle to the given vertex array.
+ * @brief Issue every upload queued in the given texture uploader, and fence the region they were staged in.
  * 
- * @param va the vertex array to inspect.
+ * @details Call this once per frame (e.g. at the start of the frame, before drawing). The uploads are issued from the
+ * uploader's buffer while it is bound to @c GL_PIXEL_UNPACK_BUFFER, so the driver doesn't copy any data from client memory.
  * 
- * @ingroup vertexspec
- */
+ * @param uploader the texture uploader to flush.
+ * 
+ * @ingroup textures
+ */
+void oriFlushTextureUploads(oriTextureUploader *uploader);
+
+// ======================================================================================
+// *****                           ORION MIPMAP FUNCTIONS                           *****
+// ======================================================================================
+
+/**
+ * @brief Downsample with a 2x2 box filter (see oriGenerateMipmapChain()).
+ * 
+ * @ingroup textures
+ */
+#define ORION_MIPMAP_FILTER_BOX     0
+/**
+ * @brief Downsample with a Kaiser-windowed sinc filter (see oriGenerateMipmapChain()).
+ * 
+ * @ingroup textures
+ */
+#define ORION_MIPMAP_FILTER_KAISER  1
+
+/**
+ * @brief Return the number of levels in a full mipmap chain for an image of the given size.
+ * 
+ * @param width the width of the base level.
+ * @param height the height of the base level.
+ * 
+ * @ingroup textures
+ */
+unsigned int oriMipmapLevelCount(unsigned int width, unsigned int height);
+
+/**
+ * @brief Return the size, in bytes, of a tightly packed mipmap chain.
+ * @details The levels of a chain are stored one after another, starting with the base level, and each level is half the
+ * size of the one before it (rounded down, to a minimum of 1) in each dimension. Rows are not padded.
+ * 
+ * @param width the width of the base level.
+ * @param height the height of the base level.
+ * @param levels the number of levels in the chain.
+ * @param imageFormat the format of the pixel data (@c GL_RED, @c GL_RG, @c GL_RGB or @c GL_RGBA).
+ * @param dataType the data type of the pixel data (@c GL_UNSIGNED_BYTE or @c GL_HALF_FLOAT).
+ * 
+ * @return the size of the chain, or 0 if the format isn't supported.
+ * 
+ * @ingroup textures
+ */
+size_t oriMipmapChainSize(unsigned int width, unsigned int height, const unsigned int levels, const unsigned int imageFormat, const unsigned int dataType);
+
+/**
+ * @brief Generate every mipmap level of an image on the CPU.
+ * @details The base level must already be at the start of @c chain, which must be large enough for the whole chain (see
+ * oriMipmapChainSize()). Each level is then filtered from the one before it and written after it.
+ * 
+ * No OpenGL context is needed, so chains can be generated ahead of time (e.g. when assets are baked) or on worker threads.
+ * The rows of each level are split between @c threadCount threads, and the filters use SSE2 or AVX2 where the CPU supports it.
+ * 
+ * @c ORION_MIPMAP_FILTER_BOX averages each 2x2 block of pixels, and is the fastest. @c ORION_MIPMAP_FILTER_KAISER uses a
+ * Kaiser-windowed sinc filter, which keeps distant levels much sharper without aliasing.
+ * 
+ * If @c srgb is true, the colour channels of @c GL_UNSIGNED_BYTE images are converted to linear values before they are
+ * filtered and back afterwards (as they should be for images stored in sRGB formats). The fourth channel is treated as
+ * alpha and is always filtered linearly. @c GL_HALF_FLOAT images are always linear.
+ * 
+ * @param chain the image and the memory for its mipmaps.
+ * @param width the width of the base level.
+ * @param height the height of the base level.
+ * @param levels the number of levels in the chain, including the base level (see oriMipmapLevelCount()).
+ * @param imageFormat the format of the pixel data (@c GL_RED, @c GL_RG, @c GL_RGB or @c GL_RGBA).
+ * @param dataType the data type of the pixel data (@c GL_UNSIGNED_BYTE or @c GL_HALF_FLOAT).
+ * @param filter the filter to downsample with (@c ORION_MIPMAP_FILTER_BOX or @c ORION_MIPMAP_FILTER_KAISER).
+ * @param srgb whether the image is sRGB encoded.
+ * @param threadCount the number of threads to use, or 0 to use one per CPU core.
+ * 
+ * @return false if the format isn't supported or there are too many levels, in which case nothing is written.
+ * 
+ * @ingroup textures
+ */
+bool oriGenerateMipmapChain(void *chain, const unsigned int width, const unsigned int height, const unsigned int levels, const unsigned int imageFormat, const unsigned int dataType, const unsigned int filter, const bool srgb, unsigned int threadCount);
+
+/**
+ * @brief Upload every level of a mipmap chain to a 2D texture.
+ * @details The chain is laid out as described in oriMipmapChainSize() (e.g. generated with oriGenerateMipmapChain()), and the
+ * texture must already have storage for every level of it (e.g. from oriCreateTextureImmutable()). Each level is uploaded
+ * with oriUploadTexSubImage().
+ * 
+ * @param texture the texture to upload to.
+ * @param chain the mipmap chain.
+ * @param width the width of the base level.
+ * @param height the height of the base level.
+ * @param levels the number of levels to upload.
+ * @param imageFormat the format of the pixel data (@c GL_RED, @c GL_RG, @c GL_RGB or @c GL_RGBA).
+ * @param dataType the data type of the pixel data (@c GL_UNSIGNED_BYTE or @c GL_HALF_FLOAT).
+ * 
+ * @ingroup textures
+ */
+void oriUploadMipmapChain(oriTexture *texture, const void *chain, const unsigned int width, const unsigned int height, const unsigned int levels, const unsigned int imageFormat, const unsigned int dataType);
+
+// ======================================================================================
+// *****                        ORION IMAGE LOADER FUNCTIONS                        *****
+// ======================================================================================
+
+/**
+ * @brief Flip the image vertically when it is loaded, so that its first row is at the bottom (as OpenGL expects).
+ * 
+ * @ingroup textures
+ */
+#define ORION_TEXTURE_LOAD_FLIP     0x1
+/**
+ * @brief Generate every mipmap level of the image when it is loaded.
+ * 
+ * @ingroup textures
+ */
+#define ORION_TEXTURE_LOAD_MIPMAPS  0x2
+/**
+ * @brief Store the image in an sRGB internal format (only applies to 3 and 4 channel images).
+ * 
+ * @ingroup textures
+ */
+#define ORION_TEXTURE_LOAD_SRGB     0x4
+
+/**
+ * @brief A callback function that will be called when a texture requested with oriLoadTextureAsync() has loaded.
+ * @details The parameters are the new texture (NULL if the image could not be loaded), the path of the image, and the
+ * user data given to oriLoadTextureAsync().
+ * 
+ * @ingroup textures
+ */
+typedef void (* oriTextureLoadCallback)(oriTexture *, const char *, void *);
+
+/**
+ * @brief Load a 2D texture from an image file, decoding it on a worker thread.
+ * @details This returns immediately. The image is decoded (with stb_image, so any format it supports can be loaded) on a
+ * pool of worker threads, one per CPU core, which is started by the first call. If @c ORION_TEXTURE_LOAD_MIPMAPS is
+ * given, every mipmap level is also generated on the worker thread.
+ * 
+ * Decoded images are uploaded by oriPollTextureLoads(), which must be called regularly (e.g. once per frame) on the thread
+ * the OpenGL context is current on. The texture is then created, with immutable storage, and handed to the callback.
+ * 
+ * @param path the path to the image file, @b relative @b to @b the @b executable!
+ * @param channels the number of channels to convert the image to (1 to 4), or 0 to keep the channels of the file.
+ * @param flags a combination of @c ORION_TEXTURE_LOAD_* flags, or 0.
+ * @param callback the function to call when the texture has loaded (or failed to load).
+ * @param userData a pointer that is passed to the callback.
+ * 
+ * @ingroup textures
+ */
+void oriLoadTextureAsync(const char *path, const unsigned int channels, const unsigned int flags, oriTextureLoadCallback callback, void *userData);
+
+/**
+ * @brief Upload every image that has been decoded since the last call, and hand their textures to their callbacks.
+ * @details Call this regularly (e.g. once per frame) on the thread the OpenGL context is current on. If an image couldn't
+ * be loaded, a warning is sent and its callback is given NULL.
+ * 
+ * @return the number of texture loads that are still in progress.
+ * 
+ * @ingroup textures
+ */
+unsigned int oriPollTextureLoads();
+
+// ======================================================================================
+// *****                           ORION ATLAS FUNCTIONS                            *****
+// ======================================================================================
+
+/**
+ * @brief Allocate and initialise a new oriAtlas structure.
+ * @details An atlas packs many small images (e.g. icons, sprites or glyphs) into one texture, so that they can all be drawn
+ * with a single texture binding. Its texture has immutable storage: a @c GL_TEXTURE_2D if @c layers is 0, or otherwise a
+ * @c GL_TEXTURE_2D_ARRAY with that many layers, each of which is packed separately.
+ * 
+ * Each image is surrounded by @c padding texels, which are filled with copies of its edge texels, so that filtering
+ * never blends in a neighbouring image. If the texture has mipmaps, the padding should be at least <tt>2^(levels - 1)</tt>
+ * texels for the smallest level to be free of bleeding too.
+ * 
+ * @param width the width of the atlas texture.
+ * @param height the height of the atlas texture.
+ * @param layers the number of layers of an array texture, or 0 for a 2D texture.
+ * @param internalFormat the internal format of the atlas texture, e.g. @c GL_RGBA8.
+ * @param levels the number of mipmap levels of the atlas texture (at least 1).
+ * @param padding the number of texels around each image.
+ * 
+ * @ingroup textures
+ */
+oriAtlas *oriCreateAtlas(const unsigned int width, const unsigned int height, const unsigned int layers, const unsigned int internalFormat, const unsigned int levels, const unsigned int padding);
+
+/**
+ * @brief Destroy and free memory for the given atlas, including its texture.
+ * 
+ * @param atlas the atlas to free.
+ * 
+ * @ingroup textures
+ */
+void oriFreeAtlas(oriAtlas *atlas);
+
+/**
+ * @brief Return the texture that the images of the given atlas are packed into.
+ * @details Bind it (e.g. with oriBindTexture()) to draw any of the atlas's images, using the texture coordinates of their
+ * oriAtlasRegion. Its mipmaps are regenerated when it is next bound after images are inserted.
+ * 
+ * @param atlas the atlas to get the texture of.
+ * 
+ * @ingroup textures
+ */
+oriTexture *oriGetAtlasTexture(oriAtlas *atlas);
+
+/**
+ * @brief Pack an image into the given atlas, and upload it to the atlas's texture.
+ * @details The image is placed in whichever layer it fits best. Images can't be rotated, and they can't be larger than the
+ * atlas (including their padding on both sides).
+ * 
+ * @param atlas the atlas to insert the image into.
+ * @param width the width of the image.
+ * @param height the height of the image.
+ * @param imageFormat the format of the pixel data, e.g. @c GL_RGBA.
+ * @param dataType the data type of the pixel data, e.g. @c GL_UNSIGNED_BYTE.
+ * @param data the pixel data, with tightly packed rows. If NULL, space is reserved but nothing is uploaded.
+ * @param region the region to write the image's position and texture coordinates into.
+ * @return false if there is no room for the image in the atlas.
+ * 
+ * @ingroup textures
+ */
+bool oriAtlasInsert(oriAtlas *atlas, const unsigned int width, const unsigned int height, const unsigned int imageFormat, const unsigned int dataType, const void *data, oriAtlasRegion *region);
+
+/**
+ * @brief Remove an image from the given atlas, so that its space can be reused.
+ * @details The texels of the image are left in the texture until they are overwritten by another image.
+ * 
+ * @param atlas the atlas that the image was inserted into.
+ * @param region the region of the image, as given by oriAtlasInsert(). It is reset to zero.
+ * 
+ * @ingroup textures
+ */
+void oriAtlasRemove(oriAtlas *atlas, oriAtlasRegion *region);
+
+// ======================================================================================
+// *****                        ORION TEXTURE POOL FUNCTIONS                        *****
+// ======================================================================================
+
+/**
+ * @brief Allocate and initialise a new oriTexturePool structure.
+ * @details A texture pool gives each 2D image a layer of a shared @c GL_TEXTURE_2D_ARRAY, instead of a texture of its own.
+ * Images with the same size, internal format and number of mipmap levels share arrays, so objects drawn with different
+ * images (e.g. materials) can be drawn with one texture binding, and merged into a single instanced or multi-draw call
+ * (see oriDrawBatch) with the layer of each image passed per instance or per draw.
+ * 
+ * Arrays are created with immutable storage as they are needed, each with @c layersPerArray layers, and layers are
+ * reused once they are freed.
+ * 
+ * @param layersPerArray the number of layers in each array texture. It is limited to @c GL_MAX_ARRAY_TEXTURE_LAYERS.
+ * 
+ * @ingroup textures
+ */
+oriTexturePool *oriCreateTexturePool(unsigned int layersPerArray);
+
+/**
+ * @brief Destroy and free memory for the given texture pool, including all of its array textures.
+ * 
+ * @param pool the texture pool to free.
+ * 
+ * @ingroup textures
+ */
+void oriFreeTexturePool(oriTexturePool *pool);
+
+/**
+ * @brief Give a layer of one of the given pool's array textures to an image.
+ * @details Upload the image into the layer with oriUploadTexSubImage(), using the layer as @c zoffset (and a @c depth of 1),
+ * and sample it with a @c sampler2DArray, using the layer as the third texture coordinate.
+ * 
+ * @param pool the texture pool to allocate from.
+ * @param width the width of the image.
+ * @param height the height of the image.
+ * @param internalFormat the internal format the image is stored with, e.g. @c GL_RGBA8.
+ * @param levels the number of mipmap levels the image has (at least 1).
+ * @param layer the texture layer to write the result into.
+ * @return false if the allocation failed.
+ * 
+ * @ingroup textures
+ */
+bool oriTexturePoolAlloc(oriTexturePool *pool, const unsigned int width, const unsigned int height, const unsigned int internalFormat, const unsigned int levels, oriTextureLayer *layer);
+
+/**
+ * @brief Free a layer that was allocated with oriTexturePoolAlloc(), so that it can be given to another image.
+ * @details The array texture itself is kept, even if none of its layers are in use, until the pool is freed.
+ * 
+ * @param pool the texture pool that the layer was allocated from.
+ * @param layer the layer to free. It is reset to zero.
+ * 
+ * @ingroup textures
+ */
+void oriTexturePoolFree(oriTexturePool *pool, oriTextureLayer *layer);
+
+/**
+ * @brief Return statistics about the given texture pool into the specified variables.
+ * 
+ * @details If you don't want to recieve a statistic, pass NULL as the argument.
+ * 
+ * @param pool the texture pool to inspect.
+ * @param arrays the number of array textures created by the pool.
+ * @param layers the number of layers in all of the pool's array textures.
+ * @param usedLayers the number of layers that are currently allocated.
+ * 
+ * @ingroup textures
+ */
+void oriGetTexturePoolStats(oriTexturePool *pool, unsigned int *arrays, unsigned int *layers, unsigned int *usedLayers);
+
+// ======================================================================================
+// *****                         ORION FRAMEBUFFER FUNCTIONS                        *****
+// ======================================================================================
+
+/**
+ * @brief Allocate and initialise a new oriFramebuffer structure, with no attachments.
+ * @details Attach images to it with oriFramebufferTexture() and oriFramebufferRenderbuffer(). Its draw buffers are set to
+ * its colour attachments (e.g. @c GL_COLOR_ATTACHMENT1 is drawn into by fragment shader output location 1).
+ * 
+ * @ingroup framebuffers
+ */
+oriFramebuffer *oriCreateFramebuffer();
+
+/**
+ * @brief Destroy and free memory for the given framebuffer, including the renderbuffers it created.
+ * @details Attached textures are not freed.
+ * 
+ * @param framebuffer the framebuffer to free.
+ * 
+ * @ingroup framebuffers
+ */
+void oriFreeFramebuffer(oriFramebuffer *framebuffer);
+
+/**
+ * @brief Attach a level of a texture to the given framebuffer.
+ * @details Nothing is done if the same image is already attached, so a pass can attach its targets every frame (e.g.
+ * targets from an oriRenderTargetPool) without the framebuffer being checked for completeness again.
+ * 
+ * @param framebuffer the framebuffer to update.
+ * @param attachment the attachment point, e.g. @c GL_COLOR_ATTACHMENT0 or @c GL_DEPTH_ATTACHMENT.
+ * @param texture the texture to attach, or NULL to detach the image at @c attachment.
+ * @param level the mipmap level of the texture to attach.
+ * @param layer the layer (or cube map face) to attach, for array, cube map and 3D textures; or -1 to attach every layer
+ * (for layered rendering).
+ * 
+ * @ingroup framebuffers
+ */
+void oriFramebufferTexture(oriFramebuffer *framebuffer, unsigned int attachment, oriTexture *texture, unsigned int level, int layer);
+
+/**
+ * @brief Create a renderbuffer and attach it to the given framebuffer.
+ * @details Renderbuffers can't be sampled, so they suit attachments that are only used while rendering (e.g. the depth
+ * buffer of a pass whose depth is not read afterwards). The renderbuffer is owned by the framebuffer, and is deleted when
+ * it is replaced or when the framebuffer is freed.
+ * 
+ * @param framebuffer the framebuffer to update.
+ * @param attachment the attachment point, e.g. @c GL_DEPTH_STENCIL_ATTACHMENT.
+ * @param internalFormat the internal format of the renderbuffer, e.g. @c GL_DEPTH24_STENCIL8.
+ * @param width the width of the renderbuffer.
+ * @param height the height of the renderbuffer.
+ * @param samples the number of samples in the renderbuffer; 0 if it is not multisampled.
+ * 
+ * @ingroup framebuffers
+ */
+void oriFramebufferRenderbuffer(oriFramebuffer *framebuffer, unsigned int attachment, unsigned int internalFormat, unsigned int width, unsigned int height, unsigned int samples);
+
+/**
+ * @brief Bind the given framebuffer for drawing and reading.
+ * @details If its attachments have changed since it was last bound, its draw buffers are updated and its completeness is
+ * checked (and a warning is given if it is incomplete). Otherwise the stored result is used, and nothing is queried.
+ * The bind is skipped if the framebuffer is already bound.
+ * 
+ * @param framebuffer the framebuffer to bind, or NULL to bind the default framebuffer (the window).
+ * 
+ * @ingroup framebuffers
+ */
+void oriBindFramebuffer(oriFramebuffer *framebuffer);
+
+/**
+ * @brief Return the completeness of the given framebuffer; @c GL_FRAMEBUFFER_COMPLETE if it can be rendered to.
+ * @details The result of the last check is returned, unless the attachments have changed since.
+ * 
+ * @param framebuffer the framebuffer to inspect.
+ * 
+ * @ingroup framebuffers
+ */
+unsigned int oriGetFramebufferStatus(oriFramebuffer *framebuffer);
+
+/**
+ * @brief Return the size of the image that was most recently attached to the given framebuffer into the specified variables.
+ * 
+ * @details If you don't want to recieve a value, pass NULL as the argument.
+ * 
+ * @param framebuffer the framebuffer to inspect.
+ * @param width the width of the image.
+ * @param height the height of the image.
+ * 
+ * @ingroup framebuffers
+ */
+void oriGetFramebufferAttachmentSize(oriFramebuffer *framebuffer, unsigned int *width, unsigned int *height);
+
+/**
+ * @brief Return the OpenGL handle of the given framebuffer.
+ * 
+ * @param framebuffer the framebuffer to inspect.
+ * 
+ * @ingroup framebuffers
+ */
+unsigned int oriGetFramebufferHandle(oriFramebuffer *framebuffer);
+
+// ======================================================================================
+// *****                     ORION RENDER TARGET POOL FUNCTIONS                     *****
+// ======================================================================================
+
+/**
+ * @brief Allocate and initialise a new oriRenderTargetPool structure.
+ * @details A render target pool keeps the textures that render passes draw into, so that they are not reallocated when
+ * a pass is toggled on or the window is resized back. A pass acquires its targets with oriAcquireRenderTarget() and
+ * releases them once the passes that read them are done, so that later passes in the same frame can reuse them.
+ * Call oriRenderTargetPoolNextFrame() once per frame; targets that have not been used for @c maxIdleFrames frames
+ * (e.g. ones of the old window size after a resize) are then freed.
+ * 
+ * @param maxIdleFrames the number of frames a target is kept for without being acquired.
+ * 
+ * @ingroup framebuffers
+ */
+oriRenderTargetPool *oriCreateRenderTargetPool(unsigned int maxIdleFrames);
+
+/**
+ * @brief Destroy and free memory for the given render target pool, including all of its textures.
+ * 
+ * @param pool the render target pool to free.
+ * 
+ * @ingroup framebuffers
+ */
+void oriFreeRenderTargetPool(oriRenderTargetPool *pool);
+
+/**
+ * @brief Return a texture from the given pool to render into, creating one if none of the same kind is free.
+ * @details The texture is a @c GL_TEXTURE_2D with one mipmap level (or a @c GL_TEXTURE_2D_MULTISAMPLE, if @c samples
+ * is not 0), filtered linearly and clamped to its edges. Its contents are undefined: they may be those of a previous pass.
+ * 
+ * @param pool the render target pool to acquire from.
+ * @param width the width of the target.
+ * @param height the height of the target.
+ * @param internalFormat the internal format of the target, e.g. @c GL_RGBA16F or @c GL_DEPTH_COMPONENT32F.
+ * @param samples the number of samples in the target; 0 if it is not multisampled.
+ * 
+ * @ingroup framebuffers
+ */
+oriTexture *oriAcquireRenderTarget(oriRenderTargetPool *pool, unsigned int width, unsigned int height, unsigned int internalFormat, unsigned int samples);
+
+/**
+ * @brief Give a texture acquired with oriAcquireRenderTarget() back to the given pool, so that it can be reused.
+ * 
+ * @param pool the render target pool that the texture was acquired from.
+ * @param texture the texture to release.
+ * 
+ * @ingroup framebuffers
+ */
+void oriReleaseRenderTarget(oriRenderTargetPool *pool, oriTexture *texture);
+
+/**
+ * @brief Start a new frame for the given render target pool, freeing the targets that have not been acquired for more
+ * than the pool's number of idle frames.
+ * @details Targets that are still acquired are never freed.
+ * 
+ * @param pool the render target pool to update.
+ * 
+ * @ingroup framebuffers
+ */
+void oriRenderTargetPoolNextFrame(oriRenderTargetPool *pool);
+
+/**
+ * @brief Return statistics about the given render target pool into the specified variables.
+ * 
+ * @details If you don't want to recieve a statistic, pass NULL as the argument.
+ * 
+ * @param pool the render target pool to inspect.
+ * @param targets the number of textures currently kept by the pool.
+ * @param inUse the number of those textures that are currently acquired.
+ * @param created the number of textures that the pool has created since it was created.
+ * 
+ * @ingroup framebuffers
+ */
+void oriGetRenderTargetPoolStats(oriRenderTargetPool *pool, unsigned int *targets, unsigned int *inUse, unsigned int *created);
+
+// ======================================================================================
+// *****                           ORION BUFFER FUNCTIONS                           *****
+// ======================================================================================
+
+/**
+ * @brief Allocate and initialise a new oriBuffer structure.
+ * 
+ * @ingroup buffers
+ */
+oriBuffer *oriCreateBuffer();
+
+/**
+ * @brief Allocate and initialise a new oriBuffer structure with immutable storage.
+ * @details The storage of the buffer is allocated once, here, and can never be resized. Buffers with immutable storage
+ * can be better placed and synchronised by the driver, so they should be preferred for data that never changes size (e.g. static meshes).
+ * 
+ * @note oriSetBufferData() and oriSetBufferSubData() can only update the contents of the buffer if @c GL_DYNAMIC_STORAGE_BIT
+ * is set in @c flags, and oriSetBufferData() will never reallocate the storage.
+ * 
+ * @param data the data to initialise the buffer's storage with. Set to NULL to leave it uninitialised.
+ * @param size the size of the buffer's storage, in bytes.
+ * @param flags a bitwise combination of @c GL_DYNAMIC_STORAGE_BIT, @c GL_MAP_READ_BIT, @c GL_MAP_WRITE_BIT, @c GL_MAP_PERSISTENT_BIT,
+ * @c GL_MAP_COHERENT_BIT and @c GL_CLIENT_STORAGE_BIT (or 0).
+ * 
+ * @sa <a href="https://www.khronos.org/opengl/wiki/Buffer_Object#Immutable_Storage">OpenGL/Immutable buffer storage</a>
+ * @sa <a href="https://docs.gl/gl4/glBufferStorage">glBufferStorage</a>
+ * 
+ * @ingroup buffers
+ */
+oriBuffer *oriCreateBufferImmutable(const void *data, const unsigned int size, const unsigned int flags);
+
+/**
+ * @brief Destroy and free memory for the given buffer.
+ * 
+ * @param buffer the buffer to free
+ * 
+ * @ingroup buffers
+ */
+void oriFreeBuffer(oriBuffer *buffer);
+
+/**
+ * @brief Bind the given buffer.
+ * 
+ * @param buffer the buffer to bind.
+ * @param target the OpenGL buffer target to bind the buffer to.
+ * 
+ * @ingroup buffers
+ */
+void oriBindBuffer(oriBuffer *buffer, unsigned int target);
+
+/**
+ * @brief Return the OpenGL handle to the given buffer struct.
+ * 
+ * @param buffer the buffer to inspect.
+ * 
+ * @ingroup buffers
+ */
+unsigned int oriGetBufferHandle(oriBuffer *buffer);
+
+/**
+ * @brief Set data in a given oriBuffer structure.
+ * 
+ * @param buffer the buffer to copy data into.
+ * @param data the data to copy in @c buffer.
+ * @param size the size of the given data.
+ * @param usage the usage of the buffer.
+ * 
+ * @ingroup buffers
+ */
+void oriSetBufferData(oriBuffer *buffer, const void *data, const unsigned int size, const unsigned int usage);
+
+/**
+ * @brief Update a range of the data store of a given oriBuffer structure, without reallocating it.
+ * 
+ * @param buffer the buffer to copy data into.
+ * @param offset the offset into the buffer's data store, in bytes, at which to start replacing data.
+ * @param data the data to copy into @c buffer.
+ * @param size the size of the given data.
+ * 
+ * @ingroup buffers
+ */
+void oriSetBufferSubData(oriBuffer *buffer, const unsigned int offset, const void *data, const unsigned int size);
+
+/**
+ * @brief Return buffer properties into the specified variables.
+ * 
+ * @details If you don't want to recieve a property, pass NULL as the argument.
+ * 
+ * @param buffer the buffer to inspect.
+ * @param size the size of the buffer's data store, in bytes (0 if it has not been allocated).
+ * @param immutable true if the buffer was created with immutable storage.
+ * @param flags the storage flags given to oriCreateBufferImmutable(); 0 if the buffer's storage is mutable.
+ * 
+ * @ingroup buffers
+ */
+void oriGetBufferProperty(oriBuffer *buffer, unsigned int *size, bool *immutable, unsigned int *flags);
+
+/**
+ * @brief Allocate and initialise a new oriStreamBuffer structure.
+ * @details The buffer's storage is allocated once with @c glBufferStorage and mapped persistently and coherently, so
+ * that data can be written into it directly every frame without any implicit synchronisation or copies in the driver.
+ * The storage is split into @c regionCount regions of @c regionSize bytes, each of which is guarded by a fence so that
+ * the CPU never writes into a region that the GPU is still reading from.
+ * 
+ * @note The region size is rounded up to a multiple of 256 bytes so that every region offset is suitably aligned.
+ * 
+ * @param regionSize the size, in bytes, of the data written in one frame.
+ * @param regionCount the number of regions (typically the number of frames that can be in flight, e.g. 3).
+ * 
+ * @sa <a href="https://www.khronos.org/opengl/wiki/Buffer_Object_Streaming#Persistent_mapped_streaming">OpenGL/Persistent mapped streaming</a>
+ * 
+ * @ingroup buffers
+ */
+oriStreamBuffer *oriCreateStreamBuffer(const unsigned int regionSize, const unsigned int regionCount);
+
+/**
+ * @brief Destroy and free memory for the given stream buffer (and its underlying oriBuffer).
+ * 
+ * @param stream the stream buffer to free.
+ * 
+ * @ingroup buffers
+ */
+void oriFreeStreamBuffer(oriStreamBuffer *stream);
+
+/**
+ * @brief Return the oriBuffer that backs the given stream buffer.
+ * @details The returned buffer can be used like any other buffer, e.g. passed to oriSpecifyVertexData().
+ * It is owned by the stream buffer and must not be freed separately.
+ * 
+ * @param stream the stream buffer to inspect.
+ * 
+ * @ingroup buffers
+ */
+oriBuffer *oriGetStreamBufferBuffer(oriStreamBuffer *stream);
+
+/**
+ * @brief Advance the stream buffer to its next region and return a pointer to write this frame's data into.
+ * @details If the GPU is still using the region (i.e. its fence has not yet been signalled) then this function
+ * will block until it is no longer in use.
+ * 
+ * @param stream the stream buffer to write into.
+ * @return a pointer to the start of the current region, which is @c regionSize bytes long.
+ * 
+ * @ingroup buffers
+ */
+void *oriStreamBufferBegin(oriStreamBuffer *stream);
+
+/**
+ * @brief Return true if the GPU has finished with the next region of the given stream buffer, i.e. if the next call
+ * to oriStreamBufferBegin() won't block.
+ * 
+ * @param stream the stream buffer to poll.
+ * 
+ * @ingroup buffers
+ */
+bool oriStreamBufferReady(oriStreamBuffer *stream);
+
+/**
+ * @brief Place a fence on the current region of the given stream buffer.
+ * @details This should be called after every draw call that reads from the current region has been issued.
+ * 
+ * @param stream the stream buffer to fence.
+ * 
+ * @ingroup buffers
+ */
+void oriStreamBufferEnd(oriStreamBuffer *stream);
+
+/**
+ * @brief Return the byte offset of the current region from the start of the stream buffer.
+ * @details Use this to offset vertex or index data (e.g. as the base vertex of a draw call) when reading from the current region.
+ * 
+ * @param stream the stream buffer to inspect.
+ * 
+ * @ingroup buffers
+ */
+unsigned int oriStreamBufferOffset(oriStreamBuffer *stream);
+
+// ======================================================================================
+// *****                         ORION BUFFER HEAP FUNCTIONS                        *****
+// ======================================================================================
+
+/**
+ * @brief Allocate and initialise a new oriBufferHeap structure.
+ * @details A buffer heap reserves a few large buffer objects ('pools') and sub-allocates ranges of them, so that
+ * many meshes can share the same buffer object (and therefore the same vertex array bindings). Draw calls can then
+ * select a mesh by its offset (e.g. with a base vertex or first index) instead of switching buffers.
+ * 
+ * Allocations are handled by a two-level segregated fit (TLSF) allocator, so allocating and freeing is O(1).
+ * A new pool is reserved whenever an allocation doesn't fit into any of the existing ones.
+ * 
+ * @param poolSize the size, in bytes, of each pool. A pool that is reserved for an allocation near or above this size is made
+ * larger, so that the allocation fits.
+ * @param flags the storage flags to create each pool with (see oriCreateBufferImmutable()). @c GL_DYNAMIC_STORAGE_BIT
+ * is needed to fill allocations with oriSetBufferSubData(). Ignored if the GL version is below 4.4.
+ * 
+ * @ingroup buffers
+ */
+oriBufferHeap *oriCreateBufferHeap(const unsigned int poolSize, const unsigned int flags);
+
+/**
+ * @brief Destroy and free memory for the given buffer heap, including all of its pools.
+ * 
+ * @param heap the heap to free.
+ * 
+ * @ingroup buffers
+ */
+void oriFreeBufferHeap(oriBufferHeap *heap);
+
+/**
+ * @brief Sub-allocate a range of one of the given heap's buffers.
+ * 
+ * @param heap the heap to allocate from.
+ * @param size the size of the allocation, in bytes.
+ * @param alignment the alignment of the allocation's offset, in bytes. Must be a power of two; values below 16 are rounded up to 16.
+ * For uniform or shader storage buffer ranges, use @c GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT or @c GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT.
+ * @param allocation the allocation to write the result into.
+ * @return false if the allocation failed.
+ * 
+ * @ingroup buffers
+ */
+bool oriBufferHeapAlloc(oriBufferHeap *heap, const unsigned int size, unsigned int alignment, oriBufferAllocation *allocation);
+
+/**
+ * @brief Free a range that was allocated with oriBufferHeapAlloc().
+ * 
+ * @param heap the heap that the range was allocated from.
+ * @param allocation the allocation to free. It is reset to zero.
+ * 
+ * @ingroup buffers
+ */
+void oriBufferHeapFree(oriBufferHeap *heap, oriBufferAllocation *allocation);
+
+/**
+ * @brief Return statistics about the given buffer heap into the specified variables.
+ * 
+ * @details If you don't want to recieve a statistic, pass NULL as the argument.
+ * 
+ * @param heap the heap to inspect.
+ * @param pools the number of pools (buffer objects) reserved by the heap.
+ * @param totalSize the combined size of all pools, in bytes.
+ * @param usedSize the number of bytes currently allocated (including alignment).
+ * @param largestFree the size of the largest free block, i.e. the largest allocation that can be made without reserving a new pool.
+ * @param fragmentation a value from 0 to 1, where 0 means that all free space is in one block; calculated as
+ * <tt>1 - largestFree / (totalSize - usedSize)</tt>.
+ * 
+ * @ingroup buffers
+ */
+void oriGetBufferHeapStats(oriBufferHeap *heap, unsigned int *pools, unsigned int *totalSize, unsigned int *usedSize, unsigned int *largestFree, float *fragmentation);
+
+// ======================================================================================
+// *****                     ORION VERTEX SPECIFICATION FUNCTIONS                   *****
+// ======================================================================================
+
+/**
+ * @brief Allocate and initialise a new oriVertexArray structure.
+ * 
+ * @ingroup vertexspec
+ */
+oriVertexArray *oriCreateVertexArray();
+
+/**
+ * @brief Destroy and free memory for the given vertex array.
+ * 
+ * @param va the vertex array to free.
+ * 
+ * @ingroup vertexspec
+ */
+void oriFreeVertexArray(oriVertexArray *va);
+
+/**
+ * @brief Bind a vertex array.
+ * 
+ * @param va the vertex array to bind.
+ * 
+ * @ingroup vertexspec
+ */
+void oriBindVertexArray(oriVertexArray *va);
+
+/**
+ * @brief Return the OpenGL handle to the given vertex array.
+ * 
+ * @param va the vertex array to inspect.
+ * 
+ * @ingroup vertexspec
+ */
 unsigned int oriGetVertexArrayHandle(oriVertexArray *va);
 
 /**
- * @brief Specifies vertex data with the given attribute format.
- * @details @c buffer @b should be a vertex buffer. But it does not necessarily have to be.
- * According to the OpenGL specification:
- *  > [Vertex Buffer Objects] are no different from any other buffer object, and a buffer object used for Transform
- *  > Feedback or asynchronous pixel transfers can be used as source values for vertex arrays.
+ * @brief Specifies vertex data with the given attribute format.
+ * @details @c buffer @b should be a vertex buffer. But it does not necessarily have to be.
+ * According to the OpenGL specification:
+ *  > [Vertex Buffer Objects] are no different from any other buffer object, and a buffer object used for Transform
+ *  > Feedback or asynchronous pixel transfers can be used as source values for vertex arrays.
+ * 
+ * @warning The buffer still needs to be bound to @c GL_ARRAY_BUFFER when not using direct state access. So
+ * if your GL version is below 4.5 and your buffer is not bound to @c GL_ARRAY_BUFFER then you will get a warning in the
+ * console and @b the @b function @b will @b exit @b early.
+ * 
+ * @param va the vertex array object (VAO) to store the vertex data in.
+ * @param buffer the buffer to read from.
+ * @param index the index of the vertex attribute to be defined.
+ * @param size the number of components per vertex attribute.
+ * @param type the type of each component, e.g. \c GL_FLOAT or \c GL_INT.
+ * @param normalised should the data be normalised
+ * @param stride the byte offset between each vertex attribute.
+ * @param offset an offset of the first component of the vertex attribute.
+ * 
+ * @ingroup vertexspec
+ */
+void oriSpecifyVertexData(oriVertexArray *va, oriBuffer *buffer, 
+    const unsigned int index,
+    const unsigned int size,
+    const unsigned int type,
+    const bool normalised,
+    const unsigned int stride,
+    const unsigned int offset
+);
+
+/**
+ * @brief Set the rate at which a vertex attribute advances during instanced draw calls.
+ * @details This is intended for attributes specified with oriSpecifyVertexData(), which use the attribute index as
+ * their binding point. For attributes described by an oriVertexLayout, give the divisor to oriVertexLayoutBinding() instead.
+ * 
+ * @param va the vertex array to modify.
+ * @param index the index of the vertex attribute.
+ * @param divisor the number of instances that pass between updates of the attribute; 0 for regular per-vertex attributes.
+ * 
+ * @sa oriDrawInstanced()
+ * @sa oriDrawElementsInstanced()
+ * 
+ * @ingroup vertexspec
+ */
+void oriSetVertexAttribDivisor(oriVertexArray *va, const unsigned int index, const unsigned int divisor);
+
+// ======================================================================================
+// *****                        ORION VERTEX LAYOUT FUNCTIONS                       *****
+// ======================================================================================
+
+/**
+ * @brief Allocate and initialise a new, empty oriVertexLayout structure.
+ * @details A vertex layout describes every attribute and vertex buffer binding point of a vertex array at once, so
+ * that it can be applied in a single pass with oriApplyVertexLayout(). Attributes read from binding points rather than
+ * directly from buffers, so the buffer for a binding point can later be swapped with a single call to oriBindVertexBuffer()
+ * without respecifying any attributes.
+ * 
+ * @sa <a href="https://www.khronos.org/opengl/wiki/Vertex_Specification#Separate_attribute_format">OpenGL/Separate attribute format</a>
+ * 
+ * @ingroup vertexspec
+ */
+oriVertexLayout *oriCreateVertexLayout();
+
+/**
+ * @brief Free memory for the given vertex layout.
+ * @details Vertex arrays that the layout has been applied to are unaffected.
+ * 
+ * @param layout the vertex layout to free.
+ * 
+ * @ingroup vertexspec
+ */
+void oriFreeVertexLayout(oriVertexLayout *layout);
+
+/**
+ * @brief Describe a vertex buffer binding point in the given layout.
+ * 
+ * @param layout the vertex layout to modify.
+ * @param binding the index of the binding point (below @c ORION_MAX_VERTEX_BINDINGS).
+ * @param stride the byte offset between consecutive elements in the buffer bound to this binding point.
+ * @param divisor the number of instances that pass between updates of attributes that read from this binding point;
+ * 0 for regular per-vertex attributes.
+ * 
+ * @ingroup vertexspec
+ */
+void oriVertexLayoutBinding(oriVertexLayout *layout, const unsigned int binding, const unsigned int stride, const unsigned int divisor);
+
+/**
+ * @brief Describe a vertex attribute in the given layout.
+ * 
+ * @param layout the vertex layout to modify.
+ * @param index the index of the vertex attribute (below @c ORION_MAX_VERTEX_ATTRIBS).
+ * @param binding the vertex buffer binding point that the attribute reads from.
+ * @param size the number of components per vertex attribute.
+ * @param type the type of each component, e.g. \c GL_FLOAT or \c GL_INT.
+ * @param normalised should the data be normalised
+ * @param offset the offset of the first component of the attribute, relative to the start of each element in the binding point's buffer.
+ * 
+ * @ingroup vertexspec
+ */
+void oriVertexLayoutAttribute(oriVertexLayout *layout, const unsigned int index, const unsigned int binding, const unsigned int size, const unsigned int type, const bool normalised, const unsigned int offset);
+
+/**
+ * @brief Describe a vertex attribute in the given layout by the name of the shader input it feeds, rather than by index.
+ * @details The index of the attribute is found when the layout is matched to a shader with oriBindVertexLayoutToShader(),
+ * which must be called before the layout is applied. This way, the layout doesn't depend on the @c layout(location = ...)
+ * qualifiers in the shader.
+ * 
+ * @param layout the vertex layout to modify.
+ * @param name the name of the shader input (e.g. @c "vertexPosIn").
+ * @param binding the vertex buffer binding point that the attribute reads from.
+ * @param size the number of components per vertex attribute.
+ * @param type the type of each component, e.g. \c GL_FLOAT or \c GL_INT.
+ * @param normalised should the data be normalised
+ * @param offset the offset of the first component of the attribute, relative to the start of each element in the binding point's buffer.
+ * 
+ * @ingroup vertexspec
+ */
+void oriVertexLayoutNamedAttribute(oriVertexLayout *layout, const char *name, const unsigned int binding, const unsigned int size, const unsigned int type, const bool normalised, const unsigned int offset);
+
+/**
+ * @brief Match the attributes of the given layout to the inputs of a shader.
+ * @details Named attributes (see oriVertexLayoutNamedAttribute()) are given the location of the shader input with the
+ * same name, and attributes that the shader doesn't read are left out, so that they are disabled when the layout is
+ * applied with oriApplyVertexLayout() and no vertex fetch bandwidth is wasted on them. A warning is sent for each input
+ * that the layout doesn't provide, or provides with the wrong type (e.g. integers to a @c vec3).
+ * 
+ * The match is kept until the layout's attributes are changed, so this only has to be called once.
+ * 
+ * @param layout the vertex layout to match.
+ * @param shader the shader whose inputs the layout feeds.
+ * 
+ * @ingroup vertexspec
+ */
+void oriBindVertexLayoutToShader(oriVertexLayout *layout, oriShader *shader);
+
+/**
+ * @brief Apply every attribute and binding point described by the given layout to a vertex array, in one pass.
+ * @details Attributes that were previously enabled on the vertex array but aren't in the layout are disabled. If the layout
+ * has been matched to a shader with oriBindVertexLayoutToShader(), only the attributes that the shader reads are applied.
+ * Buffers must then be attached to each binding point with oriBindVertexBuffer().
+ * 
+ * @param va the vertex array to modify.
+ * @param layout the vertex layout to apply.
+ * 
+ * @ingroup vertexspec
+ */
+void oriApplyVertexLayout(oriVertexArray *va, oriVertexLayout *layout);
+
+/**
+ * @brief Attach a buffer to one of a vertex array's binding points.
+ * @details Every attribute that reads from the binding point (as described by the last vertex layout applied to the
+ * vertex array) will read from the given buffer, so swapping the buffer takes just this one call.
+ * 
+ * @param va the vertex array to modify.
+ * @param binding the binding point to attach the buffer to.
+ * @param buffer the buffer to attach.
+ * @param offset the offset of the first element in the buffer, in bytes.
+ * 
+ * @ingroup vertexspec
+ */
+void oriBindVertexBuffer(oriVertexArray *va, const unsigned int binding, oriBuffer *buffer, const unsigned int offset);
+
+// ======================================================================================
+// *****                           ORION DRAWING FUNCTIONS                          *****
+// ======================================================================================
+
+/**
+ * @brief Draw multiple instances of a range of vertices, using the currently-bound vertex array and shader.
  * 
- * @warning The buffer still needs to be bound to @c GL_ARRAY_BUFFER when not using direct state access. So
- * if your GL version is below 4.5 and your buffer is not bound to @c GL_ARRAY_BUFFER then you will get a warning in the
- * console and @b the @b function @b will @b exit @b early.
+ * @param mode the kind of primitives to render, e.g. @c GL_TRIANGLES.
+ * @param first the index of the first vertex to draw.
+ * @param count the number of vertices to draw per instance.
+ * @param instanceCount the number of instances to draw.
  * 
- * @param va the vertex array object (VAO) to store the vertex data in.
- * @param buffer the buffer to read from.
- * @param index the index of the vertex attribute to be defined.
- * @param size the number of components per vertex attribute.
- * @param type the type of each component, e.g. \c GL_FLOAT or \c GL_INT.
- * @param normalised should the data be normalised
- * @param stride the byte offset between each vertex attribute.
- * @param offset an offset of the first component of the vertex attribute.
+ * @sa <a href="https://docs.gl/gl4/glDrawArraysInstanced">glDrawArraysInstanced</a>
  * 
- * @ingroup vertexspec
+ * @ingroup drawing
  */
-void oriSpecifyVertexData(oriVertexArray *va, oriBuffer *buffer, 
-    const unsigned int index,
-    const unsigned int size,
-    const unsigned int type,
-    const bool normalised,
-    const unsigned int stride,
-    const unsigned int offset
-);
+void oriDrawInstanced(const unsigned int mode, const unsigned int first, const unsigned int count, const unsigned int instanceCount);
+
+/**
+ * @brief Draw multiple instances of a set of indexed vertices, using the currently-bound vertex array, shader and index buffer.
+ * @details The index buffer is the one bound to @c GL_ELEMENT_ARRAY_BUFFER while the vertex array was bound.
+ * 
+ * @param mode the kind of primitives to render, e.g. @c GL_TRIANGLES.
+ * @param count the number of indices to draw per instance.
+ * @param type the type of the indices, e.g. @c GL_UNSIGNED_INT.
+ * @param offset the offset of the first index into the index buffer, in bytes.
+ * @param baseVertex a constant that is added to every index, e.g. the first vertex of a mesh sub-allocated from an oriBufferHeap.
+ * @param instanceCount the number of instances to draw.
+ * 
+ * @sa <a href="https://docs.gl/gl4/glDrawElementsInstancedBaseVertex">glDrawElementsInstancedBaseVertex</a>
+ * 
+ * @ingroup drawing
+ */
+void oriDrawElementsInstanced(const unsigned int mode, const unsigned int count, const unsigned int type, const unsigned int offset, const int baseVertex, const unsigned int instanceCount);
+
+/**
+ * @brief Allocate and initialise a new oriDrawBatch structure.
+ * @details A draw batch collects indexed draw commands on the CPU. When flushed, the commands are uploaded to an
+ * indirect buffer in one go, grouped by shader and vertex array, and each group is submitted with a single call to
+ * glMultiDrawElementsIndirect() - so thousands of draw calls become a handful of submissions.
+ * 
+ * @param mode the kind of primitives to render, e.g. @c GL_TRIANGLES.
+ * @param indexType the type of the indices in every index buffer drawn from, e.g. @c GL_UNSIGNED_INT.
+ * 
+ * @sa <a href="https://www.khronos.org/opengl/wiki/Vertex_Rendering#Indirect_rendering">OpenGL/Indirect rendering</a>
+ * 
+ * @ingroup drawing
+ */
+oriDrawBatch *oriCreateDrawBatch(const unsigned int mode, const unsigned int indexType);
+
+/**
+ * @brief Destroy and free memory for the given draw batch (and its indirect buffer).
+ * 
+ * @param batch the draw batch to free.
+ * 
+ * @ingroup drawing
+ */
+void oriFreeDrawBatch(oriDrawBatch *batch);
+
+/**
+ * @brief Add an indexed draw command to the given batch.
+ * @details Nothing is drawn until oriFlushDrawBatch() is called. The vertex array must have its index buffer attached
+ * (i.e. bound to @c GL_ELEMENT_ARRAY_BUFFER while the vertex array was bound).
+ * 
+ * @param batch the batch to add the command to.
+ * @param shader the shader to draw with.
+ * @param va the vertex array to draw from.
+ * @param count the number of indices to draw per instance.
+ * @param instanceCount the number of instances to draw.
+ * @param firstIndex the index of the first index to draw, in the vertex array's index buffer.
+ * @param baseVertex a constant that is added to every index.
+ * @param baseInstance the first instance to draw; this offsets the instance index used to fetch instanced attributes.
+ * 
+ * @ingroup drawing
+ */
+void oriDrawBatchAdd(oriDrawBatch *batch, oriShader *shader, oriVertexArray *va, const unsigned int count, const unsigned int instanceCount, const unsigned int firstIndex, const int baseVertex, const unsigned int baseInstance);
+
+/**
+ * @brief Submit every draw command in the given batch, then clear it.
+ * @details The commands are uploaded to the batch's indirect buffer, which is bound to @c GL_DRAW_INDIRECT_BUFFER.
+ * From OpenGL 4.4 the buffer is a stream buffer (see oriStreamBuffer) with a region for each of the last three flushes,
+ * so the commands are written while the GPU may still be reading those of earlier flushes, without the driver having to
+ * synchronise or copy. Before that, the buffer is orphaned before each upload.
+ * 
+ * Commands are grouped by shader and vertex array, and each group is drawn with one call to glMultiDrawElementsIndirect().
+ * The last group's shader and vertex array are left bound.
+ * 
+ * @param batch the batch to submit.
+ * 
+ * @ingroup drawing
+ */
+void oriFlushDrawBatch(oriDrawBatch *batch);
 
 // ======================================================================================
 // *****                           ORION SHADER FUNCTIONS                           *****
@@ -517,6 +1933,8 @@ void oriBindShader(oriShader *shader);
 
 /**
  * @brief Return the OpenGL handle to the given shader struct.
+ * @details The shader is linked first (see oriLinkShader()) if it hasn't been, and this waits for linking to finish, so
+ * the program can be used or queried straight away.
  * 
  * @param shader the shader to inspect.
  * 
@@ -537,8 +1955,22 @@ unsigned int oriCompileShader(const unsigned int type, const char *src);
 
 /**
  * @brief Parse a shader file and return it as a single string.
+ * @details Every <tt>\#include "file"</tt> (or <tt>\#include \<file\></tt>) directive is replaced with the contents of the
+ * named file, relative to the directory of the file that includes it. Includes are expanded recursively, and every file is
+ * included at most once (as if it began with <tt>\#pragma once</tt>), so include guards are not needed.
+ * 
+ * Files are read (or memory-mapped, if they are large) once and shared by every source that includes them, and the
+ * expanded source is cached until the file (or any file it includes) is modified on disk.
+ * 
+ * If the returned string is passed to oriAddShaderSource(), the shader remembers the file, so it can be hot reloaded
+ * (see oriShaderSourcesChanged()).
+ * 
+ * @note The returned string belongs to Orion: don't free it. It is freed as soon as Orion finds that the file (or any file
+ * it includes) has been modified: by the next oriParseShader() or oriAddShaderSourceFile() of the file, or by
+ * oriShaderSourcesChanged() or oriPollShaderHotReload(). Copy it if it must outlive that.
  * 
  * @param path the path to the shader, @b relative @b to @b the @b executable!
+ * @return an empty string if the file could not be read.
  * 
  * @ingroup shaders
  */
@@ -546,6 +1978,11 @@ const char *oriParseShader(const char *path);
 
 /**
  * @brief Add GLSL source to the given shader.
+ * @details The source is only stored here: every stage is compiled and the program is linked once, by oriLinkShader()
+ * (or implicitly, when the shader is first bound or its uniforms are first accessed).
+ * 
+ * If @c src is a string returned by oriParseShader(), the shader remembers the file it was parsed from, as with
+ * oriAddShaderSourceFile().
  * 
  * @param shader the shader to modify
  * @param type the type of source code (e.g. @c GL_VERTEX_SHADER)
@@ -555,17 +1992,199 @@ const char *oriParseShader(const char *path);
  */
 void oriAddShaderSource(oriShader *shader, const unsigned int type, const char *src);
 
+/**
+ * @brief Parse a GLSL source file (see oriParseShader()) and add it to the given shader.
+ * @details The shader remembers the file, so oriShaderSourcesChanged() can tell when it (or any file it includes) is modified.
+ * 
+ * @param shader the shader to modify
+ * @param type the type of source code (e.g. @c GL_VERTEX_SHADER)
+ * @param path the path to the source file, @b relative @b to @b the @b executable!
+ * 
+ * @ingroup shaders
+ */
+void oriAddShaderSourceFile(oriShader *shader, const unsigned int type, const char *path);
+
+/**
+ * @brief Return true if a source file of the given shader, or any file it includes, has been modified since it was added (or reloaded).
+ * @details Only the stages that were parsed from files are checked: those added with oriAddShaderSourceFile(), or with
+ * oriAddShaderSource() given a string returned by oriParseShader(). Files are only re-read if they have been
+ * modified, so a changed file only affects the shaders that depend on it.
+ * 
+ * @param shader the shader to check.
+ * 
+ * @ingroup shaders
+ */
+bool oriShaderSourcesChanged(oriShader *shader);
+
+/**
+ * @brief Watch every shader source file for changes, so that oriPollShaderHotReload() can rebuild the shaders that use them.
+ * @details Both the files that have already been parsed and any that are parsed later (see oriParseShader()) are watched,
+ * including every file they include. This is only supported on Linux (with inotify).
+ * 
+ * @return false if hot reloading is not supported or could not be enabled.
+ * 
+ * @ingroup shaders
+ */
+bool oriEnableShaderHotReload();
+
+/**
+ * @brief Stop watching shader source files for changes.
+ * 
+ * @ingroup shaders
+ */
+void oriDisableShaderHotReload();
+
+/**
+ * @brief Rebuild every shader whose source files have changed, if shader hot reloading is enabled (see oriEnableShaderHotReload()).
+ * @details Each affected shader is recompiled and relinked in place: the oriShader (and every oriUniformHandle to it) stays
+ * valid, uniform block bindings are kept, and the values last set to its uniforms are uploaded to the new program.
+ * If the new sources fail to compile or link, the errors are logged and the last working program keeps running.
+ * 
+ * Call this on the thread the OpenGL context is current on (e.g. once per frame). Unless a watched file has changed, it
+ * costs a single system call.
+ * 
+ * @note Uniform blocks created with oriCreateUniformBlock() keep the layout they were created with.
+ * 
+ * @return the number of shaders that were rebuilt.
+ * 
+ * @ingroup shaders
+ */
+unsigned int oriPollShaderHotReload();
+
+/**
+ * @brief Compile every stage of the given shader and link them into its program.
+ * @details This doesn't wait for compilation to finish. If the driver supports @c GL_KHR_parallel_shader_compile
+ * (or @c GL_ARB_parallel_shader_compile), the stages are compiled on the driver's own threads, so many shaders can be
+ * linked at once and polled with oriShaderIsReady(). The result is checked (and errors are logged) when the shader is
+ * first bound or its uniforms are first accessed.
+ * 
+ * If the program is in the program cache (see oriEnableProgramCache()), it is loaded from there instead.
+ * 
+ * @param shader the shader to link.
+ * 
+ * @ingroup shaders
+ */
+void oriLinkShader(oriShader *shader);
+
+/**
+ * @brief Return true if the given shader has finished linking, without waiting for it.
+ * @details The shader is linked with oriLinkShader() first if it hasn't been. If the driver doesn't support
+ * @c GL_KHR_parallel_shader_compile (or @c GL_ARB_parallel_shader_compile), this waits for linking to finish and always returns true.
+ * 
+ * @param shader the shader to poll.
+ * 
+ * @ingroup shaders
+ */
+bool oriShaderIsReady(oriShader *shader);
+
 /**
  * @brief Get the location of a GLSL uniform by its name
- * @details If the given uniform has not been cached in the oriShader struct, it will be retrieved with glGetUniformLocation() and @e then cached for later use.
+ * @details Every active uniform is reflected into a hashed table when the shader program is linked, so this never calls into OpenGL.
  * 
  * @param shader the shader to inspect.
  * @param name the name of the uniform
+ * @return -1 if the shader has no active uniform with the given name.
  * 
  * @ingroup shaders
  */
 int oriShaderGetUniformLocation(oriShader *shader, const char *name);
 
+/**
+ * @brief Get the location of an input of the given shader (i.e. a vertex attribute) by its name.
+ * @details Every active input is reflected when the shader program is linked, so this never calls into OpenGL. Unlike
+ * oriShaderGetUniformLocation(), no warning is sent if the input isn't found, as unused inputs are routinely optimised out.
+ * 
+ * @param shader the shader to inspect.
+ * @param name the name of the input.
+ * @return -1 if the program doesn't read an input with the given name.
+ * 
+ * @ingroup shaders
+ */
+int oriShaderGetInputLocation(oriShader *shader, const char *name);
+
+/**
+ * @brief Get the location of an output of the given shader (e.g. a fragment shader output) by its name.
+ * @details Outputs can only be reflected from OpenGL 4.3 onwards; with earlier versions, this always returns -1.
+ * 
+ * @param shader the shader to inspect.
+ * @param name the name of the output.
+ * @return -1 if the program doesn't write an output with the given name.
+ * 
+ * @ingroup shaders
+ */
+int oriShaderGetOutputLocation(oriShader *shader, const char *name);
+
+/**
+ * @brief Get a handle to a GLSL uniform by its name, which can be used to set the uniform without any name lookups.
+ * @details Resolve handles once (e.g. after the shader is created) and then use the oriSetUniformByHandle() family of functions
+ * on the hot path. Handles stay valid if the program is relinked.
+ * 
+ * @note Orion remembers the last value set for every uniform and skips uploads that wouldn't change it, so uniforms should
+ * only be set through Orion (and not with glUniform() directly).
+ * 
+ * @param shader the shader to inspect.
+ * @param name the name of the uniform (for arrays of basic types, elements can be given as e.g. "weights[3]").
+ * @return -1 if the shader has no active uniform with the given name.
+ * 
+ * @ingroup shaders
+ */
+oriUniformHandle oriGetUniformHandle(oriShader *shader, const char *name);
+
+/**
+ * @brief Return the number of uniform uploads that were issued to OpenGL, and the number that were skipped because the
+ * uniform already held the given value, since Orion was initialised (or since oriResetUniformUploadStats() was last called).
+ * 
+ * @details If you don't want to recieve a value, pass NULL as the argument.
+ * 
+ * @param issued the number of uniform uploads that were issued.
+ * @param skipped the number of uniform uploads that were skipped.
+ * 
+ * @ingroup shaders
+ */
+void oriGetUniformUploadStats(unsigned long *issued, unsigned long *skipped);
+
+/**
+ * @brief Reset the counters returned by oriGetUniformUploadStats() to zero.
+ * 
+ * @ingroup shaders
+ */
+void oriResetUniformUploadStats();
+
+// ----------------
+// oriSetUniformByHandle :: scalars
+
+/** @ingroup shaders */ void oriSetUniformByHandle1i(oriShader *shader, const oriUniformHandle handle, const int val);
+/** @ingroup shaders */ void oriSetUniformByHandle1f(oriShader *shader, const oriUniformHandle handle, const float val);
+/** @ingroup shaders */ void oriSetUniformByHandle1ui(oriShader *shader, const oriUniformHandle handle, const unsigned int val);
+
+// ----------------
+// oriSetUniformByHandle :: vectors
+
+/** @ingroup shaders */ void oriSetUniformByHandle2i(oriShader *shader, const oriUniformHandle handle, const int x, const int y);
+/** @ingroup shaders */ void oriSetUniformByHandle2f(oriShader *shader, const oriUniformHandle handle, const float x, const float y);
+/** @ingroup shaders */ void oriSetUniformByHandle2ui(oriShader *shader, const oriUniformHandle handle, const unsigned int x, const unsigned int y);
+
+/** @ingroup shaders */ void oriSetUniformByHandle3i(oriShader *shader, const oriUniformHandle handle, const int x, const int y, const int z);
+/** @ingroup shaders */ void oriSetUniformByHandle3f(oriShader *shader, const oriUniformHandle handle, const float x, const float y, const float z);
+/** @ingroup shaders */ void oriSetUniformByHandle3ui(oriShader *shader, const oriUniformHandle handle, const unsigned int x, const unsigned int y, const unsigned int z);
+
+/** @ingroup shaders */ void oriSetUniformByHandle4i(oriShader *shader, const oriUniformHandle handle, const int x, const int y, const int z, const int w);
+/** @ingroup shaders */ void oriSetUniformByHandle4f(oriShader *shader, const oriUniformHandle handle, const float x, const float y, const float z, const float w);
+/** @ingroup shaders */ void oriSetUniformByHandle4ui(oriShader *shader, const oriUniformHandle handle, const unsigned int x, const unsigned int y, const unsigned int z, const unsigned int w);
+
+// ----------------
+// oriSetUniformByHandle :: matrices
+
+/** @ingroup shaders */ void oriSetUniformByHandleMat2x2f(oriShader *shader, const oriUniformHandle handle, const bool transpose, const float *mat);
+/** @ingroup shaders */ void oriSetUniformByHandleMat2x3f(oriShader *shader, const oriUniformHandle handle, const bool transpose, const float *mat);
+/** @ingroup shaders */ void oriSetUniformByHandleMat2x4f(oriShader *shader, const oriUniformHandle handle, const bool transpose, const float *mat);
+/** @ingroup shaders */ void oriSetUniformByHandleMat3x2f(oriShader *shader, const oriUniformHandle handle, const bool transpose, const float *mat);
+/** @ingroup shaders */ void oriSetUniformByHandleMat3x3f(oriShader *shader, const oriUniformHandle handle, const bool transpose, const float *mat);
+/** @ingroup shaders */ void oriSetUniformByHandleMat3x4f(oriShader *shader, const oriUniformHandle handle, const bool transpose, const float *mat);
+/** @ingroup shaders */ void oriSetUniformByHandleMat4x2f(oriShader *shader, const oriUniformHandle handle, const bool transpose, const float *mat);
+/** @ingroup shaders */ void oriSetUniformByHandleMat4x3f(oriShader *shader, const oriUniformHandle handle, const bool transpose, const float *mat);
+/** @ingroup shaders */ void oriSetUniformByHandleMat4x4f(oriShader *shader, const oriUniformHandle handle, const bool transpose, const float *mat);
+
 // ----------------
 // oriSetShaderUniform :: scalars
 
@@ -601,6 +2220,217 @@ int oriShaderGetUniformLocation(oriShader *shader, const char *name);
 /** @ingroup shaders */ void oriSetUniformMat4x3f(oriShader *shader, const char *name, const bool transpose, const float *mat);
 /** @ingroup shaders */ void oriSetUniformMat4x4f(oriShader *shader, const char *name, const bool transpose, const float *mat);
 
+// ======================================================================================
+// *****                        ORION SHADER VARIANT FUNCTIONS                      *****
+// ======================================================================================
+
+/**
+ * @brief Allocate and initialise a new oriShaderFamily structure.
+ * @details A shader family holds the source of every stage of a shader program. Rather than choosing between code paths with
+ * uniforms at runtime, the sources can use preprocessor conditionals (e.g. @c #ifdef), and a separate, specialised program is
+ * compiled for each set of defines that is requested with oriGetShaderVariant().
+ * 
+ * @ingroup shaders
+ */
+oriShaderFamily *oriCreateShaderFamily();
+
+/**
+ * @brief Destroy and free memory for the given shader family, including every variant compiled from it.
+ * 
+ * @param family the shader family to free.
+ * 
+ * @ingroup shaders
+ */
+void oriFreeShaderFamily(oriShaderFamily *family);
+
+/**
+ * @brief Add GLSL source to the given shader family.
+ * @details Sources can only be added before the first variant is requested.
+ * 
+ * @param family the shader family to modify.
+ * @param type the type of source code (e.g. @c GL_VERTEX_SHADER)
+ * @param src the source code to add, as a string. It must contain a @c #version directive if it uses any defines.
+ * 
+ * @ingroup shaders
+ */
+void oriAddShaderFamilySource(oriShaderFamily *family, const unsigned int type, const char *src);
+
+/**
+ * @brief Return the variant of the given shader family that is compiled with the given set of defines.
+ * @details Each define is inserted into every stage of the family as <tt>\#define [define]</tt>, directly after the
+ * @c #version directive, so a define can give a name a value by including it after a space (e.g. <tt>"ORION_BLEND_MODE 4"</tt>).
+ * The order of the defines doesn't matter.
+ * 
+ * Variants are cached: the first request for a set of defines creates and links the program (see oriLinkShader(), so it
+ * compiles in parallel where supported), and any later request for the same set returns the same oriShader.
+ * 
+ * @note The returned shader belongs to the family and is freed with it; don't free it with oriFreeShader().
+ * 
+ * @param family the shader family to get a variant of.
+ * @param defines an array of defines (may be NULL if @c count is 0).
+ * @param count the number of defines in the array.
+ * 
+ * @ingroup shaders
+ */
+oriShader *oriGetShaderVariant(oriShaderFamily *family, const char **defines, const unsigned int count);
+
+// ======================================================================================
+// *****                        ORION PROGRAM CACHE FUNCTIONS                       *****
+// ======================================================================================
+
+/**
+ * @brief Enable the on-disk program binary cache.
+ * @details Once enabled, every shader program that is linked successfully is stored in @c dir with glGetProgramBinary().
+ * When a program with exactly the same sources is built again (e.g. the next time the application is run), it is loaded
+ * with glProgramBinary() instead of being compiled. Entries are keyed by the program's sources and the identity of the
+ * driver (vendor, renderer and version strings), and binaries that the driver rejects are recompiled from source.
+ * 
+ * When the cache grows larger than @c maxSize, the least recently used entries are deleted.
+ * 
+ * @note OpenGL must be loaded before this is called. If the driver supports no program binary formats, the cache is not enabled.
+ * 
+ * @param dir the directory to store the cache in (relative to the executable). It is created if it doesn't exist.
+ * @param maxSize the maximum size of the cache on disk, in bytes.
+ * 
+ * @sa <a href="https://www.khronos.org/opengl/wiki/Shader_Compilation#Binary_upload">OpenGL/Program binary upload</a>
+ * 
+ * @ingroup shaders
+ */
+void oriEnableProgramCache(const char *dir, const unsigned long maxSize);
+
+/**
+ * @brief Disable the on-disk program binary cache. The files already in the cache are kept.
+ * 
+ * @ingroup shaders
+ */
+void oriDisableProgramCache();
+
+/**
+ * @brief Return the number of programs that were loaded from (and that could not be found in) the program cache.
+ * 
+ * @details If you don't want to recieve a value, pass NULL as the argument.
+ * 
+ * @param hits the number of programs loaded from the cache.
+ * @param misses the number of programs that had to be compiled from source.
+ * 
+ * @ingroup shaders
+ */
+void oriGetProgramCacheStats(unsigned int *hits, unsigned int *misses);
+
+// ======================================================================================
+// *****                        ORION UNIFORM BLOCK FUNCTIONS                       *****
+// ======================================================================================
+
+/**
+ * @brief Allocate and initialise a new oriUniformBlock structure for the named uniform block in the given shader.
+ * @details The layout of the block (the offset, array stride and matrix stride of every member) is reflected from the
+ * linked shader program, so the block can be declared with any layout qualifier (@c std140, @c shared or @c packed).
+ * Setting members writes to a CPU-side copy of the block, and only the range that changed is uploaded when the block is
+ * next bound with oriBindUniformBlock() (or uploaded with oriUploadUniformBlock()).
+ * 
+ * The uniform block in @c shader is assigned to the uniform buffer binding point @c binding. Other shaders that declare
+ * the same block can share it by assigning their block to the same binding point with oriShaderSetUniformBlockBinding().
+ * 
+ * @param shader the (linked) shader that declares the uniform block.
+ * @param name the name of the uniform block (not its instance name).
+ * @param binding the uniform buffer binding point to use.
+ * @return NULL if the shader has no active uniform block with the given name.
+ * 
+ * @sa <a href="https://www.khronos.org/opengl/wiki/Interface_Block_(GLSL)#Memory_layout">OpenGL/Interface block memory layout</a>
+ * 
+ * @ingroup shaders
+ */
+oriUniformBlock *oriCreateUniformBlock(oriShader *shader, const char *name, const unsigned int binding);
+
+/**
+ * @brief Destroy and free memory for the given uniform block (and its uniform buffer).
+ * 
+ * @param block the uniform block to free.
+ * 
+ * @ingroup shaders
+ */
+void oriFreeUniformBlock(oriUniformBlock *block);
+
+/**
+ * @brief Assign the named uniform block in the given shader to a uniform buffer binding point.
+ * @details Use this to share an oriUniformBlock between every shader that declares the same block.
+ * 
+ * @param shader the shader to modify.
+ * @param name the name of the uniform block.
+ * @param binding the uniform buffer binding point to use.
+ * 
+ * @ingroup shaders
+ */
+void oriShaderSetUniformBlockBinding(oriShader *shader, const char *name, const unsigned int binding);
+
+/**
+ * @brief Upload the members of the given uniform block that have changed since it was last uploaded.
+ * @details This is called implicitly by oriBindUniformBlock().
+ * 
+ * @param block the uniform block to upload.
+ * 
+ * @ingroup shaders
+ */
+void oriUploadUniformBlock(oriUniformBlock *block);
+
+/**
+ * @brief Upload any changes to the given uniform block, then bind its buffer to the block's uniform buffer binding point.
+ * 
+ * @param block the uniform block to bind.
+ * 
+ * @ingroup shaders
+ */
+void oriBindUniformBlock(oriUniformBlock *block);
+
+/**
+ * @brief Return uniform block properties into the specified variables.
+ * 
+ * @details If you don't want to recieve a property, pass NULL as the argument.
+ * 
+ * @param block the uniform block to inspect.
+ * @param size the size of the block's data store, in bytes.
+ * @param binding the uniform buffer binding point the block is bound to.
+ * @param buffer the buffer that backs the block.
+ * 
+ * @ingroup shaders
+ */
+void oriGetUniformBlockProperty(oriUniformBlock *block, unsigned int *size, unsigned int *binding, oriBuffer **buffer);
+
+// ----------------
+// oriSetUniformBlock :: scalars
+
+/** @ingroup shaders */ void oriSetUniformBlock1i(oriUniformBlock *block, const char *name, const int val);
+/** @ingroup shaders */ void oriSetUniformBlock1f(oriUniformBlock *block, const char *name, const float val);
+/** @ingroup shaders */ void oriSetUniformBlock1ui(oriUniformBlock *block, const char *name, const unsigned int val);
+
+// ----------------
+// oriSetUniformBlock :: vectors
+
+/** @ingroup shaders */ void oriSetUniformBlock2i(oriUniformBlock *block, const char *name, const int x, const int y);
+/** @ingroup shaders */ void oriSetUniformBlock2f(oriUniformBlock *block, const char *name, const float x, const float y);
+/** @ingroup shaders */ void oriSetUniformBlock2ui(oriUniformBlock *block, const char *name, const unsigned int x, const unsigned int y);
+
+/** @ingroup shaders */ void oriSetUniformBlock3i(oriUniformBlock *block, const char *name, const int x, const int y, const int z);
+/** @ingroup shaders */ void oriSetUniformBlock3f(oriUniformBlock *block, const char *name, const float x, const float y, const float z);
+/** @ingroup shaders */ void oriSetUniformBlock3ui(oriUniformBlock *block, const char *name, const unsigned int x, const unsigned int y, const unsigned int z);
+
+/** @ingroup shaders */ void oriSetUniformBlock4i(oriUniformBlock *block, const char *name, const int x, const int y, const int z, const int w);
+/** @ingroup shaders */ void oriSetUniformBlock4f(oriUniformBlock *block, const char *name, const float x, const float y, const float z, const float w);
+/** @ingroup shaders */ void oriSetUniformBlock4ui(oriUniformBlock *block, const char *name, const unsigned int x, const unsigned int y, const unsigned int z, const unsigned int w);
+
+// ----------------
+// oriSetUniformBlock :: matrices
+
+/** @ingroup shaders */ void oriSetUniformBlockMat2x2f(oriUniformBlock *block, const char *name, const bool transpose, const float *mat);
+/** @ingroup shaders */ void oriSetUniformBlockMat2x3f(oriUniformBlock *block, const char *name, const bool transpose, const float *mat);
+/** @ingroup shaders */ void oriSetUniformBlockMat2x4f(oriUniformBlock *block, const char *name, const bool transpose, const float *mat);
+/** @ingroup shaders */ void oriSetUniformBlockMat3x2f(oriUniformBlock *block, const char *name, const bool transpose, const float *mat);
+/** @ingroup shaders */ void oriSetUniformBlockMat3x3f(oriUniformBlock *block, const char *name, const bool transpose, const float *mat);
+/** @ingroup shaders */ void oriSetUniformBlockMat3x4f(oriUniformBlock *block, const char *name, const bool transpose, const float *mat);
+/** @ingroup shaders */ void oriSetUniformBlockMat4x2f(oriUniformBlock *block, const char *name, const bool transpose, const float *mat);
+/** @ingroup shaders */ void oriSetUniformBlockMat4x3f(oriUniformBlock *block, const char *name, const bool transpose, const float *mat);
+/** @ingroup shaders */ void oriSetUniformBlockMat4x4f(oriUniformBlock *block, const char *name, const bool transpose, const float *mat);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,447 @@
+/* *************************************************************************************** */
+/*                        ORION GRAPHICS LIBRARY AND RENDERING ENGINE                      */
+/* *************************************************************************************** */
+/* Copyright (c) 2022 Jack Bennett                                                         */
+/* --------------------------------------------------------------------------------------- */
+/* THE  SOFTWARE IS  PROVIDED "AS IS",  WITHOUT WARRANTY OF ANY KIND, EXPRESS  OR IMPLIED, */
+/* INCLUDING  BUT  NOT  LIMITED  TO  THE  WARRANTIES  OF  MERCHANTABILITY,  FITNESS FOR  A */
+/* PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN  NO EVENT SHALL  THE  AUTHORS  OR COPYRIGHT */
+/* HOLDERS  BE  LIABLE  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF */
+/* CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR */
+/* THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                              */
+/* *************************************************************************************** */
+
+#include "internal.h"
+#include "oriongl.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// ======================================================================================
+// *****                          ORION INTERNAL DATA TYPES                         *****
+// ======================================================================================
+
+// Each page (layer) of an atlas is packed with the MaxRects algorithm: the page keeps a list of
+// every maximal free rectangle (they may overlap), and each image is placed in the free rectangle
+// that leaves the shortest side over (best short side fit). Placing an image splits every free
+// rectangle it overlaps into the (up to four) parts around it, and free rectangles that are
+// contained in another are discarded.
+
+typedef struct _oriAtlasRect {
+    unsigned int x;
+    unsigned int y;
+    unsigned int width;
+    unsigned int height;
+} _oriAtlasRect;
+
+typedef struct _oriAtlasRectList {
+    _oriAtlasRect *rects;
+    unsigned int count;
+    unsigned int capacity;
+} _oriAtlasRectList;
+
+typedef struct _oriAtlasPage {
+    _oriAtlasRectList free;
+    // the rectangles of the images in the page, including their padding
+    _oriAtlasRectList used;
+} _oriAtlasPage;
+
+// ======================================================================================
+// *****                            ORION PUBLIC STRUCTURES                         *****
+// ======================================================================================
+
+/**
+ * @brief A texture that many smaller images are packed into.
+ * 
+ * @ingroup textures
+ */
+typedef struct oriAtlas {
+    oriAtlas *next;
+
+    oriTexture *texture;
+    unsigned int width;
+    unsigned int height;
+    unsigned int padding;
+
+    _oriAtlasPage *pages;
+    unsigned int pageCount;
+
+    // the image being inserted, with its border extruded into its padding
+    unsigned char *scratch;
+    size_t scratchSize;
+} oriAtlas;
+
+// ======================================================================================
+// *****                           ORION HELPER FUNCTIONS                           *****
+// ======================================================================================
+
+static void _oriPushRect(_oriAtlasRectList *list, const _oriAtlasRect rect) {
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity ? list->capacity * 2 : 16;
+        list->rects = realloc(list->rects, list->capacity * sizeof(_oriAtlasRect));
+    }
+    list->rects[list->count++] = rect;
+}
+
+static bool _oriRectContains(const _oriAtlasRect a, const _oriAtlasRect b) {
+    return b.x >= a.x && b.y >= a.y && b.x + b.width <= a.x + a.width && b.y + b.height <= a.y + a.height;
+}
+
+static bool _oriRectsIntersect(const _oriAtlasRect a, const _oriAtlasRect b) {
+    return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+// add a free rectangle to a page, unless another already contains it (and discard any that it contains)
+static void _oriAddFreeRect(_oriAtlasPage *page, const _oriAtlasRect rect) {
+    _oriAtlasRectList *list = &page->free;
+
+    for (unsigned int i = 0; i < list->count; i++) {
+        if (_oriRectContains(list->rects[i], rect)) {
+            return;
+        }
+    }
+
+    unsigned int kept = 0;
+    for (unsigned int i = 0; i < list->count; i++) {
+        if (!_oriRectContains(rect, list->rects[i])) {
+            list->rects[kept++] = list->rects[i];
+        }
+    }
+    list->count = kept;
+
+    _oriPushRect(list, rect);
+}
+
+// find the free rectangle of a page that best fits the given size; return false if none are large enough
+static bool _oriFindPosition(const _oriAtlasPage *page, const unsigned int width, const unsigned int height, _oriAtlasRect *best, unsigned int *bestShort, unsigned int *bestLong) {
+    bool found = false;
+
+    for (unsigned int i = 0; i < page->free.count; i++) {
+        _oriAtlasRect f = page->free.rects[i];
+        if (f.width < width || f.height < height) {
+            continue;
+        }
+
+        unsigned int leftoverX = f.width - width;
+        unsigned int leftoverY = f.height - height;
+        unsigned int shortSide = leftoverX < leftoverY ? leftoverX : leftoverY;
+        unsigned int longSide = leftoverX < leftoverY ? leftoverY : leftoverX;
+
+        if (shortSide < *bestShort || (shortSide == *bestShort && longSide < *bestLong)) {
+            *best = (_oriAtlasRect) { f.x, f.y, width, height };
+            *bestShort = shortSide;
+            *bestLong = longSide;
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+// mark a rectangle of a page as used, splitting every free rectangle it overlaps
+static void _oriPlaceRect(_oriAtlasPage *page, const _oriAtlasRect r) {
+    _oriAtlasRectList split = { NULL, 0, 0 };
+
+    unsigned int kept = 0;
+    for (unsigned int i = 0; i < page->free.count; i++) {
+        _oriAtlasRect f = page->free.rects[i];
+        if (!_oriRectsIntersect(f, r)) {
+            page->free.rects[kept++] = f;
+            continue;
+        }
+
+        if (r.x > f.x) {
+            _oriPushRect(&split, (_oriAtlasRect) { f.x, f.y, r.x - f.x, f.height });
+        }
+        if (r.x + r.width < f.x + f.width) {
+            _oriPushRect(&split, (_oriAtlasRect) { r.x + r.width, f.y, f.x + f.width - (r.x + r.width), f.height });
+        }
+        if (r.y > f.y) {
+            _oriPushRect(&split, (_oriAtlasRect) { f.x, f.y, f.width, r.y - f.y });
+        }
+        if (r.y + r.height < f.y + f.height) {
+            _oriPushRect(&split, (_oriAtlasRect) { f.x, r.y + r.height, f.width, f.y + f.height - (r.y + r.height) });
+        }
+    }
+    page->free.count = kept;
+
+    for (unsigned int i = 0; i < split.count; i++) {
+        _oriAddFreeRect(page, split.rects[i]);
+    }
+    free(split.rects);
+
+    _oriPushRect(&page->used, r);
+}
+
+// return a rectangle of a page to its free list
+static void _oriReleaseRect(oriAtlas *atlas, _oriAtlasPage *page, _oriAtlasRect r) {
+    if (!page->used.count) {
+        // the page is empty again, so start it afresh
+        page->free.count = 0;
+        _oriPushRect(&page->free, (_oriAtlasRect) { 0, 0, atlas->width, atlas->height });
+        return;
+    }
+
+    // grow the rectangle while a free rectangle lies exactly alongside it, so that the space can be reused by larger images
+    bool merged = true;
+    while (merged) {
+        merged = false;
+
+        for (unsigned int i = 0; i < page->free.count; i++) {
+            _oriAtlasRect f = page->free.rects[i];
+
+            if (f.x == r.x && f.width == r.width && (f.y + f.height == r.y || r.y + r.height == f.y)) {
+                r.y = f.y < r.y ? f.y : r.y;
+                r.height += f.height;
+            } else if (f.y == r.y && f.height == r.height && (f.x + f.width == r.x || r.x + r.width == f.x)) {
+                r.x = f.x < r.x ? f.x : r.x;
+                r.width += f.width;
+            } else {
+                continue;
+            }
+
+            page->free.rects[i] = page->free.rects[--page->free.count];
+            merged = true;
+            break;
+        }
+    }
+
+    _oriAddFreeRect(page, r);
+}
+
+// copy an image into the atlas's scratch buffer, surrounded by copies of its edge pixels
+static const unsigned char *_oriExtrudeImage(oriAtlas *atlas, const unsigned char *data, const unsigned int width, const unsigned int height, const unsigned int pixelSize) {
+    unsigned int padding = atlas->padding;
+    unsigned int paddedWidth = width + padding * 2;
+    unsigned int paddedHeight = height + padding * 2;
+
+    size_t rowSize = (size_t) paddedWidth * pixelSize;
+    size_t size = rowSize * paddedHeight;
+    if (size > atlas->scratchSize) {
+        atlas->scratch = realloc(atlas->scratch, size);
+        atlas->scratchSize = size;
+    }
+
+    for (unsigned int y = 0; y < paddedHeight; y++) {
+        unsigned int srcY = y < padding ? 0 : y - padding >= height ? height - 1 : y - padding;
+        const unsigned char *src = data + (size_t) srcY * width * pixelSize;
+        unsigned char *dst = atlas->scratch + y * rowSize;
+
+        for (unsigned int x = 0; x < padding; x++) {
+            memcpy(dst + (size_t) x * pixelSize, src, pixelSize);
+            memcpy(dst + (size_t) (padding + width + x) * pixelSize, src + (size_t) (width - 1) * pixelSize, pixelSize);
+        }
+        memcpy(dst + (size_t) padding * pixelSize, src, (size_t) width * pixelSize);
+    }
+
+    return atlas->scratch;
+}
+
+// ======================================================================================
+// *****                           ORION ATLAS FUNCTIONS                            *****
+// ======================================================================================
+
+/**
+ * @brief Allocate and initialise a new oriAtlas structure.
+ * @details An atlas packs many small images (e.g. icons, sprites or glyphs) into one texture, so that they can all be drawn
+ * with a single texture binding. Its texture has immutable storage: a @c GL_TEXTURE_2D if @c layers is 0, or otherwise a
+ * @c GL_TEXTURE_2D_ARRAY with that many layers, each of which is packed separately.
+ * 
+ * Each image is surrounded by @c padding texels, which are filled with copies of its edge texels, so that filtering
+ * never blends in a neighbouring image. If the texture has mipmaps, the padding should be at least <tt>2^(levels - 1)</tt>
+ * texels for the smallest level to be free of bleeding too.
+ * 
+ * @param width the width of the atlas texture.
+ * @param height the height of the atlas texture.
+ * @param layers the number of layers of an array texture, or 0 for a 2D texture.
+ * @param internalFormat the internal format of the atlas texture, e.g. @c GL_RGBA8.
+ * @param levels the number of mipmap levels of the atlas texture (at least 1).
+ * @param padding the number of texels around each image.
+ * 
+ * @ingroup textures
+ */
+oriAtlas *oriCreateAtlas(const unsigned int width, const unsigned int height, const unsigned int layers, const unsigned int internalFormat, const unsigned int levels, const unsigned int padding) {
+    _orionAssertVersion(420);
+
+    if (!width || !height || !levels) {
+        _orionThrowError(ORERR_NULL_RECIEVED);
+    }
+
+    oriAtlas *r = malloc(sizeof(oriAtlas));
+
+    r->width = width;
+    r->height = height;
+    r->padding = padding;
+
+    r->pageCount = layers ? layers : 1;
+    r->pages = calloc(r->pageCount, sizeof(_oriAtlasPage));
+    for (unsigned int i = 0; i < r->pageCount; i++) {
+        _oriPushRect(&r->pages[i].free, (_oriAtlasRect) { 0, 0, width, height });
+    }
+
+    r->scratch = NULL;
+    r->scratchSize = 0;
+
+    r->texture = oriCreateTextureImmutable(layers ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D, width, height, layers, internalFormat, levels, 0, false);
+    oriSetTextureParameteri(r->texture, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    oriSetTextureParameteri(r->texture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    oriSetTextureParameteri(r->texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    oriSetTextureParameteri(r->texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    // link to global linked list
+    r->next = _orion.atlasListHead;
+    _orion.atlasListHead = r;
+
+    return r;
+}
+
+/**
+ * @brief Destroy and free memory for the given atlas, including its texture.
+ * 
+ * @param atlas the atlas to free.
+ * 
+ * @ingroup textures
+ */
+void oriFreeAtlas(oriAtlas *atlas) {
+    // unlink from global linked list
+    oriAtlas **current = &_orion.atlasListHead;
+    while (*current != atlas)
+        current = &(*current)->next;
+    *current = atlas->next;
+
+    oriFreeTexture(atlas->texture);
+
+    for (unsigned int i = 0; i < atlas->pageCount; i++) {
+        free(atlas->pages[i].free.rects);
+        free(atlas->pages[i].used.rects);
+    }
+    free(atlas->pages);
+    free(atlas->scratch);
+
+    free(atlas);
+    atlas = NULL;
+}
+
+/**
+ * @brief Return the texture that the images of the given atlas are packed into.
+ * @details Bind it (e.g. with oriBindTexture()) to draw any of the atlas's images, using the texture coordinates of their
+ * oriAtlasRegion. Its mipmaps are regenerated when it is next bound after images are inserted.
+ * 
+ * @param atlas the atlas to get the texture of.
+ * 
+ * @ingroup textures
+ */
+oriTexture *oriGetAtlasTexture(oriAtlas *atlas) {
+    return atlas->texture;
+}
+
+/**
+ * @brief Pack an image into the given atlas, and upload it to the atlas's texture.
+ * @details The image is placed in whichever layer it fits best. Images can't be rotated, and they can't be larger than the
+ * atlas (including their padding on both sides).
+ * 
+ * @param atlas the atlas to insert the image into.
+ * @param width the width of the image.
+ * @param height the height of the image.
+ * @param imageFormat the format of the pixel data, e.g. @c GL_RGBA.
+ * @param dataType the data type of the pixel data, e.g. @c GL_UNSIGNED_BYTE.
+ * @param data the pixel data, with tightly packed rows. If NULL, space is reserved but nothing is uploaded.
+ * @param region the region to write the image's position and texture coordinates into.
+ * @return false if there is no room for the image in the atlas.
+ * 
+ * @ingroup textures
+ */
+bool oriAtlasInsert(oriAtlas *atlas, const unsigned int width, const unsigned int height, const unsigned int imageFormat, const unsigned int dataType, const void *data, oriAtlasRegion *region) {
+    if (!width || !height || !region) {
+        _orionThrowWarning("(in oriAtlasInsert()): Invalid size or region given. Image not inserted.");
+        return false;
+    }
+
+    unsigned int pixelSize = _orionPixelSize(imageFormat, dataType);
+    if (!pixelSize) {
+        _orionThrowWarning("(in oriAtlasInsert()): Unsupported image format or data type specified. Image not inserted.");
+        return false;
+    }
+
+    unsigned int paddedWidth = width + atlas->padding * 2;
+    unsigned int paddedHeight = height + atlas->padding * 2;
+
+    // choose the best fit across every layer
+    _oriAtlasRect best = { 0 };
+    unsigned int bestPage = 0;
+    unsigned int bestShort = ~0u, bestLong = ~0u;
+    bool found = false;
+
+    for (unsigned int i = 0; i < atlas->pageCount; i++) {
+        if (_oriFindPosition(&atlas->pages[i], paddedWidth, paddedHeight, &best, &bestShort, &bestLong)) {
+            bestPage = i;
+            found = true;
+        }
+    }
+
+    if (!found) {
+        return false;
+    }
+
+    _oriPlaceRect(&atlas->pages[bestPage], best);
+
+    if (data) {
+        const void *image = atlas->padding ? _oriExtrudeImage(atlas, data, width, height, pixelSize) : data;
+
+        // rows are tightly packed
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        oriUploadTexSubImage(atlas->texture, 0, best.x, best.y, bestPage, paddedWidth, paddedHeight, 1, imageFormat, dataType, image, 0, 0, 0);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    }
+
+    region->x = best.x + atlas->padding;
+    region->y = best.y + atlas->padding;
+    region->width = width;
+    region->height = height;
+    region->layer = bestPage;
+
+    region->u0 = (float) region->x / atlas->width;
+    region->v0 = (float) region->y / atlas->height;
+    region->u1 = (float) (region->x + width) / atlas->width;
+    region->v1 = (float) (region->y + height) / atlas->height;
+
+    return true;
+}
+
+/**
+ * @brief Remove an image from the given atlas, so that its space can be reused.
+ * @details The texels of the image are left in the texture until they are overwritten by another image.
+ * 
+ * @param atlas the atlas that the image was inserted into.
+ * @param region the region of the image, as given by oriAtlasInsert(). It is reset to zero.
+ * 
+ * @ingroup textures
+ */
+void oriAtlasRemove(oriAtlas *atlas, oriAtlasRegion *region) {
+    if (!region->width || region->layer >= atlas->pageCount) {
+        _orionThrowWarning("(in oriAtlasRemove()): Attempted to remove an invalid or already-removed atlas region.");
+        return;
+    }
+
+    _oriAtlasPage *page = &atlas->pages[region->layer];
+    _oriAtlasRect r = {
+        region->x - atlas->padding,
+        region->y - atlas->padding,
+        region->width + atlas->padding * 2,
+        region->height + atlas->padding * 2
+    };
+
+    unsigned int i = 0;
+    while (i < page->used.count && memcmp(&page->used.rects[i], &r, sizeof(_oriAtlasRect)))
+        i++;
+
+    if (i == page->used.count) {
+        _orionThrowWarning("(in oriAtlasRemove()): Attempted to remove an invalid or already-removed atlas region.");
+        return;
+    }
+
+    page->used.rects[i] = page->used.rects[--page->used.count];
+    _oriReleaseRect(atlas, page, r);
+
+    memset(region, 0, sizeof(oriAtlasRegion));
+}
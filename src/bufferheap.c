@@ -0,0 +1,552 @@
+/* *************************************************************************************** */
+/*                        ORION GRAPHICS LIBRARY AND RENDERING ENGINE                      */
+/* *************************************************************************************** */
+/* Copyright (c) 2022 Jack Bennett                                                         */
+/* --------------------------------------------------------------------------------------- */
+/* THE  SOFTWARE IS  PROVIDED "AS IS",  WITHOUT WARRANTY OF ANY KIND, EXPRESS  OR IMPLIED, */
+/* INCLUDING  BUT  NOT  LIMITED  TO  THE  WARRANTIES  OF  MERCHANTABILITY,  FITNESS FOR  A */
+/* PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN  NO EVENT SHALL  THE  AUTHORS  OR COPYRIGHT */
+/* HOLDERS  BE  LIABLE  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF */
+/* CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR */
+/* THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                              */
+/* *************************************************************************************** */
+
+#include "internal.h"
+#include "oriongl.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// ======================================================================================
+// *****                          ORION INTERNAL DATA TYPES                         *****
+// ======================================================================================
+
+// The heap uses a two-level segregated fit (TLSF) allocator for each of its pools.
+// Free blocks are binned into lists by size class: the first level splits sizes by powers
+// of two, the second level splits each power of two linearly into _ORI_TLSF_SL_COUNT bins.
+// A bitmap for each level means that finding a suitable free block is O(1).
+//
+// As the memory being managed is GPU memory, block headers can't be stored in-line like
+// in a regular TLSF allocator; instead they are kept on the CPU in _oriHeapBlock nodes.
+
+#define _ORI_TLSF_ALIGN_LOG2 4                                          // minimum granularity of 16 bytes
+#define _ORI_TLSF_ALIGN (1u << _ORI_TLSF_ALIGN_LOG2)
+#define _ORI_TLSF_SL_LOG2 5
+#define _ORI_TLSF_SL_COUNT (1u << _ORI_TLSF_SL_LOG2)
+#define _ORI_TLSF_FL_SHIFT (_ORI_TLSF_SL_LOG2 + _ORI_TLSF_ALIGN_LOG2)
+#define _ORI_TLSF_SMALL_BLOCK (1u << _ORI_TLSF_FL_SHIFT)                // sizes below this all go in the first FL bin
+#define _ORI_TLSF_FL_COUNT (32 - _ORI_TLSF_FL_SHIFT + 1)
+
+struct _oriHeapPool;
+
+typedef struct _oriHeapBlock {
+    // neighbouring blocks in memory (sorted by offset)
+    struct _oriHeapBlock *prevPhysical;
+    struct _oriHeapBlock *nextPhysical;
+
+    // neighbouring blocks in the same free list (only valid if the block is free)
+    struct _oriHeapBlock *prevFree;
+    struct _oriHeapBlock *nextFree;
+
+    struct _oriHeapPool *pool;
+
+    unsigned int offset;
+    unsigned int size;
+    bool free;
+} _oriHeapBlock;
+
+typedef struct _oriHeapPool {
+    struct _oriHeapPool *next;
+
+    oriBuffer *buffer;
+    unsigned int size;
+
+    unsigned int flBitmap;
+    unsigned int slBitmap[_ORI_TLSF_FL_COUNT];
+    _oriHeapBlock *freeLists[_ORI_TLSF_FL_COUNT][_ORI_TLSF_SL_COUNT];
+
+    _oriHeapBlock *firstBlock;
+} _oriHeapPool;
+
+// ======================================================================================
+// *****                            ORION PUBLIC STRUCTURES                         *****
+// ======================================================================================
+
+/**
+ * @brief A collection of large OpenGL buffer objects that smaller allocations are sub-allocated from.
+ * 
+ * @ingroup buffers
+ */
+typedef struct oriBufferHeap {
+    oriBufferHeap *next;
+
+    unsigned int poolSize;
+    unsigned int storageFlags;
+
+    _oriHeapPool *poolListHead;
+
+    // spare block nodes, kept to avoid calling malloc() for every split
+    _oriHeapBlock *spareBlocks;
+} oriBufferHeap;
+
+// ======================================================================================
+// *****                              HELPER FUNCTIONS                              *****
+// ======================================================================================
+
+// index of the most significant set bit
+static inline unsigned int _oriFls(unsigned int x) {
+#if defined(__GNUC__)
+    return 31 - __builtin_clz(x);
+#else
+    unsigned int r = 0;
+    while (x >>= 1) r++;
+    return r;
+#endif
+}
+
+// index of the least significant set bit
+static inline unsigned int _oriFfs(unsigned int x) {
+#if defined(__GNUC__)
+    return __builtin_ctz(x);
+#else
+    unsigned int r = 0;
+    while (!(x & 1)) { x >>= 1; r++; }
+    return r;
+#endif
+}
+
+// get the free list indices that a block of the given size belongs in
+static void _oriTlsfMapping(unsigned int size, unsigned int *fl, unsigned int *sl) {
+    if (size < _ORI_TLSF_SMALL_BLOCK) {
+        *fl = 0;
+        *sl = size / (_ORI_TLSF_SMALL_BLOCK / _ORI_TLSF_SL_COUNT);
+    } else {
+        unsigned int f = _oriFls(size);
+        *sl = (size >> (f - _ORI_TLSF_SL_LOG2)) ^ _ORI_TLSF_SL_COUNT;
+        *fl = f - (_ORI_TLSF_FL_SHIFT - 1);
+    }
+}
+
+static _oriHeapBlock *_oriHeapNewBlock(oriBufferHeap *heap) {
+    _oriHeapBlock *r = heap->spareBlocks;
+
+    if (r) {
+        heap->spareBlocks = r->nextFree;
+    } else {
+        r = malloc(sizeof(_oriHeapBlock));
+    }
+
+    memset(r, 0, sizeof(_oriHeapBlock));
+    return r;
+}
+
+static void _oriHeapRecycleBlock(oriBufferHeap *heap, _oriHeapBlock *block) {
+    block->nextFree = heap->spareBlocks;
+    heap->spareBlocks = block;
+}
+
+static void _oriHeapInsertFree(_oriHeapPool *pool, _oriHeapBlock *block) {
+    unsigned int fl, sl;
+    _oriTlsfMapping(block->size, &fl, &sl);
+
+    block->free = true;
+    block->prevFree = NULL;
+    block->nextFree = pool->freeLists[fl][sl];
+    if (block->nextFree) {
+        block->nextFree->prevFree = block;
+    }
+    pool->freeLists[fl][sl] = block;
+
+    pool->flBitmap |= 1u << fl;
+    pool->slBitmap[fl] |= 1u << sl;
+}
+
+static void _oriHeapRemoveFree(_oriHeapPool *pool, _oriHeapBlock *block) {
+    unsigned int fl, sl;
+    _oriTlsfMapping(block->size, &fl, &sl);
+
+    if (block->prevFree) {
+        block->prevFree->nextFree = block->nextFree;
+    } else {
+        pool->freeLists[fl][sl] = block->nextFree;
+    }
+    if (block->nextFree) {
+        block->nextFree->prevFree = block->prevFree;
+    }
+
+    // clear the bitmaps if the list is now empty
+    if (!pool->freeLists[fl][sl]) {
+        pool->slBitmap[fl] &= ~(1u << sl);
+        if (!pool->slBitmap[fl]) {
+            pool->flBitmap &= ~(1u << fl);
+        }
+    }
+
+    block->free = false;
+}
+
+// round the given size up to the start of the next size class, so that any block in that class is large enough for it
+// (returns 0 if that would overflow)
+static unsigned int _oriHeapRoundSize(unsigned int size) {
+    if (size >= _ORI_TLSF_SMALL_BLOCK) {
+        unsigned int round = (1u << (_oriFls(size) - _ORI_TLSF_SL_LOG2)) - 1;
+        if (size > ~0u - round) {
+            return 0;
+        }
+        size = (size + round) & ~round;
+    }
+
+    return size;
+}
+
+// find a free block that is at least the given size, in O(1)
+static _oriHeapBlock *_oriHeapFindGoodFit(_oriHeapPool *pool, unsigned int size) {
+    size = _oriHeapRoundSize(size);
+    if (!size) {
+        return NULL;
+    }
+
+    unsigned int fl, sl;
+    _oriTlsfMapping(size, &fl, &sl);
+    if (fl >= _ORI_TLSF_FL_COUNT) {
+        return NULL;
+    }
+
+    unsigned int slMap = pool->slBitmap[fl] & (~0u << sl);
+    if (!slMap) {
+        // no suitable block at this first level, so look at the next largest non-empty one
+        unsigned int flMap = (fl + 1 < 32) ? pool->flBitmap & (~0u << (fl + 1)) : 0;
+        if (!flMap) {
+            return NULL;
+        }
+
+        fl = _oriFfs(flMap);
+        slMap = pool->slBitmap[fl];
+    }
+    sl = _oriFfs(slMap);
+
+    return pool->freeLists[fl][sl];
+}
+
+static _oriHeapPool *_oriHeapCreatePool(oriBufferHeap *heap, unsigned int size) {
+    _oriHeapPool *r = calloc(1, sizeof(_oriHeapPool));
+    r->size = size;
+
+    if (_orion.glVersion >= 440) {
+        r->buffer = oriCreateBufferImmutable(NULL, size, heap->storageFlags);
+    } else {
+        r->buffer = oriCreateBuffer();
+        oriSetBufferData(r->buffer, NULL, size, GL_STATIC_DRAW);
+    }
+
+    // the whole pool starts off as one free block
+    _oriHeapBlock *block = _oriHeapNewBlock(heap);
+    block->pool = r;
+    block->offset = 0;
+    block->size = size;
+    r->firstBlock = block;
+    _oriHeapInsertFree(r, block);
+
+    // link to the heap's pool list
+    r->next = heap->poolListHead;
+    heap->poolListHead = r;
+
+    return r;
+}
+
+// free the given pool along with its buffer and blocks (without unlinking it from its heap)
+static void _oriHeapFreePool(_oriHeapPool *pool) {
+    _oriHeapBlock *block = pool->firstBlock;
+    while (block) {
+        _oriHeapBlock *next = block->nextPhysical;
+        free(block);
+        block = next;
+    }
+
+    oriFreeBuffer(pool->buffer);
+    free(pool);
+}
+
+// allocate from the given pool, or return false if there isn't a large enough free block
+static bool _oriHeapPoolAlloc(oriBufferHeap *heap, _oriHeapPool *pool, unsigned int size, unsigned int alignment, oriBufferAllocation *allocation) {
+    // leave room for the padding needed to align the start of the block
+    unsigned int searchSize = size + alignment - _ORI_TLSF_ALIGN;
+    if (searchSize < size) {
+        return false;
+    }
+
+    _oriHeapBlock *block = _oriHeapFindGoodFit(pool, searchSize);
+    if (!block) {
+        return false;
+    }
+    _oriHeapRemoveFree(pool, block);
+
+    // split off any leading padding into its own free block
+    unsigned int padding = ((block->offset + alignment - 1) & ~(alignment - 1)) - block->offset;
+    if (padding) {
+        _oriHeapBlock *lead = _oriHeapNewBlock(heap);
+        lead->pool = pool;
+        lead->offset = block->offset;
+        lead->size = padding;
+
+        lead->prevPhysical = block->prevPhysical;
+        lead->nextPhysical = block;
+        if (lead->prevPhysical) {
+            lead->prevPhysical->nextPhysical = lead;
+        } else {
+            pool->firstBlock = lead;
+        }
+        block->prevPhysical = lead;
+
+        block->offset += padding;
+        block->size -= padding;
+
+        _oriHeapInsertFree(pool, lead);
+    }
+
+    // split off the rest of the block if it is big enough to be useful
+    if (block->size - size >= _ORI_TLSF_ALIGN) {
+        _oriHeapBlock *trail = _oriHeapNewBlock(heap);
+        trail->pool = pool;
+        trail->offset = block->offset + size;
+        trail->size = block->size - size;
+
+        trail->prevPhysical = block;
+        trail->nextPhysical = block->nextPhysical;
+        if (trail->nextPhysical) {
+            trail->nextPhysical->prevPhysical = trail;
+        }
+        block->nextPhysical = trail;
+
+        block->size = size;
+
+        _oriHeapInsertFree(pool, trail);
+    }
+
+    allocation->buffer = pool->buffer;
+    allocation->offset = block->offset;
+    allocation->size = block->size;
+    allocation->block = block;
+
+    return true;
+}
+
+// ======================================================================================
+// *****                          ORION BUFFER HEAP FUNCTIONS                       *****
+// ======================================================================================
+
+/**
+ * @brief Allocate and initialise a new oriBufferHeap structure.
+ * @details A buffer heap reserves a few large buffer objects ('pools') and sub-allocates ranges of them, so that
+ * many meshes can share the same buffer object (and therefore the same vertex array bindings). Draw calls can then
+ * select a mesh by its offset (e.g. with a base vertex or first index) instead of switching buffers.
+ * 
+ * Allocations are handled by a two-level segregated fit (TLSF) allocator, so allocating and freeing is O(1).
+ * A new pool is reserved whenever an allocation doesn't fit into any of the existing ones.
+ * 
+ * @param poolSize the size, in bytes, of each pool. A pool that is reserved for an allocation near or above this size is made
+ * larger, so that the allocation fits.
+ * @param flags the storage flags to create each pool with (see oriCreateBufferImmutable()). @c GL_DYNAMIC_STORAGE_BIT
+ * is needed to fill allocations with oriSetBufferSubData(). Ignored if the GL version is below 4.4.
+ * 
+ * @ingroup buffers
+ */
+oriBufferHeap *oriCreateBufferHeap(const unsigned int poolSize, const unsigned int flags) {
+    _orionAssertVersion(200);
+
+    if (!poolSize) {
+        _orionThrowError(ORERR_NULL_RECIEVED);
+    }
+
+    oriBufferHeap *r = malloc(sizeof(oriBufferHeap));
+    r->poolSize = (poolSize + _ORI_TLSF_ALIGN - 1) & ~(_ORI_TLSF_ALIGN - 1);
+    r->storageFlags = flags;
+    r->poolListHead = NULL;
+    r->spareBlocks = NULL;
+
+    // link to global linked list
+    r->next = _orion.bufferHeapListHead;
+    _orion.bufferHeapListHead = r;
+
+    return r;
+}
+
+/**
+ * @brief Destroy and free memory for the given buffer heap, including all of its pools.
+ * 
+ * @param heap the heap to free.
+ * 
+ * @ingroup buffers
+ */
+void oriFreeBufferHeap(oriBufferHeap *heap) {
+    // unlink from global linked list
+    oriBufferHeap **current = &_orion.bufferHeapListHead;
+    while (*current != heap)
+        current = &(*current)->next;
+    *current = heap->next;
+
+    // free the pools along with their buffers and blocks
+    while (heap->poolListHead) {
+        _oriHeapPool *pool = heap->poolListHead;
+        heap->poolListHead = pool->next;
+
+        _oriHeapFreePool(pool);
+    }
+
+    while (heap->spareBlocks) {
+        _oriHeapBlock *next = heap->spareBlocks->nextFree;
+        free(heap->spareBlocks);
+        heap->spareBlocks = next;
+    }
+
+    free(heap);
+    heap = NULL;
+}
+
+/**
+ * @brief Sub-allocate a range of one of the given heap's buffers.
+ * 
+ * @param heap the heap to allocate from.
+ * @param size the size of the allocation, in bytes.
+ * @param alignment the alignment of the allocation's offset, in bytes. Must be a power of two; values below 16 are rounded up to 16.
+ * For uniform or shader storage buffer ranges, use @c GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT or @c GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT.
+ * @param allocation the allocation to write the result into.
+ * @return false if the allocation failed.
+ * 
+ * @ingroup buffers
+ */
+bool oriBufferHeapAlloc(oriBufferHeap *heap, const unsigned int size, unsigned int alignment, oriBufferAllocation *allocation) {
+    if (!size || !allocation) {
+        _orionThrowWarning("(in oriBufferHeapAlloc()): Invalid size or allocation given. Nothing was allocated.");
+        return false;
+    }
+    if (alignment & (alignment - 1)) {
+        _orionThrowWarning("(in oriBufferHeapAlloc()): Alignment must be a power of two. Nothing was allocated.");
+        return false;
+    }
+    if (alignment < _ORI_TLSF_ALIGN) {
+        alignment = _ORI_TLSF_ALIGN;
+    }
+
+    unsigned int alignedSize = (size + _ORI_TLSF_ALIGN - 1) & ~(_ORI_TLSF_ALIGN - 1);
+
+    for (_oriHeapPool *pool = heap->poolListHead; pool; pool = pool->next) {
+        if (_oriHeapPoolAlloc(heap, pool, alignedSize, alignment, allocation)) {
+            return true;
+        }
+    }
+
+    // none of the existing pools have room, so reserve another.
+    // it must be large enough for the allocation to be found by _oriHeapFindGoodFit(), which only searches size classes
+    // that are entirely large enough, so a pool for an allocation near (or above) the pool size is made larger
+    unsigned int searchSize = alignedSize + alignment - _ORI_TLSF_ALIGN;
+    unsigned int poolSize = searchSize < alignedSize ? 0 : _oriHeapRoundSize(searchSize);
+    if (!poolSize) {
+        _orionThrowWarning("(in oriBufferHeapAlloc()): Allocation is too large. Nothing was allocated.");
+        return false;
+    }
+    if (poolSize < heap->poolSize) {
+        poolSize = heap->poolSize;
+    }
+
+    _oriHeapPool *pool = _oriHeapCreatePool(heap, poolSize);
+    if (_oriHeapPoolAlloc(heap, pool, alignedSize, alignment, allocation)) {
+        return true;
+    }
+
+    // don't keep a pool that nothing could be allocated from (it was linked at the head of the list)
+    heap->poolListHead = pool->next;
+    _oriHeapFreePool(pool);
+
+    _orionThrowWarning("(in oriBufferHeapAlloc()): Failed to allocate from a new buffer heap pool.");
+    return false;
+}
+
+/**
+ * @brief Free a range that was allocated with oriBufferHeapAlloc().
+ * 
+ * @param heap the heap that the range was allocated from.
+ * @param allocation the allocation to free. It is reset to zero.
+ * 
+ * @ingroup buffers
+ */
+void oriBufferHeapFree(oriBufferHeap *heap, oriBufferAllocation *allocation) {
+    _oriHeapBlock *block = allocation->block;
+    if (!block || block->free) {
+        _orionThrowWarning("(in oriBufferHeapFree()): Attempted to free an invalid or already-freed buffer heap allocation.");
+        return;
+    }
+
+    _oriHeapPool *pool = block->pool;
+
+    // merge with the previous block if it is free
+    _oriHeapBlock *prev = block->prevPhysical;
+    if (prev && prev->free) {
+        _oriHeapRemoveFree(pool, prev);
+
+        prev->size += block->size;
+        prev->nextPhysical = block->nextPhysical;
+        if (prev->nextPhysical) {
+            prev->nextPhysical->prevPhysical = prev;
+        }
+
+        _oriHeapRecycleBlock(heap, block);
+        block = prev;
+    }
+
+    // merge with the next block if it is free
+    _oriHeapBlock *next = block->nextPhysical;
+    if (next && next->free) {
+        _oriHeapRemoveFree(pool, next);
+
+        block->size += next->size;
+        block->nextPhysical = next->nextPhysical;
+        if (block->nextPhysical) {
+            block->nextPhysical->prevPhysical = block;
+        }
+
+        _oriHeapRecycleBlock(heap, next);
+    }
+
+    _oriHeapInsertFree(pool, block);
+
+    memset(allocation, 0, sizeof(oriBufferAllocation));
+}
+
+/**
+ * @brief Return statistics about the given buffer heap into the specified variables.
+ * 
+ * @details If you don't want to recieve a statistic, pass NULL as the argument.
+ * 
+ * @param heap the heap to inspect.
+ * @param pools the number of pools (buffer objects) reserved by the heap.
+ * @param totalSize the combined size of all pools, in bytes.
+ * @param usedSize the number of bytes currently allocated (including alignment).
+ * @param largestFree the size of the largest free block, i.e. the largest allocation that can be made without reserving a new pool.
+ * @param fragmentation a value from 0 to 1, where 0 means that all free space is in one block; calculated as
+ * <tt>1 - largestFree / (totalSize - usedSize)</tt>.
+ * 
+ * @ingroup buffers
+ */
+void oriGetBufferHeapStats(oriBufferHeap *heap, unsigned int *pools, unsigned int *totalSize, unsigned int *usedSize, unsigned int *largestFree, float *fragmentation) {
+    unsigned int poolCount = 0, total = 0, used = 0, largest = 0;
+
+    for (_oriHeapPool *pool = heap->poolListHead; pool; pool = pool->next) {
+        poolCount++;
+        total += pool->size;
+
+        for (_oriHeapBlock *block = pool->firstBlock; block; block = block->nextPhysical) {
+            if (!block->free) {
+                used += block->size;
+            } else if (block->size > largest) {
+                largest = block->size;
+            }
+        }
+    }
+
+    if (pools) *pools = poolCount;
+    if (totalSize) *totalSize = total;
+    if (usedSize) *usedSize = used;
+    if (largestFree) *largestFree = largest;
+    if (fragmentation) *fragmentation = (total - used) ? 1.0f - (float) largest / (float) (total - used) : 0.0f;
+}
@@ -16,6 +16,35 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+
+// ======================================================================================
+// *****                          ORION INTERNAL DATA TYPES                         *****
+// ======================================================================================
+
+typedef struct _oriVertexLayoutAttribute {
+    bool enabled;
+
+    unsigned int binding;
+    unsigned int size;
+    unsigned int type;
+    bool normalised;
+    unsigned int offset;
+} _oriVertexLayoutAttribute;
+
+typedef struct _oriVertexLayoutBinding {
+    bool used;
+
+    unsigned int stride;
+    unsigned int divisor;
+} _oriVertexLayoutBinding;
+
+typedef struct _oriVertexLayoutNamedAttribute {
+    // the name of the shader input that the attribute feeds
+    char *name;
+
+    _oriVertexLayoutAttribute attribute;
+} _oriVertexLayoutNamedAttribute;
 
 // ======================================================================================
 // *****                           ORION PUBLIC STRUCTURES                          *****
@@ -33,14 +62,169 @@ typedef struct oriBuffer {
     unsigned int currentTarget;
     bool dataSet;
     unsigned int dataSize;
+
+    bool immutableStorage;
+    unsigned int storageFlags;
 } oriBuffer;
 
+/**
+ * @brief A persistently-mapped OpenGL buffer object split into fenced regions.
+ * 
+ * @ingroup buffers
+ */
+typedef struct oriStreamBuffer {
+    oriStreamBuffer *next;
+
+    oriBuffer *buffer;
+    unsigned char *mapped;
+
+    unsigned int regionSize;
+    unsigned int regionCount;
+    unsigned int currentRegion;
+
+    // one fence per region; NULL if the region is not in use by the GPU
+    GLsync *fences;
+} oriStreamBuffer;
+
 typedef struct oriVertexArray {
     oriVertexArray *next;
 
     unsigned int handle;
+
+    // bitmask of the attributes that have been enabled through Orion
+    unsigned int enabledAttribs;
+    // stride of each vertex buffer binding point, as specified by the last applied vertex layout
+    unsigned int bindingStrides[ORION_MAX_VERTEX_BINDINGS];
 } oriVertexArray;
 
+/**
+ * @brief A description of every vertex attribute and vertex buffer binding point of a vertex array.
+ * 
+ * @ingroup vertexspec
+ */
+typedef struct oriVertexLayout {
+    oriVertexLayout *next;
+
+    _oriVertexLayoutAttribute attributes[ORION_MAX_VERTEX_ATTRIBS];
+    _oriVertexLayoutBinding bindings[ORION_MAX_VERTEX_BINDINGS];
+
+    // attributes described by the name of the shader input they feed, rather than by index
+    _oriVertexLayoutNamedAttribute *namedAttributes;
+    unsigned int namedAttributeCount;
+
+    // the attributes matched to the inputs of a shader by oriBindVertexLayoutToShader(); applied instead of the
+    // attributes above if boundToShader is set
+    _oriVertexLayoutAttribute resolved[ORION_MAX_VERTEX_ATTRIBS];
+    bool boundToShader;
+} oriVertexLayout;
+
+
+// ======================================================================================
+// *****                              HELPER FUNCTIONS                              *****
+// ======================================================================================
+
+/**
+ * @brief Check that the given vertex attribute format is valid, sending a warning if not.
+ * 
+ * @param func the name of the calling function, used in warning messages.
+ * @param size the number of components per vertex attribute.
+ * @param type the type of each component.
+ * @return false if the format is invalid and the attribute should not be specified.
+ */
+static bool _oriCheckVertexAttribFormat(const char *func, const unsigned int size, const unsigned int type) {
+    // As string formatted is required here, printf is used instead of _orionThrowWarning.
+    // This is annoying and be sure to change the style of this message if the style in _orionThrowWarning changes.
+    if (type == GL_DOUBLE) {
+        printf("[Orion : WARN] >> (in %s): The OpenGL Specification heavily warns against using GL_DOUBLE.\n", func);
+    }
+    if (type == GL_UNSIGNED_INT_10F_11F_11F_REV) {
+        _orionAssertVersion(440);
+        if (size != 3) {
+            printf("[Orion : WARN] >> (in %s): Size MUST be 3 when using GL_UNSIGNED_INT_10F_11F_11F_REV.\n", func);
+            return false;
+        }
+    }
+    if ((type == GL_INT_2_10_10_10_REV || type == GL_UNSIGNED_INT_2_10_10_10_REV) && size != 4) {
+        printf("[Orion : WARN] >> (in %s): Size MUST be 4 when using either GL_INT_2_10_10_10_REV or GL_UNSIGNED_INT_2_10_10_10_REV.\n", func);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Decide which variant of glVertexAttrib*Pointer / glVertexArrayAttrib*Format to use so that data of the given type isn't converted to floats.
+ * 
+ * @param type the type of each component.
+ * @return 1 for the regular variant, 2 for the I variant, or 3 for the L variant.
+ */
+static unsigned int _oriVertexAttribFuncType(const unsigned int type) {
+    // glVertexAttribPointer and its I variant are available
+    if (_orion.glVersion < 410) {
+        switch (type) {
+            case GL_HALF_FLOAT:
+            case GL_FLOAT:
+            case GL_DOUBLE:
+            case GL_FIXED:
+            case GL_INT_2_10_10_10_REV:
+            case GL_UNSIGNED_INT_2_10_10_10_REV:
+                return 1;
+            default:
+                return 2;
+        }
+    }
+
+    // all variants of glVertexAttribPointer are available
+    switch (type) {
+        case GL_HALF_FLOAT:
+        case GL_FLOAT:
+        case GL_FIXED:
+        case GL_INT_2_10_10_10_REV:
+        case GL_UNSIGNED_INT_2_10_10_10_REV:
+        case GL_UNSIGNED_INT_10F_11F_11F_REV:
+            return 1;
+        case GL_DOUBLE:
+            return 3;
+        default:
+            return 2;
+    }
+}
+
+/**
+ * @brief Decide which variant of glVertexAttrib*Pointer / glVertexArrayAttrib*Format a shader input of the given type needs to be fed by.
+ * 
+ * @param type the type of the shader input (e.g. @c GL_FLOAT_VEC3).
+ * @return 1 for the regular variant, 2 for the I variant, or 3 for the L variant.
+ */
+static unsigned int _oriShaderInputFuncType(const unsigned int type) {
+    switch (type) {
+        case GL_INT:
+        case GL_INT_VEC2:
+        case GL_INT_VEC3:
+        case GL_INT_VEC4:
+        case GL_UNSIGNED_INT:
+        case GL_UNSIGNED_INT_VEC2:
+        case GL_UNSIGNED_INT_VEC3:
+        case GL_UNSIGNED_INT_VEC4:
+            return 2;
+        case GL_DOUBLE:
+        case GL_DOUBLE_VEC2:
+        case GL_DOUBLE_VEC3:
+        case GL_DOUBLE_VEC4:
+        case GL_DOUBLE_MAT2:
+        case GL_DOUBLE_MAT2x3:
+        case GL_DOUBLE_MAT2x4:
+        case GL_DOUBLE_MAT3:
+        case GL_DOUBLE_MAT3x2:
+        case GL_DOUBLE_MAT3x4:
+        case GL_DOUBLE_MAT4:
+        case GL_DOUBLE_MAT4x2:
+        case GL_DOUBLE_MAT4x3:
+            return 3;
+        default:
+            return 1;
+    }
+}
 
 // ======================================================================================
 // *****                     ORION VERTEX SPECIFICATION FUNCTIONS                   *****
@@ -56,6 +240,8 @@ oriVertexArray *oriCreateVertexArray() {
 
     oriVertexArray *r = malloc(sizeof(oriVertexArray));
     r->handle = 0;
+    r->enabledAttribs = 0;
+    memset(r->bindingStrides, 0, sizeof(r->bindingStrides));
 
     // use DSA if possible
     if (_orion.glVersion >= 450) {
@@ -151,18 +337,7 @@ void oriSpecifyVertexData(oriVertexArray *va, oriBuffer *buffer,
     const unsigned int stride,
     const unsigned int offset
 ) {
-    if (type == GL_DOUBLE) {
-        _orionThrowWarning("(in oriSpecifyVertexData()): The OpenGL Specification heavily warns against using GL_DOUBLE.");
-    }
-    if (type == GL_UNSIGNED_INT_10F_11F_11F_REV) {
-        _orionAssertVersion(440);
-        if (size != 3) {
-            _orionThrowWarning("(in oriSpecifyVertexData()): Size MUST be 3 when using GL_UNSIGNED_INT_10F_11F_11F_REV.");
-            return;
-        }
-    }
-    if ((type == GL_INT_2_10_10_10_REV || type == GL_UNSIGNED_INT_2_10_10_10_REV) && size != 4) {
-        _orionThrowWarning("(in oriSpecifyVertexData()): Size MUST be 4 when using either GL_INT_2_10_10_10_REV or GL_UNSIGNED_INT_2_10_10_10_REV.");
+    if (!_oriCheckVertexAttribFormat("oriSpecifyVertexData()", size, type)) {
         return;
     }
 
@@ -171,42 +346,11 @@ void oriSpecifyVertexData(oriVertexArray *va, oriBuffer *buffer,
     // 1 = glVertexAttribPointer / glVertexArrayAttribFormat
     // 2 = glVertexAttribIPointer / glVertexArrayAttribIFormat
     // 3 = glVertexAttribLPointer / glVertexArrayAttribLFormat
-    unsigned int vertexAttribPointerFuncType = 0;
+    unsigned int vertexAttribPointerFuncType = _oriVertexAttribFuncType(type);
 
-    // glVertexAttribPointer and its I variant are available
-    if (_orion.glVersion < 410) {
-        switch (type) {
-            case GL_HALF_FLOAT:
-            case GL_FLOAT:
-            case GL_DOUBLE:
-            case GL_FIXED:
-            case GL_INT_2_10_10_10_REV:
-            case GL_UNSIGNED_INT_2_10_10_10_REV:
-                vertexAttribPointerFuncType = 1;
-                break;
-            default:
-                vertexAttribPointerFuncType = 2;
-                break;
-        }
-    }
-    // all variants of glVertexAttribPointer are available
-    else {
-        switch (type) {
-            case GL_HALF_FLOAT:
-            case GL_FLOAT:
-            case GL_FIXED:
-            case GL_INT_2_10_10_10_REV:
-            case GL_UNSIGNED_INT_2_10_10_10_REV:
-            case GL_UNSIGNED_INT_10F_11F_11F_REV:
-                vertexAttribPointerFuncType = 1;
-                break;
-            case GL_DOUBLE:
-                vertexAttribPointerFuncType = 3;
-                break;
-            default:
-                vertexAttribPointerFuncType = 2;
-                break;
-        }
+    if (index < ORION_MAX_VERTEX_BINDINGS) {
+        va->enabledAttribs |= 1u << index;
+        va->bindingStrides[index] = stride;
     }
 
     // Use DSA where possible
@@ -281,6 +425,423 @@ void oriSpecifyVertexData(oriVertexArray *va, oriBuffer *buffer,
     glBindBuffer(GL_ARRAY_BUFFER, previousBuffer);
 }
 
+/**
+ * @brief Set the rate at which a vertex attribute advances during instanced draw calls.
+ * @details This is intended for attributes specified with oriSpecifyVertexData(), which use the attribute index as
+ * their binding point. For attributes described by an oriVertexLayout, give the divisor to oriVertexLayoutBinding() instead.
+ * 
+ * @param va the vertex array to modify.
+ * @param index the index of the vertex attribute.
+ * @param divisor the number of instances that pass between updates of the attribute; 0 for regular per-vertex attributes.
+ * 
+ * @sa oriDrawInstanced()
+ * @sa oriDrawElementsInstanced()
+ * 
+ * @ingroup vertexspec
+ */
+void oriSetVertexAttribDivisor(oriVertexArray *va, const unsigned int index, const unsigned int divisor) {
+    _orionAssertVersion(330);
+
+    if (_orion.glVersion >= 450) {
+        glVertexArrayBindingDivisor(va->handle, index, divisor);
+        return;
+    }
+
+    unsigned int previousVA = oriCurrentVertexArray();
+    oriBindVertexArray(va);
+
+    glVertexAttribDivisor(index, divisor);
+
+    glBindVertexArray(previousVA);
+}
+
+// ======================================================================================
+// *****                         ORION VERTEX LAYOUT FUNCTIONS                      *****
+// ======================================================================================
+
+/**
+ * @brief Allocate and initialise a new, empty oriVertexLayout structure.
+ * @details A vertex layout describes every attribute and vertex buffer binding point of a vertex array at once, so
+ * that it can be applied in a single pass with oriApplyVertexLayout(). Attributes read from binding points rather than
+ * directly from buffers, so the buffer for a binding point can later be swapped with a single call to oriBindVertexBuffer()
+ * without respecifying any attributes.
+ * 
+ * @sa <a href="https://www.khronos.org/opengl/wiki/Vertex_Specification#Separate_attribute_format">OpenGL/Separate attribute format</a>
+ * 
+ * @ingroup vertexspec
+ */
+oriVertexLayout *oriCreateVertexLayout() {
+    oriVertexLayout *r = calloc(1, sizeof(oriVertexLayout));
+
+    // add to global linked list
+    r->next = _orion.vertexLayoutListHead;
+    _orion.vertexLayoutListHead = r;
+
+    return r;
+}
+
+/**
+ * @brief Free memory for the given vertex layout.
+ * @details Vertex arrays that the layout has been applied to are unaffected.
+ * 
+ * @param layout the vertex layout to free.
+ * 
+ * @ingroup vertexspec
+ */
+void oriFreeVertexLayout(oriVertexLayout *layout) {
+    // unlink from global linked list
+    oriVertexLayout **current = &_orion.vertexLayoutListHead;
+    while (*current != layout)
+        current = &(*current)->next;
+    *current = layout->next;
+
+    for (unsigned int i = 0; i < layout->namedAttributeCount; i++) {
+        free(layout->namedAttributes[i].name);
+    }
+    free(layout->namedAttributes);
+
+    free(layout);
+    layout = NULL;
+}
+
+/**
+ * @brief Describe a vertex buffer binding point in the given layout.
+ * 
+ * @param layout the vertex layout to modify.
+ * @param binding the index of the binding point (below @c ORION_MAX_VERTEX_BINDINGS).
+ * @param stride the byte offset between consecutive elements in the buffer bound to this binding point.
+ * @param divisor the number of instances that pass between updates of attributes that read from this binding point;
+ * 0 for regular per-vertex attributes.
+ * 
+ * @ingroup vertexspec
+ */
+void oriVertexLayoutBinding(oriVertexLayout *layout, const unsigned int binding, const unsigned int stride, const unsigned int divisor) {
+    if (binding >= ORION_MAX_VERTEX_BINDINGS) {
+        _orionThrowWarning("(in oriVertexLayoutBinding()): Binding index must be below ORION_MAX_VERTEX_BINDINGS.");
+        return;
+    }
+
+    layout->bindings[binding].used = true;
+    layout->bindings[binding].stride = stride;
+    layout->bindings[binding].divisor = divisor;
+}
+
+/**
+ * @brief Describe a vertex attribute in the given layout.
+ * 
+ * @param layout the vertex layout to modify.
+ * @param index the index of the vertex attribute (below @c ORION_MAX_VERTEX_ATTRIBS).
+ * @param binding the vertex buffer binding point that the attribute reads from.
+ * @param size the number of components per vertex attribute.
+ * @param type the type of each component, e.g. \c GL_FLOAT or \c GL_INT.
+ * @param normalised should the data be normalised
+ * @param offset the offset of the first component of the attribute, relative to the start of each element in the binding point's buffer.
+ * 
+ * @ingroup vertexspec
+ */
+void oriVertexLayoutAttribute(oriVertexLayout *layout, const unsigned int index, const unsigned int binding, const unsigned int size, const unsigned int type, const bool normalised, const unsigned int offset) {
+    if (index >= ORION_MAX_VERTEX_ATTRIBS || binding >= ORION_MAX_VERTEX_BINDINGS) {
+        _orionThrowWarning("(in oriVertexLayoutAttribute()): Attribute index and binding must be below ORION_MAX_VERTEX_ATTRIBS and ORION_MAX_VERTEX_BINDINGS.");
+        return;
+    }
+    if (!_oriCheckVertexAttribFormat("oriVertexLayoutAttribute()", size, type)) {
+        return;
+    }
+
+    _oriVertexLayoutAttribute *attrib = &layout->attributes[index];
+    attrib->enabled = true;
+    attrib->binding = binding;
+    attrib->size = size;
+    attrib->type = type;
+    attrib->normalised = normalised;
+    attrib->offset = offset;
+
+    // make sure the binding point is applied even if it wasn't explicitly described
+    layout->bindings[binding].used = true;
+
+    // the layout has to be matched to a shader again
+    layout->boundToShader = false;
+}
+
+/**
+ * @brief Describe a vertex attribute in the given layout by the name of the shader input it feeds, rather than by index.
+ * @details The index of the attribute is found when the layout is matched to a shader with oriBindVertexLayoutToShader(),
+ * which must be called before the layout is applied. This way, the layout doesn't depend on the @c layout(location = ...)
+ * qualifiers in the shader.
+ * 
+ * @param layout the vertex layout to modify.
+ * @param name the name of the shader input (e.g. @c "vertexPosIn").
+ * @param binding the vertex buffer binding point that the attribute reads from.
+ * @param size the number of components per vertex attribute.
+ * @param type the type of each component, e.g. \c GL_FLOAT or \c GL_INT.
+ * @param normalised should the data be normalised
+ * @param offset the offset of the first component of the attribute, relative to the start of each element in the binding point's buffer.
+ * 
+ * @ingroup vertexspec
+ */
+void oriVertexLayoutNamedAttribute(oriVertexLayout *layout, const char *name, const unsigned int binding, const unsigned int size, const unsigned int type, const bool normalised, const unsigned int offset) {
+    if (binding >= ORION_MAX_VERTEX_BINDINGS) {
+        _orionThrowWarning("(in oriVertexLayoutNamedAttribute()): Binding index must be below ORION_MAX_VERTEX_BINDINGS.");
+        return;
+    }
+    if (!_oriCheckVertexAttribFormat("oriVertexLayoutNamedAttribute()", size, type)) {
+        return;
+    }
+
+    // describing the same name again replaces the attribute
+    _oriVertexLayoutNamedAttribute *named = NULL;
+    for (unsigned int i = 0; i < layout->namedAttributeCount; i++) {
+        if (!strcmp(layout->namedAttributes[i].name, name)) {
+            named = &layout->namedAttributes[i];
+            break;
+        }
+    }
+
+    if (!named) {
+        layout->namedAttributes = realloc(layout->namedAttributes, (layout->namedAttributeCount + 1) * sizeof(_oriVertexLayoutNamedAttribute));
+        named = &layout->namedAttributes[layout->namedAttributeCount++];
+
+        named->name = malloc(strlen(name) + 1);
+        strcpy(named->name, name);
+    }
+
+    named->attribute.enabled = true;
+    named->attribute.binding = binding;
+    named->attribute.size = size;
+    named->attribute.type = type;
+    named->attribute.normalised = normalised;
+    named->attribute.offset = offset;
+
+    // make sure the binding point is applied even if it wasn't explicitly described
+    layout->bindings[binding].used = true;
+
+    // the layout has to be matched to a shader again
+    layout->boundToShader = false;
+}
+
+/**
+ * @brief Match the attributes of the given layout to the inputs of a shader.
+ * @details Named attributes (see oriVertexLayoutNamedAttribute()) are given the location of the shader input with the
+ * same name, and attributes that the shader doesn't read are left out, so that they are disabled when the layout is
+ * applied with oriApplyVertexLayout() and no vertex fetch bandwidth is wasted on them. A warning is sent for each input
+ * that the layout doesn't provide, or provides with the wrong type (e.g. integers to a @c vec3).
+ * 
+ * The match is kept until the layout's attributes are changed, so this only has to be called once.
+ * 
+ * @param layout the vertex layout to match.
+ * @param shader the shader whose inputs the layout feeds.
+ * 
+ * @ingroup vertexspec
+ */
+void oriBindVertexLayoutToShader(oriVertexLayout *layout, oriShader *shader) {
+    memset(layout->resolved, 0, sizeof(layout->resolved));
+
+    // every location the shader reads from
+    unsigned int read = 0;
+
+    const char *name;
+    int location;
+    unsigned int type, locationCount;
+
+    for (unsigned int i = 0; (name = _orionGetShaderInput(shader, i, &location, &type, &locationCount)); i++) {
+        for (unsigned int l = location; l < location + locationCount && l < ORION_MAX_VERTEX_ATTRIBS; l++) {
+            read |= 1u << l;
+        }
+    }
+
+    // attributes described by index are kept if the shader reads them
+    for (unsigned int i = 0; i < ORION_MAX_VERTEX_ATTRIBS; i++) {
+        if (layout->attributes[i].enabled && (read & (1u << i))) {
+            layout->resolved[i] = layout->attributes[i];
+        }
+    }
+
+    // attributes described by name are given the location of their input
+    for (unsigned int i = 0; i < layout->namedAttributeCount; i++) {
+        _oriVertexLayoutNamedAttribute *named = &layout->namedAttributes[i];
+
+        location = -1;
+        for (unsigned int j = 0; (name = _orionGetShaderInput(shader, j, &location, NULL, NULL)); j++) {
+            if (!strcmp(name, named->name)) {
+                break;
+            }
+        }
+
+        // the shader doesn't read the input
+        if (!name) {
+            continue;
+        }
+
+        if (location >= ORION_MAX_VERTEX_ATTRIBS) {
+            // As string formatted is required here, printf is used instead of _orionThrowWarning.
+            // This is annoying and be sure to change the style of this message if the style in _orionThrowWarning changes.
+            printf("[Orion : WARN] >> (in oriBindVertexLayoutToShader()): The location of input %s is not below ORION_MAX_VERTEX_ATTRIBS. Attribute not applied.\n", named->name);
+            continue;
+        }
+        if (layout->resolved[location].enabled) {
+            // As string formatted is required here, printf is used instead of _orionThrowWarning.
+            // This is annoying and be sure to change the style of this message if the style in _orionThrowWarning changes.
+            printf("[Orion : WARN] >> (in oriBindVertexLayoutToShader()): Input %s is described both by name and by index. The named attribute is used.\n", named->name);
+        }
+
+        layout->resolved[location] = named->attribute;
+    }
+
+    // check that every input the shader reads is provided, with a matching type
+    for (unsigned int i = 0; (name = _orionGetShaderInput(shader, i, &location, &type, &locationCount)); i++) {
+        for (unsigned int l = location; l < location + locationCount && l < ORION_MAX_VERTEX_ATTRIBS; l++) {
+            if (!layout->resolved[l].enabled) {
+                // As string formatted is required here, printf is used instead of _orionThrowWarning.
+                // This is annoying and be sure to change the style of this message if the style in _orionThrowWarning changes.
+                printf("[Orion : WARN] >> (in oriBindVertexLayoutToShader()): The shader reads input %s (location %u), which the layout doesn't provide.\n", name, l);
+            } else if (_oriVertexAttribFuncType(layout->resolved[l].type) != _oriShaderInputFuncType(type)) {
+                // As string formatted is required here, printf is used instead of _orionThrowWarning.
+                // This is annoying and be sure to change the style of this message if the style in _orionThrowWarning changes.
+                printf("[Orion : WARN] >> (in oriBindVertexLayoutToShader()): The type of the attribute at location %u doesn't match shader input %s.\n", l, name);
+            }
+        }
+    }
+
+    layout->boundToShader = true;
+}
+
+/**
+ * @brief Apply every attribute and binding point described by the given layout to a vertex array, in one pass.
+ * @details Attributes that were previously enabled on the vertex array but aren't in the layout are disabled. If the layout
+ * has been matched to a shader with oriBindVertexLayoutToShader(), only the attributes that the shader reads are applied.
+ * Buffers must then be attached to each binding point with oriBindVertexBuffer().
+ * 
+ * @param va the vertex array to modify.
+ * @param layout the vertex layout to apply.
+ * 
+ * @ingroup vertexspec
+ */
+void oriApplyVertexLayout(oriVertexArray *va, oriVertexLayout *layout) {
+    _orionAssertVersion(430);
+
+    if (layout->namedAttributeCount && !layout->boundToShader) {
+        _orionThrowWarning("(in oriApplyVertexLayout()): The layout has named attributes but hasn't been matched to a shader with oriBindVertexLayoutToShader(). Named attributes not applied.");
+    }
+    const _oriVertexLayoutAttribute *attributes = layout->boundToShader ? layout->resolved : layout->attributes;
+
+    bool dsaEnabled = _orion.glVersion >= 450;
+
+    // if DSA is not possible then the vertex array is bound once for the whole layout
+    unsigned int previousVA = 0;
+    if (!dsaEnabled) {
+        previousVA = oriCurrentVertexArray();
+        oriBindVertexArray(va);
+    }
+
+    unsigned int enabledAttribs = 0;
+
+    for (unsigned int i = 0; i < ORION_MAX_VERTEX_ATTRIBS; i++) {
+        const _oriVertexLayoutAttribute *attrib = &attributes[i];
+        if (!attrib->enabled) {
+            // disable attributes that are no longer specified
+            if (va->enabledAttribs & (1u << i)) {
+                if (dsaEnabled) {
+                    glDisableVertexArrayAttrib(va->handle, i);
+                } else {
+                    glDisableVertexAttribArray(i);
+                }
+            }
+
+            continue;
+        }
+
+        enabledAttribs |= 1u << i;
+
+        if (dsaEnabled) {
+            glEnableVertexArrayAttrib(va->handle, i);
+
+            switch (_oriVertexAttribFuncType(attrib->type)) {
+                case 1:
+                default:
+                    glVertexArrayAttribFormat(va->handle, i, attrib->size, attrib->type, attrib->normalised, attrib->offset);
+                    break;
+                case 2:
+                    glVertexArrayAttribIFormat(va->handle, i, attrib->size, attrib->type, attrib->offset);
+                    break;
+                case 3:
+                    glVertexArrayAttribLFormat(va->handle, i, attrib->size, attrib->type, attrib->offset);
+                    break;
+            }
+            glVertexArrayAttribBinding(va->handle, i, attrib->binding);
+        } else {
+            glEnableVertexAttribArray(i);
+
+            switch (_oriVertexAttribFuncType(attrib->type)) {
+                case 1:
+                default:
+                    glVertexAttribFormat(i, attrib->size, attrib->type, attrib->normalised, attrib->offset);
+                    break;
+                case 2:
+                    glVertexAttribIFormat(i, attrib->size, attrib->type, attrib->offset);
+                    break;
+                case 3:
+                    glVertexAttribLFormat(i, attrib->size, attrib->type, attrib->offset);
+                    break;
+            }
+            glVertexAttribBinding(i, attrib->binding);
+        }
+    }
+
+    for (unsigned int i = 0; i < ORION_MAX_VERTEX_BINDINGS; i++) {
+        _oriVertexLayoutBinding *binding = &layout->bindings[i];
+        if (!binding->used) {
+            continue;
+        }
+
+        va->bindingStrides[i] = binding->stride;
+
+        if (dsaEnabled) {
+            glVertexArrayBindingDivisor(va->handle, i, binding->divisor);
+        } else {
+            glVertexBindingDivisor(i, binding->divisor);
+        }
+    }
+
+    va->enabledAttribs = enabledAttribs;
+
+    if (!dsaEnabled) {
+        glBindVertexArray(previousVA);
+    }
+}
+
+/**
+ * @brief Attach a buffer to one of a vertex array's binding points.
+ * @details Every attribute that reads from the binding point (as described by the last vertex layout applied to the
+ * vertex array) will read from the given buffer, so swapping the buffer takes just this one call.
+ * 
+ * @param va the vertex array to modify.
+ * @param binding the binding point to attach the buffer to.
+ * @param buffer the buffer to attach.
+ * @param offset the offset of the first element in the buffer, in bytes.
+ * 
+ * @ingroup vertexspec
+ */
+void oriBindVertexBuffer(oriVertexArray *va, const unsigned int binding, oriBuffer *buffer, const unsigned int offset) {
+    _orionAssertVersion(430);
+
+    if (binding >= ORION_MAX_VERTEX_BINDINGS) {
+        _orionThrowWarning("(in oriBindVertexBuffer()): Binding index must be below ORION_MAX_VERTEX_BINDINGS.");
+        return;
+    }
+
+    if (_orion.glVersion >= 450) {
+        glVertexArrayVertexBuffer(va->handle, binding, buffer->handle, offset, va->bindingStrides[binding]);
+        return;
+    }
+
+    unsigned int previousVA = oriCurrentVertexArray();
+    oriBindVertexArray(va);
+
+    glBindVertexBuffer(binding, buffer->handle, offset, va->bindingStrides[binding]);
+
+    glBindVertexArray(previousVA);
+}
+
 // ======================================================================================
 // *****                            ORION BUFFER FUNCTIONS                          *****
 // ======================================================================================
@@ -298,6 +859,8 @@ oriBuffer *oriCreateBuffer() {
     r->dataSet = false;
     r->dataSize = 0;
     r->currentTarget = 0;
+    r->immutableStorage = false;
+    r->storageFlags = 0;
 
     // use DSA if possible
     if (_orion.glVersion >= 450) {
@@ -313,6 +876,49 @@ oriBuffer *oriCreateBuffer() {
     return r;
 }
 
+/**
+ * @brief Allocate and initialise a new oriBuffer structure with immutable storage.
+ * @details The storage of the buffer is allocated once, here, and can never be resized. Buffers with immutable storage
+ * can be better placed and synchronised by the driver, so they should be preferred for data that never changes size (e.g. static meshes).
+ * 
+ * @note oriSetBufferData() and oriSetBufferSubData() can only update the contents of the buffer if @c GL_DYNAMIC_STORAGE_BIT
+ * is set in @c flags, and oriSetBufferData() will never reallocate the storage.
+ * 
+ * @param data the data to initialise the buffer's storage with. Set to NULL to leave it uninitialised.
+ * @param size the size of the buffer's storage, in bytes.
+ * @param flags a bitwise combination of @c GL_DYNAMIC_STORAGE_BIT, @c GL_MAP_READ_BIT, @c GL_MAP_WRITE_BIT, @c GL_MAP_PERSISTENT_BIT,
+ * @c GL_MAP_COHERENT_BIT and @c GL_CLIENT_STORAGE_BIT (or 0).
+ * 
+ * @sa <a href="https://www.khronos.org/opengl/wiki/Buffer_Object#Immutable_Storage">OpenGL/Immutable buffer storage</a>
+ * @sa <a href="https://docs.gl/gl4/glBufferStorage">glBufferStorage</a>
+ * 
+ * @ingroup buffers
+ */
+oriBuffer *oriCreateBufferImmutable(const void *data, const unsigned int size, const unsigned int flags) {
+    _orionAssertVersion(440);
+
+    oriBuffer *r = oriCreateBuffer();
+    r->immutableStorage = true;
+    r->storageFlags = flags;
+
+    if (_orion.glVersion >= 450) {
+        glNamedBufferStorage(r->handle, size, data, flags);
+    } else {
+        // bind to this again at the end of the function if DSA is not used.
+        unsigned int boundCache = oriCurrentBufferAt(GL_ARRAY_BUFFER);
+        oriBindBuffer(r, GL_ARRAY_BUFFER);
+
+        glBufferStorage(GL_ARRAY_BUFFER, size, data, flags);
+
+        glBindBuffer(GL_ARRAY_BUFFER, boundCache);
+    }
+
+    r->dataSet = true;
+    r->dataSize = size;
+
+    return r;
+}
+
 /**
  * @brief Destroy and free memory for the given buffer.
  * 
@@ -324,10 +930,10 @@ void oriFreeBuffer(oriBuffer *buffer) {
     _orionAssertVersion(200);
 
     // unlink from global linked list
-    oriBuffer *current = _orion.bufferListHead;
-    while (current != buffer)
-        current = current->next;
-    _orion.bufferListHead = buffer->next;
+    oriBuffer **current = &_orion.bufferListHead;
+    while (*current != buffer)
+        current = &(*current)->next;
+    *current = buffer->next;
 
     glDeleteBuffers(1, &buffer->handle);
 
@@ -395,6 +1001,17 @@ unsigned int oriGetBufferHandle(oriBuffer *buffer) {
 void oriSetBufferData(oriBuffer *buffer, const void *data, const unsigned int size, const unsigned int usage) {
     _orionAssertVersion(200);
 
+    // immutable storage can't be reallocated, only updated in-place (and only if it was created as dynamic)
+    if (buffer->immutableStorage) {
+        if (size != buffer->dataSize) {
+            _orionThrowWarning("(in oriSetBufferData()): Attempted to reallocate a buffer with immutable storage. Buffer data not updated.");
+            return;
+        }
+
+        oriSetBufferSubData(buffer, 0, data, size);
+        return;
+    }
+
     bool dsaEnabled = _orion.glVersion >= 450;
 
     // for the sake of supporting non-DSA, the buffer will be temporarily bound to GL_ARRAY_BUFFER during this function's lifespan.
@@ -440,3 +1057,250 @@ void oriSetBufferData(oriBuffer *buffer, const void *data, const unsigned int si
         glBindBuffer(GL_ARRAY_BUFFER, boundCache);
     }
 }
+
+/**
+ * @brief Update a range of the data store of a given oriBuffer structure, without reallocating it.
+ * 
+ * @param buffer the buffer to copy data into.
+ * @param offset the offset into the buffer's data store, in bytes, at which to start replacing data.
+ * @param data the data to copy into @c buffer.
+ * @param size the size of the given data.
+ * 
+ * @ingroup buffers
+ */
+void oriSetBufferSubData(oriBuffer *buffer, const unsigned int offset, const void *data, const unsigned int size) {
+    _orionAssertVersion(200);
+
+    if (!buffer->dataSet || offset + size > buffer->dataSize) {
+        _orionThrowWarning("(in oriSetBufferSubData()): The given range is outside of the buffer's data store. Buffer data not updated.");
+        return;
+    }
+    if (buffer->immutableStorage && !(buffer->storageFlags & GL_DYNAMIC_STORAGE_BIT)) {
+        _orionThrowWarning("(in oriSetBufferSubData()): Buffer's immutable storage was not created with GL_DYNAMIC_STORAGE_BIT. Buffer data not updated.");
+        return;
+    }
+
+    if (_orion.glVersion >= 450) {
+        glNamedBufferSubData(buffer->handle, offset, size, data);
+        return;
+    }
+
+    // bind to this again at the end of the function if DSA is not used.
+    unsigned int boundCache = oriCurrentBufferAt(GL_ARRAY_BUFFER);
+    oriBindBuffer(buffer, GL_ARRAY_BUFFER);
+
+    glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+
+    glBindBuffer(GL_ARRAY_BUFFER, boundCache);
+}
+
+/**
+ * @brief Return buffer properties into the specified variables.
+ * 
+ * @details If you don't want to recieve a property, pass NULL as the argument.
+ * 
+ * @param buffer the buffer to inspect.
+ * @param size the size of the buffer's data store, in bytes (0 if it has not been allocated).
+ * @param immutable true if the buffer was created with immutable storage.
+ * @param flags the storage flags given to oriCreateBufferImmutable(); 0 if the buffer's storage is mutable.
+ * 
+ * @ingroup buffers
+ */
+void oriGetBufferProperty(oriBuffer *buffer, unsigned int *size, bool *immutable, unsigned int *flags) {
+    if (size) *size = buffer->dataSize;
+    if (immutable) *immutable = buffer->immutableStorage;
+    if (flags) *flags = buffer->storageFlags;
+}
+
+// ======================================================================================
+// *****                         ORION STREAM BUFFER FUNCTIONS                      *****
+// ======================================================================================
+
+/**
+ * @brief Allocate and initialise a new oriStreamBuffer structure.
+ * @details The buffer's storage is allocated once with @c glBufferStorage and mapped persistently and coherently, so
+ * that data can be written into it directly every frame without any implicit synchronisation or copies in the driver.
+ * The storage is split into @c regionCount regions of @c regionSize bytes, each of which is guarded by a fence so that
+ * the CPU never writes into a region that the GPU is still reading from.
+ * 
+ * @note The region size is rounded up to a multiple of 256 bytes so that every region offset is suitably aligned.
+ * 
+ * @param regionSize the size, in bytes, of the data written in one frame.
+ * @param regionCount the number of regions (typically the number of frames that can be in flight, e.g. 3).
+ * 
+ * @ingroup buffers
+ */
+oriStreamBuffer *oriCreateStreamBuffer(const unsigned int regionSize, const unsigned int regionCount) {
+    _orionAssertVersion(440);
+
+    if (!regionSize || !regionCount) {
+        _orionThrowError(ORERR_NULL_RECIEVED);
+    }
+
+    oriStreamBuffer *r = malloc(sizeof(oriStreamBuffer));
+    r->regionSize = (regionSize + 255) & ~255u;
+    r->regionCount = regionCount;
+    // the first call to oriStreamBufferBegin() will wrap this around to region 0
+    r->currentRegion = regionCount - 1;
+    r->fences = calloc(regionCount, sizeof(GLsync));
+
+    unsigned int size = r->regionSize * regionCount;
+    unsigned int flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    r->buffer = oriCreateBufferImmutable(NULL, size, flags);
+
+    if (_orion.glVersion >= 450) {
+        r->mapped = glMapNamedBufferRange(r->buffer->handle, 0, size, flags);
+    } else {
+        unsigned int boundCache = oriCurrentBufferAt(GL_ARRAY_BUFFER);
+        oriBindBuffer(r->buffer, GL_ARRAY_BUFFER);
+
+        r->mapped = glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags);
+
+        glBindBuffer(GL_ARRAY_BUFFER, boundCache);
+    }
+
+    if (!r->mapped) {
+        _orionThrowWarning("(in oriCreateStreamBuffer()): Failed to persistently map the stream buffer's storage.");
+    }
+
+    // link to global linked list
+    r->next = _orion.streamBufferListHead;
+    _orion.streamBufferListHead = r;
+
+    return r;
+}
+
+/**
+ * @brief Destroy and free memory for the given stream buffer (and its underlying oriBuffer).
+ * 
+ * @param stream the stream buffer to free.
+ * 
+ * @ingroup buffers
+ */
+void oriFreeStreamBuffer(oriStreamBuffer *stream) {
+    _orionAssertVersion(440);
+
+    // unlink from global linked list
+    oriStreamBuffer **current = &_orion.streamBufferListHead;
+    while (*current != stream)
+        current = &(*current)->next;
+    *current = stream->next;
+
+    for (unsigned int i = 0; i < stream->regionCount; i++) {
+        if (stream->fences[i]) {
+            glDeleteSync(stream->fences[i]);
+        }
+    }
+    free(stream->fences);
+
+    if (stream->mapped) {
+        if (_orion.glVersion >= 450) {
+            glUnmapNamedBuffer(stream->buffer->handle);
+        } else {
+            unsigned int boundCache = oriCurrentBufferAt(GL_ARRAY_BUFFER);
+            oriBindBuffer(stream->buffer, GL_ARRAY_BUFFER);
+
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+
+            glBindBuffer(GL_ARRAY_BUFFER, boundCache);
+        }
+    }
+
+    oriFreeBuffer(stream->buffer);
+
+    free(stream);
+    stream = NULL;
+}
+
+/**
+ * @brief Return the oriBuffer that backs the given stream buffer.
+ * @details The returned buffer can be used like any other buffer, e.g. passed to oriSpecifyVertexData().
+ * It is owned by the stream buffer and must not be freed separately.
+ * 
+ * @param stream the stream buffer to inspect.
+ * 
+ * @ingroup buffers
+ */
+oriBuffer *oriGetStreamBufferBuffer(oriStreamBuffer *stream) {
+    return stream->buffer;
+}
+
+/**
+ * @brief Advance the stream buffer to its next region and return a pointer to write this frame's data into.
+ * @details If the GPU is still using the region (i.e. its fence has not yet been signalled) then this function
+ * will block until it is no longer in use.
+ * 
+ * @param stream the stream buffer to write into.
+ * @return a pointer to the start of the current region, which is @c regionSize bytes long.
+ * 
+ * @ingroup buffers
+ */
+void *oriStreamBufferBegin(oriStreamBuffer *stream) {
+    stream->currentRegion = (stream->currentRegion + 1) % stream->regionCount;
+
+    GLsync fence = stream->fences[stream->currentRegion];
+    if (fence) {
+        // poll once without flushing, then flush and wait in 1ms steps until the GPU is done with the region
+        GLenum status = glClientWaitSync(fence, 0, 0);
+        while (status == GL_TIMEOUT_EXPIRED) {
+            status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+        }
+
+        if (status == GL_WAIT_FAILED) {
+            _orionThrowWarning("(in oriStreamBufferBegin()): Failed to wait on a stream buffer region's fence.");
+        }
+
+        glDeleteSync(fence);
+        stream->fences[stream->currentRegion] = NULL;
+    }
+
+    return stream->mapped + stream->currentRegion * stream->regionSize;
+}
+
+/**
+ * @brief Return true if the GPU has finished with the next region of the given stream buffer, i.e. if the next call
+ * to oriStreamBufferBegin() won't block.
+ * 
+ * @param stream the stream buffer to poll.
+ * 
+ * @ingroup buffers
+ */
+bool oriStreamBufferReady(oriStreamBuffer *stream) {
+    GLsync fence = stream->fences[(stream->currentRegion + 1) % stream->regionCount];
+    if (!fence) {
+        return true;
+    }
+
+    // the fence may never signal if it hasn't been flushed (e.g. if nothing swaps buffers, as in a headless context)
+    GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+}
+
+/**
+ * @brief Place a fence on the current region of the given stream buffer.
+ * @details This should be called after every draw call that reads from the current region has been issued.
+ * 
+ * @param stream the stream buffer to fence.
+ * 
+ * @ingroup buffers
+ */
+void oriStreamBufferEnd(oriStreamBuffer *stream) {
+    // only the most recent fence matters if this is called more than once for the same region
+    if (stream->fences[stream->currentRegion]) {
+        glDeleteSync(stream->fences[stream->currentRegion]);
+    }
+    stream->fences[stream->currentRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+/**
+ * @brief Return the byte offset of the current region from the start of the stream buffer.
+ * @details Use this to offset vertex or index data (e.g. as the base vertex of a draw call) when reading from the current region.
+ * 
+ * @param stream the stream buffer to inspect.
+ * 
+ * @ingroup buffers
+ */
+unsigned int oriStreamBufferOffset(oriStreamBuffer *stream) {
+    return stream->currentRegion * stream->regionSize;
+}
@@ -0,0 +1,371 @@
+/* *************************************************************************************** */
+/*                        ORION GRAPHICS LIBRARY AND RENDERING ENGINE                      */
+/* *************************************************************************************** */
+/* Copyright (c) 2022 Jack Bennett                                                         */
+/* --------------------------------------------------------------------------------------- */
+/* THE  SOFTWARE IS  PROVIDED "AS IS",  WITHOUT WARRANTY OF ANY KIND, EXPRESS  OR IMPLIED, */
+/* INCLUDING  BUT  NOT  LIMITED  TO  THE  WARRANTIES  OF  MERCHANTABILITY,  FITNESS FOR  A */
+/* PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN  NO EVENT SHALL  THE  AUTHORS  OR COPYRIGHT */
+/* HOLDERS  BE  LIABLE  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF */
+/* CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR */
+/* THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                              */
+/* *************************************************************************************** */
+
+#include "internal.h"
+#include "oriongl.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// the number of flushes that a draw batch's indirect stream buffer can have in flight
+#define _ORI_DRAW_BATCH_REGIONS 3
+
+// ======================================================================================
+// *****                          ORION INTERNAL DATA TYPES                         *****
+// ======================================================================================
+
+/**
+ * @brief The layout of an indirect indexed draw command, as read by glMultiDrawElementsIndirect().
+ * 
+ */
+typedef struct _oriDrawElementsIndirectCommand {
+    unsigned int count;
+    unsigned int instanceCount;
+    unsigned int firstIndex;
+    int baseVertex;
+    unsigned int baseInstance;
+} _oriDrawElementsIndirectCommand;
+
+typedef struct _oriDrawBatchEntry {
+    oriShader *shader;
+    oriVertexArray *va;
+
+    // order in which the command was added, so that sorting keeps submission order within a group
+    unsigned int sequence;
+
+    _oriDrawElementsIndirectCommand command;
+} _oriDrawBatchEntry;
+
+// ======================================================================================
+// *****                            ORION PUBLIC STRUCTURES                         *****
+// ======================================================================================
+
+/**
+ * @brief A CPU-side list of indexed draw commands that are submitted together with glMultiDrawElementsIndirect().
+ * 
+ * @ingroup drawing
+ */
+typedef struct oriDrawBatch {
+    oriDrawBatch *next;
+
+    unsigned int mode;
+    unsigned int indexType;
+
+    _oriDrawBatchEntry *entries;
+    unsigned int entryCount;
+    unsigned int entryCapacity;
+
+    // commands in submission order, as uploaded to the indirect buffer
+    _oriDrawElementsIndirectCommand *commands;
+
+    // from OpenGL 4.4, the commands of each flush are written into the next region of a stream buffer (which is created
+    // when the batch is first flushed); before that, the indirect buffer is orphaned before each upload
+    oriStreamBuffer *indirectStream;
+    oriBuffer *indirectBuffer;
+    unsigned int indirectBufferSize;
+} oriDrawBatch;
+
+// ======================================================================================
+// *****                              HELPER FUNCTIONS                              *****
+// ======================================================================================
+
+/**
+ * @brief Check that a vertex array and a shader program are bound, sending a warning if not.
+ * 
+ * @param func the name of the calling function, used in warning messages.
+ * @return false if the draw call should be skipped.
+ */
+static bool _oriCheckDrawState(const char *func) {
+    // As string formatted is required here, printf is used instead of _orionThrowWarning.
+    // This is annoying and be sure to change the style of this message if the style in _orionThrowWarning changes.
+    if (!oriCurrentVertexArray()) {
+        printf("[Orion : WARN] >> (in %s): No vertex array is bound. Nothing was drawn.\n", func);
+        return false;
+    }
+    if (!oriCurrentShaderProgram()) {
+        printf("[Orion : WARN] >> (in %s): No shader is bound. Nothing was drawn.\n", func);
+        return false;
+    }
+
+    return true;
+}
+
+// sort draw commands by shader, then by vertex array, then by the order they were added
+static int _oriCompareDrawBatchEntries(const void *a, const void *b) {
+    const _oriDrawBatchEntry *ea = a;
+    const _oriDrawBatchEntry *eb = b;
+
+    if (ea->shader != eb->shader) {
+        return (uintptr_t) ea->shader < (uintptr_t) eb->shader ? -1 : 1;
+    }
+    if (ea->va != eb->va) {
+        return (uintptr_t) ea->va < (uintptr_t) eb->va ? -1 : 1;
+    }
+    return ea->sequence < eb->sequence ? -1 : (ea->sequence > eb->sequence);
+}
+
+// ======================================================================================
+// *****                           ORION DRAWING FUNCTIONS                          *****
+// ======================================================================================
+
+/**
+ * @brief Draw multiple instances of a range of vertices, using the currently-bound vertex array and shader.
+ * 
+ * @param mode the kind of primitives to render, e.g. @c GL_TRIANGLES.
+ * @param first the index of the first vertex to draw.
+ * @param count the number of vertices to draw per instance.
+ * @param instanceCount the number of instances to draw.
+ * 
+ * @sa <a href="https://docs.gl/gl4/glDrawArraysInstanced">glDrawArraysInstanced</a>
+ * 
+ * @ingroup drawing
+ */
+void oriDrawInstanced(const unsigned int mode, const unsigned int first, const unsigned int count, const unsigned int instanceCount) {
+    _orionAssertVersion(310);
+
+    if (!_oriCheckDrawState("oriDrawInstanced()")) {
+        return;
+    }
+
+    glDrawArraysInstanced(mode, first, count, instanceCount);
+}
+
+/**
+ * @brief Draw multiple instances of a set of indexed vertices, using the currently-bound vertex array, shader and index buffer.
+ * @details The index buffer is the one bound to @c GL_ELEMENT_ARRAY_BUFFER while the vertex array was bound.
+ * 
+ * @param mode the kind of primitives to render, e.g. @c GL_TRIANGLES.
+ * @param count the number of indices to draw per instance.
+ * @param type the type of the indices, e.g. @c GL_UNSIGNED_INT.
+ * @param offset the offset of the first index into the index buffer, in bytes.
+ * @param baseVertex a constant that is added to every index, e.g. the first vertex of a mesh sub-allocated from an oriBufferHeap.
+ * @param instanceCount the number of instances to draw.
+ * 
+ * @sa <a href="https://docs.gl/gl4/glDrawElementsInstancedBaseVertex">glDrawElementsInstancedBaseVertex</a>
+ * 
+ * @ingroup drawing
+ */
+void oriDrawElementsInstanced(const unsigned int mode, const unsigned int count, const unsigned int type, const unsigned int offset, const int baseVertex, const unsigned int instanceCount) {
+    _orionAssertVersion(310);
+
+    if (!_oriCheckDrawState("oriDrawElementsInstanced()")) {
+        return;
+    }
+    if (!oriCurrentBufferAt(GL_ELEMENT_ARRAY_BUFFER)) {
+        // otherwise, the offset would be read as a pointer to indices in client memory (in a compatibility profile)
+        _orionThrowWarning("(in oriDrawElementsInstanced()): The bound vertex array has no index buffer. Nothing was drawn.");
+        return;
+    }
+
+    // the offset is passed as a pointer for (very old) backwards-compatibility reasons.
+    const void *indices = (const void *) (uintptr_t) offset;
+
+    if (baseVertex) {
+        _orionAssertVersion(320);
+        glDrawElementsInstancedBaseVertex(mode, count, type, indices, instanceCount, baseVertex);
+    } else {
+        glDrawElementsInstanced(mode, count, type, indices, instanceCount);
+    }
+}
+
+// ======================================================================================
+// *****                          ORION DRAW BATCH FUNCTIONS                        *****
+// ======================================================================================
+
+/**
+ * @brief Allocate and initialise a new oriDrawBatch structure.
+ * @details A draw batch collects indexed draw commands on the CPU. When flushed, the commands are uploaded to an
+ * indirect buffer in one go, grouped by shader and vertex array, and each group is submitted with a single call to
+ * glMultiDrawElementsIndirect() - so thousands of draw calls become a handful of submissions.
+ * 
+ * @param mode the kind of primitives to render, e.g. @c GL_TRIANGLES.
+ * @param indexType the type of the indices in every index buffer drawn from, e.g. @c GL_UNSIGNED_INT.
+ * 
+ * @sa <a href="https://www.khronos.org/opengl/wiki/Vertex_Rendering#Indirect_rendering">OpenGL/Indirect rendering</a>
+ * 
+ * @ingroup drawing
+ */
+oriDrawBatch *oriCreateDrawBatch(const unsigned int mode, const unsigned int indexType) {
+    _orionAssertVersion(430);
+
+    oriDrawBatch *r = malloc(sizeof(oriDrawBatch));
+    r->mode = mode;
+    r->indexType = indexType;
+
+    r->entries = NULL;
+    r->entryCount = 0;
+    r->entryCapacity = 0;
+    r->commands = NULL;
+
+    r->indirectStream = NULL;
+    r->indirectBuffer = _orion.glVersion >= 440 ? NULL : oriCreateBuffer();
+    r->indirectBufferSize = 0;
+
+    // link to global linked list
+    r->next = _orion.drawBatchListHead;
+    _orion.drawBatchListHead = r;
+
+    return r;
+}
+
+/**
+ * @brief Destroy and free memory for the given draw batch (and its indirect buffer).
+ * 
+ * @param batch the draw batch to free.
+ * 
+ * @ingroup drawing
+ */
+void oriFreeDrawBatch(oriDrawBatch *batch) {
+    // unlink from global linked list
+    oriDrawBatch **current = &_orion.drawBatchListHead;
+    while (*current != batch)
+        current = &(*current)->next;
+    *current = batch->next;
+
+    if (batch->indirectStream) {
+        oriFreeStreamBuffer(batch->indirectStream);
+    }
+    if (batch->indirectBuffer) {
+        oriFreeBuffer(batch->indirectBuffer);
+    }
+
+    free(batch->entries);
+    free(batch->commands);
+    free(batch);
+    batch = NULL;
+}
+
+/**
+ * @brief Add an indexed draw command to the given batch.
+ * @details Nothing is drawn until oriFlushDrawBatch() is called. The vertex array must have its index buffer attached
+ * (i.e. bound to @c GL_ELEMENT_ARRAY_BUFFER while the vertex array was bound).
+ * 
+ * @param batch the batch to add the command to.
+ * @param shader the shader to draw with.
+ * @param va the vertex array to draw from.
+ * @param count the number of indices to draw per instance.
+ * @param instanceCount the number of instances to draw.
+ * @param firstIndex the index of the first index to draw, in the vertex array's index buffer.
+ * @param baseVertex a constant that is added to every index.
+ * @param baseInstance the first instance to draw; this offsets the instance index used to fetch instanced attributes.
+ * 
+ * @ingroup drawing
+ */
+void oriDrawBatchAdd(oriDrawBatch *batch, oriShader *shader, oriVertexArray *va, const unsigned int count, const unsigned int instanceCount, const unsigned int firstIndex, const int baseVertex, const unsigned int baseInstance) {
+    if (!shader || !va) {
+        _orionThrowWarning("(in oriDrawBatchAdd()): A shader and vertex array must be given. Draw command not added.");
+        return;
+    }
+
+    // grow the command list geometrically
+    if (batch->entryCount == batch->entryCapacity) {
+        batch->entryCapacity = batch->entryCapacity ? batch->entryCapacity * 2 : 64;
+        batch->entries = realloc(batch->entries, batch->entryCapacity * sizeof(_oriDrawBatchEntry));
+        batch->commands = realloc(batch->commands, batch->entryCapacity * sizeof(_oriDrawElementsIndirectCommand));
+    }
+
+    _oriDrawBatchEntry *entry = &batch->entries[batch->entryCount];
+    entry->shader = shader;
+    entry->va = va;
+    entry->sequence = batch->entryCount;
+
+    entry->command.count = count;
+    entry->command.instanceCount = instanceCount;
+    entry->command.firstIndex = firstIndex;
+    entry->command.baseVertex = baseVertex;
+    entry->command.baseInstance = baseInstance;
+
+    batch->entryCount++;
+}
+
+/**
+ * @brief Submit every draw command in the given batch, then clear it.
+ * @details The commands are uploaded to the batch's indirect buffer, which is bound to @c GL_DRAW_INDIRECT_BUFFER.
+ * From OpenGL 4.4 the buffer is a stream buffer (see oriStreamBuffer) with a region for each of the last three flushes,
+ * so the commands are written while the GPU may still be reading those of earlier flushes, without the driver having to
+ * synchronise or copy. Before that, the buffer is orphaned before each upload.
+ * 
+ * Commands are grouped by shader and vertex array, and each group is drawn with one call to glMultiDrawElementsIndirect().
+ * The last group's shader and vertex array are left bound.
+ * 
+ * @param batch the batch to submit.
+ * 
+ * @ingroup drawing
+ */
+void oriFlushDrawBatch(oriDrawBatch *batch) {
+    _orionAssertVersion(430);
+
+    if (!batch->entryCount) {
+        return;
+    }
+
+    qsort(batch->entries, batch->entryCount, sizeof(_oriDrawBatchEntry), _oriCompareDrawBatchEntries);
+
+    for (unsigned int i = 0; i < batch->entryCount; i++) {
+        batch->commands[i] = batch->entries[i].command;
+    }
+
+    // upload all of the commands at once, only reallocating the indirect buffer when it needs to grow
+    unsigned int size = batch->entryCount * sizeof(_oriDrawElementsIndirectCommand);
+    bool grow = size > batch->indirectBufferSize;
+    if (grow) {
+        batch->indirectBufferSize = batch->entryCapacity * sizeof(_oriDrawElementsIndirectCommand);
+    }
+
+    unsigned int base = 0;
+    if (_orion.glVersion >= 440) {
+        if (grow) {
+            // (the old buffer's storage is kept alive by the driver until the GPU has finished reading it)
+            if (batch->indirectStream) {
+                oriFreeStreamBuffer(batch->indirectStream);
+            }
+            batch->indirectStream = oriCreateStreamBuffer(batch->indirectBufferSize, _ORI_DRAW_BATCH_REGIONS);
+        }
+
+        // this only waits if the region's commands from three flushes ago are still being read
+        memcpy(oriStreamBufferBegin(batch->indirectStream), batch->commands, size);
+        base = oriStreamBufferOffset(batch->indirectStream);
+
+        oriBindBuffer(oriGetStreamBufferBuffer(batch->indirectStream), GL_DRAW_INDIRECT_BUFFER);
+    } else {
+        // orphan the storage, so that the last flush's commands can still be read while these are written
+        oriSetBufferData(batch->indirectBuffer, NULL, batch->indirectBufferSize, GL_STREAM_DRAW);
+        oriSetBufferSubData(batch->indirectBuffer, 0, batch->commands, size);
+
+        oriBindBuffer(batch->indirectBuffer, GL_DRAW_INDIRECT_BUFFER);
+    }
+
+    // one multi-draw per (shader, vertex array) group
+    unsigned int first = 0;
+    while (first < batch->entryCount) {
+        unsigned int last = first + 1;
+        while (last < batch->entryCount && batch->entries[last].shader == batch->entries[first].shader && batch->entries[last].va == batch->entries[first].va) {
+            last++;
+        }
+
+        oriBindShader(batch->entries[first].shader);
+        oriBindVertexArray(batch->entries[first].va);
+
+        glMultiDrawElementsIndirect(batch->mode, batch->indexType, (const void *) (uintptr_t) (base + first * sizeof(_oriDrawElementsIndirectCommand)), last - first, 0);
+
+        first = last;
+    }
+
+    if (batch->indirectStream) {
+        oriStreamBufferEnd(batch->indirectStream);
+    }
+
+    batch->entryCount = 0;
+}
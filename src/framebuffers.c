@@ -0,0 +1,694 @@
+/* *************************************************************************************** */
+/*                        ORION GRAPHICS LIBRARY AND RENDERING ENGINE                      */
+/* *************************************************************************************** */
+/* Copyright (c) 2022 Jack Bennett                                                         */
+/* --------------------------------------------------------------------------------------- */
+/* THE  SOFTWARE IS  PROVIDED "AS IS",  WITHOUT WARRANTY OF ANY KIND, EXPRESS  OR IMPLIED, */
+/* INCLUDING  BUT  NOT  LIMITED  TO  THE  WARRANTIES  OF  MERCHANTABILITY,  FITNESS FOR  A */
+/* PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN  NO EVENT SHALL  THE  AUTHORS  OR COPYRIGHT */
+/* HOLDERS  BE  LIABLE  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF */
+/* CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR */
+/* THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                              */
+/* *************************************************************************************** */
+
+#include "internal.h"
+#include "oriongl.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// the number of colour attachments a framebuffer can have
+#define _ORI_FRAMEBUFFER_COLOR_ATTACHMENTS 8
+
+// attachment slots: the colour attachments, then depth, stencil and depth-stencil
+#define _ORI_FRAMEBUFFER_SLOTS (_ORI_FRAMEBUFFER_COLOR_ATTACHMENTS + 3)
+#define _ORI_DEPTH_SLOT (_ORI_FRAMEBUFFER_COLOR_ATTACHMENTS)
+#define _ORI_STENCIL_SLOT (_ORI_FRAMEBUFFER_COLOR_ATTACHMENTS + 1)
+#define _ORI_DEPTH_STENCIL_SLOT (_ORI_FRAMEBUFFER_COLOR_ATTACHMENTS + 2)
+
+// ======================================================================================
+// *****                          ORION INTERNAL DATA TYPES                         *****
+// ======================================================================================
+
+/**
+ * @brief The image attached to one attachment point of a framebuffer.
+ * 
+ */
+typedef struct _oriFramebufferAttachment {
+    // the attached texture, or 0 if a renderbuffer (or nothing) is attached.
+    // textures are told apart by their serial, as OpenGL reuses the names of deleted textures
+    unsigned int texture;
+    unsigned long textureSerial;
+    unsigned int level;
+    int layer;
+
+    // a renderbuffer created by (and owned by) the framebuffer, or 0
+    unsigned int renderbuffer;
+} _oriFramebufferAttachment;
+
+/**
+ * @brief A texture of a render target pool, and when it was last used.
+ * 
+ */
+typedef struct _oriRenderTarget {
+    struct _oriRenderTarget *next;
+
+    oriTexture *texture;
+    unsigned int width;
+    unsigned int height;
+    unsigned int internalFormat;
+    unsigned int samples;
+
+    bool inUse;
+    unsigned long lastUsedFrame;
+} _oriRenderTarget;
+
+// ======================================================================================
+// *****                            ORION PUBLIC STRUCTURES                         *****
+// ======================================================================================
+
+/**
+ * @brief An OpenGL framebuffer object, and the images attached to it.
+ * 
+ * @ingroup framebuffers
+ */
+typedef struct oriFramebuffer {
+    oriFramebuffer *next;
+
+    unsigned int handle;
+
+    _oriFramebufferAttachment attachments[_ORI_FRAMEBUFFER_SLOTS];
+
+    // the size of the most recently attached image
+    unsigned int width;
+    unsigned int height;
+
+    // the result of the last completeness check; 0 if the attachments have changed since, and it has to be checked again
+    unsigned int status;
+} oriFramebuffer;
+
+/**
+ * @brief A collection of textures that are rendered to, which are reused by passes that need the same kind of target.
+ * 
+ * @ingroup framebuffers
+ */
+typedef struct oriRenderTargetPool {
+    oriRenderTargetPool *next;
+
+    unsigned int maxIdleFrames;
+    unsigned long frame;
+    unsigned int created;
+
+    _oriRenderTarget *targetListHead;
+} oriRenderTargetPool;
+
+// ======================================================================================
+// *****                           ORION HELPER FUNCTIONS                           *****
+// ======================================================================================
+
+/**
+ * @brief Return the attachment slot of the given attachment point, or -1 if it is not valid.
+ * 
+ */
+static int _oriAttachmentSlot(const unsigned int attachment) {
+    if (attachment >= GL_COLOR_ATTACHMENT0 && attachment < GL_COLOR_ATTACHMENT0 + _ORI_FRAMEBUFFER_COLOR_ATTACHMENTS) {
+        return attachment - GL_COLOR_ATTACHMENT0;
+    }
+
+    switch (attachment) {
+        case GL_DEPTH_ATTACHMENT:
+            return _ORI_DEPTH_SLOT;
+        case GL_STENCIL_ATTACHMENT:
+            return _ORI_STENCIL_SLOT;
+        case GL_DEPTH_STENCIL_ATTACHMENT:
+            return _ORI_DEPTH_STENCIL_SLOT;
+        default:
+            return -1;
+    }
+}
+
+/**
+ * @brief Return the attachment point of the given attachment slot.
+ * 
+ */
+static unsigned int _oriSlotAttachment(const int slot) {
+    switch (slot) {
+        case _ORI_DEPTH_SLOT:
+            return GL_DEPTH_ATTACHMENT;
+        case _ORI_STENCIL_SLOT:
+            return GL_STENCIL_ATTACHMENT;
+        case _ORI_DEPTH_STENCIL_SLOT:
+            return GL_DEPTH_STENCIL_ATTACHMENT;
+        default:
+            return GL_COLOR_ATTACHMENT0 + slot;
+    }
+}
+
+/**
+ * @brief Attach a level of the texture with the given handle (or 0, to detach the image) to the given attachment point.
+ * 
+ */
+static void _oriAttachTexture(oriFramebuffer *framebuffer, const unsigned int attachment, const unsigned int handle, const unsigned int level, const int layer) {
+    if (_orion.glVersion >= 450) {
+        if (layer < 0) {
+            glNamedFramebufferTexture(framebuffer->handle, attachment, handle, level);
+        } else {
+            glNamedFramebufferTextureLayer(framebuffer->handle, attachment, handle, level, layer);
+        }
+    } else {
+        unsigned int boundCache = oriCurrentFramebufferAt(GL_DRAW_FRAMEBUFFER);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer->handle);
+
+        if (layer < 0) {
+            glFramebufferTexture(GL_DRAW_FRAMEBUFFER, attachment, handle, level);
+        } else {
+            glFramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, attachment, handle, level, layer);
+        }
+
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, boundCache);
+    }
+}
+
+/**
+ * @brief Forget the image attached to the given slot (deleting it if it is a renderbuffer owned by the framebuffer).
+ * 
+ */
+static void _oriClearAttachment(oriFramebuffer *framebuffer, const int slot) {
+    _oriFramebufferAttachment *a = &framebuffer->attachments[slot];
+
+    if (a->renderbuffer) {
+        glDeleteRenderbuffers(1, &a->renderbuffer);
+    }
+    memset(a, 0, sizeof(_oriFramebufferAttachment));
+
+    // a depth-stencil attachment replaces both the depth and stencil attachments
+    if (slot == _ORI_DEPTH_STENCIL_SLOT) {
+        _oriClearAttachment(framebuffer, _ORI_DEPTH_SLOT);
+        _oriClearAttachment(framebuffer, _ORI_STENCIL_SLOT);
+    }
+
+    framebuffer->status = 0;
+}
+
+/**
+ * @brief Forget the image attached to the given slot before a new one is attached to it, along with the images it overlaps.
+ * @details A depth-stencil image attached to @c GL_DEPTH_STENCIL_ATTACHMENT is attached to both the depth and stencil
+ * points, so a new depth (or stencil) image only replaces half of it: the other half is recorded in (and owned by) the slot
+ * of the point it is still attached to.
+ * 
+ */
+static void _oriReplaceAttachment(oriFramebuffer *framebuffer, const int slot) {
+    _oriFramebufferAttachment *depthStencil = &framebuffer->attachments[_ORI_DEPTH_STENCIL_SLOT];
+
+    if ((slot == _ORI_DEPTH_SLOT || slot == _ORI_STENCIL_SLOT) && (depthStencil->textureSerial || depthStencil->renderbuffer)) {
+        int other = slot == _ORI_DEPTH_SLOT ? _ORI_STENCIL_SLOT : _ORI_DEPTH_SLOT;
+        framebuffer->attachments[other] = *depthStencil;
+        memset(depthStencil, 0, sizeof(_oriFramebufferAttachment));
+    }
+
+    _oriClearAttachment(framebuffer, slot);
+}
+
+/**
+ * @brief If the attachments of the given framebuffer have changed, set its draw and read buffers to its colour
+ * attachments, and check (and store) its completeness.
+ * @details Below OpenGL 4.5 the framebuffer must be bound to @c GL_DRAW_FRAMEBUFFER and @c GL_READ_FRAMEBUFFER.
+ * 
+ */
+static void _oriValidateFramebuffer(const char *func, oriFramebuffer *framebuffer) {
+    if (framebuffer->status) {
+        return;
+    }
+
+    // draw into every colour attachment, at the location of its index
+    unsigned int drawBuffers[_ORI_FRAMEBUFFER_COLOR_ATTACHMENTS];
+    unsigned int drawBufferCount = 0, readBuffer = GL_NONE;
+    for (unsigned int i = 0; i < _ORI_FRAMEBUFFER_COLOR_ATTACHMENTS; i++) {
+        _oriFramebufferAttachment *a = &framebuffer->attachments[i];
+        if (a->texture || a->renderbuffer) {
+            drawBuffers[i] = GL_COLOR_ATTACHMENT0 + i;
+            drawBufferCount = i + 1;
+            if (readBuffer == GL_NONE) {
+                readBuffer = GL_COLOR_ATTACHMENT0 + i;
+            }
+        } else {
+            drawBuffers[i] = GL_NONE;
+        }
+    }
+
+    if (_orion.glVersion >= 450) {
+        if (drawBufferCount) {
+            glNamedFramebufferDrawBuffers(framebuffer->handle, drawBufferCount, drawBuffers);
+        } else {
+            glNamedFramebufferDrawBuffer(framebuffer->handle, GL_NONE);
+        }
+        glNamedFramebufferReadBuffer(framebuffer->handle, readBuffer);
+
+        framebuffer->status = glCheckNamedFramebufferStatus(framebuffer->handle, GL_DRAW_FRAMEBUFFER);
+    } else {
+        if (drawBufferCount) {
+            glDrawBuffers(drawBufferCount, drawBuffers);
+        } else {
+            glDrawBuffer(GL_NONE);
+        }
+        glReadBuffer(readBuffer);
+
+        framebuffer->status = glCheckFramebufferStatus(GL_DRAW_FRAMEBUFFER);
+    }
+
+    if (framebuffer->status != GL_FRAMEBUFFER_COMPLETE) {
+        // As string formatted is required here, printf is used instead of _orionThrowWarning.
+        // This is annoying and be sure to change the style of this message if the style in _orionThrowWarning changes.
+        printf("[Orion : WARN] >> (in %s): Framebuffer %u is incomplete (status 0x%x).\n", func, framebuffer->handle, framebuffer->status);
+    }
+}
+
+// ======================================================================================
+// *****                    ORION INTERNAL FRAMEBUFFER FUNCTIONS                    *****
+// ======================================================================================
+
+/**
+ * @brief Detach the texture with the given serial from every framebuffer it is attached to. Called by oriFreeTexture().
+ * 
+ */
+void _orionDetachFramebufferTexture(const unsigned long serial) {
+    for (oriFramebuffer *framebuffer = _orion.framebufferListHead; framebuffer; framebuffer = framebuffer->next) {
+        for (int i = 0; i < _ORI_FRAMEBUFFER_SLOTS; i++) {
+            _oriFramebufferAttachment *a = &framebuffer->attachments[i];
+            if (a->textureSerial != serial) {
+                continue;
+            }
+
+            // the framebuffer has to be checked again before it is next used
+            _oriAttachTexture(framebuffer, _oriSlotAttachment(i), 0, 0, -1);
+            _oriClearAttachment(framebuffer, i);
+        }
+    }
+}
+
+// ======================================================================================
+// *****                        ORION FRAMEBUFFER FUNCTIONS                         *****
+// ======================================================================================
+
+/**
+ * @brief Allocate and initialise a new oriFramebuffer structure, with no attachments.
+ * @details Attach images to it with oriFramebufferTexture() and oriFramebufferRenderbuffer(). Its draw buffers are set to
+ * its colour attachments (e.g. @c GL_COLOR_ATTACHMENT1 is drawn into by fragment shader output location 1).
+ * 
+ * @ingroup framebuffers
+ */
+oriFramebuffer *oriCreateFramebuffer() {
+    _orionAssertVersion(320);
+
+    oriFramebuffer *r = malloc(sizeof(oriFramebuffer));
+    memset(r, 0, sizeof(oriFramebuffer));
+
+    if (_orion.glVersion >= 450) {
+        glCreateFramebuffers(1, &r->handle);
+    } else {
+        glGenFramebuffers(1, &r->handle);
+    }
+
+    // link to global linked list
+    r->next = _orion.framebufferListHead;
+    _orion.framebufferListHead = r;
+
+    return r;
+}
+
+/**
+ * @brief Destroy and free memory for the given framebuffer, including the renderbuffers it created.
+ * @details Attached textures are not freed.
+ * 
+ * @param framebuffer the framebuffer to free.
+ * 
+ * @ingroup framebuffers
+ */
+void oriFreeFramebuffer(oriFramebuffer *framebuffer) {
+    // unlink from global linked list
+    oriFramebuffer **current = &_orion.framebufferListHead;
+    while (*current != framebuffer)
+        current = &(*current)->next;
+    *current = framebuffer->next;
+
+    for (int i = 0; i < _ORI_FRAMEBUFFER_SLOTS; i++) {
+        if (framebuffer->attachments[i].renderbuffer) {
+            glDeleteRenderbuffers(1, &framebuffer->attachments[i].renderbuffer);
+        }
+    }
+
+    glDeleteFramebuffers(1, &framebuffer->handle);
+
+    free(framebuffer);
+    framebuffer = NULL;
+}
+
+/**
+ * @brief Attach a level of a texture to the given framebuffer.
+ * @details Nothing is done if the same image is already attached, so a pass can attach its targets every frame (e.g.
+ * targets from an oriRenderTargetPool) without the framebuffer being checked for completeness again.
+ * 
+ * @param framebuffer the framebuffer to update.
+ * @param attachment the attachment point, e.g. @c GL_COLOR_ATTACHMENT0 or @c GL_DEPTH_ATTACHMENT.
+ * @param texture the texture to attach, or NULL to detach the image at @c attachment.
+ * @param level the mipmap level of the texture to attach.
+ * @param layer the layer (or cube map face) to attach, for array, cube map and 3D textures; or -1 to attach every layer
+ * (for layered rendering).
+ * 
+ * @ingroup framebuffers
+ */
+void oriFramebufferTexture(oriFramebuffer *framebuffer, unsigned int attachment, oriTexture *texture, unsigned int level, int layer) {
+    int slot = _oriAttachmentSlot(attachment);
+    if (slot < 0) {
+        _orionThrowWarning("(in oriFramebufferTexture()): Invalid attachment specified. Nothing was attached.");
+        return;
+    }
+
+    unsigned int handle = texture ? oriGetTextureHandle(texture) : 0;
+    unsigned long serial = texture ? _orionGetTextureSerial(texture) : 0;
+    _oriFramebufferAttachment *a = &framebuffer->attachments[slot];
+    if (a->textureSerial == serial && a->level == level && a->layer == layer && !a->renderbuffer) {
+        return;
+    }
+
+    _oriReplaceAttachment(framebuffer, slot);
+    _oriAttachTexture(framebuffer, attachment, handle, level, layer);
+
+    a->texture = handle;
+    a->textureSerial = serial;
+    a->level = level;
+    a->layer = layer;
+
+    if (texture) {
+        unsigned int width, height;
+        oriGetTextureProperty(texture, NULL, &width, &height, NULL, NULL, NULL, NULL);
+        framebuffer->width = width >> level ? width >> level : 1;
+        framebuffer->height = height >> level ? height >> level : 1;
+    }
+}
+
+/**
+ * @brief Create a renderbuffer and attach it to the given framebuffer.
+ * @details Renderbuffers can't be sampled, so they suit attachments that are only used while rendering (e.g. the depth
+ * buffer of a pass whose depth is not read afterwards). The renderbuffer is owned by the framebuffer, and is deleted when
+ * it is replaced or when the framebuffer is freed.
+ * 
+ * @param framebuffer the framebuffer to update.
+ * @param attachment the attachment point, e.g. @c GL_DEPTH_STENCIL_ATTACHMENT.
+ * @param internalFormat the internal format of the renderbuffer, e.g. @c GL_DEPTH24_STENCIL8.
+ * @param width the width of the renderbuffer.
+ * @param height the height of the renderbuffer.
+ * @param samples the number of samples in the renderbuffer; 0 if it is not multisampled.
+ * 
+ * @ingroup framebuffers
+ */
+void oriFramebufferRenderbuffer(oriFramebuffer *framebuffer, unsigned int attachment, unsigned int internalFormat, unsigned int width, unsigned int height, unsigned int samples) {
+    int slot = _oriAttachmentSlot(attachment);
+    if (slot < 0) {
+        _orionThrowWarning("(in oriFramebufferRenderbuffer()): Invalid attachment specified. Nothing was attached.");
+        return;
+    }
+
+    _oriReplaceAttachment(framebuffer, slot);
+    _oriFramebufferAttachment *a = &framebuffer->attachments[slot];
+
+    if (_orion.glVersion >= 450) {
+        glCreateRenderbuffers(1, &a->renderbuffer);
+        glNamedRenderbufferStorageMultisample(a->renderbuffer, samples, internalFormat, width, height);
+
+        glNamedFramebufferRenderbuffer(framebuffer->handle, attachment, GL_RENDERBUFFER, a->renderbuffer);
+    } else {
+        // (renderbuffer bindings are not tracked, so the binding is reset to 0 afterwards)
+        glGenRenderbuffers(1, &a->renderbuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, a->renderbuffer);
+        glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, internalFormat, width, height);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+        unsigned int boundCache = oriCurrentFramebufferAt(GL_DRAW_FRAMEBUFFER);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer->handle);
+
+        glFramebufferRenderbuffer(GL_DRAW_FRAMEBUFFER, attachment, GL_RENDERBUFFER, a->renderbuffer);
+
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, boundCache);
+    }
+
+    framebuffer->width = width;
+    framebuffer->height = height;
+}
+
+/**
+ * @brief Bind the given framebuffer for drawing and reading.
+ * @details If its attachments have changed since it was last bound, its draw buffers are updated and its completeness is
+ * checked (and a warning is given if it is incomplete). Otherwise the stored result is used, and nothing is queried.
+ * The bind is skipped if the framebuffer is already bound.
+ * 
+ * @param framebuffer the framebuffer to bind, or NULL to bind the default framebuffer (the window).
+ * 
+ * @ingroup framebuffers
+ */
+void oriBindFramebuffer(oriFramebuffer *framebuffer) {
+    _orionAssertVersion(300);
+
+    unsigned int handle = framebuffer ? framebuffer->handle : 0;
+    if (oriCurrentFramebufferAt(GL_DRAW_FRAMEBUFFER) != handle || oriCurrentFramebufferAt(GL_READ_FRAMEBUFFER) != handle) {
+        glBindFramebuffer(GL_FRAMEBUFFER, handle);
+    }
+
+    if (framebuffer) {
+        _oriValidateFramebuffer("oriBindFramebuffer()", framebuffer);
+    }
+}
+
+/**
+ * @brief Return the completeness of the given framebuffer; @c GL_FRAMEBUFFER_COMPLETE if it can be rendered to.
+ * @details The result of the last check is returned, unless the attachments have changed since.
+ * 
+ * @param framebuffer the framebuffer to inspect.
+ * 
+ * @ingroup framebuffers
+ */
+unsigned int oriGetFramebufferStatus(oriFramebuffer *framebuffer) {
+    if (!framebuffer->status) {
+        if (_orion.glVersion >= 450) {
+            _oriValidateFramebuffer("oriGetFramebufferStatus()", framebuffer);
+        } else {
+            unsigned int drawCache = oriCurrentFramebufferAt(GL_DRAW_FRAMEBUFFER);
+            unsigned int readCache = oriCurrentFramebufferAt(GL_READ_FRAMEBUFFER);
+            glBindFramebuffer(GL_FRAMEBUFFER, framebuffer->handle);
+
+            _oriValidateFramebuffer("oriGetFramebufferStatus()", framebuffer);
+
+            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, drawCache);
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, readCache);
+        }
+    }
+
+    return framebuffer->status;
+}
+
+/**
+ * @brief Return the size of the image that was most recently attached to the given framebuffer into the specified variables.
+ * 
+ * @details If you don't want to recieve a value, pass NULL as the argument.
+ * 
+ * @param framebuffer the framebuffer to inspect.
+ * @param width the width of the image.
+ * @param height the height of the image.
+ * 
+ * @ingroup framebuffers
+ */
+void oriGetFramebufferAttachmentSize(oriFramebuffer *framebuffer, unsigned int *width, unsigned int *height) {
+    if (width) *width = framebuffer->width;
+    if (height) *height = framebuffer->height;
+}
+
+/**
+ * @brief Return the OpenGL handle of the given framebuffer.
+ * 
+ * @param framebuffer the framebuffer to inspect.
+ * 
+ * @ingroup framebuffers
+ */
+unsigned int oriGetFramebufferHandle(oriFramebuffer *framebuffer) {
+    return framebuffer->handle;
+}
+
+// ======================================================================================
+// *****                     ORION RENDER TARGET POOL FUNCTIONS                     *****
+// ======================================================================================
+
+/**
+ * @brief Allocate and initialise a new oriRenderTargetPool structure.
+ * @details A render target pool keeps the textures that render passes draw into, so that they are not reallocated when
+ * a pass is toggled on or the window is resized back. A pass acquires its targets with oriAcquireRenderTarget() and
+ * releases them once the passes that read them are done, so that later passes in the same frame can reuse them.
+ * Call oriRenderTargetPoolNextFrame() once per frame; targets that have not been used for @c maxIdleFrames frames
+ * (e.g. ones of the old window size after a resize) are then freed.
+ * 
+ * @param maxIdleFrames the number of frames a target is kept for without being acquired.
+ * 
+ * @ingroup framebuffers
+ */
+oriRenderTargetPool *oriCreateRenderTargetPool(unsigned int maxIdleFrames) {
+    _orionAssertVersion(420);
+
+    oriRenderTargetPool *r = malloc(sizeof(oriRenderTargetPool));
+    r->maxIdleFrames = maxIdleFrames;
+    r->frame = 0;
+    r->created = 0;
+    r->targetListHead = NULL;
+
+    // link to global linked list
+    r->next = _orion.renderTargetPoolListHead;
+    _orion.renderTargetPoolListHead = r;
+
+    return r;
+}
+
+/**
+ * @brief Destroy and free memory for the given render target pool, including all of its textures.
+ * 
+ * @param pool the render target pool to free.
+ * 
+ * @ingroup framebuffers
+ */
+void oriFreeRenderTargetPool(oriRenderTargetPool *pool) {
+    // unlink from global linked list
+    oriRenderTargetPool **current = &_orion.renderTargetPoolListHead;
+    while (*current != pool)
+        current = &(*current)->next;
+    *current = pool->next;
+
+    while (pool->targetListHead) {
+        _oriRenderTarget *target = pool->targetListHead;
+        pool->targetListHead = target->next;
+
+        oriFreeTexture(target->texture);
+        free(target);
+    }
+
+    free(pool);
+    pool = NULL;
+}
+
+/**
+ * @brief Return a texture from the given pool to render into, creating one if none of the same kind is free.
+ * @details The texture is a @c GL_TEXTURE_2D with one mipmap level (or a @c GL_TEXTURE_2D_MULTISAMPLE, if @c samples
+ * is not 0), filtered linearly and clamped to its edges. Its contents are undefined: they may be those of a previous pass.
+ * 
+ * @param pool the render target pool to acquire from.
+ * @param width the width of the target.
+ * @param height the height of the target.
+ * @param internalFormat the internal format of the target, e.g. @c GL_RGBA16F or @c GL_DEPTH_COMPONENT32F.
+ * @param samples the number of samples in the target; 0 if it is not multisampled.
+ * 
+ * @ingroup framebuffers
+ */
+oriTexture *oriAcquireRenderTarget(oriRenderTargetPool *pool, unsigned int width, unsigned int height, unsigned int internalFormat, unsigned int samples) {
+    // the oldest matching target is taken, so that passes get the same targets every frame (and their framebuffers don't change)
+    _oriRenderTarget **current = &pool->targetListHead;
+    while (*current && ((*current)->inUse || (*current)->width != width || (*current)->height != height || (*current)->internalFormat != internalFormat || (*current)->samples != samples))
+        current = &(*current)->next;
+    _oriRenderTarget *target = *current;
+
+    if (!target) {
+        target = malloc(sizeof(_oriRenderTarget));
+        target->width = width;
+        target->height = height;
+        target->internalFormat = internalFormat;
+        target->samples = samples;
+
+        if (samples) {
+            target->texture = oriCreateTextureImmutable(GL_TEXTURE_2D_MULTISAMPLE, width, height, 0, internalFormat, 1, samples, true);
+        } else {
+            target->texture = oriCreateTextureImmutable(GL_TEXTURE_2D, width, height, 0, internalFormat, 1, 0, false);
+            oriSetTextureParameteri(target->texture, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            oriSetTextureParameteri(target->texture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            oriSetTextureParameteri(target->texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            oriSetTextureParameteri(target->texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        }
+
+        // (current is the end of the list)
+        target->next = NULL;
+        *current = target;
+        pool->created++;
+    }
+
+    target->inUse = true;
+    target->lastUsedFrame = pool->frame;
+
+    return target->texture;
+}
+
+/**
+ * @brief Give a texture acquired with oriAcquireRenderTarget() back to the given pool, so that it can be reused.
+ * 
+ * @param pool the render target pool that the texture was acquired from.
+ * @param texture the texture to release.
+ * 
+ * @ingroup framebuffers
+ */
+void oriReleaseRenderTarget(oriRenderTargetPool *pool, oriTexture *texture) {
+    _oriRenderTarget *target = pool->targetListHead;
+    while (target && target->texture != texture)
+        target = target->next;
+
+    if (!target || !target->inUse) {
+        _orionThrowWarning("(in oriReleaseRenderTarget()): The texture was not acquired from this pool, or has already been released.");
+        return;
+    }
+
+    target->inUse = false;
+}
+
+/**
+ * @brief Start a new frame for the given render target pool, freeing the targets that have not been acquired for more
+ * than the pool's number of idle frames.
+ * @details Targets that are still acquired are never freed.
+ * 
+ * @param pool the render target pool to update.
+ * 
+ * @ingroup framebuffers
+ */
+void oriRenderTargetPoolNextFrame(oriRenderTargetPool *pool) {
+    pool->frame++;
+
+    _oriRenderTarget **current = &pool->targetListHead;
+    while (*current) {
+        _oriRenderTarget *target = *current;
+
+        if (!target->inUse && pool->frame - target->lastUsedFrame > pool->maxIdleFrames) {
+            *current = target->next;
+
+            oriFreeTexture(target->texture);
+            free(target);
+        } else {
+            current = &target->next;
+        }
+    }
+}
+
+/**
+ * @brief Return statistics about the given render target pool into the specified variables.
+ * 
+ * @details If you don't want to recieve a statistic, pass NULL as the argument.
+ * 
+ * @param pool the render target pool to inspect.
+ * @param targets the number of textures currently kept by the pool.
+ * @param inUse the number of those textures that are currently acquired.
+ * @param created the number of textures that the pool has created since it was created.
+ * 
+ * @ingroup framebuffers
+ */
+void oriGetRenderTargetPoolStats(oriRenderTargetPool *pool, unsigned int *targets, unsigned int *inUse, unsigned int *created) {
+    unsigned int targetCount = 0, inUseCount = 0;
+    for (_oriRenderTarget *target = pool->targetListHead; target; target = target->next) {
+        targetCount++;
+        inUseCount += target->inUse;
+    }
+
+    if (targets) *targets = targetCount;
+    if (inUse) *inUse = inUseCount;
+    if (created) *created = pool->created;
+}
@@ -0,0 +1,534 @@
+/* *************************************************************************************** */
+/*                        ORION GRAPHICS LIBRARY AND RENDERING ENGINE                      */
+/* *************************************************************************************** */
+/* Copyright (c) 2022 Jack Bennett                                                         */
+/* --------------------------------------------------------------------------------------- */
+/* THE  SOFTWARE IS  PROVIDED "AS IS",  WITHOUT WARRANTY OF ANY KIND, EXPRESS  OR IMPLIED, */
+/* INCLUDING  BUT  NOT  LIMITED  TO  THE  WARRANTIES  OF  MERCHANTABILITY,  FITNESS FOR  A */
+/* PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN  NO EVENT SHALL  THE  AUTHORS  OR COPYRIGHT */
+/* HOLDERS  BE  LIABLE  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF */
+/* CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR */
+/* THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                              */
+/* *************************************************************************************** */
+
+// for dlopen() and RTLD_DEFAULT
+#define _GNU_SOURCE
+
+#include "internal.h"
+#include "oriongl.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __unix__
+#   include <dlfcn.h>
+#endif
+
+// ======================================================================================
+// *****                         EGL AND OSMESA DECLARATIONS                        *****
+// ======================================================================================
+
+// EGL and OSMesa are loaded at runtime, so that Orion doesn't link against (or need the headers of) either library.
+// only the types and constants that are used are declared here.
+
+typedef void *_oriEGLDisplay;
+typedef void *_oriEGLConfig;
+typedef void *_oriEGLContext;
+typedef void *_oriEGLSurface;
+typedef int _oriEGLint;
+
+#define _ORI_EGL_NONE                            0x3038
+#define _ORI_EGL_EXTENSIONS                      0x3055
+#define _ORI_EGL_RED_SIZE                        0x3024
+#define _ORI_EGL_GREEN_SIZE                      0x3023
+#define _ORI_EGL_BLUE_SIZE                       0x3022
+#define _ORI_EGL_ALPHA_SIZE                      0x3021
+#define _ORI_EGL_DEPTH_SIZE                      0x3025
+#define _ORI_EGL_STENCIL_SIZE                    0x3026
+#define _ORI_EGL_SURFACE_TYPE                    0x3033
+#define _ORI_EGL_PBUFFER_BIT                     0x0001
+#define _ORI_EGL_RENDERABLE_TYPE                 0x3040
+#define _ORI_EGL_OPENGL_BIT                      0x0008
+#define _ORI_EGL_WIDTH                           0x3057
+#define _ORI_EGL_HEIGHT                          0x3056
+#define _ORI_EGL_OPENGL_API                      0x30A2
+#define _ORI_EGL_CONTEXT_MAJOR_VERSION           0x3098
+#define _ORI_EGL_CONTEXT_MINOR_VERSION           0x30FB
+#define _ORI_EGL_CONTEXT_OPENGL_PROFILE_MASK     0x30FD
+#define _ORI_EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT 0x0001
+#define _ORI_EGL_PLATFORM_SURFACELESS_MESA       0x31DD
+
+typedef struct {
+    void *lib;
+
+    void *(* GetProcAddress)(const char *);
+    _oriEGLDisplay (* GetDisplay)(void *);
+    _oriEGLDisplay (* GetPlatformDisplayEXT)(_oriEGLint, void *, const _oriEGLint *);
+    unsigned int (* Initialize)(_oriEGLDisplay, _oriEGLint *, _oriEGLint *);
+    unsigned int (* Terminate)(_oriEGLDisplay);
+    const char *(* QueryString)(_oriEGLDisplay, _oriEGLint);
+    unsigned int (* ChooseConfig)(_oriEGLDisplay, const _oriEGLint *, _oriEGLConfig *, _oriEGLint, _oriEGLint *);
+    unsigned int (* BindAPI)(unsigned int);
+    _oriEGLContext (* CreateContext)(_oriEGLDisplay, _oriEGLConfig, _oriEGLContext, const _oriEGLint *);
+    unsigned int (* DestroyContext)(_oriEGLDisplay, _oriEGLContext);
+    _oriEGLSurface (* CreatePbufferSurface)(_oriEGLDisplay, _oriEGLConfig, const _oriEGLint *);
+    unsigned int (* DestroySurface)(_oriEGLDisplay, _oriEGLSurface);
+    unsigned int (* MakeCurrent)(_oriEGLDisplay, _oriEGLSurface, _oriEGLSurface, _oriEGLContext);
+} _oriEGLFunctions;
+
+typedef void *_oriOSMesaContext;
+
+#define _ORI_OSMESA_RGBA                    0x1908
+#define _ORI_OSMESA_FORMAT                  0x22
+#define _ORI_OSMESA_DEPTH_BITS              0x30
+#define _ORI_OSMESA_STENCIL_BITS            0x31
+#define _ORI_OSMESA_PROFILE                 0x33
+#define _ORI_OSMESA_CORE_PROFILE            0x34
+#define _ORI_OSMESA_COMPAT_PROFILE          0x35
+#define _ORI_OSMESA_CONTEXT_MAJOR_VERSION   0x36
+#define _ORI_OSMESA_CONTEXT_MINOR_VERSION   0x37
+
+typedef struct {
+    void *lib;
+
+    _oriOSMesaContext (* CreateContextAttribs)(const int *, _oriOSMesaContext);
+    void (* DestroyContext)(_oriOSMesaContext);
+    unsigned char (* MakeCurrent)(_oriOSMesaContext, void *, unsigned int, int, int);
+    void *(* GetProcAddress)(const char *);
+} _oriOSMesaFunctions;
+
+// ======================================================================================
+// *****                            ORION PUBLIC STRUCTURES                         *****
+// ======================================================================================
+
+/**
+ * @brief An OpenGL context that is not attached to a window.
+ * 
+ * @ingroup meta
+ */
+typedef struct oriHeadlessContext {
+    oriHeadlessContext *next;
+
+    unsigned int backend;
+    unsigned int width;
+    unsigned int height;
+
+    _oriEGLFunctions egl;
+    _oriEGLDisplay eglDisplay;
+    _oriEGLContext eglContext;
+    _oriEGLSurface eglSurface;
+
+    _oriOSMesaFunctions osmesa;
+    _oriOSMesaContext osmesaContext;
+    unsigned char *osmesaBuffer;
+} oriHeadlessContext;
+
+// ======================================================================================
+// *****                           ORION HELPER FUNCTIONS                           *****
+// ======================================================================================
+
+#ifdef __unix__
+
+// the context whose library OpenGL functions are loaded from (the context passed to oriLoadGL() has no user pointer)
+static oriHeadlessContext *_oriLoadingContext = NULL;
+
+/**
+ * @brief Load an OpenGL function for the context being created.
+ * @details Below EGL 1.5 (without EGL_KHR_get_all_proc_addresses) core functions might not be returned by
+ * eglGetProcAddress(), so the symbols of the process (i.e. libGL/libOpenGL, if it is loaded) are tried as well.
+ * 
+ */
+static void *_oriHeadlessLoadProc(const char *name) {
+    void *r = NULL;
+
+    if (_oriLoadingContext->backend == ORION_HEADLESS_OSMESA) {
+        r = _oriLoadingContext->osmesa.GetProcAddress(name);
+    } else {
+        r = _oriLoadingContext->egl.GetProcAddress(name);
+    }
+
+    if (!r) {
+        r = dlsym(RTLD_DEFAULT, name);
+    }
+
+    return r;
+}
+
+/**
+ * @brief Return true if the space-separated extension string contains the given extension.
+ * 
+ */
+static bool _oriHasExtension(const char *extensions, const char *extension) {
+    if (!extensions) {
+        return false;
+    }
+
+    size_t length = strlen(extension);
+    for (const char *s = strstr(extensions, extension); s; s = strstr(s + length, extension)) {
+        if ((s == extensions || s[-1] == ' ') && (s[length] == ' ' || s[length] == '\0')) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Open the first of the given shared libraries that can be found.
+ * 
+ */
+static void *_oriOpenLibrary(const char **names, const unsigned int count) {
+    for (unsigned int i = 0; i < count; i++) {
+        void *lib = dlopen(names[i], RTLD_NOW | RTLD_LOCAL);
+        if (lib) {
+            return lib;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Try to create an EGL context with a pbuffer surface (or with no surface), and make it current.
+ * 
+ * @return false if EGL isn't available, or the context couldn't be created.
+ */
+static bool _oriCreateEGLContext(oriHeadlessContext *r, const unsigned int version) {
+    const char *names[] = { "libEGL.so.1", "libEGL.so" };
+    _oriEGLFunctions *egl = &r->egl;
+
+    egl->lib = _oriOpenLibrary(names, 2);
+    if (!egl->lib) {
+        return false;
+    }
+
+    _orionStoreFunction(&egl->GetProcAddress, dlsym(egl->lib, "eglGetProcAddress"));
+    _orionStoreFunction(&egl->GetDisplay, dlsym(egl->lib, "eglGetDisplay"));
+    _orionStoreFunction(&egl->Initialize, dlsym(egl->lib, "eglInitialize"));
+    _orionStoreFunction(&egl->Terminate, dlsym(egl->lib, "eglTerminate"));
+    _orionStoreFunction(&egl->QueryString, dlsym(egl->lib, "eglQueryString"));
+    _orionStoreFunction(&egl->ChooseConfig, dlsym(egl->lib, "eglChooseConfig"));
+    _orionStoreFunction(&egl->BindAPI, dlsym(egl->lib, "eglBindAPI"));
+    _orionStoreFunction(&egl->CreateContext, dlsym(egl->lib, "eglCreateContext"));
+    _orionStoreFunction(&egl->DestroyContext, dlsym(egl->lib, "eglDestroyContext"));
+    _orionStoreFunction(&egl->CreatePbufferSurface, dlsym(egl->lib, "eglCreatePbufferSurface"));
+    _orionStoreFunction(&egl->DestroySurface, dlsym(egl->lib, "eglDestroySurface"));
+    _orionStoreFunction(&egl->MakeCurrent, dlsym(egl->lib, "eglMakeCurrent"));
+
+    if (!egl->GetProcAddress || !egl->GetDisplay || !egl->Initialize || !egl->Terminate || !egl->QueryString || !egl->ChooseConfig ||
+        !egl->BindAPI || !egl->CreateContext || !egl->DestroyContext || !egl->CreatePbufferSurface || !egl->DestroySurface || !egl->MakeCurrent) {
+        return false;
+    }
+
+    // prefer Mesa's surfaceless platform, which needs no display server or GPU device (and works with llvmpipe)
+    const char *clientExtensions = egl->QueryString(NULL, _ORI_EGL_EXTENSIONS);
+    if (_oriHasExtension(clientExtensions, "EGL_MESA_platform_surfaceless")) {
+        _orionStoreFunction(&egl->GetPlatformDisplayEXT, egl->GetProcAddress("eglGetPlatformDisplayEXT"));
+        if (egl->GetPlatformDisplayEXT) {
+            r->eglDisplay = egl->GetPlatformDisplayEXT(_ORI_EGL_PLATFORM_SURFACELESS_MESA, NULL, NULL);
+        }
+    }
+    if (!r->eglDisplay) {
+        r->eglDisplay = egl->GetDisplay(NULL);
+    }
+
+    if (!r->eglDisplay || !egl->Initialize(r->eglDisplay, NULL, NULL)) {
+        r->eglDisplay = NULL;
+        return false;
+    }
+
+    if (!egl->BindAPI(_ORI_EGL_OPENGL_API)) {
+        return false;
+    }
+
+    bool surfaceless = _oriHasExtension(egl->QueryString(r->eglDisplay, _ORI_EGL_EXTENSIONS), "EGL_KHR_surfaceless_context");
+
+    // try a pbuffer first, so that the context has a default framebuffer; fall back to no surface at all
+    _oriEGLint configAttribs[] = {
+        _ORI_EGL_RENDERABLE_TYPE, _ORI_EGL_OPENGL_BIT,
+        _ORI_EGL_RED_SIZE, 8, _ORI_EGL_GREEN_SIZE, 8, _ORI_EGL_BLUE_SIZE, 8, _ORI_EGL_ALPHA_SIZE, 8,
+        _ORI_EGL_DEPTH_SIZE, 24, _ORI_EGL_STENCIL_SIZE, 8,
+        _ORI_EGL_SURFACE_TYPE, _ORI_EGL_PBUFFER_BIT,
+        _ORI_EGL_NONE
+    };
+
+    _oriEGLConfig config = NULL;
+    _oriEGLint configCount = 0;
+    if (!egl->ChooseConfig(r->eglDisplay, configAttribs, &config, 1, &configCount) || !configCount) {
+        if (!surfaceless) {
+            return false;
+        }
+
+        // (drop the surface type)
+        configAttribs[14] = _ORI_EGL_NONE;
+        if (!egl->ChooseConfig(r->eglDisplay, configAttribs, &config, 1, &configCount) || !configCount) {
+            return false;
+        }
+    }
+
+    _oriEGLint contextAttribs[] = {
+        _ORI_EGL_CONTEXT_MAJOR_VERSION, version / 100,
+        _ORI_EGL_CONTEXT_MINOR_VERSION, (version / 10) % 10,
+        _ORI_EGL_NONE, 0,
+        _ORI_EGL_NONE
+    };
+    // core profile contexts only exist from 3.2
+    if (version >= 320) {
+        contextAttribs[4] = _ORI_EGL_CONTEXT_OPENGL_PROFILE_MASK;
+        contextAttribs[5] = _ORI_EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT;
+    }
+
+    r->eglContext = egl->CreateContext(r->eglDisplay, config, NULL, contextAttribs);
+    if (!r->eglContext) {
+        return false;
+    }
+
+    r->backend = ORION_HEADLESS_EGL_SURFACELESS;
+    if (configAttribs[14] != _ORI_EGL_NONE) {
+        _oriEGLint surfaceAttribs[] = { _ORI_EGL_WIDTH, r->width, _ORI_EGL_HEIGHT, r->height, _ORI_EGL_NONE };
+        r->eglSurface = egl->CreatePbufferSurface(r->eglDisplay, config, surfaceAttribs);
+        if (r->eglSurface) {
+            r->backend = ORION_HEADLESS_EGL_PBUFFER;
+        } else if (!surfaceless) {
+            return false;
+        }
+    }
+
+    return egl->MakeCurrent(r->eglDisplay, r->eglSurface, r->eglSurface, r->eglContext);
+}
+
+/**
+ * @brief Try to create an OSMesa context rendering into a buffer in memory, and make it current.
+ * 
+ * @return false if OSMesa isn't available, or the context couldn't be created.
+ */
+static bool _oriCreateOSMesaContext(oriHeadlessContext *r, const unsigned int version) {
+    const char *names[] = { "libOSMesa.so.8", "libOSMesa.so.6", "libOSMesa.so" };
+    _oriOSMesaFunctions *osmesa = &r->osmesa;
+
+    osmesa->lib = _oriOpenLibrary(names, 3);
+    if (!osmesa->lib) {
+        return false;
+    }
+
+    _orionStoreFunction(&osmesa->CreateContextAttribs, dlsym(osmesa->lib, "OSMesaCreateContextAttribs"));
+    _orionStoreFunction(&osmesa->DestroyContext, dlsym(osmesa->lib, "OSMesaDestroyContext"));
+    _orionStoreFunction(&osmesa->MakeCurrent, dlsym(osmesa->lib, "OSMesaMakeCurrent"));
+    _orionStoreFunction(&osmesa->GetProcAddress, dlsym(osmesa->lib, "OSMesaGetProcAddress"));
+
+    if (!osmesa->CreateContextAttribs || !osmesa->DestroyContext || !osmesa->MakeCurrent || !osmesa->GetProcAddress) {
+        return false;
+    }
+
+    int attribs[] = {
+        _ORI_OSMESA_FORMAT, _ORI_OSMESA_RGBA,
+        _ORI_OSMESA_DEPTH_BITS, 24,
+        _ORI_OSMESA_STENCIL_BITS, 8,
+        _ORI_OSMESA_PROFILE, version >= 320 ? _ORI_OSMESA_CORE_PROFILE : _ORI_OSMESA_COMPAT_PROFILE,
+        _ORI_OSMESA_CONTEXT_MAJOR_VERSION, version / 100,
+        _ORI_OSMESA_CONTEXT_MINOR_VERSION, (version / 10) % 10,
+        0
+    };
+
+    r->osmesaContext = osmesa->CreateContextAttribs(attribs, NULL);
+    if (!r->osmesaContext) {
+        return false;
+    }
+
+    r->osmesaBuffer = malloc((size_t) r->width * r->height * 4);
+    r->backend = ORION_HEADLESS_OSMESA;
+
+    return osmesa->MakeCurrent(r->osmesaContext, r->osmesaBuffer, GL_UNSIGNED_BYTE, r->width, r->height);
+}
+
+/**
+ * @brief Return true if a headless context other than the given one uses the same EGL display.
+ * @details EGL returns the same display to every caller in the process, and terminating it destroys every context on it.
+ * 
+ */
+static bool _oriEGLDisplayShared(oriHeadlessContext *context) {
+    for (oriHeadlessContext *c = _orion.headlessContextListHead; c; c = c->next) {
+        if (c != context && c->eglDisplay == context->eglDisplay) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Destroy whatever parts of the given context have been created, and close the libraries it opened.
+ * @details The EGL display is only terminated if no other headless context uses it.
+ * 
+ */
+static void _oriDestroyHeadlessContext(oriHeadlessContext *context) {
+    if (context->eglDisplay) {
+        context->egl.MakeCurrent(context->eglDisplay, NULL, NULL, NULL);
+        if (context->eglSurface) {
+            context->egl.DestroySurface(context->eglDisplay, context->eglSurface);
+        }
+        if (context->eglContext) {
+            context->egl.DestroyContext(context->eglDisplay, context->eglContext);
+        }
+        if (!_oriEGLDisplayShared(context)) {
+            context->egl.Terminate(context->eglDisplay);
+        }
+    }
+    if (context->egl.lib) {
+        dlclose(context->egl.lib);
+    }
+
+    if (context->osmesaContext) {
+        context->osmesa.DestroyContext(context->osmesaContext);
+    }
+    if (context->osmesa.lib) {
+        dlclose(context->osmesa.lib);
+    }
+    free(context->osmesaBuffer);
+
+    memset(context, 0, sizeof(oriHeadlessContext));
+}
+
+#endif
+
+// ======================================================================================
+// *****                      ORION HEADLESS CONTEXT FUNCTIONS                      *****
+// ======================================================================================
+
+/**
+ * @brief Allocate and initialise an OpenGL context that is not attached to a window, make it current, and load OpenGL
+ * for it.
+ * @details This lets Orion run without a display server (e.g. on CI machines and render farm nodes). EGL is used first:
+ * with a pbuffer surface of the given size if possible (so the context has a default framebuffer), or with no surface at
+ * all otherwise (render into an oriFramebuffer in that case). Mesa's surfaceless platform is used if it is available, so
+ * no display or GPU is needed, and software rendering with llvmpipe works. If EGL can't be used, OSMesa is used instead,
+ * which renders the default framebuffer into memory.
+ * 
+ * Set the environment variable @c ORION_HEADLESS_BACKEND to @c egl or @c osmesa to only try that backend. Any other value
+ * is warned about, and every backend is tried.
+ * 
+ * EGL and OSMesa are loaded when this function is called, so neither is needed to build or run Orion otherwise. Headless
+ * contexts are only supported on Unix-like systems.
+ * 
+ * Call oriInitialise() first, with the same OpenGL version. Like windows, headless contexts are freed with oriTerminate(),
+ * after every other Orion object.
+ * 
+ * @param version the OpenGL version of the context, e.g. 450. Contexts of 3.2 and above use the core profile.
+ * @param width the width of the default framebuffer.
+ * @param height the height of the default framebuffer.
+ * @return NULL if neither backend could create a context.
+ * 
+ * @ingroup meta
+ */
+oriHeadlessContext *oriCreateHeadlessContext(const unsigned int version, const unsigned int width, const unsigned int height) {
+#ifdef __unix__
+    if (!width || !height) {
+        _orionThrowError(ORERR_NULL_RECIEVED);
+    }
+
+    oriHeadlessContext *r = malloc(sizeof(oriHeadlessContext));
+    memset(r, 0, sizeof(oriHeadlessContext));
+    r->width = width;
+    r->height = height;
+
+    const char *backend = getenv("ORION_HEADLESS_BACKEND");
+    bool tryEGL = !backend || !strcmp(backend, "egl");
+    bool tryOSMesa = !backend || !strcmp(backend, "osmesa");
+    if (!tryEGL && !tryOSMesa) {
+        // As string formatted is required here, printf is used instead of _orionThrowWarning.
+        // This is annoying and be sure to change the style of this message if the style in _orionThrowWarning changes.
+        printf("[Orion : WARN] >> (in oriCreateHeadlessContext()): Unrecognised ORION_HEADLESS_BACKEND '%s' (expected egl or osmesa). Trying every backend.\n", backend);
+        tryEGL = tryOSMesa = true;
+    }
+
+    bool created = false;
+    if (tryEGL) {
+        created = _oriCreateEGLContext(r, version);
+        if (!created) {
+            _orionThrowWarning("(in oriCreateHeadlessContext()): Failed to create an EGL context.");
+            _oriDestroyHeadlessContext(r);
+            r->width = width;
+            r->height = height;
+        }
+    }
+    if (!created && tryOSMesa) {
+        created = _oriCreateOSMesaContext(r, version);
+        if (!created) {
+            _orionThrowWarning("(in oriCreateHeadlessContext()): Failed to create an OSMesa context.");
+            _oriDestroyHeadlessContext(r);
+        }
+    }
+
+    if (!created) {
+        free(r);
+        return NULL;
+    }
+
+    // link to global linked list
+    r->next = _orion.headlessContextListHead;
+    _orion.headlessContextListHead = r;
+
+    // load OpenGL after creation
+    _oriLoadingContext = r;
+    oriLoadGL(_oriHeadlessLoadProc);
+    _oriLoadingContext = NULL;
+
+    return r;
+#else
+    _orionThrowWarning("(in oriCreateHeadlessContext()): Headless contexts are not supported on this platform.");
+    return NULL;
+#endif
+}
+
+/**
+ * @brief Destroy and free memory for the given headless context.
+ * @details Free every Orion object that was created in the context first (or call oriTerminate(), which does so).
+ * 
+ * @param context the headless context to free.
+ * 
+ * @ingroup meta
+ */
+void oriFreeHeadlessContext(oriHeadlessContext *context) {
+    // unlink from global linked list
+    oriHeadlessContext **current = &_orion.headlessContextListHead;
+    while (*current != context)
+        current = &(*current)->next;
+    *current = context->next;
+
+#ifdef __unix__
+    _oriDestroyHeadlessContext(context);
+#endif
+
+    free(context);
+    context = NULL;
+}
+
+/**
+ * @brief Make the given headless context current on the calling thread.
+ * 
+ * @param context the headless context to make current.
+ * 
+ * @ingroup meta
+ */
+void oriMakeHeadlessContextCurrent(oriHeadlessContext *context) {
+#ifdef __unix__
+    if (context->backend == ORION_HEADLESS_OSMESA) {
+        context->osmesa.MakeCurrent(context->osmesaContext, context->osmesaBuffer, GL_UNSIGNED_BYTE, context->width, context->height);
+    } else {
+        context->egl.MakeCurrent(context->eglDisplay, context->eglSurface, context->eglSurface, context->eglContext);
+    }
+#endif
+}
+
+/**
+ * @brief Return the backend of the given headless context: @c ORION_HEADLESS_EGL_PBUFFER,
+ * @c ORION_HEADLESS_EGL_SURFACELESS or @c ORION_HEADLESS_OSMESA.
+ * 
+ * @param context the headless context to inspect.
+ * 
+ * @ingroup meta
+ */
+unsigned int oriGetHeadlessContextBackend(oriHeadlessContext *context) {
+    return context->backend;
+}
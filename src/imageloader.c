@@ -0,0 +1,397 @@
+/* *************************************************************************************** */
+/*                        ORION GRAPHICS LIBRARY AND RENDERING ENGINE                      */
+/* *************************************************************************************** */
+/* Copyright (c) 2022 Jack Bennett                                                         */
+/* --------------------------------------------------------------------------------------- */
+/* THE  SOFTWARE IS  PROVIDED "AS IS",  WITHOUT WARRANTY OF ANY KIND, EXPRESS  OR IMPLIED, */
+/* INCLUDING  BUT  NOT  LIMITED  TO  THE  WARRANTIES  OF  MERCHANTABILITY,  FITNESS FOR  A */
+/* PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN  NO EVENT SHALL  THE  AUTHORS  OR COPYRIGHT */
+/* HOLDERS  BE  LIABLE  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF */
+/* CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR */
+/* THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                              */
+/* *************************************************************************************** */
+
+// for sysconf()
+#define _XOPEN_SOURCE 700
+
+#include "internal.h"
+#include "oriongl.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <pthread.h>
+#include <unistd.h>
+
+// stb_image is compiled into this file with internal linkage, so that it doesn't clash with a copy in the application
+// (stb_image declares a static function that it never defines when compiled this way, which is only reported at the end
+// of the file, so the warning is left disabled)
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#pragma GCC diagnostic ignored "-Wunused-function"
+#include <execdeps/stb_image/stb_image.h>
+
+#define _ORION_MAX_LOADER_THREADS 16
+
+// ======================================================================================
+// *****                          ORION INTERNAL DATA TYPES                         *****
+// ======================================================================================
+
+/**
+ * @brief A texture load, from the moment it is requested until its texture is handed to the callback.
+ * 
+ */
+typedef struct _oriTextureLoadJob {
+    // next job in the pending queue (guarded by the loader's mutex)
+    struct _oriTextureLoadJob *nextPending;
+    // next job in the completion queue (written by the worker threads)
+    _Atomic(struct _oriTextureLoadJob *) nextCompleted;
+
+    char *path;
+    unsigned int channels;
+    unsigned int flags;
+
+    oriTextureLoadCallback callback;
+    void *userData;
+
+    // the decoded image, followed by every mipmap level generated from it (NULL if decoding failed)
+    unsigned char *pixels;
+    unsigned int width;
+    unsigned int height;
+    unsigned int levels;
+    const char *failure;
+} _oriTextureLoadJob;
+
+/**
+ * @brief The worker threads that decode images, and the queues that jobs are passed through.
+ * 
+ */
+typedef struct _oriImageLoader {
+    pthread_t threads[_ORION_MAX_LOADER_THREADS];
+    unsigned int threadCount;
+
+    // FIFO of jobs waiting for a worker thread
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    _oriTextureLoadJob *pendingHead;
+    _oriTextureLoadJob *pendingTail;
+    bool quit;
+
+    // lock-free (multiple producer, single consumer) queue of decoded jobs, drained on the GL thread.
+    // workers push onto completedHead; the GL thread pops from completedTail. stub keeps the queue from ever being empty
+    _Atomic(_oriTextureLoadJob *) completedHead;
+    _oriTextureLoadJob *completedTail;
+    _oriTextureLoadJob stub;
+
+    // jobs that have been requested but not yet handed to their callback (only used on the GL thread)
+    unsigned int inFlight;
+} _oriImageLoader;
+
+// ======================================================================================
+// *****                           ORION HELPER FUNCTIONS                           *****
+// ======================================================================================
+
+static void _oriPushCompleted(_oriImageLoader *loader, _oriTextureLoadJob *job) {
+    atomic_store_explicit(&job->nextCompleted, NULL, memory_order_relaxed);
+    _oriTextureLoadJob *prev = atomic_exchange_explicit(&loader->completedHead, job, memory_order_acq_rel);
+    atomic_store_explicit(&prev->nextCompleted, job, memory_order_release);
+}
+
+// return the oldest decoded job, or NULL if there are none (or one is still being pushed)
+static _oriTextureLoadJob *_oriPopCompleted(_oriImageLoader *loader) {
+    _oriTextureLoadJob *tail = loader->completedTail;
+    _oriTextureLoadJob *next = atomic_load_explicit(&tail->nextCompleted, memory_order_acquire);
+
+    if (tail == &loader->stub) {
+        if (!next) {
+            return NULL;
+        }
+        loader->completedTail = next;
+        tail = next;
+        next = atomic_load_explicit(&tail->nextCompleted, memory_order_acquire);
+    }
+
+    if (next) {
+        loader->completedTail = next;
+        return tail;
+    }
+
+    // tail is the last job; put the stub back behind it so that it can be popped
+    if (tail != atomic_load_explicit(&loader->completedHead, memory_order_acquire)) {
+        return NULL;
+    }
+    _oriPushCompleted(loader, &loader->stub);
+
+    next = atomic_load_explicit(&tail->nextCompleted, memory_order_acquire);
+    if (next) {
+        loader->completedTail = next;
+        return tail;
+    }
+    return NULL;
+}
+
+// the pixel format of an image with the given number of channels
+static unsigned int _oriChannelsFormat(const unsigned int channels) {
+    switch (channels) {
+        case 1:  return GL_RED;
+        case 2:  return GL_RG;
+        case 3:  return GL_RGB;
+        default: return GL_RGBA;
+    }
+}
+
+// decode the image of a job (and generate its mipmaps), on a worker thread
+static void _oriDecodeImage(_oriTextureLoadJob *job) {
+    stbi_set_flip_vertically_on_load_thread(job->flags & ORION_TEXTURE_LOAD_FLIP ? 1 : 0);
+
+    int x, y, fileChannels;
+    unsigned char *image = stbi_load(job->path, &x, &y, &fileChannels, job->channels);
+    if (!image) {
+        job->failure = stbi_failure_reason();
+        return;
+    }
+
+    if (!job->channels) {
+        job->channels = fileChannels;
+    }
+    job->width = x;
+    job->height = y;
+    job->levels = job->flags & ORION_TEXTURE_LOAD_MIPMAPS ? oriMipmapLevelCount(x, y) : 1;
+
+    if (job->levels == 1) {
+        job->pixels = image;
+        return;
+    }
+
+    // every level is stored one after another in a single allocation
+    unsigned int format = _oriChannelsFormat(job->channels);
+    job->pixels = malloc(oriMipmapChainSize(x, y, job->levels, format, GL_UNSIGNED_BYTE));
+    memcpy(job->pixels, image, (size_t) x * y * job->channels);
+    stbi_image_free(image);
+
+    // this is already one of a pool of threads (one per core), so the levels aren't split between more
+    bool srgb = job->flags & ORION_TEXTURE_LOAD_SRGB && job->channels >= 3;
+    oriGenerateMipmapChain(job->pixels, x, y, job->levels, format, GL_UNSIGNED_BYTE, ORION_MIPMAP_FILTER_BOX, srgb, 1);
+}
+
+static void *_oriImageLoaderThread(void *arg) {
+    _oriImageLoader *loader = arg;
+
+    while (true) {
+        pthread_mutex_lock(&loader->mutex);
+        while (!loader->pendingHead && !loader->quit) {
+            pthread_cond_wait(&loader->cond, &loader->mutex);
+        }
+        if (loader->quit) {
+            pthread_mutex_unlock(&loader->mutex);
+            return NULL;
+        }
+
+        _oriTextureLoadJob *job = loader->pendingHead;
+        loader->pendingHead = job->nextPending;
+        if (!loader->pendingHead) {
+            loader->pendingTail = NULL;
+        }
+        pthread_mutex_unlock(&loader->mutex);
+
+        _oriDecodeImage(job);
+        _oriPushCompleted(loader, job);
+    }
+}
+
+static void _oriFreeTextureLoadJob(_oriTextureLoadJob *job) {
+    if (job->levels > 1) {
+        free(job->pixels);
+    } else {
+        stbi_image_free(job->pixels);
+    }
+    free(job->path);
+    free(job);
+}
+
+// create the texture for a decoded job and upload every level of its image, on the GL thread
+static oriTexture *_oriUploadLoadedImage(_oriTextureLoadJob *job) {
+    bool srgb = job->flags & ORION_TEXTURE_LOAD_SRGB;
+
+    unsigned int internalFormat;
+    switch (job->channels) {
+        case 1:  internalFormat = GL_R8; break;
+        case 2:  internalFormat = GL_RG8; break;
+        case 3:  internalFormat = srgb ? GL_SRGB8 : GL_RGB8; break;
+        default: internalFormat = srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8; break;
+    }
+
+    oriTexture *r = oriCreateTextureImmutable(GL_TEXTURE_2D, job->width, job->height, 0, internalFormat, job->levels, 0, false);
+    oriUploadMipmapChain(r, job->pixels, job->width, job->height, job->levels, _oriChannelsFormat(job->channels), GL_UNSIGNED_BYTE);
+
+    if (job->levels > 1) {
+        oriSetTextureParameteri(r, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    } else {
+        oriSetTextureParameteri(r, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    }
+
+    return r;
+}
+
+// ======================================================================================
+// *****                    ORION INTERNAL IMAGE LOADER FUNCTIONS                   *****
+// ======================================================================================
+
+/**
+ * @brief Stop the image loader's worker threads, and discard every load that hasn't completed.
+ * 
+ */
+void _orionShutdownImageLoader() {
+    _oriImageLoader *loader = _orion.imageLoader;
+    if (!loader) {
+        return;
+    }
+
+    pthread_mutex_lock(&loader->mutex);
+    loader->quit = true;
+    pthread_cond_broadcast(&loader->cond);
+    pthread_mutex_unlock(&loader->mutex);
+
+    for (unsigned int i = 0; i < loader->threadCount; i++) {
+        pthread_join(loader->threads[i], NULL);
+    }
+
+    while (loader->pendingHead) {
+        _oriTextureLoadJob *next = loader->pendingHead->nextPending;
+        _oriFreeTextureLoadJob(loader->pendingHead);
+        loader->pendingHead = next;
+    }
+
+    _oriTextureLoadJob *job;
+    while ((job = _oriPopCompleted(loader))) {
+        _oriFreeTextureLoadJob(job);
+    }
+
+    pthread_mutex_destroy(&loader->mutex);
+    pthread_cond_destroy(&loader->cond);
+
+    free(loader);
+    _orion.imageLoader = NULL;
+}
+
+// ======================================================================================
+// *****                        ORION IMAGE LOADER FUNCTIONS                        *****
+// ======================================================================================
+
+/**
+ * @brief Load a 2D texture from an image file, decoding it on a worker thread.
+ * @details This returns immediately. The image is decoded (with stb_image, so any format it supports can be loaded) on a
+ * pool of worker threads, one per CPU core, which is started by the first call. If @c ORION_TEXTURE_LOAD_MIPMAPS is
+ * given, every mipmap level is also generated on the worker thread.
+ * 
+ * Decoded images are uploaded by oriPollTextureLoads(), which must be called regularly (e.g. once per frame) on the thread
+ * the OpenGL context is current on. The texture is then created, with immutable storage, and handed to the callback.
+ * 
+ * @param path the path to the image file, @b relative @b to @b the @b executable!
+ * @param channels the number of channels to convert the image to (1 to 4), or 0 to keep the channels of the file.
+ * @param flags a combination of @c ORION_TEXTURE_LOAD_* flags, or 0.
+ * @param callback the function to call when the texture has loaded (or failed to load).
+ * @param userData a pointer that is passed to the callback.
+ * 
+ * @ingroup textures
+ */
+void oriLoadTextureAsync(const char *path, const unsigned int channels, const unsigned int flags, oriTextureLoadCallback callback, void *userData) {
+    _orionAssertVersion(420);
+
+    if (channels > 4) {
+        _orionThrowWarning("(in oriLoadTextureAsync()): The number of channels must be between 0 and 4. Texture not loaded.");
+        return;
+    }
+
+    // start the worker threads on first use
+    if (!_orion.imageLoader) {
+        _oriImageLoader *loader = calloc(1, sizeof(_oriImageLoader));
+
+        pthread_mutex_init(&loader->mutex, NULL);
+        pthread_cond_init(&loader->cond, NULL);
+
+        atomic_init(&loader->stub.nextCompleted, NULL);
+        atomic_init(&loader->completedHead, &loader->stub);
+        loader->completedTail = &loader->stub;
+
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        unsigned int threadCount = cores < 1 ? 1 : cores > _ORION_MAX_LOADER_THREADS ? _ORION_MAX_LOADER_THREADS : cores;
+
+        for (unsigned int i = 0; i < threadCount; i++) {
+            if (pthread_create(&loader->threads[loader->threadCount], NULL, _oriImageLoaderThread, loader) == 0) {
+                loader->threadCount++;
+            }
+        }
+
+        if (!loader->threadCount) {
+            _orionThrowWarning("(in oriLoadTextureAsync()): No worker threads could be started. Texture not loaded.");
+            pthread_mutex_destroy(&loader->mutex);
+            pthread_cond_destroy(&loader->cond);
+            free(loader);
+            return;
+        }
+
+        _orion.imageLoader = loader;
+    }
+
+    _oriTextureLoadJob *job = calloc(1, sizeof(_oriTextureLoadJob));
+    job->path = malloc(strlen(path) + 1);
+    strcpy(job->path, path);
+    job->channels = channels;
+    job->flags = flags;
+    job->callback = callback;
+    job->userData = userData;
+
+    _oriImageLoader *loader = _orion.imageLoader;
+    loader->inFlight++;
+
+    pthread_mutex_lock(&loader->mutex);
+    if (loader->pendingTail) {
+        loader->pendingTail->nextPending = job;
+    } else {
+        loader->pendingHead = job;
+    }
+    loader->pendingTail = job;
+    pthread_cond_signal(&loader->cond);
+    pthread_mutex_unlock(&loader->mutex);
+}
+
+/**
+ * @brief Upload every image that has been decoded since the last call, and hand their textures to their callbacks.
+ * @details Call this regularly (e.g. once per frame) on the thread the OpenGL context is current on. If an image couldn't
+ * be loaded, a warning is sent and its callback is given NULL.
+ * 
+ * @return the number of texture loads that are still in progress.
+ * 
+ * @ingroup textures
+ */
+unsigned int oriPollTextureLoads() {
+    _oriImageLoader *loader = _orion.imageLoader;
+    if (!loader) {
+        return 0;
+    }
+
+    _oriTextureLoadJob *job;
+    while ((job = _oriPopCompleted(loader))) {
+        loader->inFlight--;
+
+        oriTexture *texture = NULL;
+        if (job->pixels) {
+            texture = _oriUploadLoadedImage(job);
+        } else {
+            // As string formatted is required here, printf is used instead of _orionThrowWarning.
+            // This is annoying and be sure to change the style of this message if the style in _orionThrowWarning changes.
+            printf("[Orion : WARN] >> (in oriPollTextureLoads()): %s could not be loaded (%s).\n", job->path, job->failure ? job->failure : "unknown error");
+        }
+
+        if (job->callback) {
+            job->callback(texture, job->path, job->userData);
+        }
+
+        _oriFreeTextureLoadJob(job);
+    }
+
+    return loader->inFlight;
+}
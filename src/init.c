@@ -81,6 +81,15 @@ void _orionAssertVersion(unsigned int minimum) {
     }
 }
 
+/**
+ * @brief Store the given symbol (e.g. from dlsym()) in the function pointer that @c function points to.
+ * @details ISO C doesn't allow object pointers to be cast to function pointers, so the symbol is copied instead.
+ * 
+ */
+void _orionStoreFunction(void *function, void *symbol) {
+    memcpy(function, &symbol, sizeof(symbol));
+}
+
 // ======================================================================================
 // *****                    ORION PUBLIC INITIALISATION FUNCTIONS                   *****
 // ======================================================================================
@@ -176,10 +185,53 @@ void oriTerminate() {
         return;
     }
 
+    // stop decoding images before anything else is destroyed
+    _orionShutdownImageLoader();
+
+    // destroy all draw batches (before stream buffers and buffer objects, as they each own one)
+    while (_orion.drawBatchListHead) {
+        oriFreeDrawBatch(_orion.drawBatchListHead);
+    }
+    // destroy all uniform blocks (before buffer objects, as they each own one)
+    while (_orion.uniformBlockListHead) {
+        oriFreeUniformBlock(_orion.uniformBlockListHead);
+    }
+    // destroy all shader families (before shader objects, as they own their variants)
+    while (_orion.shaderFamilyListHead) {
+        oriFreeShaderFamily(_orion.shaderFamilyListHead);
+    }
     // destroy all shader objects
     while (_orion.shaderListHead) {
         oriFreeShader(_orion.shaderListHead);
     }
+    // destroy all texture uploaders (before stream buffers, as they each own one)
+    while (_orion.textureUploaderListHead) {
+        oriFreeTextureUploader(_orion.textureUploaderListHead);
+    }
+    // destroy all texture atlases (before textures, as they each own one)
+    while (_orion.atlasListHead) {
+        oriFreeAtlas(_orion.atlasListHead);
+    }
+    // destroy all texture pools (also before textures)
+    while (_orion.texturePoolListHead) {
+        oriFreeTexturePool(_orion.texturePoolListHead);
+    }
+    // destroy all render target pools (also before textures)
+    while (_orion.renderTargetPoolListHead) {
+        oriFreeRenderTargetPool(_orion.renderTargetPoolListHead);
+    }
+    // destroy all framebuffer objects
+    while (_orion.framebufferListHead) {
+        oriFreeFramebuffer(_orion.framebufferListHead);
+    }
+    // destroy all stream buffers (before buffer objects, as they each own one)
+    while (_orion.streamBufferListHead) {
+        oriFreeStreamBuffer(_orion.streamBufferListHead);
+    }
+    // destroy all buffer heaps (also before buffer objects)
+    while (_orion.bufferHeapListHead) {
+        oriFreeBufferHeap(_orion.bufferHeapListHead);
+    }
     // destroy all buffer objects
     while (_orion.bufferListHead) {
         oriFreeBuffer(_orion.bufferListHead);
@@ -188,20 +240,37 @@ void oriTerminate() {
     while (_orion.vertexArrayListHead) {
         oriFreeVertexArray(_orion.vertexArrayListHead);
     }
+    // destroy all vertex layouts
+    while (_orion.vertexLayoutListHead) {
+        oriFreeVertexLayout(_orion.vertexLayoutListHead);
+    }
     // destroy all vertex array objects
     while (_orion.textureListHead) {
         oriFreeTexture(_orion.textureListHead);
     }
+    // destroy all sampler objects
+    _orionFreeSamplers();
+
+    oriDisableShaderHotReload();
+    _orionFreeShaderSources();
+    oriDisableProgramCache();
 
     // destroy all window objects
     while (_orion.windowListHead) {
         oriFreeWindow(_orion.windowListHead);
     }
+    // destroy all headless contexts
+    while (_orion.headlessContextListHead) {
+        oriFreeHeadlessContext(_orion.headlessContextListHead);
+    }
     // terminate GLFW
     if (_orion.glfwInitialised) {
         glfwTerminate();
     }
 
+    // forget the bindings tracked by orionglad, as the contexts they belong to are gone
+    orion_glResetState();
+
     // free malloc'd state members
     free(_orion.execDir);
 
@@ -223,6 +292,38 @@ void oriLoadGL(void *(* loadproc)(const char *)) {
     }
 
     _orion.glLoaded = true;
+
+    // detect parallel shader compilation, and let the driver use as many compiler threads as it likes
+    // also detect anisotropic filtering (core since 4.6), which is used by samplers (see oriGetSampler())
+    _orion.parallelShaderCompile = false;
+    _orion.maxAnisotropy = 0.0f;
+    if (_orion.glVersion >= 300) {
+        int extensionCount;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+
+        void (APIENTRYP maxShaderCompilerThreads)(GLuint) = NULL;
+        bool anisotropy = _orion.glVersion >= 460;
+        for (int i = 0; i < extensionCount; i++) {
+            const char *extension = (const char *) glGetStringi(GL_EXTENSIONS, i);
+
+            if (!maxShaderCompilerThreads && !strcmp(extension, "GL_KHR_parallel_shader_compile")) {
+                _orionStoreFunction(&maxShaderCompilerThreads, loadproc("glMaxShaderCompilerThreadsKHR"));
+            } else if (!maxShaderCompilerThreads && !strcmp(extension, "GL_ARB_parallel_shader_compile")) {
+                _orionStoreFunction(&maxShaderCompilerThreads, loadproc("glMaxShaderCompilerThreadsARB"));
+            } else if (!strcmp(extension, "GL_ARB_texture_filter_anisotropic") || !strcmp(extension, "GL_EXT_texture_filter_anisotropic")) {
+                anisotropy = true;
+            }
+        }
+
+        if (maxShaderCompilerThreads) {
+            maxShaderCompilerThreads(0xFFFFFFFF);
+            _orion.parallelShaderCompile = true;
+        }
+
+        if (anisotropy) {
+            glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &_orion.maxAnisotropy);
+        }
+    }
 }
 
 /**
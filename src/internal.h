@@ -22,6 +22,7 @@ extern "C" {
 #include "oriongl.h"
 #include "orionwin.h"
 #include <stdbool.h>
+#include <stdint.h>
 #include <signal.h>
 
 #ifdef SIGTRAP
@@ -51,10 +52,62 @@ typedef struct _orionState {
 
     // linked lists for all Orion structures
     oriWindow *windowListHead;
+    oriHeadlessContext *headlessContextListHead;
     oriShader *shaderListHead;
+    oriShaderFamily *shaderFamilyListHead;
+    oriUniformBlock *uniformBlockListHead;
     oriBuffer *bufferListHead;
+    oriStreamBuffer *streamBufferListHead;
+    oriBufferHeap *bufferHeapListHead;
     oriVertexArray *vertexArrayListHead;
+    oriVertexLayout *vertexLayoutListHead;
     oriTexture *textureListHead;
+    oriTextureUploader *textureUploaderListHead;
+    oriAtlas *atlasListHead;
+    oriTexturePool *texturePoolListHead;
+    oriSampler *samplerListHead;
+    oriFramebuffer *framebufferListHead;
+    oriRenderTargetPool *renderTargetPoolListHead;
+    oriDrawBatch *drawBatchListHead;
+
+    // every shader source file that has been parsed (see oriParseShader())
+    struct _oriShaderSource *shaderSourceListHead;
+
+    // worker threads that decode images for oriLoadTextureAsync(); NULL until first used
+    struct _oriImageLoader *imageLoader;
+
+    // inotify instance watching the directories of parsed shader sources (see oriEnableShaderHotReload())
+    struct {
+        bool enabled;
+        int fd;
+    } shaderHotReload;
+
+    // true if GL_KHR_parallel_shader_compile or GL_ARB_parallel_shader_compile is supported
+    bool parallelShaderCompile;
+
+    // uniform uploads issued and skipped (see oriGetUniformUploadStats())
+    unsigned long uniformUploadsIssued;
+    unsigned long uniformUploadsSkipped;
+
+    // the serial of the last texture created. serials are never reused (unlike OpenGL names), so they identify a texture
+    unsigned long textureSerial;
+
+    // the largest supported texture anisotropy; 0 if anisotropic filtering is not supported
+    float maxAnisotropy;
+
+    // sampler binds issued and skipped (see oriGetSamplerStats())
+    unsigned long samplerBindsIssued;
+    unsigned long samplerBindsSkipped;
+
+    // on-disk program binary cache (see oriEnableProgramCache()); disabled if dir is NULL
+    struct {
+        char *dir;
+        unsigned long maxSize;
+        uint64_t driverHash;
+
+        unsigned int hits;
+        unsigned int misses;
+    } programCache;
 
     struct {
         oriGLFWErrorCallback glfwErrorCallback;
@@ -63,6 +116,18 @@ typedef struct _orionState {
 } _orionState;
 extern _orionState _orion;
 
+// ======================================================================================
+// *****                           OPENGL EXTENSION CONSTANTS                       *****
+// ======================================================================================
+
+// GL_KHR_parallel_shader_compile (the same values are used by GL_ARB_parallel_shader_compile)
+#ifndef GL_MAX_SHADER_COMPILER_THREADS_KHR
+#   define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#endif
+#ifndef GL_COMPLETION_STATUS_KHR
+#   define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
 // ======================================================================================
 // *****                              HELPER FUNCTIONS                              *****
 // ======================================================================================
@@ -79,6 +144,100 @@ void _orionInitGLFW();
  */
 void _orionAssertVersion(unsigned int minimum);
 
+/**
+ * @brief Store the given symbol (e.g. from dlsym()) in the function pointer that @c function points to.
+ * @details ISO C doesn't allow object pointers to be cast to function pointers, so the symbol is copied instead.
+ * 
+ */
+void _orionStoreFunction(void *function, void *symbol);
+
+// 64-bit FNV-1a offset basis; the starting value of a program source hash
+#define _ORION_FNV64_OFFSET 0xcbf29ce484222325ULL
+
+/**
+ * @brief Continue the hash of a program's sources with the given shader stage.
+ * @details Start with @c _ORION_FNV64_OFFSET, and add every stage of the program in order.
+ * 
+ */
+uint64_t _orionHashProgramSource(uint64_t hash, const unsigned int type, const char *src);
+
+/**
+ * @brief Try to load the program with the given source hash from the program cache into @c program.
+ * 
+ * @return true if the program was loaded and linked successfully; false if it has to be compiled from source.
+ */
+bool _orionLoadProgramBinary(const unsigned int program, const uint64_t sourceHash);
+
+/**
+ * @brief Store the binary of the given (successfully linked) program in the program cache.
+ * 
+ */
+void _orionSaveProgramBinary(const unsigned int program, const uint64_t sourceHash);
+
+/**
+ * @brief Return the name of the input of the given shader at the given index (and its location, type and the number of
+ * locations it occupies), or NULL if the index is past the last input.
+ * 
+ */
+const char *_orionGetShaderInput(oriShader *shader, const unsigned int index, int *location, unsigned int *type, unsigned int *locationCount);
+
+/**
+ * @brief Return the up-to-date, expanded source of the given shader file (and its generation), or NULL if the file can't be read.
+ * @details The generation of a source changes whenever its expanded source does.
+ * 
+ */
+const char *_orionGetShaderSource(const char *path, unsigned int *generation);
+
+/**
+ * @brief Return the canonical path of the shader file that the given string was returned for by oriParseShader() (and its
+ * generation), or NULL if the string didn't come from oriParseShader().
+ * 
+ */
+const char *_orionGetShaderSourcePath(const char *src, unsigned int *generation);
+
+/**
+ * @brief Return true if a parsed shader source file has been written to since this was last called (always false if
+ * shader hot reloading is disabled).
+ * 
+ */
+bool _orionShaderSourcesModified();
+
+/**
+ * @brief Unmap and free every cached shader source file.
+ * 
+ */
+void _orionFreeShaderSources();
+
+/**
+ * @brief Stop the image loader's worker threads, and discard every load that hasn't completed.
+ * 
+ */
+void _orionShutdownImageLoader();
+
+/**
+ * @brief Destroy every sampler object created with oriGetSampler().
+ * 
+ */
+void _orionFreeSamplers();
+
+/**
+ * @brief Return the serial of the given texture, which no other texture has (or will have), unlike its OpenGL name.
+ * 
+ */
+unsigned long _orionGetTextureSerial(oriTexture *texture);
+
+/**
+ * @brief Detach the texture with the given serial from every framebuffer it is attached to. Called by oriFreeTexture().
+ * 
+ */
+void _orionDetachFramebufferTexture(const unsigned long serial);
+
+/**
+ * @brief Return the size, in bytes, of a single pixel with the given format and type, or 0 if either is not recognised.
+ * 
+ */
+unsigned int _orionPixelSize(const unsigned int format, const unsigned int type);
+
 // ======================================================================================
 // *****                                ORION ERRORS                                *****
 // ======================================================================================
@@ -0,0 +1,988 @@
+/* *************************************************************************************** */
+/*                        ORION GRAPHICS LIBRARY AND RENDERING ENGINE                      */
+/* *************************************************************************************** */
+/* Copyright (c) 2022 Jack Bennett                                                         */
+/* --------------------------------------------------------------------------------------- */
+/* THE  SOFTWARE IS  PROVIDED "AS IS",  WITHOUT WARRANTY OF ANY KIND, EXPRESS  OR IMPLIED, */
+/* INCLUDING  BUT  NOT  LIMITED  TO  THE  WARRANTIES  OF  MERCHANTABILITY,  FITNESS FOR  A */
+/* PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN  NO EVENT SHALL  THE  AUTHORS  OR COPYRIGHT */
+/* HOLDERS  BE  LIABLE  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF */
+/* CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR */
+/* THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                              */
+/* *************************************************************************************** */
+
+// for sysconf()
+#define _XOPEN_SOURCE 700
+
+#include "internal.h"
+#include "oriongl.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <pthread.h>
+#include <unistd.h>
+
+// the x86 kernels are compiled with per-function target attributes and chosen at runtime, by what the CPU supports
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#   define _ORION_MIPMAP_X86
+#   include <immintrin.h>
+#endif
+
+#define _ORION_MAX_MIPMAP_THREADS 16
+// levels are only split between threads in blocks of at least this many rows
+#define _ORION_MIPMAP_ROWS_PER_THREAD 16
+
+// the radius of the Kaiser-windowed sinc filter (in destination pixels), and the alpha of its window
+#define _ORION_KAISER_RADIUS 3.0f
+#define _ORION_KAISER_ALPHA 4.0f
+
+// the number of linear values in the table used to encode sRGB (enough that every 8-bit sRGB value can be reached)
+#define _ORION_SRGB_ENCODE_SIZE 16384
+
+#define _ORION_PI 3.14159265358979323846f
+
+// ======================================================================================
+// *****                          ORION INTERNAL DATA TYPES                         *****
+// ======================================================================================
+
+/**
+ * @brief The weights that resample one dimension of a mipmap level into the next.
+ * 
+ */
+typedef struct _oriFilterTaps {
+    // the number of source pixels read for each destination pixel
+    unsigned int count;
+
+    // for each destination pixel, the first source pixel it reads, and a weight for each of the count pixels from there
+    unsigned int *first;
+    float *weights;
+} _oriFilterTaps;
+
+/**
+ * @brief The row kernels used to generate mipmaps, chosen for the CPU when the first chain is generated.
+ * 
+ */
+typedef struct _oriMipmapKernels {
+    // halve a pair of 8-bit rows with a 2x2 box filter (width is the width of the destination row)
+    void (* boxRGBA8)(const unsigned char *, const unsigned char *, unsigned char *, unsigned int);
+    void (* boxR8)(const unsigned char *, const unsigned char *, unsigned char *, unsigned int);
+
+    // accum += weight * src
+    void (* accumulate)(float *, const float *, float, size_t);
+    // resample a row of 4 channel floats horizontally
+    void (* filterRGBA)(const float *, float *, const _oriFilterTaps *, unsigned int);
+
+    void (* decodeUnorm8)(const unsigned char *, float *, size_t);
+    void (* encodeUnorm8)(const float *, unsigned char *, size_t);
+    void (* decodeHalf)(const uint16_t *, float *, size_t);
+    void (* encodeHalf)(const float *, uint16_t *, size_t);
+} _oriMipmapKernels;
+
+/**
+ * @brief The generation of one mipmap level from the level before it, or the range of its rows that one thread generates.
+ * 
+ */
+typedef struct _oriMipmapLevelJob {
+    const unsigned char *src;
+    unsigned char *dst;
+
+    unsigned int srcWidth;
+    unsigned int srcHeight;
+    unsigned int dstWidth;
+    unsigned int dstHeight;
+
+    unsigned int channels;
+    unsigned int dataType;
+    bool srgb;
+
+    // NULL when the level is an exact 2x2 box reduction of 8-bit data, which is done with integer kernels instead
+    const _oriFilterTaps *xTaps;
+    const _oriFilterTaps *yTaps;
+
+    unsigned int rowBegin;
+    unsigned int rowEnd;
+} _oriMipmapLevelJob;
+
+static pthread_once_t _oriMipmapInitOnce = PTHREAD_ONCE_INIT;
+static _oriMipmapKernels _oriKernels;
+
+static float _oriSrgbDecode[256];
+static unsigned char _oriSrgbEncode[_ORION_SRGB_ENCODE_SIZE];
+
+// ======================================================================================
+// *****                           ORION HELPER FUNCTIONS                           *****
+// ======================================================================================
+
+static bool _oriMipmapFormat(const unsigned int imageFormat, const unsigned int dataType, unsigned int *channels, unsigned int *channelSize) {
+    switch (imageFormat) {
+        case GL_RED:  *channels = 1; break;
+        case GL_RG:   *channels = 2; break;
+        case GL_RGB:  *channels = 3; break;
+        case GL_RGBA: *channels = 4; break;
+        default: return false;
+    }
+
+    switch (dataType) {
+        case GL_UNSIGNED_BYTE: *channelSize = 1; break;
+        case GL_HALF_FLOAT:    *channelSize = 2; break;
+        default: return false;
+    }
+
+    return true;
+}
+
+static float _oriHalfToFloat(const uint16_t h) {
+    uint32_t sign = (uint32_t) (h & 0x8000) << 16;
+    uint32_t exponent = (h >> 10) & 0x1f;
+    uint32_t mantissa = h & 0x3ff;
+
+    uint32_t bits;
+    if (exponent == 0x1f) {
+        // infinity or NaN
+        bits = sign | 0x7f800000 | (mantissa << 13);
+    } else if (exponent) {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    } else if (mantissa) {
+        // subnormal halves are normal floats
+        exponent = 113;
+        while (!(mantissa & 0x400)) {
+            mantissa <<= 1;
+            exponent--;
+        }
+        bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+    } else {
+        bits = sign;
+    }
+
+    float f;
+    memcpy(&f, &bits, sizeof(float));
+    return f;
+}
+
+// (rounds to nearest even, as F16C does, so that every kernel gives the same result)
+static uint16_t _oriFloatToHalf(const float f) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(float));
+
+    uint16_t sign = (bits >> 16) & 0x8000;
+    uint32_t abs = bits & 0x7fffffff;
+
+    if (abs >= 0x7f800000) {
+        return sign | 0x7c00 | (abs > 0x7f800000 ? 0x200 : 0);
+    }
+    if (abs >= 0x477ff000) {
+        // too large; rounds to infinity
+        return sign | 0x7c00;
+    }
+
+    uint32_t r, remainder, halfway;
+    if (abs < 0x38800000) {
+        // subnormal (or zero) as a half
+        if (abs < 0x33000000) {
+            return sign;
+        }
+        uint32_t exponent = abs >> 23;
+        uint32_t mantissa = (abs & 0x7fffff) | 0x800000;
+        unsigned int shift = 126 - exponent;
+
+        r = mantissa >> shift;
+        remainder = mantissa & ((1u << shift) - 1);
+        halfway = 1u << (shift - 1);
+    } else {
+        r = (abs - 0x38000000) >> 13;
+        remainder = abs & 0x1fff;
+        halfway = 0x1000;
+    }
+
+    if (remainder > halfway || (remainder == halfway && (r & 1))) {
+        r++;
+    }
+    return sign | r;
+}
+
+static unsigned char _oriEncodeUnorm8Value(float v) {
+    v = v * 255.0f + 0.5f;
+    return !(v > 0.0f) ? 0 : v >= 255.0f ? 255 : (unsigned char) v;
+}
+
+static unsigned char _oriEncodeSrgbValue(const float v) {
+    if (!(v > 0.0f)) return _oriSrgbEncode[0];
+    if (v >= 1.0f) return _oriSrgbEncode[_ORION_SRGB_ENCODE_SIZE - 1];
+    return _oriSrgbEncode[(unsigned int) (v * (_ORION_SRGB_ENCODE_SIZE - 1) + 0.5f)];
+}
+
+// the modified Bessel function of the first kind, of order zero (a power series, which converges quickly for the
+// arguments the Kaiser window uses)
+static float _oriBesselI0(const float x) {
+    float sum = 1.0f;
+    float term = 1.0f;
+    for (int k = 1; k < 32; k++) {
+        float f = x / (2.0f * k);
+        term *= f * f;
+        sum += term;
+
+        if (term < sum * 1e-7f) {
+            break;
+        }
+    }
+    return sum;
+}
+
+// the weight of a source pixel whose centre is t destination pixels from the centre of a destination pixel
+static float _oriFilterWeight(const unsigned int filter, const float t) {
+    if (filter == ORION_MIPMAP_FILTER_BOX) {
+        return fabsf(t) <= 0.5f ? 1.0f : 0.0f;
+    }
+
+    // Kaiser-windowed sinc
+    float r = t / _ORION_KAISER_RADIUS;
+    if (r * r >= 1.0f) {
+        return 0.0f;
+    }
+
+    float sinc = t == 0.0f ? 1.0f : sinf(_ORION_PI * t) / (_ORION_PI * t);
+    return sinc * _oriBesselI0(_ORION_KAISER_ALPHA * sqrtf(1.0f - r * r)) / _oriBesselI0(_ORION_KAISER_ALPHA);
+}
+
+static void _oriComputeFilterTaps(_oriFilterTaps *taps, const unsigned int filter, const unsigned int srcSize, const unsigned int dstSize) {
+    float scale = (float) srcSize / dstSize;
+    float radius = (filter == ORION_MIPMAP_FILTER_BOX ? 0.5f : _ORION_KAISER_RADIUS) * scale;
+
+    // pixels past the edges are clamped to it, so no more than the whole dimension is ever read
+    unsigned int count = (unsigned int) (2.0f * radius) + 2;
+    if (count > srcSize) {
+        count = srcSize;
+    }
+
+    taps->count = count;
+    taps->first = malloc(dstSize * sizeof(unsigned int));
+    taps->weights = calloc((size_t) dstSize * count, sizeof(float));
+
+    for (unsigned int i = 0; i < dstSize; i++) {
+        float centre = (i + 0.5f) * scale;
+        int lo = (int) floorf(centre - radius);
+        int hi = (int) ceilf(centre + radius);
+
+        int first = lo < 0 ? 0 : lo > (int) (srcSize - count) ? (int) (srcSize - count) : lo;
+        float *w = taps->weights + (size_t) i * count;
+
+        float total = 0.0f;
+        for (int j = lo; j <= hi; j++) {
+            float weight = _oriFilterWeight(filter, (j + 0.5f - centre) / scale);
+            int clamped = j < 0 ? 0 : j >= (int) srcSize ? (int) srcSize - 1 : j;
+            if (weight == 0.0f || clamped < first || clamped >= first + (int) count) {
+                continue;
+            }
+
+            w[clamped - first] += weight;
+            total += weight;
+        }
+
+        for (unsigned int k = 0; k < count; k++) {
+            w[k] /= total;
+        }
+        taps->first[i] = first;
+    }
+}
+
+static void _oriFreeFilterTaps(_oriFilterTaps *taps) {
+    free(taps->first);
+    free(taps->weights);
+}
+
+// ======================================================================================
+// *****                          ORION SCALAR ROW KERNELS                          *****
+// ======================================================================================
+
+static void _oriBoxUnorm8Scalar(const unsigned char *row0, const unsigned char *row1, unsigned char *dst, const unsigned int width, const unsigned int channels) {
+    for (size_t i = 0; i < (size_t) width * channels; i++) {
+        size_t p = (i / channels) * channels * 2 + i % channels;
+        dst[i] = (row0[p] + row0[p + channels] + row1[p] + row1[p + channels] + 2) >> 2;
+    }
+}
+
+static void _oriBoxRGBA8Scalar(const unsigned char *row0, const unsigned char *row1, unsigned char *dst, const unsigned int width) {
+    _oriBoxUnorm8Scalar(row0, row1, dst, width, 4);
+}
+
+static void _oriBoxR8Scalar(const unsigned char *row0, const unsigned char *row1, unsigned char *dst, const unsigned int width) {
+    _oriBoxUnorm8Scalar(row0, row1, dst, width, 1);
+}
+
+static void _oriAccumulateScalar(float *accum, const float *src, const float weight, const size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        accum[i] += weight * src[i];
+    }
+}
+
+static void _oriFilterRowScalar(const float *src, float *dst, const _oriFilterTaps *taps, const unsigned int width, const unsigned int channels) {
+    for (unsigned int x = 0; x < width; x++) {
+        const float *s = src + (size_t) taps->first[x] * channels;
+        const float *w = taps->weights + (size_t) x * taps->count;
+
+        for (unsigned int c = 0; c < channels; c++) {
+            float sum = 0.0f;
+            for (unsigned int k = 0; k < taps->count; k++) {
+                sum += w[k] * s[k * channels + c];
+            }
+            dst[(size_t) x * channels + c] = sum;
+        }
+    }
+}
+
+static void _oriFilterRGBAScalar(const float *src, float *dst, const _oriFilterTaps *taps, const unsigned int width) {
+    _oriFilterRowScalar(src, dst, taps, width, 4);
+}
+
+static void _oriDecodeUnorm8Scalar(const unsigned char *src, float *dst, const size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = src[i] * (1.0f / 255.0f);
+    }
+}
+
+static void _oriEncodeUnorm8Scalar(const float *src, unsigned char *dst, const size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = _oriEncodeUnorm8Value(src[i]);
+    }
+}
+
+static void _oriDecodeHalfScalar(const uint16_t *src, float *dst, const size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = _oriHalfToFloat(src[i]);
+    }
+}
+
+static void _oriEncodeHalfScalar(const float *src, uint16_t *dst, const size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = _oriFloatToHalf(src[i]);
+    }
+}
+
+#ifdef _ORION_MIPMAP_X86
+
+// ======================================================================================
+// *****                           ORION SSE2 ROW KERNELS                           *****
+// ======================================================================================
+
+__attribute__((target("sse2")))
+static void _oriBoxRGBA8SSE2(const unsigned char *row0, const unsigned char *row1, unsigned char *dst, const unsigned int width) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i two = _mm_set1_epi16(2);
+
+    // 4 source pixels (2 destination pixels) at a time
+    unsigned int x = 0;
+    for (; x + 2 <= width; x += 2) {
+        __m128i a = _mm_loadu_si128((const __m128i *) (row0 + (size_t) x * 8));
+        __m128i b = _mm_loadu_si128((const __m128i *) (row1 + (size_t) x * 8));
+
+        // sum the rows as 16-bit channels (pixels 0 and 1, then pixels 2 and 3), then each pair of pixels
+        __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+        __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+        lo = _mm_add_epi16(lo, _mm_srli_si128(lo, 8));
+        hi = _mm_add_epi16(hi, _mm_srli_si128(hi, 8));
+
+        __m128i sum = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(lo, hi), two), 2);
+        _mm_storel_epi64((__m128i *) (dst + (size_t) x * 4), _mm_packus_epi16(sum, sum));
+    }
+
+    _oriBoxUnorm8Scalar(row0 + (size_t) x * 8, row1 + (size_t) x * 8, dst + (size_t) x * 4, width - x, 4);
+}
+
+__attribute__((target("sse2")))
+static void _oriBoxR8SSE2(const unsigned char *row0, const unsigned char *row1, unsigned char *dst, const unsigned int width) {
+    const __m128i mask = _mm_set1_epi16(0xff);
+    const __m128i two = _mm_set1_epi16(2);
+
+    // 16 source pixels (8 destination pixels) at a time. as 16-bit lanes, the even pixels are the low bytes and the odd
+    // pixels are the high bytes
+    unsigned int x = 0;
+    for (; x + 8 <= width; x += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i *) (row0 + (size_t) x * 2));
+        __m128i b = _mm_loadu_si128((const __m128i *) (row1 + (size_t) x * 2));
+
+        __m128i sum = _mm_add_epi16(
+            _mm_add_epi16(_mm_and_si128(a, mask), _mm_srli_epi16(a, 8)),
+            _mm_add_epi16(_mm_and_si128(b, mask), _mm_srli_epi16(b, 8))
+        );
+
+        sum = _mm_srli_epi16(_mm_add_epi16(sum, two), 2);
+        _mm_storel_epi64((__m128i *) (dst + x), _mm_packus_epi16(sum, sum));
+    }
+
+    _oriBoxUnorm8Scalar(row0 + (size_t) x * 2, row1 + (size_t) x * 2, dst + x, width - x, 1);
+}
+
+__attribute__((target("sse2")))
+static void _oriAccumulateSSE2(float *accum, const float *src, const float weight, const size_t count) {
+    const __m128 w = _mm_set1_ps(weight);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(accum + i, _mm_add_ps(_mm_loadu_ps(accum + i), _mm_mul_ps(w, _mm_loadu_ps(src + i))));
+    }
+
+    _oriAccumulateScalar(accum + i, src + i, weight, count - i);
+}
+
+__attribute__((target("sse2")))
+static void _oriFilterRGBASSE2(const float *src, float *dst, const _oriFilterTaps *taps, const unsigned int width) {
+    // one destination pixel (all 4 channels) at a time
+    for (unsigned int x = 0; x < width; x++) {
+        const float *s = src + (size_t) taps->first[x] * 4;
+        const float *w = taps->weights + (size_t) x * taps->count;
+
+        __m128 sum = _mm_setzero_ps();
+        for (unsigned int k = 0; k < taps->count; k++) {
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(w[k]), _mm_loadu_ps(s + k * 4)));
+        }
+        _mm_storeu_ps(dst + (size_t) x * 4, sum);
+    }
+}
+
+__attribute__((target("sse2")))
+static void _oriDecodeUnorm8SSE2(const unsigned char *src, float *dst, const size_t count) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *) (src + i));
+        __m128i lo = _mm_unpacklo_epi8(v, zero);
+        __m128i hi = _mm_unpackhi_epi8(v, zero);
+
+        _mm_storeu_ps(dst + i,      _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), scale));
+        _mm_storeu_ps(dst + i + 4,  _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), scale));
+        _mm_storeu_ps(dst + i + 8,  _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), scale));
+        _mm_storeu_ps(dst + i + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), scale));
+    }
+
+    _oriDecodeUnorm8Scalar(src + i, dst + i, count - i);
+}
+
+__attribute__((target("sse2")))
+static void _oriEncodeUnorm8SSE2(const float *src, unsigned char *dst, const size_t count) {
+    const __m128 scale = _mm_set1_ps(255.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+
+    // out of range values (and NaNs, which convert to INT_MIN) are clamped by the saturating packs
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i a = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(src + i), scale), half));
+        __m128i b = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(src + i + 4), scale), half));
+
+        __m128i packed = _mm_packs_epi32(a, b);
+        _mm_storel_epi64((__m128i *) (dst + i), _mm_packus_epi16(packed, packed));
+    }
+
+    _oriEncodeUnorm8Scalar(src + i, dst + i, count - i);
+}
+
+// ======================================================================================
+// *****                           ORION AVX2 ROW KERNELS                           *****
+// ======================================================================================
+
+// (the AVX2 kernels also use FMA and F16C, which every CPU with AVX2 has in practice, but they are checked for anyway)
+
+__attribute__((target("avx2,fma,f16c")))
+static void _oriBoxRGBA8AVX2(const unsigned char *row0, const unsigned char *row1, unsigned char *dst, const unsigned int width) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i two = _mm256_set1_epi16(2);
+
+    // 8 source pixels (4 destination pixels) at a time. the unpacks work within each 128-bit lane, so the low lane holds
+    // pixels 0 to 3 and the high lane holds pixels 4 to 7
+    unsigned int x = 0;
+    for (; x + 4 <= width; x += 4) {
+        __m256i a = _mm256_loadu_si256((const __m256i *) (row0 + (size_t) x * 8));
+        __m256i b = _mm256_loadu_si256((const __m256i *) (row1 + (size_t) x * 8));
+
+        __m256i lo = _mm256_add_epi16(_mm256_unpacklo_epi8(a, zero), _mm256_unpacklo_epi8(b, zero));
+        __m256i hi = _mm256_add_epi16(_mm256_unpackhi_epi8(a, zero), _mm256_unpackhi_epi8(b, zero));
+        lo = _mm256_add_epi16(lo, _mm256_srli_si256(lo, 8));
+        hi = _mm256_add_epi16(hi, _mm256_srli_si256(hi, 8));
+
+        __m256i sum = _mm256_srli_epi16(_mm256_add_epi16(_mm256_unpacklo_epi64(lo, hi), two), 2);
+
+        // the 4 destination pixels are in the low 64 bits of each lane; gather them into the low lane
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(sum, sum), 0x08);
+        _mm_storeu_si128((__m128i *) (dst + (size_t) x * 4), _mm256_castsi256_si128(packed));
+    }
+
+    _oriBoxRGBA8SSE2(row0 + (size_t) x * 8, row1 + (size_t) x * 8, dst + (size_t) x * 4, width - x);
+}
+
+__attribute__((target("avx2,fma,f16c")))
+static void _oriBoxR8AVX2(const unsigned char *row0, const unsigned char *row1, unsigned char *dst, const unsigned int width) {
+    const __m256i mask = _mm256_set1_epi16(0xff);
+    const __m256i two = _mm256_set1_epi16(2);
+
+    // 32 source pixels (16 destination pixels) at a time
+    unsigned int x = 0;
+    for (; x + 16 <= width; x += 16) {
+        __m256i a = _mm256_loadu_si256((const __m256i *) (row0 + (size_t) x * 2));
+        __m256i b = _mm256_loadu_si256((const __m256i *) (row1 + (size_t) x * 2));
+
+        __m256i sum = _mm256_add_epi16(
+            _mm256_add_epi16(_mm256_and_si256(a, mask), _mm256_srli_epi16(a, 8)),
+            _mm256_add_epi16(_mm256_and_si256(b, mask), _mm256_srli_epi16(b, 8))
+        );
+
+        sum = _mm256_srli_epi16(_mm256_add_epi16(sum, two), 2);
+
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(sum, sum), 0x08);
+        _mm_storeu_si128((__m128i *) (dst + x), _mm256_castsi256_si128(packed));
+    }
+
+    _oriBoxR8SSE2(row0 + (size_t) x * 2, row1 + (size_t) x * 2, dst + x, width - x);
+}
+
+__attribute__((target("avx2,fma,f16c")))
+static void _oriAccumulateAVX2(float *accum, const float *src, const float weight, const size_t count) {
+    const __m256 w = _mm256_set1_ps(weight);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(accum + i, _mm256_fmadd_ps(w, _mm256_loadu_ps(src + i), _mm256_loadu_ps(accum + i)));
+    }
+
+    _oriAccumulateScalar(accum + i, src + i, weight, count - i);
+}
+
+__attribute__((target("avx2,fma,f16c")))
+static void _oriFilterRGBAAVX2(const float *src, float *dst, const _oriFilterTaps *taps, const unsigned int width) {
+    // two destination pixels at a time, one in each lane
+    unsigned int x = 0;
+    for (; x + 2 <= width; x += 2) {
+        const float *s0 = src + (size_t) taps->first[x] * 4;
+        const float *s1 = src + (size_t) taps->first[x + 1] * 4;
+        const float *w0 = taps->weights + (size_t) x * taps->count;
+        const float *w1 = w0 + taps->count;
+
+        __m256 sum = _mm256_setzero_ps();
+        for (unsigned int k = 0; k < taps->count; k++) {
+            __m256 pixels = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(s0 + k * 4)), _mm_loadu_ps(s1 + k * 4), 1);
+            __m256 weights = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(w0[k])), _mm_set1_ps(w1[k]), 1);
+            sum = _mm256_fmadd_ps(weights, pixels, sum);
+        }
+        _mm256_storeu_ps(dst + (size_t) x * 4, sum);
+    }
+
+    if (x < width) {
+        // (the last pixel of an odd row)
+        const _oriFilterTaps last = { taps->count, taps->first + x, taps->weights + (size_t) x * taps->count };
+        _oriFilterRowScalar(src, dst + (size_t) x * 4, &last, width - x, 4);
+    }
+}
+
+__attribute__((target("avx2,fma,f16c")))
+static void _oriDecodeUnorm8AVX2(const unsigned char *src, float *dst, const size_t count) {
+    const __m256 scale = _mm256_set1_ps(1.0f / 255.0f);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i v = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *) (src + i)));
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+    }
+
+    _oriDecodeUnorm8Scalar(src + i, dst + i, count - i);
+}
+
+__attribute__((target("avx2,fma,f16c")))
+static void _oriEncodeUnorm8AVX2(const float *src, unsigned char *dst, const size_t count) {
+    const __m256 scale = _mm256_set1_ps(255.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i a = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(src + i), scale), half));
+        __m256i b = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(src + i + 8), scale), half));
+
+        // packs works within each lane (a0-3 b0-3 | a4-7 b4-7), so the 64-bit blocks are reordered after it
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xd8);
+        __m128i bytes = _mm_packus_epi16(_mm256_castsi256_si128(packed), _mm256_extracti128_si256(packed, 1));
+        _mm_storeu_si128((__m128i *) (dst + i), bytes);
+    }
+
+    _oriEncodeUnorm8SSE2(src + i, dst + i, count - i);
+}
+
+__attribute__((target("avx2,fma,f16c")))
+static void _oriDecodeHalfAVX2(const uint16_t *src, float *dst, const size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *) (src + i))));
+    }
+
+    _oriDecodeHalfScalar(src + i, dst + i, count - i);
+}
+
+__attribute__((target("avx2,fma,f16c")))
+static void _oriEncodeHalfAVX2(const float *src, uint16_t *dst, const size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm_storeu_si128((__m128i *) (dst + i), _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT));
+    }
+
+    _oriEncodeHalfScalar(src + i, dst + i, count - i);
+}
+
+#endif // _ORION_MIPMAP_X86
+
+// ======================================================================================
+// *****                      ORION MIPMAP GENERATOR FUNCTIONS                      *****
+// ======================================================================================
+
+// build the sRGB tables and choose the kernels for this CPU (once, from whichever thread generates the first chain)
+static void _oriInitMipmapGenerator() {
+    for (unsigned int i = 0; i < 256; i++) {
+        float c = i / 255.0f;
+        _oriSrgbDecode[i] = c <= 0.04045f ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+    }
+    for (unsigned int i = 0; i < _ORION_SRGB_ENCODE_SIZE; i++) {
+        float l = (float) i / (_ORION_SRGB_ENCODE_SIZE - 1);
+        float c = l <= 0.0031308f ? l * 12.92f : 1.055f * powf(l, 1.0f / 2.4f) - 0.055f;
+        _oriSrgbEncode[i] = _oriEncodeUnorm8Value(c);
+    }
+
+    _oriKernels = (_oriMipmapKernels) {
+        _oriBoxRGBA8Scalar, _oriBoxR8Scalar,
+        _oriAccumulateScalar, _oriFilterRGBAScalar,
+        _oriDecodeUnorm8Scalar, _oriEncodeUnorm8Scalar,
+        _oriDecodeHalfScalar, _oriEncodeHalfScalar
+    };
+
+#ifdef _ORION_MIPMAP_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("sse2")) {
+        _oriKernels.boxRGBA8 = _oriBoxRGBA8SSE2;
+        _oriKernels.boxR8 = _oriBoxR8SSE2;
+        _oriKernels.accumulate = _oriAccumulateSSE2;
+        _oriKernels.filterRGBA = _oriFilterRGBASSE2;
+        _oriKernels.decodeUnorm8 = _oriDecodeUnorm8SSE2;
+        _oriKernels.encodeUnorm8 = _oriEncodeUnorm8SSE2;
+    }
+
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") && __builtin_cpu_supports("f16c")) {
+        _oriKernels = (_oriMipmapKernels) {
+            _oriBoxRGBA8AVX2, _oriBoxR8AVX2,
+            _oriAccumulateAVX2, _oriFilterRGBAAVX2,
+            _oriDecodeUnorm8AVX2, _oriEncodeUnorm8AVX2,
+            _oriDecodeHalfAVX2, _oriEncodeHalfAVX2
+        };
+    }
+#endif
+}
+
+// convert a row of a level to floats (the colour channels of sRGB data are linearised; alpha never is)
+static void _oriDecodeRow(const _oriMipmapLevelJob *job, const unsigned char *src, float *dst) {
+    size_t count = (size_t) job->srcWidth * job->channels;
+
+    if (job->dataType == GL_HALF_FLOAT) {
+        _oriKernels.decodeHalf((const uint16_t *) src, dst, count);
+    } else if (!job->srgb) {
+        _oriKernels.decodeUnorm8(src, dst, count);
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            dst[i] = job->channels == 4 && i % 4 == 3 ? src[i] * (1.0f / 255.0f) : _oriSrgbDecode[src[i]];
+        }
+    }
+}
+
+static void _oriEncodeRow(const _oriMipmapLevelJob *job, const float *src, unsigned char *dst) {
+    size_t count = (size_t) job->dstWidth * job->channels;
+
+    if (job->dataType == GL_HALF_FLOAT) {
+        _oriKernels.encodeHalf(src, (uint16_t *) dst, count);
+    } else if (!job->srgb) {
+        _oriKernels.encodeUnorm8(src, dst, count);
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            dst[i] = job->channels == 4 && i % 4 == 3 ? _oriEncodeUnorm8Value(src[i]) : _oriEncodeSrgbValue(src[i]);
+        }
+    }
+}
+
+// generate rows rowBegin to rowEnd of a level (the entry point of each thread a level is split between)
+static void *_oriGenerateLevelRows(void *arg) {
+    const _oriMipmapLevelJob *job = arg;
+
+    size_t pixelSize = job->channels * (job->dataType == GL_HALF_FLOAT ? 2 : 1);
+    size_t srcPitch = (size_t) job->srcWidth * pixelSize;
+    size_t dstPitch = (size_t) job->dstWidth * pixelSize;
+
+    if (!job->xTaps) {
+        for (unsigned int y = job->rowBegin; y < job->rowEnd; y++) {
+            const unsigned char *row0 = job->src + (size_t) y * 2 * srcPitch;
+            const unsigned char *row1 = row0 + srcPitch;
+            unsigned char *dst = job->dst + (size_t) y * dstPitch;
+
+            switch (job->channels) {
+                case 4:  _oriKernels.boxRGBA8(row0, row1, dst, job->dstWidth); break;
+                case 1:  _oriKernels.boxR8(row0, row1, dst, job->dstWidth); break;
+                default: _oriBoxUnorm8Scalar(row0, row1, dst, job->dstWidth, job->channels); break;
+            }
+        }
+        return NULL;
+    }
+
+    // the filter is separable: each destination row is first accumulated from the source rows it covers, then resampled
+    // horizontally
+    size_t srcCount = (size_t) job->srcWidth * job->channels;
+    float *row = malloc(srcCount * sizeof(float));
+    float *accum = malloc(srcCount * sizeof(float));
+    float *out = malloc((size_t) job->dstWidth * job->channels * sizeof(float));
+
+    const _oriFilterTaps *yTaps = job->yTaps;
+    for (unsigned int y = job->rowBegin; y < job->rowEnd; y++) {
+        memset(accum, 0, srcCount * sizeof(float));
+
+        for (unsigned int k = 0; k < yTaps->count; k++) {
+            float weight = yTaps->weights[(size_t) y * yTaps->count + k];
+            if (weight == 0.0f) {
+                continue;
+            }
+
+            _oriDecodeRow(job, job->src + (size_t) (yTaps->first[y] + k) * srcPitch, row);
+            _oriKernels.accumulate(accum, row, weight, srcCount);
+        }
+
+        if (job->channels == 4) {
+            _oriKernels.filterRGBA(accum, out, job->xTaps, job->dstWidth);
+        } else {
+            _oriFilterRowScalar(accum, out, job->xTaps, job->dstWidth, job->channels);
+        }
+
+        _oriEncodeRow(job, out, job->dst + (size_t) y * dstPitch);
+    }
+
+    free(row);
+    free(accum);
+    free(out);
+
+    return NULL;
+}
+
+static void _oriGenerateLevel(_oriMipmapLevelJob *level, unsigned int threadCount) {
+    unsigned int useful = (level->dstHeight + _ORION_MIPMAP_ROWS_PER_THREAD - 1) / _ORION_MIPMAP_ROWS_PER_THREAD;
+    if (threadCount > useful) {
+        threadCount = useful;
+    }
+
+    if (threadCount <= 1) {
+        level->rowBegin = 0;
+        level->rowEnd = level->dstHeight;
+        _oriGenerateLevelRows(level);
+        return;
+    }
+
+    pthread_t threads[_ORION_MAX_MIPMAP_THREADS];
+    bool started[_ORION_MAX_MIPMAP_THREADS];
+    _oriMipmapLevelJob jobs[_ORION_MAX_MIPMAP_THREADS];
+
+    for (unsigned int i = 0; i < threadCount; i++) {
+        jobs[i] = *level;
+        jobs[i].rowBegin = (unsigned int) ((uint64_t) level->dstHeight * i / threadCount);
+        jobs[i].rowEnd = (unsigned int) ((uint64_t) level->dstHeight * (i + 1) / threadCount);
+    }
+
+    // the calling thread generates the first block (and any block whose thread couldn't be started)
+    for (unsigned int i = 1; i < threadCount; i++) {
+        started[i] = pthread_create(&threads[i], NULL, _oriGenerateLevelRows, &jobs[i]) == 0;
+    }
+
+    _oriGenerateLevelRows(&jobs[0]);
+
+    for (unsigned int i = 1; i < threadCount; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        } else {
+            _oriGenerateLevelRows(&jobs[i]);
+        }
+    }
+}
+
+// ======================================================================================
+// *****                           ORION MIPMAP FUNCTIONS                           *****
+// ======================================================================================
+
+/**
+ * @brief Return the number of levels in a full mipmap chain for an image of the given size.
+ * 
+ * @param width the width of the base level.
+ * @param height the height of the base level.
+ * 
+ * @ingroup textures
+ */
+unsigned int oriMipmapLevelCount(unsigned int width, unsigned int height) {
+    unsigned int levels = 1;
+    while (width > 1 || height > 1) {
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+        levels++;
+    }
+    return levels;
+}
+
+/**
+ * @brief Return the size, in bytes, of a tightly packed mipmap chain.
+ * @details The levels of a chain are stored one after another, starting with the base level, and each level is half the
+ * size of the one before it (rounded down, to a minimum of 1) in each dimension. Rows are not padded.
+ * 
+ * @param width the width of the base level.
+ * @param height the height of the base level.
+ * @param levels the number of levels in the chain.
+ * @param imageFormat the format of the pixel data (@c GL_RED, @c GL_RG, @c GL_RGB or @c GL_RGBA).
+ * @param dataType the data type of the pixel data (@c GL_UNSIGNED_BYTE or @c GL_HALF_FLOAT).
+ * 
+ * @return the size of the chain, or 0 if the format isn't supported.
+ * 
+ * @ingroup textures
+ */
+size_t oriMipmapChainSize(unsigned int width, unsigned int height, const unsigned int levels, const unsigned int imageFormat, const unsigned int dataType) {
+    unsigned int channels, channelSize;
+    if (!_oriMipmapFormat(imageFormat, dataType, &channels, &channelSize)) {
+        _orionThrowWarning("(in oriMipmapChainSize()): Only GL_RED, GL_RG, GL_RGB and GL_RGBA images of GL_UNSIGNED_BYTE or GL_HALF_FLOAT data are supported.");
+        return 0;
+    }
+
+    size_t size = 0;
+    for (unsigned int i = 0; i < levels; i++) {
+        size += (size_t) width * height * channels * channelSize;
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    return size;
+}
+
+/**
+ * @brief Generate every mipmap level of an image on the CPU.
+ * @details The base level must already be at the start of @c chain, which must be large enough for the whole chain (see
+ * oriMipmapChainSize()). Each level is then filtered from the one before it and written after it.
+ * 
+ * No OpenGL context is needed, so chains can be generated ahead of time (e.g. when assets are baked) or on worker threads.
+ * The rows of each level are split between @c threadCount threads, and the filters use SSE2 or AVX2 where the CPU supports it.
+ * 
+ * @c ORION_MIPMAP_FILTER_BOX averages each 2x2 block of pixels, and is the fastest. @c ORION_MIPMAP_FILTER_KAISER uses a
+ * Kaiser-windowed sinc filter, which keeps distant levels much sharper without aliasing.
+ * 
+ * If @c srgb is true, the colour channels of @c GL_UNSIGNED_BYTE images are converted to linear values before they are
+ * filtered and back afterwards (as they should be for images stored in sRGB formats). The fourth channel is treated as
+ * alpha and is always filtered linearly. @c GL_HALF_FLOAT images are always linear.
+ * 
+ * @param chain the image and the memory for its mipmaps.
+ * @param width the width of the base level.
+ * @param height the height of the base level.
+ * @param levels the number of levels in the chain, including the base level (see oriMipmapLevelCount()).
+ * @param imageFormat the format of the pixel data (@c GL_RED, @c GL_RG, @c GL_RGB or @c GL_RGBA).
+ * @param dataType the data type of the pixel data (@c GL_UNSIGNED_BYTE or @c GL_HALF_FLOAT).
+ * @param filter the filter to downsample with (@c ORION_MIPMAP_FILTER_BOX or @c ORION_MIPMAP_FILTER_KAISER).
+ * @param srgb whether the image is sRGB encoded.
+ * @param threadCount the number of threads to use, or 0 to use one per CPU core.
+ * 
+ * @return false if the format isn't supported or there are too many levels, in which case nothing is written.
+ * 
+ * @ingroup textures
+ */
+bool oriGenerateMipmapChain(void *chain, const unsigned int width, const unsigned int height, const unsigned int levels, const unsigned int imageFormat, const unsigned int dataType, const unsigned int filter, const bool srgb, unsigned int threadCount) {
+    unsigned int channels, channelSize;
+    if (!_oriMipmapFormat(imageFormat, dataType, &channels, &channelSize)) {
+        _orionThrowWarning("(in oriGenerateMipmapChain()): Only GL_RED, GL_RG, GL_RGB and GL_RGBA images of GL_UNSIGNED_BYTE or GL_HALF_FLOAT data are supported.");
+        return false;
+    }
+    if (levels > oriMipmapLevelCount(width, height)) {
+        _orionThrowWarning("(in oriGenerateMipmapChain()): There are more levels than in a full mipmap chain. Mipmaps not generated.");
+        return false;
+    }
+
+    pthread_once(&_oriMipmapInitOnce, _oriInitMipmapGenerator);
+
+    if (!threadCount) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        threadCount = cores < 1 ? 1 : cores;
+    }
+    if (threadCount > _ORION_MAX_MIPMAP_THREADS) {
+        threadCount = _ORION_MAX_MIPMAP_THREADS;
+    }
+
+    unsigned char *src = chain;
+    unsigned int w = width, h = height;
+    for (unsigned int i = 1; i < levels; i++) {
+        _oriMipmapLevelJob level = {
+            .src = src,
+            .dst = src + (size_t) w * h * channels * channelSize,
+            .srcWidth = w,
+            .srcHeight = h,
+            .dstWidth = w > 1 ? w / 2 : 1,
+            .dstHeight = h > 1 ? h / 2 : 1,
+            .channels = channels,
+            .dataType = dataType,
+            .srgb = srgb && dataType == GL_UNSIGNED_BYTE
+        };
+
+        // an even-sized 8-bit level that is box filtered in the space it is stored in is exactly a 2x2 average
+        bool exactBox = filter == ORION_MIPMAP_FILTER_BOX && !level.srgb && dataType == GL_UNSIGNED_BYTE && w % 2 == 0 && h % 2 == 0;
+
+        _oriFilterTaps xTaps, yTaps;
+        if (!exactBox) {
+            _oriComputeFilterTaps(&xTaps, filter, level.srcWidth, level.dstWidth);
+            _oriComputeFilterTaps(&yTaps, filter, level.srcHeight, level.dstHeight);
+            level.xTaps = &xTaps;
+            level.yTaps = &yTaps;
+        }
+
+        _oriGenerateLevel(&level, threadCount);
+
+        if (!exactBox) {
+            _oriFreeFilterTaps(&xTaps);
+            _oriFreeFilterTaps(&yTaps);
+        }
+
+        src = level.dst;
+        w = level.dstWidth;
+        h = level.dstHeight;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Upload every level of a mipmap chain to a 2D texture.
+ * @details The chain is laid out as described in oriMipmapChainSize() (e.g. generated with oriGenerateMipmapChain()), and the
+ * texture must already have storage for every level of it (e.g. from oriCreateTextureImmutable()). Each level is uploaded
+ * with oriUploadTexSubImage().
+ * 
+ * @param texture the texture to upload to.
+ * @param chain the mipmap chain.
+ * @param width the width of the base level.
+ * @param height the height of the base level.
+ * @param levels the number of levels to upload.
+ * @param imageFormat the format of the pixel data (@c GL_RED, @c GL_RG, @c GL_RGB or @c GL_RGBA).
+ * @param dataType the data type of the pixel data (@c GL_UNSIGNED_BYTE or @c GL_HALF_FLOAT).
+ * 
+ * @ingroup textures
+ */
+void oriUploadMipmapChain(oriTexture *texture, const void *chain, const unsigned int width, const unsigned int height, const unsigned int levels, const unsigned int imageFormat, const unsigned int dataType) {
+    unsigned int channels, channelSize;
+    if (!_oriMipmapFormat(imageFormat, dataType, &channels, &channelSize)) {
+        _orionThrowWarning("(in oriUploadMipmapChain()): Only GL_RED, GL_RG, GL_RGB and GL_RGBA images of GL_UNSIGNED_BYTE or GL_HALF_FLOAT data are supported.");
+        return;
+    }
+
+    // rows are tightly packed
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    const unsigned char *level = chain;
+    unsigned int w = width, h = height;
+    for (unsigned int i = 0; i < levels; i++) {
+        oriUploadTexSubImage(texture, i, 0, 0, 0, w, h, 1, imageFormat, dataType, level, 0, 0, 0);
+
+        level += (size_t) w * h * channels * channelSize;
+        w = w > 1 ? w / 2 : 1;
+        h = h > 1 ? h / 2 : 1;
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
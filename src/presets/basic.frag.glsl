@@ -21,8 +21,14 @@ in vec4 vertexColour;                           // colour value of the vertex
 
 uniform Blend blend;
 
+// the blend mode can be fixed when the shader is compiled, by defining ORION_BLEND_MODE (e.g. with oriGetShaderVariant()).
+// the switch below is then resolved by the compiler; otherwise, it is chosen at runtime with blend.mode.
+#ifndef ORION_BLEND_MODE
+#define ORION_BLEND_MODE blend.mode
+#endif
+
 void main() {
-    // blend based on blend.mode
+    // blend based on ORION_BLEND_MODE
     // 1 = solid colour only
     // 2 = texture only
     // 3 = gradient (vertex colours) only
@@ -30,7 +36,7 @@ void main() {
     // 5 = solid colour and gradient
     // 6 = texture and gradient
     // 7 = all colour sources
-    switch (blend.mode) {
+    switch (ORION_BLEND_MODE) {
         case 1:
             fragColour = blend.colour;
             break;
@@ -0,0 +1,352 @@
+/* *************************************************************************************** */
+/*                        ORION GRAPHICS LIBRARY AND RENDERING ENGINE                      */
+/* *************************************************************************************** */
+/* Copyright (c) 2022 Jack Bennett                                                         */
+/* --------------------------------------------------------------------------------------- */
+/* THE  SOFTWARE IS  PROVIDED "AS IS",  WITHOUT WARRANTY OF ANY KIND, EXPRESS  OR IMPLIED, */
+/* INCLUDING  BUT  NOT  LIMITED  TO  THE  WARRANTIES  OF  MERCHANTABILITY,  FITNESS FOR  A */
+/* PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN  NO EVENT SHALL  THE  AUTHORS  OR COPYRIGHT */
+/* HOLDERS  BE  LIABLE  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF */
+/* CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR */
+/* THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                              */
+/* *************************************************************************************** */
+
+#include "internal.h"
+#include "oriongl.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include <utime.h>
+
+// ======================================================================================
+// *****                          ORION INTERNAL DATA TYPES                         *****
+// ======================================================================================
+
+#define _ORION_PROGRAM_CACHE_MAGIC "ORPB"
+#define _ORION_PROGRAM_CACHE_VERSION 1
+#define _ORION_PROGRAM_CACHE_EXTENSION ".glbin"
+
+/**
+ * @brief The header at the start of every program cache file, followed by the program binary itself.
+ * 
+ */
+typedef struct _oriProgramCacheHeader {
+    char magic[4];
+    uint32_t version;
+
+    // the full key of the entry, as the file name alone could collide
+    uint64_t key;
+
+    uint32_t binaryFormat;
+    uint32_t binaryLength;
+} _oriProgramCacheHeader;
+
+typedef struct _oriProgramCacheFile {
+    char *path;
+    time_t lastUsed;
+    unsigned long size;
+} _oriProgramCacheFile;
+
+// ======================================================================================
+// *****                           ORION HELPER FUNCTIONS                           *****
+// ======================================================================================
+
+// continue a 64-bit FNV-1a hash over the given bytes
+static uint64_t _oriHash64(uint64_t h, const void *data, const size_t size) {
+    const unsigned char *bytes = data;
+    for (size_t i = 0; i < size; i++) {
+        h ^= bytes[i];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+// the key of a program in the cache: its sources, and the driver that compiled it
+static void _oriProgramCachePath(char *path, const size_t size, const uint64_t sourceHash) {
+    uint64_t key = _oriHash64(sourceHash, &_orion.programCache.driverHash, sizeof(uint64_t));
+    snprintf(path, size, "%s/%016llx" _ORION_PROGRAM_CACHE_EXTENSION, _orion.programCache.dir, (unsigned long long) key);
+}
+
+static int _oriCompareProgramCacheFiles(const void *a, const void *b) {
+    const _oriProgramCacheFile *fa = a;
+    const _oriProgramCacheFile *fb = b;
+
+    return (fa->lastUsed > fb->lastUsed) - (fa->lastUsed < fb->lastUsed);
+}
+
+// delete the least recently used entries in the cache until it fits in its size limit.
+// the modification time of each file is used as its last use time (it is updated whenever the entry is loaded).
+static void _oriTrimProgramCache() {
+    DIR *dir = opendir(_orion.programCache.dir);
+    if (!dir) {
+        return;
+    }
+
+    _oriProgramCacheFile *files = NULL;
+    unsigned int fileCount = 0;
+    unsigned int fileCapacity = 0;
+    unsigned long totalSize = 0;
+
+    size_t extLength = strlen(_ORION_PROGRAM_CACHE_EXTENSION);
+    struct dirent *entry;
+    while ((entry = readdir(dir))) {
+        size_t nameLength = strlen(entry->d_name);
+        if (nameLength <= extLength || strcmp(entry->d_name + nameLength - extLength, _ORION_PROGRAM_CACHE_EXTENSION)) {
+            continue;
+        }
+
+        char *path = malloc(strlen(_orion.programCache.dir) + nameLength + 2);
+        sprintf(path, "%s/%s", _orion.programCache.dir, entry->d_name);
+
+        struct stat st;
+        if (stat(path, &st) != 0) {
+            free(path);
+            continue;
+        }
+
+        if (fileCount == fileCapacity) {
+            fileCapacity = fileCapacity ? fileCapacity * 2 : 64;
+            files = realloc(files, fileCapacity * sizeof(_oriProgramCacheFile));
+        }
+        files[fileCount].path = path;
+        files[fileCount].lastUsed = st.st_mtime;
+        files[fileCount].size = st.st_size;
+        fileCount++;
+
+        totalSize += st.st_size;
+    }
+    closedir(dir);
+
+    if (totalSize > _orion.programCache.maxSize) {
+        qsort(files, fileCount, sizeof(_oriProgramCacheFile), _oriCompareProgramCacheFiles);
+
+        for (unsigned int i = 0; i < fileCount && totalSize > _orion.programCache.maxSize; i++) {
+            if (unlink(files[i].path) == 0) {
+                totalSize -= files[i].size;
+            }
+        }
+    }
+
+    for (unsigned int i = 0; i < fileCount; i++) {
+        free(files[i].path);
+    }
+    free(files);
+}
+
+// ======================================================================================
+// *****                      ORION INTERNAL PROGRAM CACHE FUNCTIONS                *****
+// ======================================================================================
+
+/**
+ * @brief Continue the hash of a program's sources with the given shader stage.
+ * @details Start with @c _ORION_FNV64_OFFSET, and add every stage of the program in order.
+ * 
+ */
+uint64_t _orionHashProgramSource(uint64_t hash, const unsigned int type, const char *src) {
+    hash = _oriHash64(hash, &type, sizeof(type));
+    return _oriHash64(hash, src, strlen(src));
+}
+
+/**
+ * @brief Try to load the program with the given source hash from the program cache into @c program.
+ * 
+ * @return true if the program was loaded and linked successfully; false if it has to be compiled from source.
+ */
+bool _orionLoadProgramBinary(const unsigned int program, const uint64_t sourceHash) {
+    if (!_orion.programCache.dir) {
+        return false;
+    }
+
+    char path[4096];
+    _oriProgramCachePath(path, sizeof(path), sourceHash);
+
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        _orion.programCache.misses++;
+        return false;
+    }
+
+    _oriProgramCacheHeader header;
+    void *binary = NULL;
+    bool loaded = false;
+
+    if (fread(&header, sizeof(header), 1, f) == 1 &&
+        !memcmp(header.magic, _ORION_PROGRAM_CACHE_MAGIC, 4) &&
+        header.version == _ORION_PROGRAM_CACHE_VERSION &&
+        header.key == _oriHash64(sourceHash, &_orion.programCache.driverHash, sizeof(uint64_t))) {
+        binary = malloc(header.binaryLength);
+
+        if (fread(binary, 1, header.binaryLength, f) == header.binaryLength) {
+            glProgramBinary(program, header.binaryFormat, binary, header.binaryLength);
+
+            // the driver can reject a binary at any time (e.g. after it has been updated)
+            int status;
+            glGetProgramiv(program, GL_LINK_STATUS, &status);
+            loaded = status;
+        }
+    }
+
+    free(binary);
+    fclose(f);
+
+    if (!loaded) {
+        // the entry is no use to anyone
+        unlink(path);
+        _orion.programCache.misses++;
+        return false;
+    }
+
+    // mark the entry as recently used
+    utime(path, NULL);
+    _orion.programCache.hits++;
+    return true;
+}
+
+/**
+ * @brief Store the binary of the given (successfully linked) program in the program cache.
+ * 
+ */
+void _orionSaveProgramBinary(const unsigned int program, const uint64_t sourceHash) {
+    if (!_orion.programCache.dir) {
+        return;
+    }
+
+    int length;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+
+    _oriProgramCacheHeader header;
+    memcpy(header.magic, _ORION_PROGRAM_CACHE_MAGIC, 4);
+    header.version = _ORION_PROGRAM_CACHE_VERSION;
+    header.key = _oriHash64(sourceHash, &_orion.programCache.driverHash, sizeof(uint64_t));
+
+    void *binary = malloc(length);
+    glGetProgramBinary(program, length, &length, &header.binaryFormat, binary);
+    header.binaryLength = length;
+
+    char path[4096];
+    _oriProgramCachePath(path, sizeof(path), sourceHash);
+
+    // write to a temporary file first, so that a reader never sees a partially written entry
+    char tmpPath[4096 + 8];
+    snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
+
+    FILE *f = fopen(tmpPath, "wb");
+    if (!f) {
+        free(binary);
+        return;
+    }
+
+    bool written = fwrite(&header, sizeof(header), 1, f) == 1 && fwrite(binary, 1, length, f) == (size_t) length;
+    written = !fclose(f) && written;
+    free(binary);
+
+    if (!written || rename(tmpPath, path) != 0) {
+        unlink(tmpPath);
+        return;
+    }
+
+    _oriTrimProgramCache();
+}
+
+// ======================================================================================
+// *****                        ORION PROGRAM CACHE FUNCTIONS                       *****
+// ======================================================================================
+
+/**
+ * @brief Enable the on-disk program binary cache.
+ * @details Once enabled, every shader program that is linked successfully is stored in @c dir with glGetProgramBinary().
+ * When a program with exactly the same sources is built again (e.g. the next time the application is run), it is loaded
+ * with glProgramBinary() instead of being compiled. Entries are keyed by the program's sources and the identity of the
+ * driver (vendor, renderer and version strings), and binaries that the driver rejects are recompiled from source.
+ * 
+ * When the cache grows larger than @c maxSize, the least recently used entries are deleted.
+ * 
+ * @note OpenGL must be loaded before this is called. If the driver supports no program binary formats, the cache is not enabled.
+ * 
+ * @param dir the directory to store the cache in (relative to the executable). It is created if it doesn't exist.
+ * @param maxSize the maximum size of the cache on disk, in bytes.
+ * 
+ * @sa <a href="https://www.khronos.org/opengl/wiki/Shader_Compilation#Binary_upload">OpenGL/Program binary upload</a>
+ * 
+ * @ingroup shaders
+ */
+void oriEnableProgramCache(const char *dir, const unsigned long maxSize) {
+    _orionAssertVersion(410);
+
+    if (!_orion.glLoaded) {
+        _orionThrowError(ORERR_GL_NOT_LOADED);
+    }
+
+    int formatCount;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    if (formatCount <= 0) {
+        _orionThrowWarning("(in oriEnableProgramCache()): The OpenGL driver does not support any program binary formats. The program cache is not enabled.");
+        return;
+    }
+
+    if (mkdir(dir, 0755) != 0 && access(dir, W_OK) != 0) {
+        // As string formatted is required here, printf is used instead of _orionThrowWarning.
+        // This is annoying and be sure to change the style of this message if the style in _orionThrowWarning changes.
+        printf("[Orion : WARN] >> (in oriEnableProgramCache()): The cache directory %s could not be created or is not writable.\n", dir);
+        return;
+    }
+
+    oriDisableProgramCache();
+
+    _orion.programCache.dir = malloc(strlen(dir) + 1);
+    strcpy(_orion.programCache.dir, dir);
+    _orion.programCache.maxSize = maxSize;
+
+    // a binary can only be loaded by the same driver that created it
+    const char *driverStrings[] = {
+        (const char *) glGetString(GL_VENDOR),
+        (const char *) glGetString(GL_RENDERER),
+        (const char *) glGetString(GL_VERSION),
+        (const char *) glGetString(GL_SHADING_LANGUAGE_VERSION),
+    };
+
+    uint64_t h = _ORION_FNV64_OFFSET;
+    for (unsigned int i = 0; i < 4; i++) {
+        if (driverStrings[i]) {
+            h = _oriHash64(h, driverStrings[i], strlen(driverStrings[i]) + 1);
+        }
+    }
+    _orion.programCache.driverHash = h;
+
+    _oriTrimProgramCache();
+}
+
+/**
+ * @brief Disable the on-disk program binary cache. The files already in the cache are kept.
+ * 
+ * @ingroup shaders
+ */
+void oriDisableProgramCache() {
+    free(_orion.programCache.dir);
+    _orion.programCache.dir = NULL;
+}
+
+/**
+ * @brief Return the number of programs that were loaded from (and that could not be found in) the program cache.
+ * 
+ * @details If you don't want to recieve a value, pass NULL as the argument.
+ * 
+ * @param hits the number of programs loaded from the cache.
+ * @param misses the number of programs that had to be compiled from source.
+ * 
+ * @ingroup shaders
+ */
+void oriGetProgramCacheStats(unsigned int *hits, unsigned int *misses) {
+    if (hits) *hits = _orion.programCache.hits;
+    if (misses) *misses = _orion.programCache.misses;
+}
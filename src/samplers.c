@@ -0,0 +1,257 @@
+/* *************************************************************************************** */
+/*                        ORION GRAPHICS LIBRARY AND RENDERING ENGINE                      */
+/* *************************************************************************************** */
+/* Copyright (c) 2022 Jack Bennett                                                         */
+/* --------------------------------------------------------------------------------------- */
+/* THE  SOFTWARE IS  PROVIDED "AS IS",  WITHOUT WARRANTY OF ANY KIND, EXPRESS  OR IMPLIED, */
+/* INCLUDING  BUT  NOT  LIMITED  TO  THE  WARRANTIES  OF  MERCHANTABILITY,  FITNESS FOR  A */
+/* PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN  NO EVENT SHALL  THE  AUTHORS  OR COPYRIGHT */
+/* HOLDERS  BE  LIABLE  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF */
+/* CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR */
+/* THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                              */
+/* *************************************************************************************** */
+
+#include "internal.h"
+#include "oriongl.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// ======================================================================================
+// *****                            ORION PUBLIC STRUCTURES                         *****
+// ======================================================================================
+
+/**
+ * @brief A shared OpenGL sampler object.
+ * 
+ * @ingroup textures
+ */
+typedef struct oriSampler {
+    oriSampler *next;
+
+    unsigned int handle;
+
+    uint64_t hash;
+    oriSamplerState state;
+} oriSampler;
+
+// ======================================================================================
+// *****                           ORION HELPER FUNCTIONS                           *****
+// ======================================================================================
+
+/**
+ * @brief Clear the fields of the given sampler state that have no effect, and clamp the anisotropy to what is supported,
+ * so that states that sample the same way are equal.
+ * 
+ */
+static void _oriNormaliseSamplerState(oriSamplerState *state) {
+    if (state->maxAnisotropy < 1.0f || _orion.maxAnisotropy < 1.0f) {
+        state->maxAnisotropy = 1.0f;
+    } else if (state->maxAnisotropy > _orion.maxAnisotropy) {
+        state->maxAnisotropy = _orion.maxAnisotropy;
+    }
+
+    if (state->compareMode == GL_NONE) {
+        state->compareFunc = GL_LEQUAL;
+    }
+
+    if (state->wrapS != GL_CLAMP_TO_BORDER && state->wrapT != GL_CLAMP_TO_BORDER && state->wrapR != GL_CLAMP_TO_BORDER) {
+        memset(state->borderColor, 0, sizeof(state->borderColor));
+    }
+
+    // -0.0 and 0.0 have different bits
+    if (state->lodBias == 0.0f) {
+        state->lodBias = 0.0f;
+    }
+}
+
+/**
+ * @brief Return the 64-bit FNV-1a hash of the given (normalised) sampler state.
+ * 
+ */
+static uint64_t _oriHashSamplerState(const oriSamplerState *state) {
+    uint64_t hash = _ORION_FNV64_OFFSET;
+
+    const unsigned char *bytes = (const unsigned char *) state;
+    for (size_t i = 0; i < sizeof(oriSamplerState); i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
+// ======================================================================================
+// *****                          ORION SAMPLER FUNCTIONS                           *****
+// ======================================================================================
+
+/**
+ * @brief Initialise the given sampler state with OpenGL's default sampling parameters.
+ * 
+ * @param state the sampler state to initialise.
+ * 
+ * @ingroup textures
+ */
+void oriInitSamplerState(oriSamplerState *state) {
+    memset(state, 0, sizeof(oriSamplerState));
+
+    state->minFilter = GL_NEAREST_MIPMAP_LINEAR;
+    state->magFilter = GL_LINEAR;
+    state->wrapS = GL_REPEAT;
+    state->wrapT = GL_REPEAT;
+    state->wrapR = GL_REPEAT;
+    state->minLod = -1000.0f;
+    state->maxLod = 1000.0f;
+    state->lodBias = 0.0f;
+    state->maxAnisotropy = 1.0f;
+    state->compareMode = GL_NONE;
+    state->compareFunc = GL_LEQUAL;
+}
+
+/**
+ * @brief Return a sampler object with the given sampling parameters.
+ * @details Samplers are shared: the first call with a set of parameters creates a sampler, and every later call with the
+ * same parameters returns that same sampler. Binding a sampler to a texture unit with oriBindSampler() overrides the
+ * sampling parameters of the texture bound to the unit, so textures can share a few samplers instead of each having its
+ * parameters set with oriSetTextureParameteri().
+ * 
+ * The anisotropy is limited to @c GL_MAX_TEXTURE_MAX_ANISOTROPY, and is ignored if anisotropic filtering is not supported.
+ * 
+ * Samplers are owned by Orion, and are only freed with oriTerminate().
+ * 
+ * @param state the sampling parameters. Initialise it with oriInitSamplerState() before changing the parameters you need.
+ * 
+ * @ingroup textures
+ */
+oriSampler *oriGetSampler(const oriSamplerState *state) {
+    _orionAssertVersion(330);
+
+    if (!state) {
+        _orionThrowError(ORERR_NULL_RECIEVED);
+    }
+
+    oriSamplerState normalised = *state;
+    _oriNormaliseSamplerState(&normalised);
+    uint64_t hash = _oriHashSamplerState(&normalised);
+
+    // return the existing sampler with the same parameters
+    for (oriSampler *s = _orion.samplerListHead; s; s = s->next) {
+        if (s->hash == hash && !memcmp(&s->state, &normalised, sizeof(oriSamplerState))) {
+            return s;
+        }
+    }
+
+    oriSampler *r = malloc(sizeof(oriSampler));
+    r->hash = hash;
+    r->state = normalised;
+
+    if (_orion.glVersion >= 450) {
+        glCreateSamplers(1, &r->handle);
+    } else {
+        glGenSamplers(1, &r->handle);
+    }
+
+    glSamplerParameteri(r->handle, GL_TEXTURE_MIN_FILTER, normalised.minFilter);
+    glSamplerParameteri(r->handle, GL_TEXTURE_MAG_FILTER, normalised.magFilter);
+    glSamplerParameteri(r->handle, GL_TEXTURE_WRAP_S, normalised.wrapS);
+    glSamplerParameteri(r->handle, GL_TEXTURE_WRAP_T, normalised.wrapT);
+    glSamplerParameteri(r->handle, GL_TEXTURE_WRAP_R, normalised.wrapR);
+    glSamplerParameterf(r->handle, GL_TEXTURE_MIN_LOD, normalised.minLod);
+    glSamplerParameterf(r->handle, GL_TEXTURE_MAX_LOD, normalised.maxLod);
+    glSamplerParameterf(r->handle, GL_TEXTURE_LOD_BIAS, normalised.lodBias);
+    glSamplerParameteri(r->handle, GL_TEXTURE_COMPARE_MODE, normalised.compareMode);
+    glSamplerParameteri(r->handle, GL_TEXTURE_COMPARE_FUNC, normalised.compareFunc);
+    glSamplerParameterfv(r->handle, GL_TEXTURE_BORDER_COLOR, normalised.borderColor);
+    if (_orion.maxAnisotropy >= 1.0f) {
+        glSamplerParameterf(r->handle, GL_TEXTURE_MAX_ANISOTROPY, normalised.maxAnisotropy);
+    }
+
+    // link to global linked list
+    r->next = _orion.samplerListHead;
+    _orion.samplerListHead = r;
+
+    return r;
+}
+
+/**
+ * @brief Bind the given sampler to a texture unit.
+ * @details The bind is skipped if the sampler is already bound to the unit.
+ * 
+ * @param sampler the sampler to bind, or NULL to unbind the sampler that is bound to @c unit.
+ * @param unit the texture unit to bind the sampler to (starting from 0, not from @c GL_TEXTURE0).
+ * 
+ * @ingroup textures
+ */
+void oriBindSampler(oriSampler *sampler, unsigned int unit) {
+    _orionAssertVersion(330);
+
+    unsigned int handle = sampler ? sampler->handle : 0;
+    if (oriCurrentSamplerAt(unit) == handle) {
+        _orion.samplerBindsSkipped++;
+        return;
+    }
+
+    glBindSampler(unit, handle);
+    _orion.samplerBindsIssued++;
+}
+
+/**
+ * @brief Return the OpenGL handle of the given sampler.
+ * 
+ * @param sampler the sampler to inspect.
+ * 
+ * @ingroup textures
+ */
+unsigned int oriGetSamplerHandle(oriSampler *sampler) {
+    return sampler->handle;
+}
+
+/**
+ * @brief Return the sampling parameters of the given sampler into @c state.
+ * @details The parameters are stored when the sampler is created, so OpenGL is not queried. Parameters that have no effect
+ * (e.g. the border colour, when no wrap mode is @c GL_CLAMP_TO_BORDER) are reset to their defaults.
+ * 
+ * @param sampler the sampler to inspect.
+ * @param state the sampler state to write the parameters into.
+ * 
+ * @ingroup textures
+ */
+void oriGetSamplerState(oriSampler *sampler, oriSamplerState *state) {
+    *state = sampler->state;
+}
+
+/**
+ * @brief Return statistics about sampler objects into the specified variables.
+ * 
+ * @details If you don't want to recieve a statistic, pass NULL as the argument.
+ * 
+ * @param samplers the number of samplers that have been created.
+ * @param bindsIssued the number of sampler binds that were issued to OpenGL with oriBindSampler().
+ * @param bindsSkipped the number of sampler binds that were skipped because the sampler was already bound.
+ * 
+ * @ingroup textures
+ */
+void oriGetSamplerStats(unsigned int *samplers, unsigned long *bindsIssued, unsigned long *bindsSkipped) {
+    unsigned int count = 0;
+    for (oriSampler *s = _orion.samplerListHead; s; s = s->next) {
+        count++;
+    }
+
+    if (samplers) *samplers = count;
+    if (bindsIssued) *bindsIssued = _orion.samplerBindsIssued;
+    if (bindsSkipped) *bindsSkipped = _orion.samplerBindsSkipped;
+}
+
+/**
+ * @brief Destroy every sampler object. Called by oriTerminate().
+ * 
+ */
+void _orionFreeSamplers() {
+    while (_orion.samplerListHead) {
+        oriSampler *s = _orion.samplerListHead;
+        _orion.samplerListHead = s->next;
+
+        glDeleteSamplers(1, &s->handle);
+        free(s);
+    }
+}
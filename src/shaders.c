@@ -14,6 +14,7 @@
 #include "internal.h"
 #include "oriongl.h"
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -22,13 +23,80 @@
 // *****                          ORION INTERNAL DATA TYPES                         *****
 // ======================================================================================
 
+/**
+ * @brief An active uniform in a linked shader program, as reflected at link time.
+ * 
+ */
 typedef struct _oriUniform {
-    struct _oriUniform *next;
+    char *name;
+    uint32_t hash;
 
+    // -1 if the uniform is no longer active (e.g. after the program was relinked)
     int location;
-    const char *name;
+    unsigned int type;
+
+    // the last value uploaded to the uniform (large enough for a 4x4 matrix), so that redundant uploads can be skipped.
+    // valueType is the type of the setter that uploaded it, so e.g. a 1i and a 1f with the same bits are not confused.
+    bool valueSet;
+    unsigned int valueType;
+    bool valueTranspose;
+    unsigned char value[64];
 } _oriUniform;
 
+/**
+ * @brief An active input or output of a linked shader program, as reflected at link time.
+ * 
+ */
+typedef struct _oriProgramInterfaceVariable {
+    char *name;
+
+    int location;
+    unsigned int type;
+    // the number of consecutive locations the variable occupies (e.g. 4 for a mat4)
+    unsigned int locationCount;
+} _oriProgramInterfaceVariable;
+
+/**
+ * @brief The stage of building a shader program that an oriShader is in.
+ * 
+ */
+typedef enum _oriShaderLinkState {
+    // stages have been added since the program was last linked
+    _ORI_SHADER_UNLINKED,
+    // the stages are compiling and the program is linking (possibly in parallel, in the driver), but the result hasn't been checked
+    _ORI_SHADER_LINKING,
+    // the program has been linked (or failed to link) and reflected
+    _ORI_SHADER_LINKED,
+} _oriShaderLinkState;
+
+/**
+ * @brief A shader stage that has been added to a shader program, kept so that the program can be rebuilt from source.
+ * 
+ */
+typedef struct _oriShaderStage {
+    unsigned int type;
+    char *src;
+
+    // the file the stage was parsed from (NULL if it was added as a string), and the generation of its expanded source
+    char *path;
+    unsigned int generation;
+} _oriShaderStage;
+
+/**
+ * @brief A single active member of a uniform block, as reflected from the linked program.
+ *
+ */
+typedef struct _oriUniformBlockMember {
+    char *name;
+
+    unsigned int type;
+    int offset;
+    int arraySize;
+    int arrayStride;
+    int matrixStride;
+    bool rowMajor;
+} _oriUniformBlockMember;
+
 // ======================================================================================
 // *****                            ORION PUBLIC STRUCTURES                         *****
 // ======================================================================================
@@ -44,10 +112,787 @@ typedef struct oriShader {
     unsigned int handle;
     const char *src;
 
-    // linked list to cache uniform locations in the shader program
-    _oriUniform *uniformListHead;
+    // every stage added to the program
+    _oriShaderStage *stages;
+    unsigned int stageCount;
+
+    _oriShaderLinkState linkState;
+
+    // the shader objects compiled for each stage, while the program is linking
+    unsigned int *compiledStages;
+
+    // hash of the sources of every stage, used as the key of the program in the program cache
+    uint64_t sourceHash;
+
+    // every uniform that has been active in the program. an oriUniformHandle is an index into this array, so entries are
+    // never removed or reordered (and handles stay valid when the program is relinked)
+    _oriUniform *uniforms;
+    unsigned int uniformCount;
+    unsigned int uniformCapacity;
+
+    // open-addressed hash table of (index + 1) into uniforms; 0 marks an empty slot. the size is always a power of two
+    unsigned int *uniformTable;
+    unsigned int uniformTableSize;
+
+    // the inputs the program reads (the vertex attributes) and the outputs it writes, excluding built-in variables
+    _oriProgramInterfaceVariable *inputs;
+    unsigned int inputCount;
+    _oriProgramInterfaceVariable *outputs;
+    unsigned int outputCount;
 } oriShader;
 
+/**
+ * @brief A uniform buffer object laid out to match a uniform block in a shader program.
+ * 
+ * @ingroup shaders
+ */
+typedef struct oriUniformBlock {
+    oriUniformBlock *next;
+
+    unsigned int binding;
+
+    oriBuffer *buffer;
+
+    // CPU-side copy of the block's data store, written to by the setters and uploaded lazily
+    unsigned char *shadow;
+    unsigned int size;
+
+    // the byte range of the shadow copy that has changed since the last upload
+    unsigned int dirtyBegin;
+    unsigned int dirtyEnd;
+
+    _oriUniformBlockMember *members;
+    unsigned int memberCount;
+} oriUniformBlock;
+
+// ======================================================================================
+// *****                           ORION HELPER FUNCTIONS                           *****
+// ======================================================================================
+
+// check whether the given shader object compiled successfully, logging the error if it didn't
+static bool _oriCheckCompileStatus(const unsigned int id, const unsigned int type) {
+    int status;
+    glGetShaderiv(id, GL_COMPILE_STATUS, &status);
+
+    if (status) {
+        return true;
+    }
+
+    // get length of error message
+    int len;
+    glGetShaderiv(id, GL_INFO_LOG_LENGTH, &len);
+
+    // get error
+    char *e = malloc(len * sizeof(char));
+    glGetShaderInfoLog(id, len, &len, e);
+
+    // Log error to stdout
+    // As string formatted is required here, printf is used instead of _orionThrowWarning.
+    // This is annoying and be sure to change the style of this message if the style in _orionThrowWarning changes.
+    printf("[Orion : WARN] >> (shader type %d) %s\n", type, e);
+
+    free(e);
+    return false;
+}
+
+// 32-bit FNV-1a hash of the first length characters of str
+static uint32_t _oriHashString(const char *str, const size_t length) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        h ^= (unsigned char) str[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// return the index of the uniform with the given name in the shader's uniform table, or -1 if it isn't there
+static int _oriFindUniform(oriShader *shader, const char *name, const size_t length) {
+    if (!shader->uniformTableSize) {
+        return -1;
+    }
+
+    uint32_t h = _oriHashString(name, length);
+    unsigned int mask = shader->uniformTableSize - 1;
+
+    for (unsigned int slot = h & mask; shader->uniformTable[slot]; slot = (slot + 1) & mask) {
+        _oriUniform *u = &shader->uniforms[shader->uniformTable[slot] - 1];
+        if (u->hash == h && !strncmp(u->name, name, length) && u->name[length] == '\0') {
+            return shader->uniformTable[slot] - 1;
+        }
+    }
+
+    return -1;
+}
+
+// add a uniform to the shader's uniform table, or update it if a uniform with the same name is already there
+static void _oriAddUniform(oriShader *shader, const char *name, const int location, const unsigned int type) {
+    int existing = _oriFindUniform(shader, name, strlen(name));
+    if (existing >= 0) {
+        shader->uniforms[existing].location = location;
+        shader->uniforms[existing].type = type;
+        return;
+    }
+
+    if (shader->uniformCount == shader->uniformCapacity) {
+        shader->uniformCapacity = shader->uniformCapacity ? shader->uniformCapacity * 2 : 16;
+        shader->uniforms = realloc(shader->uniforms, shader->uniformCapacity * sizeof(_oriUniform));
+    }
+
+    _oriUniform *u = &shader->uniforms[shader->uniformCount++];
+    u->name = malloc(strlen(name) + 1);
+    strcpy(u->name, name);
+    u->hash = _oriHashString(name, strlen(name));
+    u->location = location;
+    u->type = type;
+    u->valueSet = false;
+
+    // keep the hash table at most half full
+    if (shader->uniformCount * 2 > shader->uniformTableSize) {
+        shader->uniformTableSize = shader->uniformTableSize ? shader->uniformTableSize * 2 : 32;
+        free(shader->uniformTable);
+        shader->uniformTable = calloc(shader->uniformTableSize, sizeof(unsigned int));
+
+        for (unsigned int i = 0; i < shader->uniformCount; i++) {
+            unsigned int slot = shader->uniforms[i].hash & (shader->uniformTableSize - 1);
+            while (shader->uniformTable[slot])
+                slot = (slot + 1) & (shader->uniformTableSize - 1);
+            shader->uniformTable[slot] = i + 1;
+        }
+        return;
+    }
+
+    unsigned int slot = u->hash & (shader->uniformTableSize - 1);
+    while (shader->uniformTable[slot])
+        slot = (slot + 1) & (shader->uniformTableSize - 1);
+    shader->uniformTable[slot] = shader->uniformCount;
+}
+
+// add a reflected uniform. arrays of basic types are reflected once as "name[0]", so every element is added,
+// with the first element also reachable by the name of the array itself
+static void _oriAddReflectedUniform(oriShader *shader, char *name, const int location, const unsigned int type, const int arraySize) {
+    size_t length = strlen(name);
+    if (length > 3 && !strcmp(name + length - 3, "[0]")) {
+        name[length - 3] = '\0';
+    }
+
+    _oriAddUniform(shader, name, location, type);
+
+    if (arraySize <= 1) {
+        return;
+    }
+
+    char *elementName = malloc(length + 16);
+    for (int i = 1; i < arraySize; i++) {
+        sprintf(elementName, "%s[%d]", name, i);
+        _oriAddUniform(shader, elementName, glGetUniformLocation(shader->handle, elementName), type);
+    }
+    free(elementName);
+}
+
+// enumerate every active uniform of the shader's (linked) program into its uniform table
+static void _oriReflectUniforms(oriShader *shader) {
+    // uniforms that are no longer active keep their entry (so handles to them stay valid) but can't be set.
+    // linking resets every uniform to its default value, so the shadowed values are out of date too.
+    for (unsigned int i = 0; i < shader->uniformCount; i++) {
+        shader->uniforms[i].location = -1;
+        shader->uniforms[i].valueSet = false;
+    }
+
+    // use the program interface query API if possible
+    if (_orion.glVersion >= 430) {
+        int count, maxNameLength;
+        glGetProgramInterfaceiv(shader->handle, GL_UNIFORM, GL_ACTIVE_RESOURCES, &count);
+        glGetProgramInterfaceiv(shader->handle, GL_UNIFORM, GL_MAX_NAME_LENGTH, &maxNameLength);
+
+        char *name = malloc(maxNameLength + 1);
+        const unsigned int props[] = { GL_LOCATION, GL_TYPE, GL_ARRAY_SIZE };
+
+        for (int i = 0; i < count; i++) {
+            int values[3];
+            glGetProgramResourceiv(shader->handle, GL_UNIFORM, i, 3, props, 3, NULL, values);
+
+            // members of uniform blocks have no location; they're set through oriUniformBlock
+            if (values[0] < 0) {
+                continue;
+            }
+
+            glGetProgramResourceName(shader->handle, GL_UNIFORM, i, maxNameLength + 1, NULL, name);
+            _oriAddReflectedUniform(shader, name, values[0], values[1], values[2]);
+        }
+
+        free(name);
+        return;
+    }
+
+    int count, maxNameLength;
+    glGetProgramiv(shader->handle, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(shader->handle, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+    char *name = malloc(maxNameLength + 1);
+
+    for (int i = 0; i < count; i++) {
+        int size;
+        unsigned int type;
+        glGetActiveUniform(shader->handle, i, maxNameLength + 1, NULL, &size, &type, name);
+
+        int location = glGetUniformLocation(shader->handle, name);
+        if (location < 0) {
+            continue;
+        }
+
+        _oriAddReflectedUniform(shader, name, location, type, size);
+    }
+
+    free(name);
+}
+
+// return true if the given program linked successfully, logging its info log if it didn't
+static bool _oriCheckLinkStatus(const unsigned int program) {
+    int status;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+
+    if (!status) {
+        int len;
+        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &len);
+
+        char *e = malloc(len * sizeof(char));
+        glGetProgramInfoLog(program, len, &len, e);
+
+        // As string formatted is required here, printf is used instead of _orionThrowWarning.
+        // This is annoying and be sure to change the style of this message if the style in _orionThrowWarning changes.
+        printf("[Orion : WARN] >> (shader program link) %s\n", e);
+
+        free(e);
+        return false;
+    }
+
+    return true;
+}
+
+// the number of consecutive locations taken by a program input or output of the given type
+static unsigned int _oriLocationCount(const unsigned int type) {
+    switch (type) {
+        case GL_FLOAT_MAT2:
+        case GL_FLOAT_MAT2x3:
+        case GL_FLOAT_MAT2x4:
+        case GL_DOUBLE_MAT2:
+        case GL_DOUBLE_MAT2x3:
+        case GL_DOUBLE_MAT2x4:
+            return 2;
+        case GL_FLOAT_MAT3:
+        case GL_FLOAT_MAT3x2:
+        case GL_FLOAT_MAT3x4:
+        case GL_DOUBLE_MAT3:
+        case GL_DOUBLE_MAT3x2:
+        case GL_DOUBLE_MAT3x4:
+            return 3;
+        case GL_FLOAT_MAT4:
+        case GL_FLOAT_MAT4x2:
+        case GL_FLOAT_MAT4x3:
+        case GL_DOUBLE_MAT4:
+        case GL_DOUBLE_MAT4x2:
+        case GL_DOUBLE_MAT4x3:
+            return 4;
+        default:
+            return 1;
+    }
+}
+
+static void _oriAddInterfaceVariable(_oriProgramInterfaceVariable **variables, unsigned int *count, char *name, const int location, const unsigned int type, const int arraySize) {
+    // arrays are reflected as "name[0]"
+    size_t length = strlen(name);
+    if (length > 3 && !strcmp(name + length - 3, "[0]")) {
+        name[length - 3] = '\0';
+    }
+
+    *variables = realloc(*variables, (*count + 1) * sizeof(_oriProgramInterfaceVariable));
+
+    _oriProgramInterfaceVariable *v = &(*variables)[(*count)++];
+    v->name = malloc(strlen(name) + 1);
+    strcpy(v->name, name);
+    v->location = location;
+    v->type = type;
+    v->locationCount = _oriLocationCount(type) * (arraySize > 1 ? arraySize : 1);
+}
+
+static void _oriFreeInterfaceVariables(_oriProgramInterfaceVariable **variables, unsigned int *count) {
+    for (unsigned int i = 0; i < *count; i++) {
+        free((*variables)[i].name);
+    }
+    free(*variables);
+
+    *variables = NULL;
+    *count = 0;
+}
+
+// enumerate the active variables of one of the program's interfaces (GL_PROGRAM_INPUT or GL_PROGRAM_OUTPUT)
+static void _oriReflectInterface(const unsigned int program, const unsigned int interface, _oriProgramInterfaceVariable **variables, unsigned int *count) {
+    int activeCount, maxNameLength;
+    glGetProgramInterfaceiv(program, interface, GL_ACTIVE_RESOURCES, &activeCount);
+    glGetProgramInterfaceiv(program, interface, GL_MAX_NAME_LENGTH, &maxNameLength);
+
+    char *name = malloc(maxNameLength + 1);
+    const unsigned int props[] = { GL_LOCATION, GL_TYPE, GL_ARRAY_SIZE };
+
+    for (int i = 0; i < activeCount; i++) {
+        int values[3];
+        glGetProgramResourceiv(program, interface, i, 3, props, 3, NULL, values);
+
+        // built-in variables (e.g. gl_VertexID) have no location
+        if (values[0] < 0) {
+            continue;
+        }
+
+        glGetProgramResourceName(program, interface, i, maxNameLength + 1, NULL, name);
+        _oriAddInterfaceVariable(variables, count, name, values[0], values[1], values[2]);
+    }
+
+    free(name);
+}
+
+// enumerate every active input and output of the shader's (linked) program
+static void _oriReflectProgramInterface(oriShader *shader) {
+    _oriFreeInterfaceVariables(&shader->inputs, &shader->inputCount);
+    _oriFreeInterfaceVariables(&shader->outputs, &shader->outputCount);
+
+    // use the program interface query API if possible
+    if (_orion.glVersion >= 430) {
+        _oriReflectInterface(shader->handle, GL_PROGRAM_INPUT, &shader->inputs, &shader->inputCount);
+        _oriReflectInterface(shader->handle, GL_PROGRAM_OUTPUT, &shader->outputs, &shader->outputCount);
+        return;
+    }
+
+    // before 4.3, only the inputs (vertex attributes) can be enumerated
+    int count, maxNameLength;
+    glGetProgramiv(shader->handle, GL_ACTIVE_ATTRIBUTES, &count);
+    glGetProgramiv(shader->handle, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxNameLength);
+
+    char *name = malloc(maxNameLength + 1);
+
+    for (int i = 0; i < count; i++) {
+        int size;
+        unsigned int type;
+        glGetActiveAttrib(shader->handle, i, maxNameLength + 1, NULL, &size, &type, name);
+
+        int location = glGetAttribLocation(shader->handle, name);
+        if (location < 0) {
+            continue;
+        }
+
+        _oriAddInterfaceVariable(&shader->inputs, &shader->inputCount, name, location, type, size);
+    }
+
+    free(name);
+}
+
+// wait for a program that is linking to finish, then check it and reflect its uniforms.
+// the program is linked first if it hasn't been yet; this does nothing if the program is already linked.
+static void _oriFinaliseShader(oriShader *shader) {
+    if (shader->linkState == _ORI_SHADER_LINKED) {
+        return;
+    }
+    if (shader->linkState == _ORI_SHADER_UNLINKED) {
+        oriLinkShader(shader);
+
+        // the program was loaded from the program cache (or there was nothing to link)
+        if (shader->linkState != _ORI_SHADER_LINKING) {
+            return;
+        }
+    }
+
+    // these queries block until the driver has finished compiling and linking
+    for (unsigned int i = 0; i < shader->stageCount; i++) {
+        _oriCheckCompileStatus(shader->compiledStages[i], shader->stages[i].type);
+
+        glDetachShader(shader->handle, shader->compiledStages[i]);
+        glDeleteShader(shader->compiledStages[i]);
+    }
+
+    shader->linkState = _ORI_SHADER_LINKED;
+
+    if (!_oriCheckLinkStatus(shader->handle)) {
+        return;
+    }
+
+    _orionSaveProgramBinary(shader->handle, shader->sourceHash);
+    _oriReflectUniforms(shader);
+    _oriReflectProgramInterface(shader);
+}
+
+// look up the handle of a uniform by name (accepting "name[0]" for the first element of an array), or -1 if it isn't active
+static oriUniformHandle _oriLookupUniformHandle(oriShader *shader, const char *name) {
+    _oriFinaliseShader(shader);
+
+    size_t length = strlen(name);
+
+    int r = _oriFindUniform(shader, name, length);
+    if (r < 0 && length > 3 && !strcmp(name + length - 3, "[0]")) {
+        r = _oriFindUniform(shader, name, length - 3);
+    }
+
+    if (r < 0 || shader->uniforms[r].location < 0) {
+        return -1;
+    }
+    return r;
+}
+
+// compare a new uniform value against the last value uploaded to the uniform, and record it if it is different.
+// returns true if the value needs to be uploaded.
+static bool _oriShadowUniform(oriShader *shader, const oriUniformHandle handle, const unsigned int type, const bool transpose, const void *data, const unsigned int size) {
+    _oriFinaliseShader(shader);
+
+    if (handle < 0 || handle >= (int) shader->uniformCount || shader->uniforms[handle].location < 0) {
+        return false;
+    }
+
+    _oriUniform *u = &shader->uniforms[handle];
+
+    if (u->valueSet && u->valueType == type && u->valueTranspose == transpose && !memcmp(u->value, data, size)) {
+        _orion.uniformUploadsSkipped++;
+        return false;
+    }
+
+    u->valueSet = true;
+    u->valueType = type;
+    u->valueTranspose = transpose;
+    memcpy(u->value, data, size);
+
+    _orion.uniformUploadsIssued++;
+    return true;
+}
+
+// upload the shadowed value of a uniform to the program that is currently bound
+static void _oriRestoreUniform(const _oriUniform *u) {
+    // the shadowed value isn't necessarily aligned
+    union { int i[16]; unsigned int ui[16]; float f[16]; } v;
+    memcpy(&v, u->value, sizeof(v));
+
+    switch (u->valueType) {
+        case GL_INT:               glUniform1iv(u->location, 1, v.i); break;
+        case GL_INT_VEC2:          glUniform2iv(u->location, 1, v.i); break;
+        case GL_INT_VEC3:          glUniform3iv(u->location, 1, v.i); break;
+        case GL_INT_VEC4:          glUniform4iv(u->location, 1, v.i); break;
+        case GL_FLOAT:             glUniform1fv(u->location, 1, v.f); break;
+        case GL_FLOAT_VEC2:        glUniform2fv(u->location, 1, v.f); break;
+        case GL_FLOAT_VEC3:        glUniform3fv(u->location, 1, v.f); break;
+        case GL_FLOAT_VEC4:        glUniform4fv(u->location, 1, v.f); break;
+        case GL_UNSIGNED_INT:      glUniform1uiv(u->location, 1, v.ui); break;
+        case GL_UNSIGNED_INT_VEC2: glUniform2uiv(u->location, 1, v.ui); break;
+        case GL_UNSIGNED_INT_VEC3: glUniform3uiv(u->location, 1, v.ui); break;
+        case GL_UNSIGNED_INT_VEC4: glUniform4uiv(u->location, 1, v.ui); break;
+        case GL_FLOAT_MAT2:        glUniformMatrix2fv(u->location, 1, u->valueTranspose, v.f); break;
+        case GL_FLOAT_MAT2x3:      glUniformMatrix2x3fv(u->location, 1, u->valueTranspose, v.f); break;
+        case GL_FLOAT_MAT2x4:      glUniformMatrix2x4fv(u->location, 1, u->valueTranspose, v.f); break;
+        case GL_FLOAT_MAT3x2:      glUniformMatrix3x2fv(u->location, 1, u->valueTranspose, v.f); break;
+        case GL_FLOAT_MAT3:        glUniformMatrix3fv(u->location, 1, u->valueTranspose, v.f); break;
+        case GL_FLOAT_MAT3x4:      glUniformMatrix3x4fv(u->location, 1, u->valueTranspose, v.f); break;
+        case GL_FLOAT_MAT4x2:      glUniformMatrix4x2fv(u->location, 1, u->valueTranspose, v.f); break;
+        case GL_FLOAT_MAT4x3:      glUniformMatrix4x3fv(u->location, 1, u->valueTranspose, v.f); break;
+        case GL_FLOAT_MAT4:        glUniformMatrix4fv(u->location, 1, u->valueTranspose, v.f); break;
+    }
+}
+
+// give every uniform block of one program the binding point of the block with the same name in another
+static void _oriCopyUniformBlockBindings(const unsigned int from, const unsigned int to) {
+    if (_orion.glVersion < 310) {
+        return;
+    }
+
+    int count, maxNameLength;
+    glGetProgramiv(from, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+    glGetProgramiv(from, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxNameLength);
+
+    char *name = malloc(maxNameLength + 1);
+
+    for (int i = 0; i < count; i++) {
+        int binding;
+        glGetActiveUniformBlockName(from, i, maxNameLength + 1, NULL, name);
+        glGetActiveUniformBlockiv(from, i, GL_UNIFORM_BLOCK_BINDING, &binding);
+
+        unsigned int index = glGetUniformBlockIndex(to, name);
+        if (index != GL_INVALID_INDEX) {
+            glUniformBlockBinding(to, index, binding);
+        }
+    }
+
+    free(name);
+}
+
+// rebuild the program of the given shader from the current contents of its source files, and swap it in place of the old one.
+// if the new sources fail to compile or link, the old program is kept. returns true if the program was replaced.
+static bool _oriReloadShader(oriShader *shader) {
+    _oriFinaliseShader(shader);
+
+    // collect the current source of every stage
+    const char **sources = malloc(shader->stageCount * sizeof(const char *));
+    unsigned int *generations = malloc(shader->stageCount * sizeof(unsigned int));
+    uint64_t sourceHash = _ORION_FNV64_OFFSET;
+
+    for (unsigned int i = 0; i < shader->stageCount; i++) {
+        sources[i] = shader->stages[i].src;
+        generations[i] = shader->stages[i].generation;
+
+        // a file can briefly be missing while an editor saves it; it will be picked up by the next change
+        if (shader->stages[i].path && !(sources[i] = _orionGetShaderSource(shader->stages[i].path, &generations[i]))) {
+            free(sources);
+            free(generations);
+            return false;
+        }
+
+        sourceHash = _orionHashProgramSource(sourceHash, shader->stages[i].type, sources[i]);
+    }
+
+    // the sources are marked as seen even if they fail to compile, so that errors are only reported once per change
+    for (unsigned int i = 0; i < shader->stageCount; i++) {
+        shader->stages[i].generation = generations[i];
+    }
+    free(generations);
+
+    unsigned int program = glCreateProgram();
+    bool linked = _orionLoadProgramBinary(program, sourceHash);
+
+    if (!linked) {
+        bool compiled = true;
+        unsigned int *ids = malloc(shader->stageCount * sizeof(unsigned int));
+
+        for (unsigned int i = 0; i < shader->stageCount; i++) {
+            ids[i] = oriCompileShader(shader->stages[i].type, sources[i]);
+            if (ids[i]) {
+                glAttachShader(program, ids[i]);
+            } else {
+                compiled = false;
+            }
+        }
+
+        if (compiled) {
+            // the binary has to be retrievable to be stored in the program cache
+            if (_orion.programCache.dir) {
+                glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+            }
+
+            glLinkProgram(program);
+            linked = _oriCheckLinkStatus(program);
+
+            if (linked) {
+                _orionSaveProgramBinary(program, sourceHash);
+            }
+        }
+
+        for (unsigned int i = 0; i < shader->stageCount; i++) {
+            if (ids[i]) {
+                glDetachShader(program, ids[i]);
+                glDeleteShader(ids[i]);
+            }
+        }
+        free(ids);
+    }
+
+    if (!linked) {
+        _orionThrowWarning("(in oriPollShaderHotReload()): A modified shader failed to compile or link. The last working program is kept.");
+        glDeleteProgram(program);
+        free(sources);
+        return false;
+    }
+
+    // keep the new sources
+    for (unsigned int i = 0; i < shader->stageCount; i++) {
+        if (!shader->stages[i].path) {
+            continue;
+        }
+
+        free(shader->stages[i].src);
+        shader->stages[i].src = malloc(strlen(sources[i]) + 1);
+        strcpy(shader->stages[i].src, sources[i]);
+    }
+    free(sources);
+
+    _oriCopyUniformBlockBindings(shader->handle, program);
+
+    unsigned int oldProgram = shader->handle;
+    shader->handle = program;
+    shader->sourceHash = sourceHash;
+
+    // reflecting the new program forgets the shadowed values (as linking resets every uniform), so remember which
+    // uniforms were set, and upload their values again so that the shader keeps its state
+    unsigned int uniformCount = shader->uniformCount;
+    unsigned int *setTypes = malloc((uniformCount ? uniformCount : 1) * sizeof(unsigned int));
+    for (unsigned int i = 0; i < uniformCount; i++) {
+        setTypes[i] = shader->uniforms[i].valueSet ? shader->uniforms[i].type : GL_NONE;
+    }
+
+    _oriReflectUniforms(shader);
+
+    _oriReflectProgramInterface(shader);
+
+    unsigned int boundCache = oriCurrentShaderProgram();
+    glUseProgram(program);
+
+    for (unsigned int i = 0; i < uniformCount; i++) {
+        _oriUniform *u = &shader->uniforms[i];
+
+        // a uniform whose type changed can't take its old value
+        if (setTypes[i] == GL_NONE || u->location < 0 || u->type != setTypes[i]) {
+            continue;
+        }
+
+        _oriRestoreUniform(u);
+        u->valueSet = true;
+    }
+    free(setTypes);
+
+    // the new program replaces the old one if it was bound
+    glUseProgram(boundCache == oldProgram ? program : boundCache);
+    glDeleteProgram(oldProgram);
+
+    return true;
+}
+
+// find a block member by name, also accepting an element of an array of basic types (e.g. "weights[3]").
+// the byte offset of the member (or element) is returned in offset.
+static _oriUniformBlockMember *_oriFindUniformBlockMember(oriUniformBlock *block, const char *name, unsigned int *offset) {
+    // split a trailing subscript off the name
+    size_t baseLength = strlen(name);
+    unsigned long element = 0;
+    if (baseLength && name[baseLength - 1] == ']') {
+        const char *subscript = strrchr(name, '[');
+        if (subscript) {
+            element = strtoul(subscript + 1, NULL, 10);
+            baseLength = subscript - name;
+        }
+    }
+
+    for (unsigned int i = 0; i < block->memberCount; i++) {
+        _oriUniformBlockMember *m = &block->members[i];
+
+        // exact match, which includes members of arrays of structs (e.g. "lights[1].colour")
+        if (!strcmp(m->name, name)) {
+            *offset = m->offset;
+            return m;
+        }
+
+        // arrays of basic types are reflected once, as "name[0]"
+        if (strlen(m->name) == baseLength + 3 && !strncmp(m->name, name, baseLength) && !strcmp(m->name + baseLength, "[0]")) {
+            if (element >= (unsigned long) m->arraySize) {
+                return NULL;
+            }
+            *offset = m->offset + element * m->arrayStride;
+            return m;
+        }
+    }
+
+    return NULL;
+}
+
+// bool members are stored as 4-byte integers, so they can be set with the integer setters
+static bool _oriUniformBlockTypeMatches(const unsigned int memberType, const unsigned int type) {
+    if (memberType == type) {
+        return true;
+    }
+
+    switch (memberType) {
+        case GL_BOOL:      return type == GL_INT || type == GL_UNSIGNED_INT;
+        case GL_BOOL_VEC2: return type == GL_INT_VEC2 || type == GL_UNSIGNED_INT_VEC2;
+        case GL_BOOL_VEC3: return type == GL_INT_VEC3 || type == GL_UNSIGNED_INT_VEC3;
+        case GL_BOOL_VEC4: return type == GL_INT_VEC4 || type == GL_UNSIGNED_INT_VEC4;
+        default:           return false;
+    }
+}
+
+static void _oriMarkUniformBlockDirty(oriUniformBlock *block, const unsigned int begin, const unsigned int end) {
+    if (block->dirtyBegin >= block->dirtyEnd) {
+        block->dirtyBegin = begin;
+        block->dirtyEnd = end;
+        return;
+    }
+
+    if (begin < block->dirtyBegin) block->dirtyBegin = begin;
+    if (end > block->dirtyEnd) block->dirtyEnd = end;
+}
+
+// look up a member and check that it has the given type. 0 is returned if the member can't be written to.
+static _oriUniformBlockMember *_oriGetWritableUniformBlockMember(oriUniformBlock *block, const char *func, const char *name, const unsigned int type, unsigned int *offset) {
+    _oriUniformBlockMember *m = _oriFindUniformBlockMember(block, name, offset);
+
+    if (!m) {
+        // As string formatted is required here, printf is used instead of _orionThrowWarning.
+        // This is annoying and be sure to change the style of this message if the style in _orionThrowWarning changes.
+        printf("[Orion : WARN] >> (in %s): The uniform block has no active member %s.\n", func, name);
+        return NULL;
+    }
+    if (!_oriUniformBlockTypeMatches(m->type, type)) {
+        // As string formatted is required here, printf is used instead of _orionThrowWarning.
+        // This is annoying and be sure to change the style of this message if the style in _orionThrowWarning changes.
+        printf("[Orion : WARN] >> (in %s): The type of uniform block member %s does not match the setter used.\n", func, name);
+        return NULL;
+    }
+
+    return m;
+}
+
+// copy a scalar or vector into the shadow copy, marking it dirty only if the value has changed
+static void _oriWriteUniformBlock(oriUniformBlock *block, const char *func, const char *name, const unsigned int type, const void *data, const unsigned int size) {
+    unsigned int offset;
+    if (!_oriGetWritableUniformBlockMember(block, func, name, type, &offset)) {
+        return;
+    }
+
+    if (!memcmp(block->shadow + offset, data, size)) {
+        return;
+    }
+    memcpy(block->shadow + offset, data, size);
+    _oriMarkUniformBlockDirty(block, offset, offset + size);
+}
+
+// copy a matrix into the shadow copy, scattering its columns (or rows, for row_major members) at the member's matrix stride
+static void _oriWriteUniformBlockMatrix(oriUniformBlock *block, const char *func, const char *name, const unsigned int type, const unsigned int columns, const unsigned int rows, const bool transpose, const float *mat) {
+    unsigned int offset;
+    _oriUniformBlockMember *m = _oriGetWritableUniformBlockMember(block, func, name, type, &offset);
+    if (!m) {
+        return;
+    }
+
+    bool changed = false;
+    for (unsigned int c = 0; c < columns; c++) {
+        for (unsigned int r = 0; r < rows; r++) {
+            float value = transpose ? mat[r * columns + c] : mat[c * rows + r];
+
+            unsigned int dest = m->rowMajor ? offset + r * m->matrixStride + c * sizeof(float) : offset + c * m->matrixStride + r * sizeof(float);
+            if (memcmp(block->shadow + dest, &value, sizeof(float))) {
+                memcpy(block->shadow + dest, &value, sizeof(float));
+                changed = true;
+            }
+        }
+    }
+
+    if (changed) {
+        unsigned int majors = m->rowMajor ? rows : columns;
+        unsigned int minors = m->rowMajor ? columns : rows;
+        _oriMarkUniformBlockDirty(block, offset, offset + (majors - 1) * m->matrixStride + minors * sizeof(float));
+    }
+}
+
+// ======================================================================================
+// *****                        ORION INTERNAL SHADER FUNCTIONS                     *****
+// ======================================================================================
+
+/**
+ * @brief Return the name of the input of the given shader at the given index (and its location, type and the number of
+ * locations it occupies), or NULL if the index is past the last input.
+ * 
+ */
+const char *_orionGetShaderInput(oriShader *shader, const unsigned int index, int *location, unsigned int *type, unsigned int *locationCount) {
+    _oriFinaliseShader(shader);
+
+    if (index >= shader->inputCount) {
+        return NULL;
+    }
+
+    if (location) *location = shader->inputs[index].location;
+    if (type) *type = shader->inputs[index].type;
+    if (locationCount) *locationCount = shader->inputs[index].locationCount;
+    return shader->inputs[index].name;
+}
+
 // ======================================================================================
 // *****                            ORION SHADER FUNCTIONS                          *****
 // ======================================================================================
@@ -61,9 +906,24 @@ oriShader *oriCreateShader() {
 
     oriShader *r = malloc(sizeof(oriShader));
 
-    r->uniformListHead = NULL;
+    r->uniforms = NULL;
+    r->uniformCount = 0;
+    r->uniformCapacity = 0;
+    r->uniformTable = NULL;
+    r->uniformTableSize = 0;
     r->src = NULL;
 
+    r->inputs = NULL;
+    r->inputCount = 0;
+    r->outputs = NULL;
+    r->outputCount = 0;
+
+    r->stages = NULL;
+    r->stageCount = 0;
+    r->linkState = _ORI_SHADER_UNLINKED;
+    r->compiledStages = NULL;
+    r->sourceHash = _ORION_FNV64_OFFSET;
+
     r->handle = glCreateProgram();
 
     // link to global linked list (add to the start)
@@ -81,22 +941,37 @@ oriShader *oriCreateShader() {
 void oriFreeShader(oriShader *shader) {
     _orionAssertVersion(200);
 
-    // free the shader uniforms linked list
-    _oriUniform *u_next = NULL;
-    
-    while (shader->uniformListHead) {
-        u_next = shader->uniformListHead->next;
+    // free the shader uniforms table
+    for (unsigned int i = 0; i < shader->uniformCount; i++) {
+        free(shader->uniforms[i].name);
+    }
+    free(shader->uniforms);
+    free(shader->uniformTable);
+
+    // free the reflected program interface
+    _oriFreeInterfaceVariables(&shader->inputs, &shader->inputCount);
+    _oriFreeInterfaceVariables(&shader->outputs, &shader->outputCount);
 
-        free(shader->uniformListHead);
+    // free the stored shader stages
+    for (unsigned int i = 0; i < shader->stageCount; i++) {
+        free(shader->stages[i].src);
+        free(shader->stages[i].path);
+    }
+    free(shader->stages);
 
-        shader->uniformListHead = u_next;
+    // delete the shader objects of a program that is still linking
+    if (shader->linkState == _ORI_SHADER_LINKING) {
+        for (unsigned int i = 0; i < shader->stageCount; i++) {
+            glDeleteShader(shader->compiledStages[i]);
+        }
     }
+    free(shader->compiledStages);
 
     // unlink from global linked list
-    oriShader *current = _orion.shaderListHead;
-    while (current != shader)
-        current = current->next;
-    _orion.shaderListHead = shader->next;
+    oriShader **current = &_orion.shaderListHead;
+    while (*current != shader)
+        current = &(*current)->next;
+    *current = shader->next;
 
     // opengl delete program
     glDeleteProgram(shader->handle);
@@ -114,6 +989,8 @@ void oriFreeShader(oriShader *shader) {
 void oriBindShader(oriShader *shader) {
     _orionAssertVersion(200);
 
+    _oriFinaliseShader(shader);
+
     if (oriCurrentShaderProgram() == shader->handle) {
         return;
     }
@@ -122,273 +999,884 @@ void oriBindShader(oriShader *shader) {
 
 /**
  * @brief Return the OpenGL handle to the given shader struct.
+ * @details The shader is linked first (see oriLinkShader()) if it hasn't been, and this waits for linking to finish, so
+ * the program can be used or queried straight away.
  * 
  * @param shader the shader to inspect.
  * 
  * @ingroup shaders
  */
 unsigned int oriGetShaderHandle(oriShader *shader) {
+    _oriFinaliseShader(shader);
+
     return shader->handle;
 }
 
 /**
- * @brief Compile and error-check the given GLSL source code.
+ * @brief Compile and error-check the given GLSL source code.
+ * 
+ * @param type the type of shader (e.g. @c GL_FRAGMENT_SHADER)
+ * @param src the source code to compile
+ * @return 0 if the shader did not successfully compile.
+ * 
+ * @ingroup shaders
+ */
+unsigned int oriCompileShader(const unsigned int type, const char *src) {
+    _orionAssertVersion(200);
+
+    unsigned int id = glCreateShader(type);
+
+    // input shader code from src
+    glShaderSource(id, 1, &src, NULL);
+
+    // compile
+    glCompileShader(id);
+
+    // if compilation failed
+    if (!_oriCheckCompileStatus(id, type)) {
+        glDeleteShader(id);
+        return 0;
+    }
+    
+    // if compilation succeeded then return the new compiled shader ID
+    return id;
+}
+
+/**
+ * @brief Add GLSL source to the given shader.
+ * @details The source is only stored here: every stage is compiled and the program is linked once, by oriLinkShader()
+ * (or implicitly, when the shader is first bound or its uniforms are first accessed).
+ * 
+ * If @c src is a string returned by oriParseShader(), the shader remembers the file it was parsed from, as with
+ * oriAddShaderSourceFile().
+ * 
+ * @param shader the shader to modify
+ * @param type the type of source code (e.g. @c GL_VERTEX_SHADER)
+ * @param src the source code to add, as a string
+ * 
+ * @ingroup shaders
+ */
+void oriAddShaderSource(oriShader *shader, const unsigned int type, const char *src) {
+    _orionAssertVersion(200);
+
+    // finish a link that is already in progress, so that its shader objects are cleaned up
+    if (shader->linkState == _ORI_SHADER_LINKING) {
+        _oriFinaliseShader(shader);
+    }
+
+    // store a copy of the stage, to be compiled when the program is linked
+    shader->stages = realloc(shader->stages, (shader->stageCount + 1) * sizeof(_oriShaderStage));
+    shader->stages[shader->stageCount].type = type;
+    shader->stages[shader->stageCount].src = malloc(strlen(src) + 1);
+    strcpy(shader->stages[shader->stageCount].src, src);
+    shader->stages[shader->stageCount].path = NULL;
+    shader->stages[shader->stageCount].generation = 0;
+
+    // remember the file that the source was parsed from, so that it can be hot reloaded
+    unsigned int generation;
+    const char *path = _orionGetShaderSourcePath(src, &generation);
+    if (path) {
+        shader->stages[shader->stageCount].path = malloc(strlen(path) + 1);
+        strcpy(shader->stages[shader->stageCount].path, path);
+        shader->stages[shader->stageCount].generation = generation;
+    }
+
+    shader->stageCount++;
+
+    shader->sourceHash = _orionHashProgramSource(shader->sourceHash, type, src);
+
+    shader->linkState = _ORI_SHADER_UNLINKED;
+}
+
+/**
+ * @brief Parse a GLSL source file (see oriParseShader()) and add it to the given shader.
+ * @details The shader remembers the file, so oriShaderSourcesChanged() can tell when it (or any file it includes) is modified.
+ * 
+ * @param shader the shader to modify
+ * @param type the type of source code (e.g. @c GL_VERTEX_SHADER)
+ * @param path the path to the source file, @b relative @b to @b the @b executable!
+ * 
+ * @ingroup shaders
+ */
+void oriAddShaderSourceFile(oriShader *shader, const unsigned int type, const char *path) {
+    _orionAssertVersion(200);
+
+    const char *src = _orionGetShaderSource(path, NULL);
+    if (!src) {
+        _orionThrowWarning("(in oriAddShaderSourceFile()): The specified source file could not be accessed. Source not added.");
+        return;
+    }
+
+    // the source is recognised as a parsed file, so the shader remembers the file
+    oriAddShaderSource(shader, type, src);
+}
+
+/**
+ * @brief Return true if a source file of the given shader, or any file it includes, has been modified since it was added (or reloaded).
+ * @details Only the stages that were parsed from files are checked: those added with oriAddShaderSourceFile(), or with
+ * oriAddShaderSource() given a string returned by oriParseShader(). Files are only re-read if they have been
+ * modified, so a changed file only affects the shaders that depend on it.
+ * 
+ * @param shader the shader to check.
+ * 
+ * @ingroup shaders
+ */
+bool oriShaderSourcesChanged(oriShader *shader) {
+    for (unsigned int i = 0; i < shader->stageCount; i++) {
+        if (!shader->stages[i].path) {
+            continue;
+        }
+
+        unsigned int generation;
+        if (_orionGetShaderSource(shader->stages[i].path, &generation) && generation != shader->stages[i].generation) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Rebuild every shader whose source files have changed, if shader hot reloading is enabled (see oriEnableShaderHotReload()).
+ * @details Each affected shader is recompiled and relinked in place: the oriShader (and every oriUniformHandle to it) stays
+ * valid, uniform block bindings are kept, and the values last set to its uniforms are uploaded to the new program.
+ * If the new sources fail to compile or link, the errors are logged and the last working program keeps running.
+ * 
+ * Call this on the thread the OpenGL context is current on (e.g. once per frame). Unless a watched file has changed, it
+ * costs a single system call.
+ * 
+ * @note Uniform blocks created with oriCreateUniformBlock() keep the layout they were created with.
+ * 
+ * @return the number of shaders that were rebuilt.
+ * 
+ * @ingroup shaders
+ */
+unsigned int oriPollShaderHotReload() {
+    _orionAssertVersion(200);
+
+    if (!_orionShaderSourcesModified()) {
+        return 0;
+    }
+
+    unsigned int r = 0;
+    for (oriShader *shader = _orion.shaderListHead; shader; shader = shader->next) {
+        if (oriShaderSourcesChanged(shader) && _oriReloadShader(shader)) {
+            r++;
+        }
+    }
+
+    return r;
+}
+
+/**
+ * @brief Compile every stage of the given shader and link them into its program.
+ * @details This doesn't wait for compilation to finish. If the driver supports @c GL_KHR_parallel_shader_compile
+ * (or @c GL_ARB_parallel_shader_compile), the stages are compiled on the driver's own threads, so many shaders can be
+ * linked at once and polled with oriShaderIsReady(). The result is checked (and errors are logged) when the shader is
+ * first bound or its uniforms are first accessed.
  * 
- * @param type the type of shader (e.g. @c GL_FRAGMENT_SHADER)
- * @param src the source code to compile
- * @return 0 if the shader did not successfully compile.
+ * If the program is in the program cache (see oriEnableProgramCache()), it is loaded from there instead.
+ * 
+ * @param shader the shader to link.
  * 
  * @ingroup shaders
  */
-unsigned int oriCompileShader(const unsigned int type, const char *src) {
+void oriLinkShader(oriShader *shader) {
     _orionAssertVersion(200);
 
-    unsigned int id = glCreateShader(type);
+    if (shader->linkState != _ORI_SHADER_UNLINKED) {
+        return;
+    }
+    if (!shader->stageCount) {
+        _orionThrowWarning("(in oriLinkShader()): No shader source has been added to the shader. Shader not linked.");
+        return;
+    }
 
-    // input shader code from src
-    glShaderSource(id, 1, &src, NULL);
+    // skip compilation entirely if the program is in the program cache
+    if (_orionLoadProgramBinary(shader->handle, shader->sourceHash)) {
+        shader->linkState = _ORI_SHADER_LINKED;
+        _oriReflectUniforms(shader);
+        _oriReflectProgramInterface(shader);
+        return;
+    }
 
-    // compile
-    glCompileShader(id);
-    int status;
-    glGetShaderiv(id, GL_COMPILE_STATUS, &status);
+    // compile + attach every stage, without waiting for the results
+    shader->compiledStages = realloc(shader->compiledStages, shader->stageCount * sizeof(unsigned int));
+    for (unsigned int i = 0; i < shader->stageCount; i++) {
+        const char *src = shader->stages[i].src;
 
-    // if compilation failed
-    if (!status) {
-        // get length of error message
-        int len;
-        glGetShaderiv(id, GL_INFO_LOG_LENGTH, &len);
+        unsigned int id = glCreateShader(shader->stages[i].type);
+        glShaderSource(id, 1, &src, NULL);
+        glCompileShader(id);
 
-        // get error
-        char *e = malloc(len * sizeof(char));
-        glGetShaderInfoLog(id, len, &len, e);
+        glAttachShader(shader->handle, id);
+        shader->compiledStages[i] = id;
+    }
 
-        // Log error to stdout
-        // As string formatted is required here, printf is used instead of _orionThrowWarning.
-        // This is annoying and be sure to change the style of this message if the style in _orionThrowWarning changes.
-        printf("[Orion : WARN] >> (shader type %d) %s\n", type, e);
+    // the binary has to be retrievable to be stored in the program cache
+    if (_orion.programCache.dir) {
+        glProgramParameteri(shader->handle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
 
-        free(e);
+    glLinkProgram(shader->handle);
 
-        glDeleteShader(id);
-        return 0;
-    }
-    
-    // if compilation succeeded then return the new compiled shader ID
-    return id;
+    shader->linkState = _ORI_SHADER_LINKING;
 }
 
 /**
- * @brief Parse a shader file and return it as a single string.
+ * @brief Return true if the given shader has finished linking, without waiting for it.
+ * @details The shader is linked with oriLinkShader() first if it hasn't been. If the driver doesn't support
+ * @c GL_KHR_parallel_shader_compile (or @c GL_ARB_parallel_shader_compile), this waits for linking to finish and always returns true.
  * 
- * @param path the path to the shader, @b relative @b to @b the @b executable!
+ * @param shader the shader to poll.
  * 
  * @ingroup shaders
  */
-const char *oriParseShader(const char *path) {
-    // ----
-    // method courtesy of Joe Cool on stackoverflow
-    // ----
-
-    char *buffer;
-    unsigned int length;
-    FILE *f = fopen(path, "rb");
-    unsigned readlength;
-
-    // initialise empty string to be returned in case of file read error.
-    char *backup = malloc(sizeof(char));
-    memset(backup, 0, sizeof(backup));
-
-    if (f) {
-        fseek(f, 0, SEEK_END);
-        length = ftell(f);
-        fseek(f, 0, SEEK_SET);
-
-        // 1 GB is a reasonable limit
-        if (length > 1073741824) {
-            _orionThrowWarning("(in oriParseShader()): The size of the specified source file exceeds the limit of 1 GB.");
-            // free(buffer) is not called as buffer is not initialised so this would result in undefined behaviour
-            return backup;
-        }
-
-        buffer = malloc((length + 1) * sizeof(char)); // +1 for null terminator.
+bool oriShaderIsReady(oriShader *shader) {
+    _orionAssertVersion(200);
 
-        if (length) {
-            readlength = fread(buffer, 1, length, f);
+    if (shader->linkState == _ORI_SHADER_UNLINKED) {
+        oriLinkShader(shader);
+    }
+    if (shader->linkState == _ORI_SHADER_LINKED) {
+        return true;
+    }
 
-            if (length != readlength) {
-                _orionThrowWarning("(in oriParseShader()): An error was encountered when reading the specified source file.");
-                free(buffer);
-                return backup;
-            }
+    if (_orion.parallelShaderCompile) {
+        int done;
+        glGetProgramiv(shader->handle, GL_COMPLETION_STATUS_KHR, &done);
+        if (!done) {
+            return false;
         }
+    }
 
-        fclose(f);
+    _oriFinaliseShader(shader);
+    return true;
+}
 
-        buffer[length] = '\0';
-    } else {
-        _orionThrowWarning("(in oriParseShader()): The specified source file could not be accessed.");
-        // free(buffer) is not called as buffer is not initialised so this would result in undefined behaviour
-        return backup;
+/**
+ * @brief Get the location of a GLSL uniform by its name
+ * @details Every active uniform is reflected into a hashed table when the shader program is linked, so this never calls into OpenGL.
+ * 
+ * @param shader the shader to inspect.
+ * @param name the name of the uniform
+ * @return -1 if the shader has no active uniform with the given name.
+ * 
+ * @ingroup shaders
+ */
+int oriShaderGetUniformLocation(oriShader *shader, const char *name) {
+    oriUniformHandle handle = _oriLookupUniformHandle(shader, name);
+
+    if (handle < 0) {
+        // As string formatted is required here, printf is used instead of _orionThrowWarning.
+        // This is annoying and be sure to change the style of this message if the style in _orionThrowWarning changes.
+        printf("[Orion : WARN] >> (in oriShaderGetUniformLocation()): The shader has no active uniform %s.\n", name);
+        return -1;
     }
 
-    free(backup);
-    return buffer;
+    return shader->uniforms[handle].location;
 }
 
 /**
- * @brief Add GLSL source to the given shader.
+ * @brief Get the location of an input of the given shader (i.e. a vertex attribute) by its name.
+ * @details Every active input is reflected when the shader program is linked, so this never calls into OpenGL. Unlike
+ * oriShaderGetUniformLocation(), no warning is sent if the input isn't found, as unused inputs are routinely optimised out.
  * 
- * @param shader the shader to modify
- * @param type the type of source code (e.g. @c GL_VERTEX_SHADER)
- * @param src the source code to add, as a string
+ * @param shader the shader to inspect.
+ * @param name the name of the input.
+ * @return -1 if the program doesn't read an input with the given name.
  * 
- * @ingroup shader
+ * @ingroup shaders
  */
-void oriAddShaderSource(oriShader *shader, const unsigned int type, const char *src) {
-    _orionAssertVersion(200);
+int oriShaderGetInputLocation(oriShader *shader, const char *name) {
+    _oriFinaliseShader(shader);
 
-    // compile + attach
-    unsigned int id = oriCompileShader(type, src);
-    glAttachShader(shader->handle, id);
-
-    // link and validate program
-    glLinkProgram(shader->handle);
-    glValidateProgram(shader->handle);
+    for (unsigned int i = 0; i < shader->inputCount; i++) {
+        if (!strcmp(shader->inputs[i].name, name)) {
+            return shader->inputs[i].location;
+        }
+    }
 
-    // free shader
-    glDeleteShader(id);
+    return -1;
 }
 
 /**
- * @brief Get the location of a GLSL uniform by its name
- * @details If the given uniform has not been cached in the oriShader struct, it will be retrieved with glGetUniformLocation() and @e then cached for later use.
+ * @brief Get the location of an output of the given shader (e.g. a fragment shader output) by its name.
+ * @details Outputs can only be reflected from OpenGL 4.3 onwards; with earlier versions, this always returns -1.
  * 
  * @param shader the shader to inspect.
- * @param name the name of the uniform
+ * @param name the name of the output.
+ * @return -1 if the program doesn't write an output with the given name.
+ * 
+ * @ingroup shaders
  */
-int oriShaderGetUniformLocation(oriShader *shader, const char *name) {
-    _oriUniform *current = shader->uniformListHead;
-    
-    while (current && current->name != name) {
-        current = current->next;
-    }
+int oriShaderGetOutputLocation(oriShader *shader, const char *name) {
+    _oriFinaliseShader(shader);
 
-    // the uniform with the given name has been found in the uniforms cache
-    if (current) {
-        return current->location;
+    for (unsigned int i = 0; i < shader->outputCount; i++) {
+        if (!strcmp(shader->outputs[i].name, name)) {
+            return shader->outputs[i].location;
+        }
     }
-    // the given name has not been found in the uniforms cache
-    else {
-        _orionAssertVersion(200);
 
-        int r = glGetUniformLocation(shader->handle, name);
+    return -1;
+}
 
-        if (r < 0) {
-            // OpenGL didn't get the location
-            // As string formatted is required here, printf is used instead of _orionThrowWarning.
-            // This is annoying and be sure to change the style of this message if the style in _orionThrowWarning changes.
-            printf("[Orion : WARN] >> glGetUniformLocation() with uniform name %s failed!\n", name);
-            return 0;
-        }
+/**
+ * @brief Get a handle to a GLSL uniform by its name, which can be used to set the uniform without any name lookups.
+ * @details Resolve handles once (e.g. after the shader is created) and then use the oriSetUniformByHandle() family of functions
+ * on the hot path. Handles stay valid if the program is relinked.
+ * 
+ * @note Orion remembers the last value set for every uniform and skips uploads that wouldn't change it, so uniforms should
+ * only be set through Orion (and not with glUniform() directly).
+ * 
+ * @param shader the shader to inspect.
+ * @param name the name of the uniform (for arrays of basic types, elements can be given as e.g. "weights[3]").
+ * @return -1 if the shader has no active uniform with the given name.
+ * 
+ * @ingroup shaders
+ */
+oriUniformHandle oriGetUniformHandle(oriShader *shader, const char *name) {
+    return _oriLookupUniformHandle(shader, name);
+}
 
-        // store r in cache (link a new uniform node to the uniforms linked list)
-        _oriUniform *new = malloc(sizeof(_oriUniform));
-        new->location = r;
-        new->name = name;
-        new->next = shader->uniformListHead;
-        shader->uniformListHead = new;
+/**
+ * @brief Return the number of uniform uploads that were issued to OpenGL, and the number that were skipped because the
+ * uniform already held the given value, since Orion was initialised (or since oriResetUniformUploadStats() was last called).
+ * 
+ * @details If you don't want to recieve a value, pass NULL as the argument.
+ * 
+ * @param issued the number of uniform uploads that were issued.
+ * @param skipped the number of uniform uploads that were skipped.
+ * 
+ * @ingroup shaders
+ */
+void oriGetUniformUploadStats(unsigned long *issued, unsigned long *skipped) {
+    if (issued) *issued = _orion.uniformUploadsIssued;
+    if (skipped) *skipped = _orion.uniformUploadsSkipped;
+}
 
-        // return r
-        return r;
-    }
+/**
+ * @brief Reset the counters returned by oriGetUniformUploadStats() to zero.
+ * 
+ * @ingroup shaders
+ */
+void oriResetUniformUploadStats() {
+    _orion.uniformUploadsIssued = 0;
+    _orion.uniformUploadsSkipped = 0;
 }
 
 // -----------------------
 // oriSetUniform() stuff
 // ----------------------
 
-#define __setUniformHelper(glfunc, version) {\
+// glfunc is used to upload the value to the bound program; dsafunc is used instead if glProgramUniform (4.1) is supported.
+// the value is not uploaded at all if it is the same as the value that was last uploaded to the uniform.
+#define __setUniformHelper(glfunc, dsafunc, version, type, transpose, data, size) {\
     _orionAssertVersion(version);\
+    if (!_oriShadowUniform(shader, handle, type, transpose, data, size)) {\
+        return;\
+    }\
+    int location = shader->uniforms[handle].location;\
+    if (_orion.glVersion >= 410) {\
+        dsafunc;\
+        return;\
+    }\
     unsigned int _boundCache = oriCurrentShaderProgram();\
     oriBindShader(shader);\
     glfunc;\
     glUseProgram(_boundCache);\
 }
 
+// warn (as these setters always have) when the given name is not an active uniform
+#define __getNamedUniformHelper(func)\
+    oriUniformHandle handle = _oriLookupUniformHandle(shader, name);\
+    if (handle < 0) {\
+        printf("[Orion : WARN] >> (in " func "): The shader has no active uniform %s.\n", name);\
+        return;\
+    }
+
+// ----------------
+// oriSetUniformByHandle :: scalars
+
+/** @ingroup shaders */ void oriSetUniformByHandle1i(oriShader *shader, const oriUniformHandle handle, const int val) {
+    __setUniformHelper(glUniform1i(location, val), glProgramUniform1i(shader->handle, location, val), 200, GL_INT, false, &val, sizeof(val));
+}
+/** @ingroup shaders */ void oriSetUniformByHandle1f(oriShader *shader, const oriUniformHandle handle, const float val) {
+    __setUniformHelper(glUniform1f(location, val), glProgramUniform1f(shader->handle, location, val), 200, GL_FLOAT, false, &val, sizeof(val));
+}
+/** @ingroup shaders */ void oriSetUniformByHandle1ui(oriShader *shader, const oriUniformHandle handle, const unsigned int val) {
+    __setUniformHelper(glUniform1ui(location, val), glProgramUniform1ui(shader->handle, location, val), 300, GL_UNSIGNED_INT, false, &val, sizeof(val));
+}
+
+// ----------------
+// oriSetUniformByHandle :: vectors
+
+/** @ingroup shaders */ void oriSetUniformByHandle2i(oriShader *shader, const oriUniformHandle handle, const int x, const int y) {
+    int v[] = { x, y };
+    __setUniformHelper(glUniform2i(location, x, y), glProgramUniform2i(shader->handle, location, x, y), 200, GL_INT_VEC2, false, v, sizeof(v));
+}
+/** @ingroup shaders */ void oriSetUniformByHandle2f(oriShader *shader, const oriUniformHandle handle, const float x, const float y) {
+    float v[] = { x, y };
+    __setUniformHelper(glUniform2f(location, x, y), glProgramUniform2f(shader->handle, location, x, y), 200, GL_FLOAT_VEC2, false, v, sizeof(v));
+}
+/** @ingroup shaders */ void oriSetUniformByHandle2ui(oriShader *shader, const oriUniformHandle handle, const unsigned int x, const unsigned int y) {
+    unsigned int v[] = { x, y };
+    __setUniformHelper(glUniform2ui(location, x, y), glProgramUniform2ui(shader->handle, location, x, y), 300, GL_UNSIGNED_INT_VEC2, false, v, sizeof(v));
+}
+
+/** @ingroup shaders */ void oriSetUniformByHandle3i(oriShader *shader, const oriUniformHandle handle, const int x, const int y, const int z) {
+    int v[] = { x, y, z };
+    __setUniformHelper(glUniform3i(location, x, y, z), glProgramUniform3i(shader->handle, location, x, y, z), 200, GL_INT_VEC3, false, v, sizeof(v));
+}
+/** @ingroup shaders */ void oriSetUniformByHandle3f(oriShader *shader, const oriUniformHandle handle, const float x, const float y, const float z) {
+    float v[] = { x, y, z };
+    __setUniformHelper(glUniform3f(location, x, y, z), glProgramUniform3f(shader->handle, location, x, y, z), 200, GL_FLOAT_VEC3, false, v, sizeof(v));
+}
+/** @ingroup shaders */ void oriSetUniformByHandle3ui(oriShader *shader, const oriUniformHandle handle, const unsigned int x, const unsigned int y, const unsigned int z) {
+    unsigned int v[] = { x, y, z };
+    __setUniformHelper(glUniform3ui(location, x, y, z), glProgramUniform3ui(shader->handle, location, x, y, z), 300, GL_UNSIGNED_INT_VEC3, false, v, sizeof(v));
+}
+
+/** @ingroup shaders */ void oriSetUniformByHandle4i(oriShader *shader, const oriUniformHandle handle, const int x, const int y, const int z, const int w) {
+    int v[] = { x, y, z, w };
+    __setUniformHelper(glUniform4i(location, x, y, z, w), glProgramUniform4i(shader->handle, location, x, y, z, w), 200, GL_INT_VEC4, false, v, sizeof(v));
+}
+/** @ingroup shaders */ void oriSetUniformByHandle4f(oriShader *shader, const oriUniformHandle handle, const float x, const float y, const float z, const float w) {
+    float v[] = { x, y, z, w };
+    __setUniformHelper(glUniform4f(location, x, y, z, w), glProgramUniform4f(shader->handle, location, x, y, z, w), 200, GL_FLOAT_VEC4, false, v, sizeof(v));
+}
+/** @ingroup shaders */ void oriSetUniformByHandle4ui(oriShader *shader, const oriUniformHandle handle, const unsigned int x, const unsigned int y, const unsigned int z, const unsigned int w) {
+    unsigned int v[] = { x, y, z, w };
+    __setUniformHelper(glUniform4ui(location, x, y, z, w), glProgramUniform4ui(shader->handle, location, x, y, z, w), 300, GL_UNSIGNED_INT_VEC4, false, v, sizeof(v));
+}
+
+// ----------------
+// oriSetUniformByHandle :: matrices
+
+/** @ingroup shaders */ void oriSetUniformByHandleMat2x2f(oriShader *shader, const oriUniformHandle handle, const bool transpose, const float *mat) {
+    __setUniformHelper(glUniformMatrix2fv(location, 1, transpose, mat), glProgramUniformMatrix2fv(shader->handle, location, 1, transpose, mat), 200, GL_FLOAT_MAT2, transpose, mat, 4 * sizeof(float));
+}
+/** @ingroup shaders */ void oriSetUniformByHandleMat2x3f(oriShader *shader, const oriUniformHandle handle, const bool transpose, const float *mat) {
+    __setUniformHelper(glUniformMatrix2x3fv(location, 1, transpose, mat), glProgramUniformMatrix2x3fv(shader->handle, location, 1, transpose, mat), 210, GL_FLOAT_MAT2x3, transpose, mat, 6 * sizeof(float));
+}
+/** @ingroup shaders */ void oriSetUniformByHandleMat2x4f(oriShader *shader, const oriUniformHandle handle, const bool transpose, const float *mat) {
+    __setUniformHelper(glUniformMatrix2x4fv(location, 1, transpose, mat), glProgramUniformMatrix2x4fv(shader->handle, location, 1, transpose, mat), 210, GL_FLOAT_MAT2x4, transpose, mat, 8 * sizeof(float));
+}
+/** @ingroup shaders */ void oriSetUniformByHandleMat3x2f(oriShader *shader, const oriUniformHandle handle, const bool transpose, const float *mat) {
+    __setUniformHelper(glUniformMatrix3x2fv(location, 1, transpose, mat), glProgramUniformMatrix3x2fv(shader->handle, location, 1, transpose, mat), 210, GL_FLOAT_MAT3x2, transpose, mat, 6 * sizeof(float));
+}
+/** @ingroup shaders */ void oriSetUniformByHandleMat3x3f(oriShader *shader, const oriUniformHandle handle, const bool transpose, const float *mat) {
+    __setUniformHelper(glUniformMatrix3fv(location, 1, transpose, mat), glProgramUniformMatrix3fv(shader->handle, location, 1, transpose, mat), 200, GL_FLOAT_MAT3, transpose, mat, 9 * sizeof(float));
+}
+/** @ingroup shaders */ void oriSetUniformByHandleMat3x4f(oriShader *shader, const oriUniformHandle handle, const bool transpose, const float *mat) {
+    __setUniformHelper(glUniformMatrix3x4fv(location, 1, transpose, mat), glProgramUniformMatrix3x4fv(shader->handle, location, 1, transpose, mat), 210, GL_FLOAT_MAT3x4, transpose, mat, 12 * sizeof(float));
+}
+/** @ingroup shaders */ void oriSetUniformByHandleMat4x2f(oriShader *shader, const oriUniformHandle handle, const bool transpose, const float *mat) {
+    __setUniformHelper(glUniformMatrix4x2fv(location, 1, transpose, mat), glProgramUniformMatrix4x2fv(shader->handle, location, 1, transpose, mat), 210, GL_FLOAT_MAT4x2, transpose, mat, 8 * sizeof(float));
+}
+/** @ingroup shaders */ void oriSetUniformByHandleMat4x3f(oriShader *shader, const oriUniformHandle handle, const bool transpose, const float *mat) {
+    __setUniformHelper(glUniformMatrix4x3fv(location, 1, transpose, mat), glProgramUniformMatrix4x3fv(shader->handle, location, 1, transpose, mat), 210, GL_FLOAT_MAT4x3, transpose, mat, 12 * sizeof(float));
+}
+/** @ingroup shaders */ void oriSetUniformByHandleMat4x4f(oriShader *shader, const oriUniformHandle handle, const bool transpose, const float *mat) {
+    __setUniformHelper(glUniformMatrix4fv(location, 1, transpose, mat), glProgramUniformMatrix4fv(shader->handle, location, 1, transpose, mat), 200, GL_FLOAT_MAT4, transpose, mat, 16 * sizeof(float));
+}
+
 // ----------------
 // oriSetUniform :: scalars
 
 /** @ingroup shaders */ void oriSetUniform1i(oriShader *shader, const char *name, const int val) {
-    __setUniformHelper(glUniform1i(oriShaderGetUniformLocation(shader, name), val), 200);
+    __getNamedUniformHelper("oriSetUniform1i()");
+    oriSetUniformByHandle1i(shader, handle, val);
 }
 /** @ingroup shaders */ void oriSetUniform1f(oriShader *shader, const char *name, const float val) {
-    __setUniformHelper(glUniform1f(oriShaderGetUniformLocation(shader, name), val), 200);
+    __getNamedUniformHelper("oriSetUniform1f()");
+    oriSetUniformByHandle1f(shader, handle, val);
 }
 /** @ingroup shaders */ void oriSetUniform1ui(oriShader *shader, const char *name, const unsigned int val) {
-    __setUniformHelper(glUniform1ui(oriShaderGetUniformLocation(shader, name), val), 300);
+    __getNamedUniformHelper("oriSetUniform1ui()");
+    oriSetUniformByHandle1ui(shader, handle, val);
 }
 
 // ----------------
 // oriSetUniform :: vectors
 
 /** @ingroup shaders */ void oriSetUniform2i(oriShader *shader, const char *name, const int x, const int y) {
-    __setUniformHelper(glUniform2i(oriShaderGetUniformLocation(shader, name), x, y), 200);
+    __getNamedUniformHelper("oriSetUniform2i()");
+    oriSetUniformByHandle2i(shader, handle, x, y);
 }
 /** @ingroup shaders */ void oriSetUniform2f(oriShader *shader, const char *name, const float x, const float y) {
-    __setUniformHelper(glUniform2f(oriShaderGetUniformLocation(shader, name), x, y), 200);
+    __getNamedUniformHelper("oriSetUniform2f()");
+    oriSetUniformByHandle2f(shader, handle, x, y);
 }
 /** @ingroup shaders */ void oriSetUniform2ui(oriShader *shader, const char *name, const unsigned int x, const unsigned int y) {
-    __setUniformHelper(glUniform2ui(oriShaderGetUniformLocation(shader, name), x, y), 300);
+    __getNamedUniformHelper("oriSetUniform2ui()");
+    oriSetUniformByHandle2ui(shader, handle, x, y);
 }
 
 /** @ingroup shaders */ void oriSetUniform3i(oriShader *shader, const char *name, const int x, const int y, const int z) {
-    __setUniformHelper(glUniform3i(oriShaderGetUniformLocation(shader, name), x, y, z), 200);
+    __getNamedUniformHelper("oriSetUniform3i()");
+    oriSetUniformByHandle3i(shader, handle, x, y, z);
 }
 /** @ingroup shaders */ void oriSetUniform3f(oriShader *shader, const char *name, const float x, const float y, const float z) {
-    __setUniformHelper(glUniform3f(oriShaderGetUniformLocation(shader, name), x, y, z), 200);
+    __getNamedUniformHelper("oriSetUniform3f()");
+    oriSetUniformByHandle3f(shader, handle, x, y, z);
 }
 /** @ingroup shaders */ void oriSetUniform3ui(oriShader *shader, const char *name, const unsigned int x, const unsigned int y, const unsigned int z) {
-    __setUniformHelper(glUniform3ui(oriShaderGetUniformLocation(shader, name), x, y, z), 300);
+    __getNamedUniformHelper("oriSetUniform3ui()");
+    oriSetUniformByHandle3ui(shader, handle, x, y, z);
 }
 
 /** @ingroup shaders */ void oriSetUniform4i(oriShader *shader, const char *name, const int x, const int y, const int z, const int w) {
-    __setUniformHelper(glUniform4i(oriShaderGetUniformLocation(shader, name), x, y, z, w), 200);
+    __getNamedUniformHelper("oriSetUniform4i()");
+    oriSetUniformByHandle4i(shader, handle, x, y, z, w);
 }
 /** @ingroup shaders */ void oriSetUniform4f(oriShader *shader, const char *name, const float x, const float y, const float z, const float w) {
-    __setUniformHelper(glUniform4f(oriShaderGetUniformLocation(shader, name), x, y, z, w), 200);
+    __getNamedUniformHelper("oriSetUniform4f()");
+    oriSetUniformByHandle4f(shader, handle, x, y, z, w);
 }
 /** @ingroup shaders */ void oriSetUniform4ui(oriShader *shader, const char *name, const unsigned int x, const unsigned int y, const unsigned int z, const unsigned int w) {
-    __setUniformHelper(glUniform4ui(oriShaderGetUniformLocation(shader, name), x, y, z, w), 300);
+    __getNamedUniformHelper("oriSetUniform4ui()");
+    oriSetUniformByHandle4ui(shader, handle, x, y, z, w);
 }
 
 // ----------------
 // oriSetUniform :: matrices
 
 /** @ingroup shaders */ void oriSetUniformMat2x2f(oriShader *shader, const char *name, const bool transpose, const float *mat) {
-    __setUniformHelper(glUniformMatrix2fv(oriShaderGetUniformLocation(shader, name), 1, transpose, mat), 200);
+    __getNamedUniformHelper("oriSetUniformMat2x2f()");
+    oriSetUniformByHandleMat2x2f(shader, handle, transpose, mat);
 }
 /** @ingroup shaders */ void oriSetUniformMat2x3f(oriShader *shader, const char *name, const bool transpose, const float *mat) {
-    __setUniformHelper(glUniformMatrix2x3fv(oriShaderGetUniformLocation(shader, name), 1, transpose, mat), 210);
+    __getNamedUniformHelper("oriSetUniformMat2x3f()");
+    oriSetUniformByHandleMat2x3f(shader, handle, transpose, mat);
 }
 /** @ingroup shaders */ void oriSetUniformMat2x4f(oriShader *shader, const char *name, const bool transpose, const float *mat) {
-    __setUniformHelper(glUniformMatrix2x4fv(oriShaderGetUniformLocation(shader, name), 1, transpose, mat), 210);
+    __getNamedUniformHelper("oriSetUniformMat2x4f()");
+    oriSetUniformByHandleMat2x4f(shader, handle, transpose, mat);
 }
 /** @ingroup shaders */ void oriSetUniformMat3x2f(oriShader *shader, const char *name, const bool transpose, const float *mat) {
-    __setUniformHelper(glUniformMatrix3x2fv(oriShaderGetUniformLocation(shader, name), 1, transpose, mat), 210);
+    __getNamedUniformHelper("oriSetUniformMat3x2f()");
+    oriSetUniformByHandleMat3x2f(shader, handle, transpose, mat);
 }
 /** @ingroup shaders */ void oriSetUniformMat3x3f(oriShader *shader, const char *name, const bool transpose, const float *mat) {
-    __setUniformHelper(glUniformMatrix3fv(oriShaderGetUniformLocation(shader, name), 1, transpose, mat), 200);
+    __getNamedUniformHelper("oriSetUniformMat3x3f()");
+    oriSetUniformByHandleMat3x3f(shader, handle, transpose, mat);
 }
 /** @ingroup shaders */ void oriSetUniformMat3x4f(oriShader *shader, const char *name, const bool transpose, const float *mat) {
-    __setUniformHelper(glUniformMatrix3x4fv(oriShaderGetUniformLocation(shader, name), 1, transpose, mat), 210);
+    __getNamedUniformHelper("oriSetUniformMat3x4f()");
+    oriSetUniformByHandleMat3x4f(shader, handle, transpose, mat);
 }
 /** @ingroup shaders */ void oriSetUniformMat4x2f(oriShader *shader, const char *name, const bool transpose, const float *mat) {
-    __setUniformHelper(glUniformMatrix4x2fv(oriShaderGetUniformLocation(shader, name), 1, transpose, mat), 210);
+    __getNamedUniformHelper("oriSetUniformMat4x2f()");
+    oriSetUniformByHandleMat4x2f(shader, handle, transpose, mat);
 }
 /** @ingroup shaders */ void oriSetUniformMat4x3f(oriShader *shader, const char *name, const bool transpose, const float *mat) {
-    __setUniformHelper(glUniformMatrix4x3fv(oriShaderGetUniformLocation(shader, name), 1, transpose, mat), 210);
+    __getNamedUniformHelper("oriSetUniformMat4x3f()");
+    oriSetUniformByHandleMat4x3f(shader, handle, transpose, mat);
 }
 /** @ingroup shaders */ void oriSetUniformMat4x4f(oriShader *shader, const char *name, const bool transpose, const float *mat) {
-    __setUniformHelper(glUniformMatrix4fv(oriShaderGetUniformLocation(shader, name), 1, transpose, mat), 200);
+    __getNamedUniformHelper("oriSetUniformMat4x4f()");
+    oriSetUniformByHandleMat4x4f(shader, handle, transpose, mat);
+}
+
+// ======================================================================================
+// *****                        ORION UNIFORM BLOCK FUNCTIONS                       *****
+// ======================================================================================
+
+/**
+ * @brief Allocate and initialise a new oriUniformBlock structure for the named uniform block in the given shader.
+ * @details The layout of the block (the offset, array stride and matrix stride of every member) is reflected from the
+ * linked shader program, so the block can be declared with any layout qualifier (@c std140, @c shared or @c packed).
+ * Setting members writes to a CPU-side copy of the block, and only the range that changed is uploaded when the block is
+ * next bound with oriBindUniformBlock() (or uploaded with oriUploadUniformBlock()).
+ * 
+ * The uniform block in @c shader is assigned to the uniform buffer binding point @c binding. Other shaders that declare
+ * the same block can share it by assigning their block to the same binding point with oriShaderSetUniformBlockBinding().
+ * 
+ * @param shader the (linked) shader that declares the uniform block.
+ * @param name the name of the uniform block (not its instance name).
+ * @param binding the uniform buffer binding point to use.
+ * @return NULL if the shader has no active uniform block with the given name.
+ * 
+ * @sa <a href="https://www.khronos.org/opengl/wiki/Interface_Block_(GLSL)#Memory_layout">OpenGL/Interface block memory layout</a>
+ * 
+ * @ingroup shaders
+ */
+oriUniformBlock *oriCreateUniformBlock(oriShader *shader, const char *name, const unsigned int binding) {
+    _orionAssertVersion(310);
+
+    _oriFinaliseShader(shader);
+
+    unsigned int blockIndex = glGetUniformBlockIndex(shader->handle, name);
+    if (blockIndex == GL_INVALID_INDEX) {
+        // As string formatted is required here, printf is used instead of _orionThrowWarning.
+        // This is annoying and be sure to change the style of this message if the style in _orionThrowWarning changes.
+        printf("[Orion : WARN] >> (in oriCreateUniformBlock()): The shader has no active uniform block %s.\n", name);
+        return NULL;
+    }
+
+    int size, memberCount;
+    glGetActiveUniformBlockiv(shader->handle, blockIndex, GL_UNIFORM_BLOCK_DATA_SIZE, &size);
+    glGetActiveUniformBlockiv(shader->handle, blockIndex, GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS, &memberCount);
+
+    oriUniformBlock *r = malloc(sizeof(oriUniformBlock));
+    r->binding = binding;
+    r->size = size;
+    r->shadow = calloc(size, 1);
+    r->dirtyBegin = 0;
+    r->dirtyEnd = 0;
+    r->memberCount = memberCount;
+    r->members = malloc(memberCount * sizeof(_oriUniformBlockMember));
+
+    // reflect the layout of every active member of the block
+    int *indices = malloc(memberCount * sizeof(int));
+    int *types = malloc(memberCount * sizeof(int));
+    int *offsets = malloc(memberCount * sizeof(int));
+    int *arraySizes = malloc(memberCount * sizeof(int));
+    int *arrayStrides = malloc(memberCount * sizeof(int));
+    int *matrixStrides = malloc(memberCount * sizeof(int));
+    int *rowMajors = malloc(memberCount * sizeof(int));
+
+    glGetActiveUniformBlockiv(shader->handle, blockIndex, GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES, indices);
+    glGetActiveUniformsiv(shader->handle, memberCount, (const unsigned int *) indices, GL_UNIFORM_TYPE, types);
+    glGetActiveUniformsiv(shader->handle, memberCount, (const unsigned int *) indices, GL_UNIFORM_OFFSET, offsets);
+    glGetActiveUniformsiv(shader->handle, memberCount, (const unsigned int *) indices, GL_UNIFORM_SIZE, arraySizes);
+    glGetActiveUniformsiv(shader->handle, memberCount, (const unsigned int *) indices, GL_UNIFORM_ARRAY_STRIDE, arrayStrides);
+    glGetActiveUniformsiv(shader->handle, memberCount, (const unsigned int *) indices, GL_UNIFORM_MATRIX_STRIDE, matrixStrides);
+    glGetActiveUniformsiv(shader->handle, memberCount, (const unsigned int *) indices, GL_UNIFORM_IS_ROW_MAJOR, rowMajors);
+
+    int maxNameLength;
+    glGetProgramiv(shader->handle, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+    for (int i = 0; i < memberCount; i++) {
+        _oriUniformBlockMember *m = &r->members[i];
+
+        m->name = malloc(maxNameLength + 1);
+        glGetActiveUniformName(shader->handle, indices[i], maxNameLength + 1, NULL, m->name);
+
+        m->type = types[i];
+        m->offset = offsets[i];
+        m->arraySize = arraySizes[i];
+        m->arrayStride = arrayStrides[i];
+        m->matrixStride = matrixStrides[i];
+        m->rowMajor = rowMajors[i];
+    }
+
+    free(indices);
+    free(types);
+    free(offsets);
+    free(arraySizes);
+    free(arrayStrides);
+    free(matrixStrides);
+    free(rowMajors);
+
+    glUniformBlockBinding(shader->handle, blockIndex, binding);
+
+    // the buffer is only ever updated in-place, so give it immutable storage where possible
+    if (_orion.glVersion >= 440) {
+        r->buffer = oriCreateBufferImmutable(r->shadow, size, GL_DYNAMIC_STORAGE_BIT);
+    } else {
+        r->buffer = oriCreateBuffer();
+        oriSetBufferData(r->buffer, r->shadow, size, GL_DYNAMIC_DRAW);
+    }
+
+    // link to global linked list
+    r->next = _orion.uniformBlockListHead;
+    _orion.uniformBlockListHead = r;
+
+    return r;
+}
+
+/**
+ * @brief Destroy and free memory for the given uniform block (and its uniform buffer).
+ * 
+ * @param block the uniform block to free.
+ * 
+ * @ingroup shaders
+ */
+void oriFreeUniformBlock(oriUniformBlock *block) {
+    // unlink from global linked list
+    oriUniformBlock **current = &_orion.uniformBlockListHead;
+    while (*current != block)
+        current = &(*current)->next;
+    *current = block->next;
+
+    oriFreeBuffer(block->buffer);
+
+    for (unsigned int i = 0; i < block->memberCount; i++) {
+        free(block->members[i].name);
+    }
+    free(block->members);
+    free(block->shadow);
+    free(block);
+    block = NULL;
+}
+
+/**
+ * @brief Assign the named uniform block in the given shader to a uniform buffer binding point.
+ * @details Use this to share an oriUniformBlock between every shader that declares the same block.
+ * 
+ * @param shader the shader to modify.
+ * @param name the name of the uniform block.
+ * @param binding the uniform buffer binding point to use.
+ * 
+ * @ingroup shaders
+ */
+void oriShaderSetUniformBlockBinding(oriShader *shader, const char *name, const unsigned int binding) {
+    _orionAssertVersion(310);
+
+    _oriFinaliseShader(shader);
+
+    unsigned int blockIndex = glGetUniformBlockIndex(shader->handle, name);
+    if (blockIndex == GL_INVALID_INDEX) {
+        // As string formatted is required here, printf is used instead of _orionThrowWarning.
+        // This is annoying and be sure to change the style of this message if the style in _orionThrowWarning changes.
+        printf("[Orion : WARN] >> (in oriShaderSetUniformBlockBinding()): The shader has no active uniform block %s.\n", name);
+        return;
+    }
+
+    glUniformBlockBinding(shader->handle, blockIndex, binding);
+}
+
+/**
+ * @brief Upload the members of the given uniform block that have changed since it was last uploaded.
+ * @details This is called implicitly by oriBindUniformBlock().
+ * 
+ * @param block the uniform block to upload.
+ * 
+ * @ingroup shaders
+ */
+void oriUploadUniformBlock(oriUniformBlock *block) {
+    if (block->dirtyBegin >= block->dirtyEnd) {
+        return;
+    }
+
+    oriSetBufferSubData(block->buffer, block->dirtyBegin, block->shadow + block->dirtyBegin, block->dirtyEnd - block->dirtyBegin);
+
+    block->dirtyBegin = 0;
+    block->dirtyEnd = 0;
+}
+
+/**
+ * @brief Upload any changes to the given uniform block, then bind its buffer to the block's uniform buffer binding point.
+ * 
+ * @param block the uniform block to bind.
+ * 
+ * @ingroup shaders
+ */
+void oriBindUniformBlock(oriUniformBlock *block) {
+    _orionAssertVersion(310);
+
+    oriUploadUniformBlock(block);
+
+    glBindBufferRange(GL_UNIFORM_BUFFER, block->binding, oriGetBufferHandle(block->buffer), 0, block->size);
+}
+
+/**
+ * @brief Return uniform block properties into the specified variables.
+ * 
+ * @details If you don't want to recieve a property, pass NULL as the argument.
+ * 
+ * @param block the uniform block to inspect.
+ * @param size the size of the block's data store, in bytes.
+ * @param binding the uniform buffer binding point the block is bound to.
+ * @param buffer the buffer that backs the block.
+ * 
+ * @ingroup shaders
+ */
+void oriGetUniformBlockProperty(oriUniformBlock *block, unsigned int *size, unsigned int *binding, oriBuffer **buffer) {
+    if (size) *size = block->size;
+    if (binding) *binding = block->binding;
+    if (buffer) *buffer = block->buffer;
+}
+
+// -----------------------
+// oriSetUniformBlock() stuff
+// ----------------------
+
+// ----------------
+// oriSetUniformBlock :: scalars
+
+/** @ingroup shaders */ void oriSetUniformBlock1i(oriUniformBlock *block, const char *name, const int val) {
+    _oriWriteUniformBlock(block, "oriSetUniformBlock1i()", name, GL_INT, &val, sizeof(val));
+}
+/** @ingroup shaders */ void oriSetUniformBlock1f(oriUniformBlock *block, const char *name, const float val) {
+    _oriWriteUniformBlock(block, "oriSetUniformBlock1f()", name, GL_FLOAT, &val, sizeof(val));
+}
+/** @ingroup shaders */ void oriSetUniformBlock1ui(oriUniformBlock *block, const char *name, const unsigned int val) {
+    _oriWriteUniformBlock(block, "oriSetUniformBlock1ui()", name, GL_UNSIGNED_INT, &val, sizeof(val));
+}
+
+// ----------------
+// oriSetUniformBlock :: vectors
+
+/** @ingroup shaders */ void oriSetUniformBlock2i(oriUniformBlock *block, const char *name, const int x, const int y) {
+    int v[] = { x, y };
+    _oriWriteUniformBlock(block, "oriSetUniformBlock2i()", name, GL_INT_VEC2, v, sizeof(v));
+}
+/** @ingroup shaders */ void oriSetUniformBlock2f(oriUniformBlock *block, const char *name, const float x, const float y) {
+    float v[] = { x, y };
+    _oriWriteUniformBlock(block, "oriSetUniformBlock2f()", name, GL_FLOAT_VEC2, v, sizeof(v));
+}
+/** @ingroup shaders */ void oriSetUniformBlock2ui(oriUniformBlock *block, const char *name, const unsigned int x, const unsigned int y) {
+    unsigned int v[] = { x, y };
+    _oriWriteUniformBlock(block, "oriSetUniformBlock2ui()", name, GL_UNSIGNED_INT_VEC2, v, sizeof(v));
+}
+
+/** @ingroup shaders */ void oriSetUniformBlock3i(oriUniformBlock *block, const char *name, const int x, const int y, const int z) {
+    int v[] = { x, y, z };
+    _oriWriteUniformBlock(block, "oriSetUniformBlock3i()", name, GL_INT_VEC3, v, sizeof(v));
+}
+/** @ingroup shaders */ void oriSetUniformBlock3f(oriUniformBlock *block, const char *name, const float x, const float y, const float z) {
+    float v[] = { x, y, z };
+    _oriWriteUniformBlock(block, "oriSetUniformBlock3f()", name, GL_FLOAT_VEC3, v, sizeof(v));
+}
+/** @ingroup shaders */ void oriSetUniformBlock3ui(oriUniformBlock *block, const char *name, const unsigned int x, const unsigned int y, const unsigned int z) {
+    unsigned int v[] = { x, y, z };
+    _oriWriteUniformBlock(block, "oriSetUniformBlock3ui()", name, GL_UNSIGNED_INT_VEC3, v, sizeof(v));
+}
+
+/** @ingroup shaders */ void oriSetUniformBlock4i(oriUniformBlock *block, const char *name, const int x, const int y, const int z, const int w) {
+    int v[] = { x, y, z, w };
+    _oriWriteUniformBlock(block, "oriSetUniformBlock4i()", name, GL_INT_VEC4, v, sizeof(v));
+}
+/** @ingroup shaders */ void oriSetUniformBlock4f(oriUniformBlock *block, const char *name, const float x, const float y, const float z, const float w) {
+    float v[] = { x, y, z, w };
+    _oriWriteUniformBlock(block, "oriSetUniformBlock4f()", name, GL_FLOAT_VEC4, v, sizeof(v));
+}
+/** @ingroup shaders */ void oriSetUniformBlock4ui(oriUniformBlock *block, const char *name, const unsigned int x, const unsigned int y, const unsigned int z, const unsigned int w) {
+    unsigned int v[] = { x, y, z, w };
+    _oriWriteUniformBlock(block, "oriSetUniformBlock4ui()", name, GL_UNSIGNED_INT_VEC4, v, sizeof(v));
+}
+
+// ----------------
+// oriSetUniformBlock :: matrices
+
+/** @ingroup shaders */ void oriSetUniformBlockMat2x2f(oriUniformBlock *block, const char *name, const bool transpose, const float *mat) {
+    _oriWriteUniformBlockMatrix(block, "oriSetUniformBlockMat2x2f()", name, GL_FLOAT_MAT2, 2, 2, transpose, mat);
+}
+/** @ingroup shaders */ void oriSetUniformBlockMat2x3f(oriUniformBlock *block, const char *name, const bool transpose, const float *mat) {
+    _oriWriteUniformBlockMatrix(block, "oriSetUniformBlockMat2x3f()", name, GL_FLOAT_MAT2x3, 2, 3, transpose, mat);
+}
+/** @ingroup shaders */ void oriSetUniformBlockMat2x4f(oriUniformBlock *block, const char *name, const bool transpose, const float *mat) {
+    _oriWriteUniformBlockMatrix(block, "oriSetUniformBlockMat2x4f()", name, GL_FLOAT_MAT2x4, 2, 4, transpose, mat);
+}
+/** @ingroup shaders */ void oriSetUniformBlockMat3x2f(oriUniformBlock *block, const char *name, const bool transpose, const float *mat) {
+    _oriWriteUniformBlockMatrix(block, "oriSetUniformBlockMat3x2f()", name, GL_FLOAT_MAT3x2, 3, 2, transpose, mat);
+}
+/** @ingroup shaders */ void oriSetUniformBlockMat3x3f(oriUniformBlock *block, const char *name, const bool transpose, const float *mat) {
+    _oriWriteUniformBlockMatrix(block, "oriSetUniformBlockMat3x3f()", name, GL_FLOAT_MAT3, 3, 3, transpose, mat);
+}
+/** @ingroup shaders */ void oriSetUniformBlockMat3x4f(oriUniformBlock *block, const char *name, const bool transpose, const float *mat) {
+    _oriWriteUniformBlockMatrix(block, "oriSetUniformBlockMat3x4f()", name, GL_FLOAT_MAT3x4, 3, 4, transpose, mat);
+}
+/** @ingroup shaders */ void oriSetUniformBlockMat4x2f(oriUniformBlock *block, const char *name, const bool transpose, const float *mat) {
+    _oriWriteUniformBlockMatrix(block, "oriSetUniformBlockMat4x2f()", name, GL_FLOAT_MAT4x2, 4, 2, transpose, mat);
+}
+/** @ingroup shaders */ void oriSetUniformBlockMat4x3f(oriUniformBlock *block, const char *name, const bool transpose, const float *mat) {
+    _oriWriteUniformBlockMatrix(block, "oriSetUniformBlockMat4x3f()", name, GL_FLOAT_MAT4x3, 4, 3, transpose, mat);
+}
+/** @ingroup shaders */ void oriSetUniformBlockMat4x4f(oriUniformBlock *block, const char *name, const bool transpose, const float *mat) {
+    _oriWriteUniformBlockMatrix(block, "oriSetUniformBlockMat4x4f()", name, GL_FLOAT_MAT4, 4, 4, transpose, mat);
 }
@@ -0,0 +1,608 @@
+/* *************************************************************************************** */
+/*                        ORION GRAPHICS LIBRARY AND RENDERING ENGINE                      */
+/* *************************************************************************************** */
+/* Copyright (c) 2022 Jack Bennett                                                         */
+/* --------------------------------------------------------------------------------------- */
+/* THE  SOFTWARE IS  PROVIDED "AS IS",  WITHOUT WARRANTY OF ANY KIND, EXPRESS  OR IMPLIED, */
+/* INCLUDING  BUT  NOT  LIMITED  TO  THE  WARRANTIES  OF  MERCHANTABILITY,  FITNESS FOR  A */
+/* PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN  NO EVENT SHALL  THE  AUTHORS  OR COPYRIGHT */
+/* HOLDERS  BE  LIABLE  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF */
+/* CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR */
+/* THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                              */
+/* *************************************************************************************** */
+
+// for realpath(), PATH_MAX and nanosecond modification times
+#define _XOPEN_SOURCE 700
+
+#include "internal.h"
+#include "oriongl.h"
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+// ======================================================================================
+// *****                          ORION INTERNAL DATA TYPES                         *****
+// ======================================================================================
+
+/**
+ * @brief A shader source file, read (or memory-mapped) once and shared by every source that includes it.
+ * 
+ */
+typedef struct _oriShaderSource {
+    struct _oriShaderSource *next;
+
+    // canonical (absolute) path of the file
+    char *path;
+    uint32_t hash;
+
+    // the contents of the file, and the modification time and size they were read at
+    const char *data;
+    size_t size;
+    struct timespec mtime;
+
+    // true if the contents are memory-mapped, rather than read into an allocated copy (see _ORI_SHADER_SOURCE_MAP_SIZE)
+    bool mapped;
+
+    // incremented whenever the file is remapped, so that every source that includes it can tell that it changed
+    unsigned int revision;
+
+    // the file with every #include expanded; NULL until it is first needed (or after it has gone out of date)
+    char *expanded;
+
+    // incremented whenever the expanded source changes
+    unsigned int generation;
+
+    // the revision of the file that the expanded source was made from
+    unsigned int expandedRevision;
+
+    // every file that was included (directly or indirectly) in the expanded source, and the revision it was included at
+    struct _oriShaderSource **dependencies;
+    unsigned int *dependencyRevisions;
+    unsigned int dependencyCount;
+} _oriShaderSource;
+
+/**
+ * @brief A growable string.
+ * 
+ */
+typedef struct _oriStringBuilder {
+    char *data;
+    size_t length;
+    size_t capacity;
+} _oriStringBuilder;
+
+// files larger than this are memory-mapped; smaller ones (i.e. almost every shader) are copied with read(), as reading a
+// mapping of a file that an editor truncates in place raises SIGBUS
+#define _ORI_SHADER_SOURCE_MAP_SIZE (1024 * 1024)
+
+// ======================================================================================
+// *****                           ORION HELPER FUNCTIONS                           *****
+// ======================================================================================
+
+static void _oriAppend(_oriStringBuilder *sb, const char *str, const size_t length) {
+    if (sb->length + length + 1 > sb->capacity) {
+        while (sb->length + length + 1 > sb->capacity) {
+            sb->capacity = sb->capacity ? sb->capacity * 2 : 4096;
+        }
+        sb->data = realloc(sb->data, sb->capacity);
+    }
+
+    memcpy(sb->data + sb->length, str, length);
+    sb->length += length;
+    sb->data[sb->length] = '\0';
+}
+
+static uint32_t _oriHashPath(const char *path) {
+    uint32_t h = 2166136261u;
+    for (const char *c = path; *c; c++) {
+        h ^= (unsigned char) *c;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static void _oriUnmapShaderSource(_oriShaderSource *source) {
+    if (source->mapped) {
+        munmap((void *) source->data, source->size);
+    } else if (source->size) {
+        free((void *) source->data);
+    }
+    source->data = "";
+    source->size = 0;
+    source->mapped = false;
+}
+
+// read up to the given size of the given file into a new, allocated buffer, and set the size to the length that was read
+// (which is shorter if the file was truncated since its size was checked). returns NULL if the file can't be read.
+static char *_oriReadShaderSource(const int fd, size_t *size) {
+    char *r = malloc(*size);
+    size_t length = 0;
+
+    while (length < *size) {
+        ssize_t n = read(fd, r + length, *size - length);
+        if (n < 0) {
+            free(r);
+            return NULL;
+        }
+        if (n == 0) {
+            break;
+        }
+        length += n;
+    }
+
+    *size = length;
+    return r;
+}
+
+// map (or read, or re-read) the file of the given source. returns false if the file can't be read.
+static bool _oriMapShaderSource(_oriShaderSource *source) {
+    _oriUnmapShaderSource(source);
+
+    int fd = open(source->path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+
+    source->mtime = st.st_mtim;
+
+    // small files are copied and large ones are mapped (an empty file can't be mapped, so it is left as an empty string)
+    if (st.st_size > _ORI_SHADER_SOURCE_MAP_SIZE) {
+        void *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            close(fd);
+            return false;
+        }
+
+        source->data = data;
+        source->size = st.st_size;
+        source->mapped = true;
+    } else if (st.st_size > 0) {
+        size_t size = st.st_size;
+        char *data = _oriReadShaderSource(fd, &size);
+        if (!data) {
+            close(fd);
+            return false;
+        }
+
+        if (size) {
+            source->data = data;
+            source->size = size;
+        } else {
+            free(data);
+        }
+    }
+
+    // the mapping stays valid after the file is closed
+    close(fd);
+    return true;
+}
+
+// watch the directory of the given source for changes, if hot reloading is enabled. directories are watched rather than
+// the files themselves, as many editors save by replacing the file (which would remove a watch on it)
+static void _oriWatchShaderSource(_oriShaderSource *source) {
+#ifdef __linux__
+    if (!_orion.shaderHotReload.enabled) {
+        return;
+    }
+
+    const char *slash = strrchr(source->path, '/');
+    size_t length = slash ? (size_t) (slash - source->path) : 0;
+
+    char *dir = malloc(length + 2);
+    memcpy(dir, source->path, length);
+    strcpy(dir + length, length ? "" : "/");
+
+    // watching a directory again returns the same watch, so each directory is only watched once
+    if (inotify_add_watch(_orion.shaderHotReload.fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        // As string formatted is required here, printf is used instead of _orionThrowWarning.
+        // This is annoying and be sure to change the style of this message if the style in _orionThrowWarning changes.
+        printf("[Orion : WARN] >> (in oriEnableShaderHotReload()): %s could not be watched for changes.\n", dir);
+    }
+
+    free(dir);
+#else
+    (void) source;
+#endif
+}
+
+// return the cached source for the given canonical path, mapping the file if it hasn't been yet
+static _oriShaderSource *_oriGetShaderSource(const char *canonicalPath) {
+    uint32_t h = _oriHashPath(canonicalPath);
+
+    for (_oriShaderSource *s = _orion.shaderSourceListHead; s; s = s->next) {
+        if (s->hash == h && !strcmp(s->path, canonicalPath)) {
+            return s;
+        }
+    }
+
+    _oriShaderSource *r = malloc(sizeof(_oriShaderSource));
+    r->path = malloc(strlen(canonicalPath) + 1);
+    strcpy(r->path, canonicalPath);
+    r->hash = h;
+
+    r->data = "";
+    r->size = 0;
+    r->mapped = false;
+    r->expanded = NULL;
+    r->revision = 0;
+    r->generation = 0;
+    r->expandedRevision = 0;
+    r->dependencies = NULL;
+    r->dependencyRevisions = NULL;
+    r->dependencyCount = 0;
+
+    if (!_oriMapShaderSource(r)) {
+        free(r->path);
+        free(r);
+        return NULL;
+    }
+
+    // link to global linked list
+    r->next = _orion.shaderSourceListHead;
+    _orion.shaderSourceListHead = r;
+
+    _oriWatchShaderSource(r);
+
+    return r;
+}
+
+// remap the file of the given source if it has changed on disk
+static void _oriRefreshShaderSource(_oriShaderSource *source) {
+    struct stat st;
+    if (stat(source->path, &st) != 0) {
+        return;
+    }
+    if (st.st_mtim.tv_sec == source->mtime.tv_sec && st.st_mtim.tv_nsec == source->mtime.tv_nsec && (size_t) st.st_size == source->size) {
+        return;
+    }
+
+    _oriMapShaderSource(source);
+    source->revision++;
+}
+
+static bool _oriHasDependency(_oriShaderSource *root, _oriShaderSource *source) {
+    if (root == source) {
+        return true;
+    }
+    for (unsigned int i = 0; i < root->dependencyCount; i++) {
+        if (root->dependencies[i] == source) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// resolve an included path relative to the directory of the file that includes it
+static _oriShaderSource *_oriResolveInclude(_oriShaderSource *includer, const char *name, const size_t nameLength) {
+    const char *slash = strrchr(includer->path, '/');
+    size_t dirLength = slash ? (size_t) (slash - includer->path) + 1 : 0;
+
+    char *path = malloc(dirLength + nameLength + 1);
+    memcpy(path, includer->path, dirLength);
+    memcpy(path + dirLength, name, nameLength);
+    path[dirLength + nameLength] = '\0';
+
+    char canonical[PATH_MAX];
+    _oriShaderSource *r = NULL;
+    if (realpath(path, canonical)) {
+        r = _oriGetShaderSource(canonical);
+    }
+
+    if (!r) {
+        // As string formatted is required here, printf is used instead of _orionThrowWarning.
+        // This is annoying and be sure to change the style of this message if the style in _orionThrowWarning changes.
+        printf("[Orion : WARN] >> (in oriParseShader()): %s (included from %s) could not be accessed.\n", path, includer->path);
+    }
+
+    free(path);
+    return r;
+}
+
+// append the given source to out, replacing every #include directive with the (expanded) file it names.
+// every file is included at most once into root, which also guards against circular includes.
+static void _oriExpandShaderSource(_oriShaderSource *root, _oriShaderSource *source, _oriStringBuilder *out) {
+    const char *p = source->data;
+    const char *end = source->data + source->size;
+    unsigned int line = 1;
+
+    while (p < end) {
+        const char *eol = memchr(p, '\n', end - p);
+        if (!eol) {
+            eol = end;
+        }
+
+        const char *c = p;
+        while (c < eol && (*c == ' ' || *c == '\t')) c++;
+
+        if (eol - c > 8 && !strncmp(c, "#include", 8)) {
+            // #include "file" or #include <file>
+            const char *open = c + 8;
+            while (open < eol && (*open == ' ' || *open == '\t')) open++;
+
+            const char *close = NULL;
+            if (open < eol && (*open == '"' || *open == '<')) {
+                close = memchr(open + 1, *open == '"' ? '"' : '>', eol - open - 1);
+            }
+
+            if (!close) {
+                // As string formatted is required here, printf is used instead of _orionThrowWarning.
+                // This is annoying and be sure to change the style of this message if the style in _orionThrowWarning changes.
+                printf("[Orion : WARN] >> (in oriParseShader()): Malformed #include directive on line %u of %s.\n", line, source->path);
+            } else {
+                _oriShaderSource *included = _oriResolveInclude(source, open + 1, close - open - 1);
+
+                if (included && !_oriHasDependency(root, included)) {
+                    // a file that is already cached may be out of date, if this is the first source to include it
+                    _oriRefreshShaderSource(included);
+
+                    root->dependencies = realloc(root->dependencies, (root->dependencyCount + 1) * sizeof(_oriShaderSource *));
+                    root->dependencyRevisions = realloc(root->dependencyRevisions, (root->dependencyCount + 1) * sizeof(unsigned int));
+                    root->dependencies[root->dependencyCount] = included;
+                    root->dependencyRevisions[root->dependencyCount] = included->revision;
+                    root->dependencyCount++;
+
+                    // keep the line numbers in compile errors meaningful
+                    _oriAppend(out, "#line 1\n", 8);
+                    _oriExpandShaderSource(root, included, out);
+
+                    char lineDirective[32];
+                    int length = snprintf(lineDirective, sizeof(lineDirective), "\n#line %u\n", line + 1);
+                    _oriAppend(out, lineDirective, length);
+
+                    p = eol + 1;
+                    line++;
+                    continue;
+                }
+            }
+
+            // the directive is dropped, but the line is kept so that the line numbers stay the same
+            _oriAppend(out, "\n", 1);
+        } else if (eol - c >= 12 && !strncmp(c, "#pragma once", 12)) {
+            // every file is only included once anyway
+            _oriAppend(out, "\n", 1);
+        } else {
+            _oriAppend(out, p, eol - p);
+            _oriAppend(out, "\n", 1);
+        }
+
+        p = eol + 1;
+        line++;
+    }
+}
+
+// bring the expanded source up to date with the files on disk.
+// files are shared, so a file may already have been remapped while updating another source that includes it: the
+// revisions that the expanded source was made from are compared, rather than whether this update remapped anything.
+static void _oriUpdateShaderSource(_oriShaderSource *source) {
+    _oriRefreshShaderSource(source);
+    bool changed = !source->expanded || source->expandedRevision != source->revision;
+
+    for (unsigned int i = 0; i < source->dependencyCount; i++) {
+        // every dependency is checked, so that each one is remapped if it changed
+        _oriRefreshShaderSource(source->dependencies[i]);
+        changed = changed || source->dependencyRevisions[i] != source->dependencies[i]->revision;
+    }
+
+    if (!changed) {
+        return;
+    }
+
+    free(source->expanded);
+    source->dependencyCount = 0;
+    source->expandedRevision = source->revision;
+
+    _oriStringBuilder out = { NULL, 0, 0 };
+    _oriAppend(&out, "", 0);
+    _oriExpandShaderSource(source, source, &out);
+
+    source->expanded = out.data;
+    source->generation++;
+}
+
+// ======================================================================================
+// *****                    ORION INTERNAL SHADER SOURCE FUNCTIONS                  *****
+// ======================================================================================
+
+/**
+ * @brief Return the up-to-date, expanded source of the given shader file (and its generation), or NULL if the file can't be read.
+ * @details The generation of a source changes whenever its expanded source does.
+ * 
+ */
+const char *_orionGetShaderSource(const char *path, unsigned int *generation) {
+    char canonical[PATH_MAX];
+    if (!realpath(path, canonical)) {
+        return NULL;
+    }
+
+    _oriShaderSource *source = _oriGetShaderSource(canonical);
+    if (!source) {
+        return NULL;
+    }
+
+    _oriUpdateShaderSource(source);
+
+    if (generation) *generation = source->generation;
+    return source->expanded;
+}
+
+/**
+ * @brief Return the canonical path of the shader file that the given string was returned for by oriParseShader() (and its
+ * generation), or NULL if the string didn't come from oriParseShader().
+ * 
+ */
+const char *_orionGetShaderSourcePath(const char *src, unsigned int *generation) {
+    // the strings returned by oriParseShader() are the expanded sources themselves
+    for (_oriShaderSource *s = _orion.shaderSourceListHead; s; s = s->next) {
+        if (s->expanded && s->expanded == src) {
+            if (generation) *generation = s->generation;
+            return s->path;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Return true if a parsed shader source file has been written to since this was last called (always false if
+ * shader hot reloading is disabled).
+ * 
+ */
+bool _orionShaderSourcesModified() {
+#ifdef __linux__
+    if (!_orion.shaderHotReload.enabled) {
+        return false;
+    }
+
+    _Alignas(struct inotify_event) char buf[4096];
+    bool r = false;
+    ssize_t length;
+
+    // drain every pending event (the descriptor is non-blocking)
+    while ((length = read(_orion.shaderHotReload.fd, buf, sizeof(buf))) > 0) {
+        for (char *p = buf; p < buf + length; ) {
+            const struct inotify_event *e = (const struct inotify_event *) p;
+            p += sizeof(struct inotify_event) + e->len;
+
+            if (r || !e->len) {
+                continue;
+            }
+
+            // ignore other files in the watched directories (e.g. an editor's swap files)
+            for (_oriShaderSource *s = _orion.shaderSourceListHead; s; s = s->next) {
+                if (!strcmp(strrchr(s->path, '/') + 1, e->name)) {
+                    r = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    return r;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Unmap and free every cached shader source file.
+ * 
+ */
+void _orionFreeShaderSources() {
+    while (_orion.shaderSourceListHead) {
+        _oriShaderSource *next = _orion.shaderSourceListHead->next;
+
+        _oriUnmapShaderSource(_orion.shaderSourceListHead);
+        free(_orion.shaderSourceListHead->expanded);
+        free(_orion.shaderSourceListHead->dependencies);
+        free(_orion.shaderSourceListHead->dependencyRevisions);
+        free(_orion.shaderSourceListHead->path);
+        free(_orion.shaderSourceListHead);
+
+        _orion.shaderSourceListHead = next;
+    }
+}
+
+// ======================================================================================
+// *****                        ORION SHADER SOURCE FUNCTIONS                       *****
+// ======================================================================================
+
+/**
+ * @brief Parse a shader file and return it as a single string.
+ * @details Every <tt>\#include "file"</tt> (or <tt>\#include \<file\></tt>) directive is replaced with the contents of the
+ * named file, relative to the directory of the file that includes it. Includes are expanded recursively, and every file is
+ * included at most once (as if it began with <tt>\#pragma once</tt>), so include guards are not needed.
+ * 
+ * Files are read (or memory-mapped, if they are large) once and shared by every source that includes them, and the
+ * expanded source is cached until the file (or any file it includes) is modified on disk.
+ * 
+ * If the returned string is passed to oriAddShaderSource(), the shader remembers the file, so it can be hot reloaded
+ * (see oriShaderSourcesChanged()).
+ * 
+ * @note The returned string belongs to Orion: don't free it. It is freed as soon as Orion finds that the file (or any file
+ * it includes) has been modified: by the next oriParseShader() or oriAddShaderSourceFile() of the file, or by
+ * oriShaderSourcesChanged() or oriPollShaderHotReload(). Copy it if it must outlive that.
+ * 
+ * @param path the path to the shader, @b relative @b to @b the @b executable!
+ * @return an empty string if the file could not be read.
+ * 
+ * @ingroup shaders
+ */
+const char *oriParseShader(const char *path) {
+    const char *r = _orionGetShaderSource(path, NULL);
+
+    if (!r) {
+        _orionThrowWarning("(in oriParseShader()): The specified source file could not be accessed.");
+        return "";
+    }
+
+    return r;
+}
+
+/**
+ * @brief Watch every shader source file for changes, so that oriPollShaderHotReload() can rebuild the shaders that use them.
+ * @details Both the files that have already been parsed and any that are parsed later (see oriParseShader()) are watched,
+ * including every file they include. This is only supported on Linux (with inotify).
+ * 
+ * @return false if hot reloading is not supported or could not be enabled.
+ * 
+ * @ingroup shaders
+ */
+bool oriEnableShaderHotReload() {
+#ifdef __linux__
+    if (_orion.shaderHotReload.enabled) {
+        return true;
+    }
+
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) {
+        _orionThrowWarning("(in oriEnableShaderHotReload()): An inotify instance could not be created. Hot reloading not enabled.");
+        return false;
+    }
+
+    _orion.shaderHotReload.fd = fd;
+    _orion.shaderHotReload.enabled = true;
+
+    for (_oriShaderSource *s = _orion.shaderSourceListHead; s; s = s->next) {
+        _oriWatchShaderSource(s);
+    }
+
+    return true;
+#else
+    _orionThrowWarning("(in oriEnableShaderHotReload()): Shader hot reloading is only supported on Linux.");
+    return false;
+#endif
+}
+
+/**
+ * @brief Stop watching shader source files for changes.
+ * 
+ * @ingroup shaders
+ */
+void oriDisableShaderHotReload() {
+#ifdef __linux__
+    if (!_orion.shaderHotReload.enabled) {
+        return;
+    }
+
+    close(_orion.shaderHotReload.fd);
+    _orion.shaderHotReload.enabled = false;
+#endif
+}
@@ -0,0 +1,324 @@
+/* *************************************************************************************** */
+/*                        ORION GRAPHICS LIBRARY AND RENDERING ENGINE                      */
+/* *************************************************************************************** */
+/* Copyright (c) 2022 Jack Bennett                                                         */
+/* --------------------------------------------------------------------------------------- */
+/* THE  SOFTWARE IS  PROVIDED "AS IS",  WITHOUT WARRANTY OF ANY KIND, EXPRESS  OR IMPLIED, */
+/* INCLUDING  BUT  NOT  LIMITED  TO  THE  WARRANTIES  OF  MERCHANTABILITY,  FITNESS FOR  A */
+/* PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN  NO EVENT SHALL  THE  AUTHORS  OR COPYRIGHT */
+/* HOLDERS  BE  LIABLE  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF */
+/* CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR */
+/* THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                              */
+/* *************************************************************************************** */
+
+#include "internal.h"
+#include "oriongl.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+// ======================================================================================
+// *****                          ORION INTERNAL DATA TYPES                         *****
+// ======================================================================================
+
+/**
+ * @brief A compiled variant of a shader family, and the set of defines it was compiled with.
+ * 
+ */
+typedef struct _oriShaderVariant {
+    uint64_t hash;
+
+    // sorted copies of the defines
+    char **defines;
+    unsigned int defineCount;
+
+    oriShader *shader;
+} _oriShaderVariant;
+
+typedef struct _oriShaderFamilyStage {
+    unsigned int type;
+    char *src;
+} _oriShaderFamilyStage;
+
+// ======================================================================================
+// *****                            ORION PUBLIC STRUCTURES                         *****
+// ======================================================================================
+
+/**
+ * @brief A set of shader sources that is compiled into a separate, specialised program for every combination of defines.
+ * 
+ * @ingroup shaders
+ */
+typedef struct oriShaderFamily {
+    oriShaderFamily *next;
+
+    _oriShaderFamilyStage *stages;
+    unsigned int stageCount;
+
+    // open-addressed hash table of the variants compiled so far (NULL marks an empty slot). the size is always a power of two
+    _oriShaderVariant **variants;
+    unsigned int variantCount;
+    unsigned int variantTableSize;
+} oriShaderFamily;
+
+// ======================================================================================
+// *****                           ORION HELPER FUNCTIONS                           *****
+// ======================================================================================
+
+static int _oriCompareDefines(const void *a, const void *b) {
+    return strcmp(*(const char **) a, *(const char **) b);
+}
+
+// hash a sorted set of defines (64-bit FNV-1a, including each null terminator so that e.g. {"AB"} and {"A", "B"} differ)
+static uint64_t _oriHashDefines(const char **defines, const unsigned int count) {
+    uint64_t h = _ORION_FNV64_OFFSET;
+    for (unsigned int i = 0; i < count; i++) {
+        for (const char *c = defines[i]; ; c++) {
+            h ^= (unsigned char) *c;
+            h *= 0x100000001b3ULL;
+
+            if (!*c) {
+                break;
+            }
+        }
+    }
+    return h;
+}
+
+static bool _oriVariantMatches(const _oriShaderVariant *variant, const uint64_t hash, const char **defines, const unsigned int count) {
+    if (variant->hash != hash || variant->defineCount != count) {
+        return false;
+    }
+    for (unsigned int i = 0; i < count; i++) {
+        if (strcmp(variant->defines[i], defines[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void _oriInsertVariant(oriShaderFamily *family, _oriShaderVariant *variant) {
+    unsigned int mask = family->variantTableSize - 1;
+    unsigned int slot = variant->hash & mask;
+    while (family->variants[slot])
+        slot = (slot + 1) & mask;
+    family->variants[slot] = variant;
+}
+
+// return a copy of src with a #define line for every define inserted after its #version directive.
+// a #line directive follows the defines, so that line numbers in compile errors still match the original source.
+static char *_oriInjectDefines(const char *src, const char **defines, const unsigned int count) {
+    // find the end of the #version line (GLSL requires #version to come before anything but comments and whitespace)
+    const char *insert = src;
+    unsigned int line = 1;
+
+    const char *version = strstr(src, "#version");
+    if (version) {
+        for (const char *c = src; c < version; c++) {
+            if (*c == '\n') line++;
+        }
+
+        insert = strchr(version, '\n');
+        insert = insert ? insert + 1 : version + strlen(version);
+        line++;
+    }
+
+    size_t size = strlen(src) + 32;
+    for (unsigned int i = 0; i < count; i++) {
+        size += strlen(defines[i]) + 10;
+    }
+
+    char *r = malloc(size);
+    size_t prefix = insert - src;
+    memcpy(r, src, prefix);
+
+    // the #version line may be the last line of the source
+    char *w = r + prefix;
+    if (prefix && r[prefix - 1] != '\n') {
+        *w++ = '\n';
+    }
+
+    for (unsigned int i = 0; i < count; i++) {
+        w += sprintf(w, "#define %s\n", defines[i]);
+    }
+    w += sprintf(w, "#line %u\n", line);
+
+    strcpy(w, insert);
+    return r;
+}
+
+// ======================================================================================
+// *****                        ORION SHADER VARIANT FUNCTIONS                      *****
+// ======================================================================================
+
+/**
+ * @brief Allocate and initialise a new oriShaderFamily structure.
+ * @details A shader family holds the source of every stage of a shader program. Rather than choosing between code paths with
+ * uniforms at runtime, the sources can use preprocessor conditionals (e.g. @c #ifdef), and a separate, specialised program is
+ * compiled for each set of defines that is requested with oriGetShaderVariant().
+ * 
+ * @ingroup shaders
+ */
+oriShaderFamily *oriCreateShaderFamily() {
+    _orionAssertVersion(200);
+
+    oriShaderFamily *r = malloc(sizeof(oriShaderFamily));
+
+    r->stages = NULL;
+    r->stageCount = 0;
+
+    r->variants = NULL;
+    r->variantCount = 0;
+    r->variantTableSize = 0;
+
+    // link to global linked list
+    r->next = _orion.shaderFamilyListHead;
+    _orion.shaderFamilyListHead = r;
+
+    return r;
+}
+
+/**
+ * @brief Destroy and free memory for the given shader family, including every variant compiled from it.
+ * 
+ * @param family the shader family to free.
+ * 
+ * @ingroup shaders
+ */
+void oriFreeShaderFamily(oriShaderFamily *family) {
+    // unlink from global linked list
+    oriShaderFamily **current = &_orion.shaderFamilyListHead;
+    while (*current != family)
+        current = &(*current)->next;
+    *current = family->next;
+
+    for (unsigned int i = 0; i < family->variantTableSize; i++) {
+        _oriShaderVariant *v = family->variants[i];
+        if (!v) {
+            continue;
+        }
+
+        oriFreeShader(v->shader);
+
+        for (unsigned int j = 0; j < v->defineCount; j++) {
+            free(v->defines[j]);
+        }
+        free(v->defines);
+        free(v);
+    }
+    free(family->variants);
+
+    for (unsigned int i = 0; i < family->stageCount; i++) {
+        free(family->stages[i].src);
+    }
+    free(family->stages);
+
+    free(family);
+    family = NULL;
+}
+
+/**
+ * @brief Add GLSL source to the given shader family.
+ * @details Sources can only be added before the first variant is requested.
+ * 
+ * @param family the shader family to modify.
+ * @param type the type of source code (e.g. @c GL_VERTEX_SHADER)
+ * @param src the source code to add, as a string. It must contain a @c #version directive if it uses any defines.
+ * 
+ * @ingroup shaders
+ */
+void oriAddShaderFamilySource(oriShaderFamily *family, const unsigned int type, const char *src) {
+    if (family->variantCount) {
+        _orionThrowWarning("(in oriAddShaderFamilySource()): Sources can't be added to a shader family after a variant has been created. Source not added.");
+        return;
+    }
+
+    family->stages = realloc(family->stages, (family->stageCount + 1) * sizeof(_oriShaderFamilyStage));
+    family->stages[family->stageCount].type = type;
+    family->stages[family->stageCount].src = malloc(strlen(src) + 1);
+    strcpy(family->stages[family->stageCount].src, src);
+    family->stageCount++;
+}
+
+/**
+ * @brief Return the variant of the given shader family that is compiled with the given set of defines.
+ * @details Each define is inserted into every stage of the family as <tt>\#define [define]</tt>, directly after the
+ * @c #version directive, so a define can give a name a value by including it after a space (e.g. <tt>"ORION_BLEND_MODE 4"</tt>).
+ * The order of the defines doesn't matter.
+ * 
+ * Variants are cached: the first request for a set of defines creates and links the program (see oriLinkShader(), so it
+ * compiles in parallel where supported), and any later request for the same set returns the same oriShader.
+ * 
+ * @note The returned shader belongs to the family and is freed with it; don't free it with oriFreeShader().
+ * 
+ * @param family the shader family to get a variant of.
+ * @param defines an array of defines (may be NULL if @c count is 0).
+ * @param count the number of defines in the array.
+ * 
+ * @ingroup shaders
+ */
+oriShader *oriGetShaderVariant(oriShaderFamily *family, const char **defines, const unsigned int count) {
+    _orionAssertVersion(200);
+
+    // the key is the sorted set of defines, so that their order doesn't matter
+    const char **sorted = malloc((count ? count : 1) * sizeof(const char *));
+    if (count) {
+        memcpy(sorted, defines, count * sizeof(const char *));
+        qsort(sorted, count, sizeof(const char *), _oriCompareDefines);
+    }
+
+    uint64_t hash = _oriHashDefines(sorted, count);
+
+    // look for a variant that has already been compiled
+    if (family->variantTableSize) {
+        unsigned int mask = family->variantTableSize - 1;
+        for (unsigned int slot = hash & mask; family->variants[slot]; slot = (slot + 1) & mask) {
+            if (_oriVariantMatches(family->variants[slot], hash, sorted, count)) {
+                free(sorted);
+                return family->variants[slot]->shader;
+            }
+        }
+    }
+
+    // create a new variant
+    _oriShaderVariant *v = malloc(sizeof(_oriShaderVariant));
+    v->hash = hash;
+    v->defineCount = count;
+    v->defines = malloc((count ? count : 1) * sizeof(char *));
+    for (unsigned int i = 0; i < count; i++) {
+        v->defines[i] = malloc(strlen(sorted[i]) + 1);
+        strcpy(v->defines[i], sorted[i]);
+    }
+
+    v->shader = oriCreateShader();
+    for (unsigned int i = 0; i < family->stageCount; i++) {
+        char *src = _oriInjectDefines(family->stages[i].src, sorted, count);
+        oriAddShaderSource(v->shader, family->stages[i].type, src);
+        free(src);
+    }
+    oriLinkShader(v->shader);
+
+    free(sorted);
+
+    // keep the hash table at most half full
+    family->variantCount++;
+    if (family->variantCount * 2 > family->variantTableSize) {
+        unsigned int oldSize = family->variantTableSize;
+        _oriShaderVariant **old = family->variants;
+
+        family->variantTableSize = oldSize ? oldSize * 2 : 16;
+        family->variants = calloc(family->variantTableSize, sizeof(_oriShaderVariant *));
+
+        for (unsigned int i = 0; i < oldSize; i++) {
+            if (old[i]) {
+                _oriInsertVariant(family, old[i]);
+            }
+        }
+        free(old);
+    }
+    _oriInsertVariant(family, v);
+
+    return v->shader;
+}
@@ -0,0 +1,277 @@
+/* *************************************************************************************** */
+/*                        ORION GRAPHICS LIBRARY AND RENDERING ENGINE                      */
+/* *************************************************************************************** */
+/* Copyright (c) 2022 Jack Bennett                                                         */
+/* --------------------------------------------------------------------------------------- */
+/* THE  SOFTWARE IS  PROVIDED "AS IS",  WITHOUT WARRANTY OF ANY KIND, EXPRESS  OR IMPLIED, */
+/* INCLUDING  BUT  NOT  LIMITED  TO  THE  WARRANTIES  OF  MERCHANTABILITY,  FITNESS FOR  A */
+/* PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN  NO EVENT SHALL  THE  AUTHORS  OR COPYRIGHT */
+/* HOLDERS  BE  LIABLE  FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF */
+/* CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR */
+/* THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                              */
+/* *************************************************************************************** */
+
+#include "internal.h"
+#include "oriongl.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// ======================================================================================
+// *****                          ORION INTERNAL DATA TYPES                         *****
+// ======================================================================================
+
+/**
+ * @brief One array texture of a texture pool, and which of its layers are free.
+ * 
+ */
+typedef struct _oriTexturePoolArray {
+    struct _oriTexturePoolArray *next;
+
+    oriTexture *texture;
+
+    // stack of the free layers, and whether each layer is in use (to catch layers being freed twice)
+    unsigned int *freeLayers;
+    unsigned int freeCount;
+    bool *used;
+} _oriTexturePoolArray;
+
+/**
+ * @brief Every array texture of a texture pool with the same layer size, format and number of mipmap levels.
+ * 
+ */
+typedef struct _oriTexturePoolGroup {
+    struct _oriTexturePoolGroup *next;
+
+    unsigned int width;
+    unsigned int height;
+    unsigned int internalFormat;
+    unsigned int levels;
+
+    _oriTexturePoolArray *arrayListHead;
+} _oriTexturePoolGroup;
+
+// ======================================================================================
+// *****                            ORION PUBLIC STRUCTURES                         *****
+// ======================================================================================
+
+/**
+ * @brief A collection of array textures that same-sized 2D images are given layers of.
+ * 
+ * @ingroup textures
+ */
+typedef struct oriTexturePool {
+    oriTexturePool *next;
+
+    unsigned int layersPerArray;
+
+    _oriTexturePoolGroup *groupListHead;
+} oriTexturePool;
+
+// ======================================================================================
+// *****                           ORION HELPER FUNCTIONS                           *****
+// ======================================================================================
+
+static _oriTexturePoolArray *_oriCreatePoolArray(oriTexturePool *pool, _oriTexturePoolGroup *group) {
+    _oriTexturePoolArray *r = malloc(sizeof(_oriTexturePoolArray));
+
+    r->texture = oriCreateTextureImmutable(GL_TEXTURE_2D_ARRAY, group->width, group->height, pool->layersPerArray, group->internalFormat, group->levels, 0, false);
+    oriSetTextureParameteri(r->texture, GL_TEXTURE_MIN_FILTER, group->levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    oriSetTextureParameteri(r->texture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    // the lowest layers are handed out first
+    r->freeLayers = malloc(pool->layersPerArray * sizeof(unsigned int));
+    r->freeCount = pool->layersPerArray;
+    for (unsigned int i = 0; i < pool->layersPerArray; i++) {
+        r->freeLayers[i] = pool->layersPerArray - 1 - i;
+    }
+    r->used = calloc(pool->layersPerArray, sizeof(bool));
+
+    r->next = group->arrayListHead;
+    group->arrayListHead = r;
+
+    return r;
+}
+
+// ======================================================================================
+// *****                        ORION TEXTURE POOL FUNCTIONS                        *****
+// ======================================================================================
+
+/**
+ * @brief Allocate and initialise a new oriTexturePool structure.
+ * @details A texture pool gives each 2D image a layer of a shared @c GL_TEXTURE_2D_ARRAY, instead of a texture of its own.
+ * Images with the same size, internal format and number of mipmap levels share arrays, so objects drawn with different
+ * images (e.g. materials) can be drawn with one texture binding, and merged into a single instanced or multi-draw call
+ * (see oriDrawBatch) with the layer of each image passed per instance or per draw.
+ * 
+ * Arrays are created with immutable storage as they are needed, each with @c layersPerArray layers, and layers are
+ * reused once they are freed.
+ * 
+ * @param layersPerArray the number of layers in each array texture. It is limited to @c GL_MAX_ARRAY_TEXTURE_LAYERS.
+ * 
+ * @ingroup textures
+ */
+oriTexturePool *oriCreateTexturePool(unsigned int layersPerArray) {
+    _orionAssertVersion(420);
+
+    if (!layersPerArray) {
+        _orionThrowError(ORERR_NULL_RECIEVED);
+    }
+
+    int maxLayers;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+    if (layersPerArray > (unsigned int) maxLayers) {
+        _orionThrowWarning("(in oriCreateTexturePool()): The number of layers per array is larger than GL_MAX_ARRAY_TEXTURE_LAYERS, so it has been limited to it.");
+        layersPerArray = maxLayers;
+    }
+
+    oriTexturePool *r = malloc(sizeof(oriTexturePool));
+    r->layersPerArray = layersPerArray;
+    r->groupListHead = NULL;
+
+    // link to global linked list
+    r->next = _orion.texturePoolListHead;
+    _orion.texturePoolListHead = r;
+
+    return r;
+}
+
+/**
+ * @brief Destroy and free memory for the given texture pool, including all of its array textures.
+ * 
+ * @param pool the texture pool to free.
+ * 
+ * @ingroup textures
+ */
+void oriFreeTexturePool(oriTexturePool *pool) {
+    // unlink from global linked list
+    oriTexturePool **current = &_orion.texturePoolListHead;
+    while (*current != pool)
+        current = &(*current)->next;
+    *current = pool->next;
+
+    while (pool->groupListHead) {
+        _oriTexturePoolGroup *group = pool->groupListHead;
+        pool->groupListHead = group->next;
+
+        while (group->arrayListHead) {
+            _oriTexturePoolArray *array = group->arrayListHead;
+            group->arrayListHead = array->next;
+
+            oriFreeTexture(array->texture);
+            free(array->freeLayers);
+            free(array->used);
+            free(array);
+        }
+
+        free(group);
+    }
+
+    free(pool);
+    pool = NULL;
+}
+
+/**
+ * @brief Give a layer of one of the given pool's array textures to an image.
+ * @details Upload the image into the layer with oriUploadTexSubImage(), using the layer as @c zoffset (and a @c depth of 1),
+ * and sample it with a @c sampler2DArray, using the layer as the third texture coordinate.
+ * 
+ * @param pool the texture pool to allocate from.
+ * @param width the width of the image.
+ * @param height the height of the image.
+ * @param internalFormat the internal format the image is stored with, e.g. @c GL_RGBA8.
+ * @param levels the number of mipmap levels the image has (at least 1).
+ * @param layer the texture layer to write the result into.
+ * @return false if the allocation failed.
+ * 
+ * @ingroup textures
+ */
+bool oriTexturePoolAlloc(oriTexturePool *pool, const unsigned int width, const unsigned int height, const unsigned int internalFormat, const unsigned int levels, oriTextureLayer *layer) {
+    if (!width || !height || !levels || !layer) {
+        _orionThrowWarning("(in oriTexturePoolAlloc()): Invalid size, levels or layer given. Nothing was allocated.");
+        return false;
+    }
+
+    // find the arrays for images like this one, or start them
+    _oriTexturePoolGroup *group = pool->groupListHead;
+    while (group && (group->width != width || group->height != height || group->internalFormat != internalFormat || group->levels != levels))
+        group = group->next;
+
+    if (!group) {
+        group = malloc(sizeof(_oriTexturePoolGroup));
+        group->width = width;
+        group->height = height;
+        group->internalFormat = internalFormat;
+        group->levels = levels;
+        group->arrayListHead = NULL;
+
+        group->next = pool->groupListHead;
+        pool->groupListHead = group;
+    }
+
+    _oriTexturePoolArray *array = group->arrayListHead;
+    while (array && !array->freeCount)
+        array = array->next;
+
+    if (!array) {
+        array = _oriCreatePoolArray(pool, group);
+    }
+
+    unsigned int index = array->freeLayers[--array->freeCount];
+    array->used[index] = true;
+
+    layer->texture = array->texture;
+    layer->layer = index;
+    layer->array = array;
+
+    return true;
+}
+
+/**
+ * @brief Free a layer that was allocated with oriTexturePoolAlloc(), so that it can be given to another image.
+ * @details The array texture itself is kept, even if none of its layers are in use, until the pool is freed.
+ * 
+ * @param pool the texture pool that the layer was allocated from.
+ * @param layer the layer to free. It is reset to zero.
+ * 
+ * @ingroup textures
+ */
+void oriTexturePoolFree(oriTexturePool *pool, oriTextureLayer *layer) {
+    _oriTexturePoolArray *array = layer->array;
+    if (!array || layer->layer >= pool->layersPerArray || !array->used[layer->layer]) {
+        _orionThrowWarning("(in oriTexturePoolFree()): Attempted to free an invalid or already-freed texture pool layer.");
+        return;
+    }
+
+    array->used[layer->layer] = false;
+    array->freeLayers[array->freeCount++] = layer->layer;
+
+    memset(layer, 0, sizeof(oriTextureLayer));
+}
+
+/**
+ * @brief Return statistics about the given texture pool into the specified variables.
+ * 
+ * @details If you don't want to recieve a statistic, pass NULL as the argument.
+ * 
+ * @param pool the texture pool to inspect.
+ * @param arrays the number of array textures created by the pool.
+ * @param layers the number of layers in all of the pool's array textures.
+ * @param usedLayers the number of layers that are currently allocated.
+ * 
+ * @ingroup textures
+ */
+void oriGetTexturePoolStats(oriTexturePool *pool, unsigned int *arrays, unsigned int *layers, unsigned int *usedLayers) {
+    unsigned int arrayCount = 0, freeCount = 0;
+
+    for (_oriTexturePoolGroup *group = pool->groupListHead; group; group = group->next) {
+        for (_oriTexturePoolArray *array = group->arrayListHead; array; array = array->next) {
+            arrayCount++;
+            freeCount += array->freeCount;
+        }
+    }
+
+    if (arrays) *arrays = arrayCount;
+    if (layers) *layers = arrayCount * pool->layersPerArray;
+    if (usedLayers) *usedLayers = arrayCount * pool->layersPerArray - freeCount;
+}
@@ -17,6 +17,28 @@
 #include "string.h"
 #include "stdlib.h"
 #include "stdio.h"
+#include "stdint.h"
+
+// ======================================================================================
+// *****                          ORION INTERNAL DATA TYPES                         *****
+// ======================================================================================
+
+/**
+ * @brief An upload queued in an oriTextureUploader, waiting to be issued from the uploader's pixel unpack buffer.
+ *
+ */
+typedef struct _oriQueuedTextureUpload {
+    oriTexture *texture;
+
+    unsigned int level;
+    unsigned int xoffset, yoffset, zoffset;
+    unsigned int width, height, depth;
+    unsigned int imageFormat;
+    unsigned int dataType;
+
+    // offset of the (tightly packed) image data from the start of the current region
+    unsigned int offset;
+} _oriQueuedTextureUpload;
 
 // ======================================================================================
 // *****                            ORION PUBLIC STRUCTURES                         *****
@@ -26,6 +48,9 @@ typedef struct oriTexture {
     oriTexture *next;
     unsigned int handle;
 
+    // unique to this texture (see _orionGetTextureSerial())
+    unsigned long serial;
+
     unsigned int type;
     unsigned int width;
     unsigned int height;
@@ -35,8 +60,144 @@ typedef struct oriTexture {
     unsigned int samples;
 
     bool immutableStorage;
+
+    // set when the base level is changed by oriUploadTexSubImage(); the mipmaps are regenerated when the texture is next bound
+    bool mipmapsDirty;
 } oriTexture;
 
+/**
+ * @brief A ring of pixel unpack buffer regions that texture uploads are staged in, and issued from a frame later.
+ *
+ * @ingroup textures
+ */
+typedef struct oriTextureUploader {
+    oriTextureUploader *next;
+
+    // one region of the stream buffer is filled per frame
+    oriStreamBuffer *stream;
+    unsigned int regionSize;
+
+    // the mapped memory of the current region, if one has been started with oriStreamBufferBegin() and not yet fenced
+    bool regionOpen;
+    unsigned char *region;
+    unsigned int regionUsed;
+
+    _oriQueuedTextureUpload *uploads;
+    unsigned int uploadCount;
+    unsigned int uploadCapacity;
+} oriTextureUploader;
+
+// ======================================================================================
+// *****                           ORION HELPER FUNCTIONS                           *****
+// ======================================================================================
+
+/**
+ * @brief Return the size, in bytes, of a single pixel with the given format and type, or 0 if either is not recognised.
+ *
+ */
+unsigned int _orionPixelSize(const unsigned int format, const unsigned int type) {
+    // packed types hold every component of a pixel
+    switch (type) {
+        case GL_UNSIGNED_BYTE_3_3_2:
+        case GL_UNSIGNED_BYTE_2_3_3_REV:
+            return 1;
+        case GL_UNSIGNED_SHORT_5_6_5:
+        case GL_UNSIGNED_SHORT_5_6_5_REV:
+        case GL_UNSIGNED_SHORT_4_4_4_4:
+        case GL_UNSIGNED_SHORT_4_4_4_4_REV:
+        case GL_UNSIGNED_SHORT_5_5_5_1:
+        case GL_UNSIGNED_SHORT_1_5_5_5_REV:
+            return 2;
+        case GL_UNSIGNED_INT_8_8_8_8:
+        case GL_UNSIGNED_INT_8_8_8_8_REV:
+        case GL_UNSIGNED_INT_10_10_10_2:
+        case GL_UNSIGNED_INT_2_10_10_10_REV:
+        case GL_UNSIGNED_INT_24_8:
+        case GL_UNSIGNED_INT_10F_11F_11F_REV:
+        case GL_UNSIGNED_INT_5_9_9_9_REV:
+            return 4;
+        case GL_FLOAT_32_UNSIGNED_INT_24_8_REV:
+            return 8;
+    }
+
+    unsigned int componentSize;
+    switch (type) {
+        case GL_UNSIGNED_BYTE:
+        case GL_BYTE:
+            componentSize = 1;
+            break;
+        case GL_UNSIGNED_SHORT:
+        case GL_SHORT:
+        case GL_HALF_FLOAT:
+            componentSize = 2;
+            break;
+        case GL_UNSIGNED_INT:
+        case GL_INT:
+        case GL_FLOAT:
+            componentSize = 4;
+            break;
+        default:
+            return 0;
+    }
+
+    switch (format) {
+        case GL_RED:
+        case GL_RED_INTEGER:
+        case GL_DEPTH_COMPONENT:
+        case GL_STENCIL_INDEX:
+            return componentSize;
+        case GL_RG:
+        case GL_RG_INTEGER:
+        case GL_DEPTH_STENCIL:
+            return componentSize * 2;
+        case GL_RGB:
+        case GL_BGR:
+        case GL_RGB_INTEGER:
+        case GL_BGR_INTEGER:
+            return componentSize * 3;
+        case GL_RGBA:
+        case GL_BGRA:
+        case GL_RGBA_INTEGER:
+        case GL_BGRA_INTEGER:
+            return componentSize * 4;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Return true if the mipmaps of the given texture can (and need to) be generated with oriGenerateTextureMipmap().
+ *
+ */
+static bool _oriHasGeneratedMipmaps(oriTexture *texture) {
+    if (_orion.glVersion < 300) {
+        return false;
+    }
+
+    // an immutable texture with only a base level has no mipmaps to update
+    if (texture->immutableStorage && texture->levels == 1) {
+        return false;
+    }
+
+    switch (texture->type) {
+        case GL_TEXTURE_RECTANGLE:
+        case GL_TEXTURE_2D_MULTISAMPLE:
+        case GL_TEXTURE_2D_MULTISAMPLE_ARRAY:
+        case GL_TEXTURE_BUFFER:
+            return false;
+        default:
+            return true;
+    }
+}
+
+/**
+ * @brief Return the serial of the given texture, which no other texture has (or will have), unlike its OpenGL name.
+ *
+ */
+unsigned long _orionGetTextureSerial(oriTexture *texture) {
+    return texture->serial;
+}
+
 // ======================================================================================
 // *****                           ORION TEXTURE FUNCTIONS                          *****
 // ======================================================================================
@@ -65,6 +226,7 @@ oriTexture *oriCreateTexture(unsigned int target, unsigned int internalFormat) {
     }
 
     oriTexture *r = malloc(sizeof(oriTexture));
+    r->serial = ++_orion.textureSerial;
     r->type = target;
     r->width = 0;
     r->height = 0;
@@ -73,6 +235,7 @@ oriTexture *oriCreateTexture(unsigned int target, unsigned int internalFormat) {
     r->levels = 0;
     r->samples = 0;
     r->immutableStorage = false;
+    r->mipmapsDirty = false;
 
     // use DSA if possible
     if (_orion.glVersion >= 450) {
@@ -145,10 +308,10 @@ oriTexture *oriCreateTextureImmutable(unsigned int target, unsigned int width, u
             break;
         case GL_TEXTURE_2D_MULTISAMPLE:
             glTexStorageFuncType = 3;
-            return r;
+            break;
         case GL_TEXTURE_2D_MULTISAMPLE_ARRAY:
             glTexStorageFuncType = 4;
-            return r;
+            break;
         default:
             _orionThrowWarning("(in oriCreateTextureImmutable()): Unsupported texture type specified. Immutable texture storage not allocated.");
             return r;
@@ -231,11 +394,14 @@ void oriFreeTexture(oriTexture *texture) {
     _orionAssertVersion(200);
 
     // unlink from global linked list.
-    oriTexture *current = _orion.textureListHead;
-    while (current != texture) {
-        current = current->next;
+    oriTexture **current = &_orion.textureListHead;
+    while (*current != texture) {
+        current = &(*current)->next;
     }
-    _orion.textureListHead = texture->next;
+    *current = texture->next;
+
+    // deleting the texture would only detach it from the framebuffer that is currently bound
+    _orionDetachFramebufferTexture(texture->serial);
 
     glDeleteTextures(1, &texture->handle);
 
@@ -245,6 +411,8 @@ void oriFreeTexture(oriTexture *texture) {
 
 /**
  * @brief Bind a given texture to the specified target.
+ * @details If the base level of the texture has been changed with oriUploadTexSubImage(), its mipmaps are regenerated first.
+ * Nothing is done if the texture is already bound to @c unit, and the active texture unit is only changed if it has to be.
  *
  * @param texture the texture to bind.
  * @param unit the texture image unit to bind the texture to.
@@ -254,14 +422,76 @@ void oriFreeTexture(oriTexture *texture) {
 void oriBindTexture(oriTexture *texture, unsigned int unit) {
     _orionAssertVersion(200);
 
-    if (oriCurrentTextureAt(texture->type) == texture->handle) {
+    // regenerate mipmaps that are out of date before the texture is sampled
+    if (texture->mipmapsDirty) {
+        oriGenerateTextureMipmap(texture);
+    }
+
+    if (oriCurrentTextureAtUnit(unit, texture->type) == texture->handle) {
         return;
     }
 
-    glActiveTexture(GL_TEXTURE0 + unit);
+    if (oriActiveTextureUnit() != unit) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+    }
     glBindTexture(texture->type, texture->handle);
 }
 
+/**
+ * @brief Bind textures to a range of consecutive texture units.
+ * @details From OpenGL 4.4, the textures are bound with one call to @c glBindTextures. Below 4.4, each texture is bound
+ * with oriBindTexture(). Either way, textures that are already bound to their unit are not bound again.
+ *
+ * @param first the texture image unit to bind the first texture to.
+ * @param count the number of textures to bind.
+ * @param textures the textures to bind. An entry can be NULL to leave its unit unchanged.
+ *
+ * @ingroup textures
+ */
+void oriBindTextures(unsigned int first, unsigned int count, oriTexture **textures) {
+    _orionAssertVersion(200);
+
+    if (_orion.glVersion < 440) {
+        for (unsigned int i = 0; i < count; i++) {
+            if (textures[i]) {
+                oriBindTexture(textures[i], first + i);
+            }
+        }
+        return;
+    }
+
+    unsigned int targets[32];
+    unsigned int handles[32];
+
+    // bind each run of textures that are not already bound with one call (of at most 32 textures)
+    unsigned int runStart = 0, runLength = 0;
+    for (unsigned int i = 0; i <= count; i++) {
+        bool bind = false;
+        if (i < count && textures[i]) {
+            // regenerate mipmaps that are out of date before the texture is sampled
+            if (textures[i]->mipmapsDirty) {
+                oriGenerateTextureMipmap(textures[i]);
+            }
+
+            bind = oriCurrentTextureAtUnit(first + i, textures[i]->type) != textures[i]->handle;
+        }
+
+        if (bind) {
+            if (!runLength) {
+                runStart = i;
+            }
+            targets[runLength] = textures[i]->type;
+            handles[runLength] = textures[i]->handle;
+            runLength++;
+        }
+
+        if (runLength && (!bind || runLength == 32)) {
+            orion_glBindTextures(first + runStart, runLength, targets, handles);
+            runLength = 0;
+        }
+    }
+}
+
 /**
  * @brief Return the OpenGL handle to the given texture structure.
  *
@@ -339,7 +569,7 @@ void oriUploadTexImage(oriTexture *texture, unsigned int dataType, const void *d
         case GL_TEXTURE_2D_ARRAY:
         case GL_TEXTURE_CUBE_MAP_ARRAY:
             glTexImageFuncType = 2;
-            return;
+            break;
         case GL_TEXTURE_2D_MULTISAMPLE:
         case GL_TEXTURE_2D_MULTISAMPLE_ARRAY:
             _orionThrowWarning("(in oriUploadTexImage()): OpenGL does not support directly writing to multisample textures. Texture data not updated.");
@@ -357,7 +587,10 @@ void oriUploadTexImage(oriTexture *texture, unsigned int dataType, const void *d
         glBindTexture(texture->type, texture->handle);
     }
 
-    if (texture->immutableStorage) {
+    // storage only has to be reallocated if the texture is mutable and the size of its image changes
+    bool sameSize = texture->width && width == texture->width && height == texture->height && depth == texture->depth;
+
+    if (texture->immutableStorage || sameSize) {
         switch (glTexImageFuncType) {
             case 0:
                 if (_orion.glVersion >= 450) {
@@ -434,10 +667,161 @@ void oriUploadTexImage(oriTexture *texture, unsigned int dataType, const void *d
         // generate mipmap with DSA
         glGenerateTextureMipmap(texture->handle);
     }
+
+    texture->mipmapsDirty = false;
+}
+
+/**
+ * @brief Update a region of one level of the given texture's image, without reallocating its storage or regenerating its mipmaps.
+ *
+ * @details The source data can be a sub-rectangle of a larger image in memory, without being repacked: give the width of the
+ * whole image as @c rowLength, and the position of the sub-rectangle in it as @c skipPixels and @c skipRows. Each row of
+ * the source image must start on a 4-byte boundary, as with any other upload (see @c GL_UNPACK_ALIGNMENT).
+ *
+ * Mipmaps are not regenerated here, so many regions can be updated at the cost of a single regeneration. If the base
+ * level is changed, the mipmaps are regenerated when the texture is next bound with oriBindTexture(), or they can be
+ * regenerated explicitly with oriGenerateTextureMipmap(). Uploading to any other level clears the pending regeneration,
+ * so that mipmap levels can also be supplied by the caller. Textures without mipmaps (rectangle textures, and immutable
+ * textures with a single level) are never regenerated, and neither is anything before OpenGL 3.0.
+ *
+ * @param texture the texture object to update. Its storage must already be allocated (e.g. with oriCreateTextureImmutable() or oriUploadTexImage()).
+ * @param level the mipmap level to update.
+ * @param xoffset the x coordinate of the region in the texture.
+ * @param yoffset the y coordinate of the region in the texture (or the first layer, for 1D array textures).
+ * @param zoffset the z coordinate of the region in the texture (or the first layer, for array textures, or the face, for cube maps).
+ * @param width the width of the region.
+ * @param height the height of the region. Set to 1 if the texture is 1D.
+ * @param depth the depth of the region. Set to 1 if the texture is not 3D, an array of 2D textures or a cube map.
+ * @param imageFormat the format of the source image (e.g. @c GL_RGBA).
+ * @param dataType the GL type of the given data (e.g. GL_UNSIGNED_BYTE if @c data is an unsigned char array)
+ * @param data the image data to use.
+ * @param rowLength the width, in pixels, of the whole source image. Set to 0 if the rows of the source image are @c width pixels wide.
+ * @param skipPixels the number of pixels to skip at the start of each row of the source image.
+ * @param skipRows the number of rows to skip at the start of the source image.
+ *
+ * @ingroup textures
+ */
+void oriUploadTexSubImage(oriTexture *texture, unsigned int level, unsigned int xoffset, unsigned int yoffset, unsigned int zoffset, unsigned int width, unsigned int height, unsigned int depth, unsigned int imageFormat, unsigned int dataType, const void *data, unsigned int rowLength, unsigned int skipPixels, unsigned int skipRows) {
+    _orionAssertVersion(200);
+
+    // 0: glTex*SubImage1D
+    // 1: glTex*SubImage2D
+    // 2: glTex*SubImage3D
+    // 3: glTex*SubImage2D for each face of a cube map (glTextureSubImage3D if DSA is possible)
+    unsigned int glTexSubImageFuncType;
+
+    switch (texture->type) {
+        case GL_TEXTURE_1D:
+            glTexSubImageFuncType = 0;
+            break;
+        case GL_TEXTURE_2D:
+        case GL_TEXTURE_RECTANGLE:
+        case GL_TEXTURE_1D_ARRAY:
+            glTexSubImageFuncType = 1;
+            break;
+        case GL_TEXTURE_3D:
+        case GL_TEXTURE_2D_ARRAY:
+        case GL_TEXTURE_CUBE_MAP_ARRAY:
+            glTexSubImageFuncType = 2;
+            break;
+        case GL_TEXTURE_CUBE_MAP:
+            glTexSubImageFuncType = 3;
+            break;
+        case GL_TEXTURE_2D_MULTISAMPLE:
+        case GL_TEXTURE_2D_MULTISAMPLE_ARRAY:
+            _orionThrowWarning("(in oriUploadTexSubImage()): OpenGL does not support directly writing to multisample textures. Texture data not updated.");
+            return;
+        default:
+            _orionThrowWarning("(in oriUploadTexSubImage()): Unsupported texture type specified. Texture data not updated.");
+            return;
+    }
+
+    if (!texture->width) {
+        _orionThrowWarning("(in oriUploadTexSubImage()): The texture has no storage allocated. Texture data not updated.");
+        return;
+    }
+
+    // describe where the region is in the source image
+    if (rowLength) glPixelStorei(GL_UNPACK_ROW_LENGTH, rowLength);
+    if (skipPixels) glPixelStorei(GL_UNPACK_SKIP_PIXELS, skipPixels);
+    if (skipRows) glPixelStorei(GL_UNPACK_SKIP_ROWS, skipRows);
+
+    if (_orion.glVersion >= 450) {
+        switch (glTexSubImageFuncType) {
+            case 0:
+                glTextureSubImage1D(texture->handle, level, xoffset, width, imageFormat, dataType, data);
+                break;
+            case 1:
+                glTextureSubImage2D(texture->handle, level, xoffset, yoffset, width, height, imageFormat, dataType, data);
+                break;
+            case 2:
+            case 3:
+                glTextureSubImage3D(texture->handle, level, xoffset, yoffset, zoffset, width, height, depth, imageFormat, dataType, data);
+                break;
+        }
+    } else {
+        unsigned int boundCache = oriCurrentTextureAt(texture->type);
+        glBindTexture(texture->type, texture->handle);
+
+        switch (glTexSubImageFuncType) {
+            case 0:
+                glTexSubImage1D(texture->type, level, xoffset, width, imageFormat, dataType, data);
+                break;
+            case 1:
+                glTexSubImage2D(texture->type, level, xoffset, yoffset, width, height, imageFormat, dataType, data);
+                break;
+            case 2:
+                glTexSubImage3D(texture->type, level, xoffset, yoffset, zoffset, width, height, depth, imageFormat, dataType, data);
+                break;
+            case 3:
+                // without DSA, each face of a cube map is a separate target
+                if (depth > 1) {
+                    _orionThrowWarning("(in oriUploadTexSubImage()): Before OpenGL 4.5, only one cube map face can be updated at a time. Only the first face was updated.");
+                }
+                glTexSubImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + zoffset, level, xoffset, yoffset, width, height, imageFormat, dataType, data);
+                break;
+        }
+
+        glBindTexture(texture->type, boundCache);
+    }
+
+    // restore the default unpack state
+    if (rowLength) glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    if (skipPixels) glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+    if (skipRows) glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+
+    texture->mipmapsDirty = level == 0 && _oriHasGeneratedMipmaps(texture);
+}
+
+/**
+ * @brief Regenerate every mipmap level of the given texture from its base level.
+ *
+ * @param texture the texture to update.
+ *
+ * @ingroup textures
+ */
+void oriGenerateTextureMipmap(oriTexture *texture) {
+    _orionAssertVersion(300);
+
+    if (_orion.glVersion >= 450) {
+        glGenerateTextureMipmap(texture->handle);
+    } else {
+        unsigned int boundCache = oriCurrentTextureAt(texture->type);
+        glBindTexture(texture->type, texture->handle);
+
+        glGenerateMipmap(texture->type);
+
+        glBindTexture(texture->type, boundCache);
+    }
+
+    texture->mipmapsDirty = false;
 }
 
 /**
  * @brief Set a parameter for the given texture.
+ * @details Below OpenGL 4.5, the texture is bound to set the parameter (and the previous binding is restored). To sample
+ * many textures the same way, consider sharing an oriSampler (see oriGetSampler()) instead of setting the sampling
+ * parameters of each texture.
  *
  * @param texture the texture to update.
  * @param param the texture parameter to set.
@@ -462,6 +846,9 @@ void oriSetTextureParameteri(oriTexture *texture, unsigned int param, int val) {
 
 /**
  * @brief Set a parameter for the given texture.
+ * @details Below OpenGL 4.5, the texture is bound to set the parameter (and the previous binding is restored). To sample
+ * many textures the same way, consider sharing an oriSampler (see oriGetSampler()) instead of setting the sampling
+ * parameters of each texture.
  *
  * @param texture the texture to update.
  * @param param the texture parameter to set.
@@ -537,3 +924,189 @@ float oriGetTextureParameterf(oriTexture *texture, unsigned int param) {
 
     return r;
 }
+
+// ======================================================================================
+// *****                       ORION TEXTURE UPLOADER FUNCTIONS                     *****
+// ======================================================================================
+
+/**
+ * @brief Allocate and initialise a new oriTextureUploader structure.
+ *
+ * @details A texture uploader stages texture uploads in a persistently-mapped pixel unpack buffer (see oriStreamBuffer),
+ * so that queueing an upload with oriQueueTexSubImage() is just a copy into mapped memory, and never waits for the driver.
+ * The queued uploads are issued from the buffer by oriFlushTextureUploads(), once per frame; the GPU then copies the data
+ * into the textures asynchronously, and each region of the buffer is only reused once the GPU has finished with it.
+ *
+ * @param regionSize the maximum size, in bytes, of the image data that can be queued in one frame.
+ * @param regionCount the number of regions (typically the number of frames that can be in flight, e.g. 3).
+ *
+ * @ingroup textures
+ */
+oriTextureUploader *oriCreateTextureUploader(const unsigned int regionSize, const unsigned int regionCount) {
+    _orionAssertVersion(440);
+
+    oriTextureUploader *r = malloc(sizeof(oriTextureUploader));
+
+    r->stream = oriCreateStreamBuffer(regionSize, regionCount);
+    r->regionSize = regionSize;
+    r->regionOpen = false;
+    r->region = NULL;
+    r->regionUsed = 0;
+
+    r->uploads = NULL;
+    r->uploadCount = 0;
+    r->uploadCapacity = 0;
+
+    // link to global linked list
+    r->next = _orion.textureUploaderListHead;
+    _orion.textureUploaderListHead = r;
+
+    return r;
+}
+
+/**
+ * @brief Destroy and free memory for the given texture uploader. Uploads that have been queued but not flushed are discarded.
+ *
+ * @param uploader the texture uploader to free.
+ *
+ * @ingroup textures
+ */
+void oriFreeTextureUploader(oriTextureUploader *uploader) {
+    _orionAssertVersion(440);
+
+    // unlink from global linked list
+    oriTextureUploader **current = &_orion.textureUploaderListHead;
+    while (*current != uploader)
+        current = &(*current)->next;
+    *current = uploader->next;
+
+    oriFreeStreamBuffer(uploader->stream);
+    free(uploader->uploads);
+
+    free(uploader);
+    uploader = NULL;
+}
+
+/**
+ * @brief Queue an update of a region of one level of a texture's image, to be issued by the next call to oriFlushTextureUploads().
+ *
+ * @details The data is copied into the uploader's pixel unpack buffer straight away, so it can be freed as soon as this
+ * returns. Nothing else is done until the uploads are flushed; see oriUploadTexSubImage() for how the region is specified
+ * and how mipmaps are regenerated.
+ *
+ * This never blocks: if the image data doesn't fit in what is left of this frame's region, or if the GPU is still reading
+ * from the region that would be used next, nothing is queued and false is returned, so the upload can be retried next frame.
+ *
+ * @note The texture must not be freed before the upload is flushed.
+ *
+ * @param uploader the texture uploader to queue the upload in.
+ * @param texture the texture object to update.
+ * @param level the mipmap level to update.
+ * @param xoffset the x coordinate of the region in the texture.
+ * @param yoffset the y coordinate of the region in the texture.
+ * @param zoffset the z coordinate of the region in the texture.
+ * @param width the width of the region.
+ * @param height the height of the region. Set to 1 if the texture is 1D.
+ * @param depth the depth of the region. Set to 1 if the texture is not 3D, an array of 2D textures or a cube map.
+ * @param imageFormat the format of the source image (e.g. @c GL_RGBA).
+ * @param dataType the GL type of the given data (e.g. GL_UNSIGNED_BYTE if @c data is an unsigned char array)
+ * @param data the image data to use, tightly packed (i.e. with no padding at the end of each row).
+ * @return true if the upload was queued.
+ *
+ * @ingroup textures
+ */
+bool oriQueueTexSubImage(oriTextureUploader *uploader, oriTexture *texture, unsigned int level, unsigned int xoffset, unsigned int yoffset, unsigned int zoffset, unsigned int width, unsigned int height, unsigned int depth, unsigned int imageFormat, unsigned int dataType, const void *data) {
+    unsigned int pixelSize = _orionPixelSize(imageFormat, dataType);
+    if (!pixelSize) {
+        _orionThrowWarning("(in oriQueueTexSubImage()): Unsupported image format or data type specified. Upload not queued.");
+        return false;
+    }
+
+    unsigned int size = width * height * depth * pixelSize;
+    if (size > uploader->regionSize) {
+        _orionThrowWarning("(in oriQueueTexSubImage()): The image data is larger than the uploader's region size. Upload not queued.");
+        return false;
+    }
+
+    // start this frame's region, unless the GPU is still reading from it
+    if (!uploader->regionOpen) {
+        if (!oriStreamBufferReady(uploader->stream)) {
+            return false;
+        }
+
+        uploader->region = oriStreamBufferBegin(uploader->stream);
+        uploader->regionOpen = true;
+        uploader->regionUsed = 0;
+    }
+
+    // keep every offset aligned for the largest component type
+    unsigned int offset = (uploader->regionUsed + 7) & ~7u;
+    if (offset + size > uploader->regionSize) {
+        return false;
+    }
+
+    memcpy(uploader->region + offset, data, size);
+    uploader->regionUsed = offset + size;
+
+    if (uploader->uploadCount == uploader->uploadCapacity) {
+        uploader->uploadCapacity = uploader->uploadCapacity ? uploader->uploadCapacity * 2 : 16;
+        uploader->uploads = realloc(uploader->uploads, uploader->uploadCapacity * sizeof(_oriQueuedTextureUpload));
+    }
+
+    _oriQueuedTextureUpload *u = &uploader->uploads[uploader->uploadCount++];
+    u->texture = texture;
+    u->level = level;
+    u->xoffset = xoffset;
+    u->yoffset = yoffset;
+    u->zoffset = zoffset;
+    u->width = width;
+    u->height = height;
+    u->depth = depth;
+    u->imageFormat = imageFormat;
+    u->dataType = dataType;
+    u->offset = offset;
+
+    return true;
+}
+
+/**
+ * @brief Issue every upload queued in the given texture uploader, and fence the region they were staged in.
+ *
+ * @details Call this once per frame (e.g. at the start of the frame, before drawing). The uploads are issued from the
+ * uploader's buffer while it is bound to @c GL_PIXEL_UNPACK_BUFFER, so the driver doesn't copy any data from client memory.
+ *
+ * @param uploader the texture uploader to flush.
+ *
+ * @ingroup textures
+ */
+void oriFlushTextureUploads(oriTextureUploader *uploader) {
+    _orionAssertVersion(440);
+
+    if (!uploader->regionOpen) {
+        return;
+    }
+
+    unsigned int boundCache = oriCurrentBufferAt(GL_PIXEL_UNPACK_BUFFER);
+    oriBindBuffer(oriGetStreamBufferBuffer(uploader->stream), GL_PIXEL_UNPACK_BUFFER);
+
+    // the staged rows are tightly packed
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    unsigned int regionOffset = oriStreamBufferOffset(uploader->stream);
+    for (unsigned int i = 0; i < uploader->uploadCount; i++) {
+        _oriQueuedTextureUpload *u = &uploader->uploads[i];
+
+        // with a pixel unpack buffer bound, the data pointer is an offset into the buffer
+        const void *offset = (const void *) (uintptr_t) (regionOffset + u->offset);
+        oriUploadTexSubImage(u->texture, u->level, u->xoffset, u->yoffset, u->zoffset, u->width, u->height, u->depth, u->imageFormat, u->dataType, offset, 0, 0, 0);
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, boundCache);
+
+    // the region can't be reused until the GPU has copied everything out of it
+    oriStreamBufferEnd(uploader->stream);
+
+    uploader->regionOpen = false;
+    uploader->uploadCount = 0;
+}
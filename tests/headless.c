@@ -0,0 +1,950 @@
+// Checks of Orion's behaviour that don't need a window, run in a headless context (see oriCreateHeadlessContext()).
+// Unlike the other tests, this exits with a non-zero status if any check fails.
+
+// for mkdtemp() and setenv(), and usleep() (which POSIX has since removed)
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+
+#include "oriongl.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <unistd.h>
+
+unsigned int failures = 0;
+
+#define CHECK(condition) \
+    if (!(condition)) { \
+        printf("[Orion test] FAILED (line %d): %s\n", __LINE__, #condition); \
+        failures++; \
+    }
+
+// ======================================================================================
+// *****                                   HELPERS                                  *****
+// ======================================================================================
+
+void writeFile(const char *dir, const char *name, const char *contents) {
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+
+    FILE *f = fopen(path, "w");
+    fputs(contents, f);
+    fclose(f);
+}
+
+void removeFile(const char *dir, const char *name) {
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+    remove(path);
+}
+
+// ======================================================================================
+// *****                              IMMUTABLE BUFFERS                             *****
+// ======================================================================================
+
+void testImmutableBuffers() {
+    const unsigned int data[] = { 1, 2, 3, 4 };
+    unsigned int contents[4], size, flags;
+    bool immutable;
+    int glImmutable, glFlags;
+
+    oriBuffer *dynamic = oriCreateBufferImmutable(data, sizeof(data), GL_DYNAMIC_STORAGE_BIT);
+    oriGetBufferProperty(dynamic, &size, &immutable, &flags);
+    CHECK(size == sizeof(data) && immutable && flags == GL_DYNAMIC_STORAGE_BIT);
+
+    glGetNamedBufferParameteriv(oriGetBufferHandle(dynamic), GL_BUFFER_IMMUTABLE_STORAGE, &glImmutable);
+    glGetNamedBufferParameteriv(oriGetBufferHandle(dynamic), GL_BUFFER_STORAGE_FLAGS, &glFlags);
+    CHECK(glImmutable && glFlags == GL_DYNAMIC_STORAGE_BIT);
+
+    glGetNamedBufferSubData(oriGetBufferHandle(dynamic), 0, sizeof(contents), contents);
+    CHECK(contents[0] == 1 && contents[3] == 4);
+
+    // dynamic storage can be updated in place...
+    const unsigned int update[] = { 7, 8 };
+    oriSetBufferSubData(dynamic, 2 * sizeof(unsigned int), update, sizeof(update));
+    glGetNamedBufferSubData(oriGetBufferHandle(dynamic), 0, sizeof(contents), contents);
+    CHECK(contents[1] == 2 && contents[2] == 7 && contents[3] == 8);
+
+    // ...but not reallocated (this warns)
+    oriSetBufferData(dynamic, data, 2 * sizeof(data), GL_STATIC_DRAW);
+    oriGetBufferProperty(dynamic, &size, NULL, NULL);
+    CHECK(size == sizeof(data));
+
+    // static storage can't be updated at all (this warns too)
+    oriBuffer *fixed = oriCreateBufferImmutable(data, sizeof(data), 0);
+    oriSetBufferSubData(fixed, 0, update, sizeof(update));
+    glGetNamedBufferSubData(oriGetBufferHandle(fixed), 0, sizeof(contents), contents);
+    CHECK(contents[0] == 1 && contents[1] == 2);
+    CHECK(glGetError() == GL_NO_ERROR);
+
+    oriFreeBuffer(fixed);
+    oriFreeBuffer(dynamic);
+}
+
+// ======================================================================================
+// *****                                 BUFFER HEAPS                               *****
+// ======================================================================================
+
+void testBufferHeap() {
+    oriBufferHeap *heap = oriCreateBufferHeap(1024, GL_DYNAMIC_STORAGE_BIT);
+    oriBufferAllocation small, large, nearlyFull;
+    unsigned int pools, totalSize;
+
+    CHECK(oriBufferHeapAlloc(heap, 256, 0, &small));
+
+    // an allocation larger than the pool size gets a pool of its own
+    CHECK(oriBufferHeapAlloc(heap, 4112, 0, &large));
+    CHECK(large.size >= 4112 && large.buffer != small.buffer);
+    oriGetBufferHeapStats(heap, &pools, NULL, NULL, NULL, NULL);
+    CHECK(pools == 2);
+
+    oriFreeBufferHeap(heap);
+
+    // an allocation that nearly fills a new pool is allocated from it (the pool is made a little larger to fit it)
+    heap = oriCreateBufferHeap(100000, GL_DYNAMIC_STORAGE_BIT);
+    CHECK(oriBufferHeapAlloc(heap, 99000, 0, &nearlyFull));
+    oriGetBufferHeapStats(heap, &pools, &totalSize, NULL, NULL, NULL);
+    CHECK(pools == 1 && totalSize >= 100000 && totalSize < 100000 + 4096);
+
+    // as do allocations with large alignments
+    oriBufferAllocation aligned;
+    CHECK(oriBufferHeapAlloc(heap, 99000, 4096, &aligned));
+    CHECK(aligned.offset % 4096 == 0 && aligned.size >= 99000);
+    oriGetBufferHeapStats(heap, &pools, NULL, NULL, NULL, NULL);
+    CHECK(pools == 2);
+
+    oriFreeBufferHeap(heap);
+}
+
+// ======================================================================================
+// *****                                FRAMEBUFFERS                                *****
+// ======================================================================================
+
+void testFramebufferTargets() {
+    oriRenderTargetPool *pool = oriCreateRenderTargetPool(0);
+    oriFramebuffer *framebuffer = oriCreateFramebuffer();
+
+    oriTexture *target = oriAcquireRenderTarget(pool, 64, 64, GL_RGBA8, 0);
+    oriFramebufferTexture(framebuffer, GL_COLOR_ATTACHMENT0, target, 0, -1);
+    CHECK(oriGetFramebufferStatus(framebuffer) == GL_FRAMEBUFFER_COMPLETE);
+
+    // freeing an idle target detaches it from the framebuffer
+    oriReleaseRenderTarget(pool, target);
+    oriRenderTargetPoolNextFrame(pool);
+    oriRenderTargetPoolNextFrame(pool);
+    CHECK(oriGetFramebufferStatus(framebuffer) != GL_FRAMEBUFFER_COMPLETE);
+
+    // a new target is attached, even if OpenGL gives it the name of the freed one
+    target = oriAcquireRenderTarget(pool, 32, 32, GL_RGBA8, 0);
+    oriFramebufferTexture(framebuffer, GL_COLOR_ATTACHMENT0, target, 0, -1);
+    CHECK(oriGetFramebufferStatus(framebuffer) == GL_FRAMEBUFFER_COMPLETE);
+
+    oriBindFramebuffer(framebuffer);
+
+    int attached;
+    glGetFramebufferAttachmentParameteriv(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME, &attached);
+    CHECK((unsigned int) attached == oriGetTextureHandle(target));
+
+    glViewport(0, 0, 32, 32);
+    glClearColor(0.0f, 1.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    unsigned char pixel[4];
+    glReadPixels(16, 16, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+    CHECK(pixel[0] == 0 && pixel[1] == 255 && pixel[2] == 0);
+
+    oriBindFramebuffer(NULL);
+    oriReleaseRenderTarget(pool, target);
+    oriFreeFramebuffer(framebuffer);
+    oriFreeRenderTargetPool(pool);
+}
+
+unsigned int attachedObject(unsigned int framebuffer, unsigned int attachment, unsigned int *type) {
+    int name, objectType;
+    glGetNamedFramebufferAttachmentParameteriv(framebuffer, attachment, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, &objectType);
+    glGetNamedFramebufferAttachmentParameteriv(framebuffer, attachment, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME, &name);
+
+    *type = objectType;
+    return objectType == GL_NONE ? 0 : name;
+}
+
+void testDepthStencilAttachments() {
+    oriFramebuffer *framebuffer = oriCreateFramebuffer();
+    unsigned int handle = oriGetFramebufferHandle(framebuffer);
+    unsigned int type;
+
+    oriTexture *colour = oriCreateTextureImmutable(GL_TEXTURE_2D, 16, 16, 0, GL_RGBA8, 1, 0, false);
+    oriTexture *depth = oriCreateTextureImmutable(GL_TEXTURE_2D, 16, 16, 0, GL_DEPTH_COMPONENT24, 1, 0, false);
+    oriTexture *depthStencil = oriCreateTextureImmutable(GL_TEXTURE_2D, 16, 16, 0, GL_DEPTH24_STENCIL8, 1, 0, false);
+    oriFramebufferTexture(framebuffer, GL_COLOR_ATTACHMENT0, colour, 0, -1);
+
+    // a depth texture only replaces the depth half of a depth-stencil renderbuffer
+    oriFramebufferRenderbuffer(framebuffer, GL_DEPTH_STENCIL_ATTACHMENT, GL_DEPTH24_STENCIL8, 16, 16, 0);
+    unsigned int renderbuffer = attachedObject(handle, GL_STENCIL_ATTACHMENT, &type);
+    oriFramebufferTexture(framebuffer, GL_DEPTH_ATTACHMENT, depth, 0, -1);
+    CHECK(attachedObject(handle, GL_DEPTH_ATTACHMENT, &type) == oriGetTextureHandle(depth) && type == GL_TEXTURE);
+    CHECK(attachedObject(handle, GL_STENCIL_ATTACHMENT, &type) == renderbuffer && type == GL_RENDERBUFFER);
+
+    // detaching the stencil half deletes the renderbuffer, as nothing is attached to it any more
+    oriFramebufferTexture(framebuffer, GL_STENCIL_ATTACHMENT, NULL, 0, -1);
+    CHECK(attachedObject(handle, GL_STENCIL_ATTACHMENT, &type) == 0 && type == GL_NONE);
+    CHECK(!glIsRenderbuffer(renderbuffer));
+
+    // re-attaching a depth-stencil texture after its depth half was replaced attaches it again
+    oriFramebufferTexture(framebuffer, GL_DEPTH_STENCIL_ATTACHMENT, depthStencil, 0, -1);
+    oriFramebufferTexture(framebuffer, GL_DEPTH_ATTACHMENT, depth, 0, -1);
+    oriFramebufferTexture(framebuffer, GL_DEPTH_STENCIL_ATTACHMENT, depthStencil, 0, -1);
+    CHECK(attachedObject(handle, GL_DEPTH_ATTACHMENT, &type) == oriGetTextureHandle(depthStencil));
+    CHECK(attachedObject(handle, GL_STENCIL_ATTACHMENT, &type) == oriGetTextureHandle(depthStencil));
+    CHECK(oriGetFramebufferStatus(framebuffer) == GL_FRAMEBUFFER_COMPLETE);
+
+    oriFreeFramebuffer(framebuffer);
+    oriFreeTexture(colour);
+    oriFreeTexture(depth);
+    oriFreeTexture(depthStencil);
+}
+
+// ======================================================================================
+// *****                               TEXTURE UPLOADS                              *****
+// ======================================================================================
+
+void testTextureUploader() {
+    oriTexture *texture = oriCreateTextureImmutable(GL_TEXTURE_2D, 16, 16, 0, GL_RGBA8, 1, 0, false);
+    oriTextureUploader *uploader = oriCreateTextureUploader(16 * 16 * 4, 2);
+
+    unsigned char image[16 * 16 * 4];
+
+    // every region of the ring is reused several times, without buffers ever being swapped
+    bool queued = true;
+    for (unsigned int frame = 0; frame < 8 && queued; frame++) {
+        memset(image, frame * 16, sizeof(image));
+
+        // the GPU may still be reading from the region, so give it a while
+        queued = false;
+        for (unsigned int tries = 0; tries < 1000 && !queued; tries++) {
+            queued = oriQueueTexSubImage(uploader, texture, 0, 0, 0, 0, 16, 16, 1, GL_RGBA, GL_UNSIGNED_BYTE, image);
+            if (!queued) {
+                usleep(1000);
+            }
+        }
+
+        oriFlushTextureUploads(uploader);
+    }
+    CHECK(queued);
+
+    unsigned char pixel[16 * 16 * 4];
+    oriBindTexture(texture, 0);
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+    CHECK(pixel[0] == 7 * 16);
+
+    oriFreeTextureUploader(uploader);
+    oriFreeTexture(texture);
+
+    // textures without mipmaps are not regenerated when they are bound after an update
+    oriTexture *rectangle = oriCreateTexture(GL_TEXTURE_RECTANGLE, GL_RGBA8);
+    oriUploadTexImage(rectangle, GL_UNSIGNED_BYTE, image, 16, 16, 0, GL_RGBA);
+    oriUploadTexSubImage(rectangle, 0, 0, 0, 0, 8, 8, 1, GL_RGBA, GL_UNSIGNED_BYTE, image, 16, 0, 0);
+
+    while (glGetError() != GL_NO_ERROR);
+    oriBindTexture(rectangle, 1);
+    CHECK(glGetError() == GL_NO_ERROR);
+
+    oriFreeTexture(rectangle);
+}
+
+// ======================================================================================
+// *****                               TEXTURE BINDING                              *****
+// ======================================================================================
+
+// the GL calls made through Orion are counted by swapping Glad's function pointers for these
+unsigned int activeTextureCalls = 0, bindTexturesCalls = 0;
+PFNGLACTIVETEXTUREPROC realActiveTexture;
+PFNGLBINDTEXTURESPROC realBindTextures;
+
+void APIENTRY countActiveTexture(GLenum texture) {
+    activeTextureCalls++;
+    realActiveTexture(texture);
+}
+
+void APIENTRY countBindTextures(GLuint first, GLsizei count, const GLuint *textures) {
+    bindTexturesCalls++;
+    realBindTextures(first, count, textures);
+}
+
+// return the texture bound to the given unit (at the target of the given binding query), as reported by OpenGL
+unsigned int boundTexture(unsigned int unit, unsigned int binding) {
+    unsigned int active = oriActiveTextureUnit();
+    int r;
+
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glGetIntegerv(binding, &r);
+    glActiveTexture(GL_TEXTURE0 + active);
+
+    return r;
+}
+
+void testTextureBinding() {
+    realActiveTexture = glad_glActiveTexture;
+    realBindTextures = glad_glBindTextures;
+    glad_glActiveTexture = countActiveTexture;
+    glad_glBindTextures = countBindTextures;
+
+    oriTexture *textures[8];
+    for (unsigned int i = 0; i < 8; i++) {
+        textures[i] = oriCreateTextureImmutable(GL_TEXTURE_2D, 4, 4, 0, GL_RGBA8, 1, 0, false);
+    }
+
+    // the same texture bound to two units ends up on both
+    oriBindTexture(textures[0], 0);
+    oriBindTexture(textures[0], 1);
+    CHECK(boundTexture(0, GL_TEXTURE_BINDING_2D) == oriGetTextureHandle(textures[0]));
+    CHECK(boundTexture(1, GL_TEXTURE_BINDING_2D) == oriGetTextureHandle(textures[0]));
+
+    // binding to the active unit doesn't change the active unit again
+    activeTextureCalls = 0;
+    oriBindTexture(textures[1], 1);
+    CHECK(activeTextureCalls == 0);
+    CHECK(boundTexture(1, GL_TEXTURE_BINDING_2D) == oriGetTextureHandle(textures[1]));
+
+    // a run of eight textures is bound with one call, and not at all once it is in place
+    bindTexturesCalls = 0;
+    oriBindTextures(2, 8, textures);
+    CHECK(bindTexturesCalls == 1);
+    oriBindTextures(2, 8, textures);
+    CHECK(bindTexturesCalls == 1);
+    CHECK(boundTexture(2, GL_TEXTURE_BINDING_2D) == oriGetTextureHandle(textures[0]));
+    CHECK(boundTexture(9, GL_TEXTURE_BINDING_2D) == oriGetTextureHandle(textures[7]));
+
+    // multisample and multisample array textures are tracked separately
+    oriTexture *multisample = oriCreateTextureImmutable(GL_TEXTURE_2D_MULTISAMPLE, 4, 4, 0, GL_RGBA8, 1, 4, true);
+    oriTexture *multisampleArray = oriCreateTextureImmutable(GL_TEXTURE_2D_MULTISAMPLE_ARRAY, 4, 4, 2, GL_RGBA8, 1, 4, true);
+    oriBindTexture(multisample, 0);
+    oriBindTexture(multisampleArray, 0);
+    CHECK(oriCurrentTextureAtUnit(0, GL_TEXTURE_2D_MULTISAMPLE) == oriGetTextureHandle(multisample));
+    CHECK(oriCurrentTextureAtUnit(0, GL_TEXTURE_2D_MULTISAMPLE_ARRAY) == oriGetTextureHandle(multisampleArray));
+    CHECK(boundTexture(0, GL_TEXTURE_BINDING_2D_MULTISAMPLE) == oriGetTextureHandle(multisample));
+
+    glad_glActiveTexture = realActiveTexture;
+    glad_glBindTextures = realBindTextures;
+    CHECK(glGetError() == GL_NO_ERROR);
+
+    // freeing textures that aren't at the head of the texture list leaves the rest of the list intact
+    // (otherwise, freeing the others here or in oriTerminate() touches freed memory)
+    oriFreeTexture(textures[3]);
+    oriFreeTexture(textures[0]);
+    oriFreeTexture(multisample);
+    oriFreeTexture(multisampleArray);
+    for (unsigned int i = 1; i < 8; i++) {
+        if (i != 3) {
+            oriFreeTexture(textures[i]);
+        }
+    }
+}
+
+// ======================================================================================
+// *****                                  SAMPLERS                                  *****
+// ======================================================================================
+
+void testSamplers() {
+    oriSamplerState clamped, bordered;
+    oriInitSamplerState(&clamped);
+    clamped.wrapS = clamped.wrapT = GL_CLAMP_TO_EDGE;
+    bordered = clamped;
+    bordered.borderColor[0] = 1.0f;
+
+    // the border colour has no effect without GL_CLAMP_TO_BORDER, so both states give the same sampler
+    unsigned int samplers[2];
+    oriGetSamplerStats(&samplers[0], NULL, NULL);
+    oriSampler *sampler = oriGetSampler(&clamped);
+    CHECK(oriGetSampler(&bordered) == sampler);
+    oriGetSamplerStats(&samplers[1], NULL, NULL);
+    CHECK(samplers[1] == samplers[0] + 1);
+
+    bordered.wrapS = GL_CLAMP_TO_BORDER;
+    CHECK(oriGetSampler(&bordered) != sampler);
+
+    // binding a sampler that is already bound is skipped
+    unsigned long issued[2], skipped[2];
+    oriBindSampler(sampler, 2);
+    oriGetSamplerStats(NULL, &issued[0], &skipped[0]);
+    oriBindSampler(sampler, 2);
+    oriGetSamplerStats(NULL, &issued[1], &skipped[1]);
+    CHECK(issued[1] == issued[0] && skipped[1] == skipped[0] + 1);
+
+    int bound;
+    glActiveTexture(GL_TEXTURE2);
+    glGetIntegerv(GL_SAMPLER_BINDING, &bound);
+    glActiveTexture(GL_TEXTURE0);
+    CHECK((unsigned int) bound == oriGetSamplerHandle(sampler));
+
+    // deleting a sampler unbinds it from its units, so binding another sampler there again isn't skipped
+    unsigned int raw;
+    glGenSamplers(1, &raw);
+    glBindSampler(3, raw);
+    CHECK(oriCurrentSamplerAt(3) == raw);
+    glDeleteSamplers(1, &raw);
+    CHECK(oriCurrentSamplerAt(3) == 0);
+
+    oriGetSamplerStats(NULL, &issued[0], NULL);
+    oriBindSampler(sampler, 3);
+    oriGetSamplerStats(NULL, &issued[1], NULL);
+    CHECK(issued[1] == issued[0] + 1 && oriCurrentSamplerAt(3) == oriGetSamplerHandle(sampler));
+
+    oriBindSampler(NULL, 2);
+    oriBindSampler(NULL, 3);
+    CHECK(glGetError() == GL_NO_ERROR);
+}
+
+// ======================================================================================
+// *****                                 DRAW BATCHES                               *****
+// ======================================================================================
+
+const char *flatVertex =
+    "#version 330 core\n"
+    "layout (location = 0) in vec2 position;\n"
+    "void main() { gl_Position = vec4(position, 0.0, 1.0); }\n";
+
+const char *flatFragment =
+    "#version 330 core\n"
+    "out vec4 fragColour;\n"
+    "void main() { fragColour = vec4(1.0); }\n";
+
+void testDrawBatch() {
+    // a quad in each quarter of the screen
+    float vertices[4 * 4 * 2];
+    for (unsigned int q = 0; q < 4; q++) {
+        float x = q % 2 ? 0.0f : -1.0f, y = q / 2 ? 0.0f : -1.0f;
+        float quad[] = { x, y,  x + 1.0f, y,  x, y + 1.0f,  x + 1.0f, y + 1.0f };
+        memcpy(&vertices[q * 8], quad, sizeof(quad));
+    }
+    const unsigned int indices[] = { 0, 1, 2, 2, 1, 3 };
+
+    oriBuffer *vbo = oriCreateBufferImmutable(vertices, sizeof(vertices), 0);
+    oriBuffer *ibo = oriCreateBufferImmutable(indices, sizeof(indices), 0);
+
+    oriVertexArray *vao = oriCreateVertexArray();
+    oriSpecifyVertexData(vao, vbo, 0, 2, GL_FLOAT, false, 2 * sizeof(float), 0);
+    oriBindVertexArray(vao);
+    oriBindBuffer(ibo, GL_ELEMENT_ARRAY_BUFFER);
+
+    oriShader *shader = oriCreateShader();
+    oriAddShaderSource(shader, GL_VERTEX_SHADER, flatVertex);
+    oriAddShaderSource(shader, GL_FRAGMENT_SHADER, flatFragment);
+
+    oriTexture *target = oriCreateTextureImmutable(GL_TEXTURE_2D, 8, 8, 0, GL_RGBA8, 1, 0, false);
+    oriFramebuffer *framebuffer = oriCreateFramebuffer();
+    oriFramebufferTexture(framebuffer, GL_COLOR_ATTACHMENT0, target, 0, -1);
+    oriBindFramebuffer(framebuffer);
+
+    glViewport(0, 0, 8, 8);
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    // more flushes than the batch has regions to stream its commands into, each drawing one quad
+    oriDrawBatch *batch = oriCreateDrawBatch(GL_TRIANGLES, GL_UNSIGNED_INT);
+    for (unsigned int flush = 0; flush < 8; flush++) {
+        if (flush % 2 == 0) {
+            oriDrawBatchAdd(batch, shader, vao, 6, 1, 0, (flush / 2) * 4, 0);
+        }
+        oriFlushDrawBatch(batch);
+    }
+
+    unsigned char pixels[8 * 8 * 4];
+    glReadPixels(0, 0, 8, 8, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    CHECK(pixels[(2 * 8 + 2) * 4] == 255 && pixels[(2 * 8 + 6) * 4] == 255);
+    CHECK(pixels[(6 * 8 + 2) * 4] == 255 && pixels[(6 * 8 + 6) * 4] == 255);
+    CHECK(glGetError() == GL_NO_ERROR);
+
+    // the index buffer is part of the vertex array, so drawing from one without an index buffer is caught
+    oriVertexArray *unindexed = oriCreateVertexArray();
+    oriSpecifyVertexData(unindexed, vbo, 0, 2, GL_FLOAT, false, 2 * sizeof(float), 0);
+    oriBindVertexArray(unindexed);
+    CHECK(oriCurrentBufferAt(GL_ELEMENT_ARRAY_BUFFER) == 0);
+
+    oriBindShader(shader);
+    oriDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, 0, 1);
+    CHECK(glGetError() == GL_NO_ERROR);
+
+    oriBindVertexArray(vao);
+    CHECK(oriCurrentBufferAt(GL_ELEMENT_ARRAY_BUFFER) == oriGetBufferHandle(ibo));
+
+    // an index buffer attached to a vertex array that isn't bound is restored when it is bound
+    glVertexArrayElementBuffer(oriGetVertexArrayHandle(unindexed), oriGetBufferHandle(ibo));
+    oriBindVertexArray(unindexed);
+    int elementArrayBuffer;
+    glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &elementArrayBuffer);
+    CHECK(oriCurrentBufferAt(GL_ELEMENT_ARRAY_BUFFER) == (unsigned int) elementArrayBuffer);
+    CHECK(oriCurrentBufferAt(GL_ELEMENT_ARRAY_BUFFER) == oriGetBufferHandle(ibo));
+
+    oriBindFramebuffer(NULL);
+    oriFreeVertexArray(unindexed);
+    oriFreeDrawBatch(batch);
+    oriFreeFramebuffer(framebuffer);
+    oriFreeTexture(target);
+    oriFreeShader(shader);
+    oriFreeVertexArray(vao);
+    oriFreeBuffer(vbo);
+    oriFreeBuffer(ibo);
+}
+
+// ======================================================================================
+// *****                             SHADER HOT RELOADING                           *****
+// ======================================================================================
+
+const char *hotReloadVertex =
+    "#version 330 core\n"
+    "void main() { gl_Position = vec4(0.0, 0.0, 0.0, 1.0); }\n";
+
+void testShaderHotReload() {
+    // the shader files are written to a temporary directory, not the working directory
+    char dir[] = "/tmp/orion-test-XXXXXX";
+    if (!mkdtemp(dir)) {
+        printf("[Orion test] Skipped shader hot reloading (no temporary directory).\n");
+        return;
+    }
+
+    char aPath[256], bPath[256];
+    snprintf(aPath, sizeof(aPath), "%s/a.frag", dir);
+    snprintf(bPath, sizeof(bPath), "%s/b.frag", dir);
+
+    // two shaders that include the same file
+    writeFile(dir, "colour.glsl", "const vec4 colour = vec4(1.0, 0.0, 0.0, 1.0);\n");
+    writeFile(dir, "a.frag", "#version 330 core\n#include \"colour.glsl\"\nout vec4 fragColour;\nvoid main() { fragColour = colour; }\n");
+    writeFile(dir, "b.frag", "#version 330 core\n#include \"colour.glsl\"\nout vec4 fragColour;\nvoid main() { fragColour = colour * 0.5; }\n");
+
+    CHECK(oriEnableShaderHotReload());
+
+    // one stage is added from oriParseShader(), the other with oriAddShaderSourceFile(): both are watched
+    oriShader *a = oriCreateShader();
+    oriAddShaderSource(a, GL_VERTEX_SHADER, hotReloadVertex);
+    oriAddShaderSource(a, GL_FRAGMENT_SHADER, oriParseShader(aPath));
+
+    oriShader *b = oriCreateShader();
+    oriAddShaderSource(b, GL_VERTEX_SHADER, hotReloadVertex);
+    oriAddShaderSourceFile(b, GL_FRAGMENT_SHADER, bPath);
+
+    unsigned int aProgram = oriGetShaderHandle(a);
+    unsigned int bProgram = oriGetShaderHandle(b);
+
+    CHECK(oriPollShaderHotReload() == 0);
+    CHECK(!oriShaderSourcesChanged(a) && !oriShaderSourcesChanged(b));
+
+    // changing the shared file rebuilds both shaders
+    writeFile(dir, "colour.glsl", "const vec4 colour = vec4(0.0, 1.0, 0.0, 1.0); // changed\n");
+
+    CHECK(oriShaderSourcesChanged(a) && oriShaderSourcesChanged(b));
+    CHECK(oriPollShaderHotReload() == 2);
+    CHECK(oriGetShaderHandle(a) != aProgram && oriGetShaderHandle(b) != bProgram);
+    CHECK(!oriShaderSourcesChanged(a) && !oriShaderSourcesChanged(b));
+
+    oriFreeShader(a);
+    oriFreeShader(b);
+    oriDisableShaderHotReload();
+
+    removeFile(dir, "colour.glsl");
+    removeFile(dir, "a.frag");
+    removeFile(dir, "b.frag");
+    rmdir(dir);
+}
+
+// ======================================================================================
+// *****                               SHADER VARIANTS                              *****
+// ======================================================================================
+
+// a triangle covering the whole viewport, without any vertex attributes
+const char *coverVertex =
+    "#version 330 core\n"
+    "void main() { gl_Position = vec4(gl_VertexID == 1 ? 3.0 : -1.0, gl_VertexID == 2 ? 3.0 : -1.0, 0.0, 1.0); }\n";
+
+const char *variantFragment =
+    "#version 330 core\n"
+    "out vec4 fragColour;\n"
+    "void main() {\n"
+    "#ifdef RED\n"
+    "    fragColour.r = 1.0;\n"
+    "#else\n"
+    "    fragColour.r = 0.0;\n"
+    "#endif\n"
+    "    fragColour.gba = vec3(GREEN / 255.0, 0.0, 1.0);\n"
+    "}\n";
+
+void testShaderVariants() {
+    oriShaderFamily *family = oriCreateShaderFamily();
+    oriAddShaderFamilySource(family, GL_VERTEX_SHADER, coverVertex);
+    oriAddShaderFamilySource(family, GL_FRAGMENT_SHADER, variantFragment);
+
+    const char *redDefines[] = { "RED", "GREEN 64" };
+    const char *reorderedDefines[] = { "GREEN 64", "RED" };
+    const char *greenDefines[] = { "GREEN 128" };
+
+    // the same set of defines in any order gives the same variant
+    oriShader *red = oriGetShaderVariant(family, redDefines, 2);
+    oriShader *green = oriGetShaderVariant(family, greenDefines, 1);
+    CHECK(red && green && red != green);
+    CHECK(oriGetShaderVariant(family, reorderedDefines, 2) == red);
+
+    oriTexture *target = oriCreateTextureImmutable(GL_TEXTURE_2D, 1, 1, 0, GL_RGBA8, 1, 0, false);
+    oriFramebuffer *framebuffer = oriCreateFramebuffer();
+    oriFramebufferTexture(framebuffer, GL_COLOR_ATTACHMENT0, target, 0, -1);
+    oriBindFramebuffer(framebuffer);
+    glViewport(0, 0, 1, 1);
+
+    oriVertexArray *empty = oriCreateVertexArray();
+    oriBindVertexArray(empty);
+
+    // each variant is compiled with its own defines
+    unsigned char pixel[4];
+    oriBindShader(red);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glReadPixels(0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+    CHECK(pixel[0] == 255 && pixel[1] == 64);
+
+    oriBindShader(green);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glReadPixels(0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+    CHECK(pixel[0] == 0 && pixel[1] == 128);
+    CHECK(glGetError() == GL_NO_ERROR);
+
+    oriBindFramebuffer(NULL);
+    oriFreeVertexArray(empty);
+    oriFreeFramebuffer(framebuffer);
+    oriFreeTexture(target);
+    oriFreeShaderFamily(family);
+}
+
+// ======================================================================================
+// *****                               SHADER LINKING                               *****
+// ======================================================================================
+
+const char *uniformFragment =
+    "#version 330 core\n"
+    "uniform vec4 colour;\n"
+    "out vec4 fragColour;\n"
+    "void main() { fragColour = colour; }\n";
+
+void testLazyLinking() {
+    oriTexture *target = oriCreateTextureImmutable(GL_TEXTURE_2D, 1, 1, 0, GL_RGBA8, 1, 0, false);
+    oriFramebuffer *framebuffer = oriCreateFramebuffer();
+    oriFramebufferTexture(framebuffer, GL_COLOR_ATTACHMENT0, target, 0, -1);
+    oriBindFramebuffer(framebuffer);
+    glViewport(0, 0, 1, 1);
+
+    oriVertexArray *empty = oriCreateVertexArray();
+    oriBindVertexArray(empty);
+
+    // without oriLinkShader(), the program is linked by the first function that needs it (here, setting a uniform)
+    oriShader *shader = oriCreateShader();
+    oriAddShaderSource(shader, GL_VERTEX_SHADER, coverVertex);
+    oriAddShaderSource(shader, GL_FRAGMENT_SHADER, uniformFragment);
+    oriSetUniform4f(shader, "colour", 0.0f, 1.0f, 0.0f, 1.0f);
+
+    oriBindShader(shader);
+    CHECK(oriCurrentShaderProgram() == oriGetShaderHandle(shader));
+
+    int linked = 0;
+    glGetProgramiv(oriGetShaderHandle(shader), GL_LINK_STATUS, &linked);
+    CHECK(linked);
+
+    unsigned char pixel[4];
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glReadPixels(0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+    CHECK(pixel[0] == 0 && pixel[1] == 255);
+
+    // and binding a shader that nothing else has used links it too
+    oriShader *bound = oriCreateShader();
+    oriAddShaderSource(bound, GL_VERTEX_SHADER, coverVertex);
+    oriAddShaderSource(bound, GL_FRAGMENT_SHADER, flatFragment);
+
+    oriBindShader(bound);
+    CHECK(oriCurrentShaderProgram() != 0 && oriCurrentShaderProgram() == oriGetShaderHandle(bound));
+
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glReadPixels(0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+    CHECK(pixel[0] == 255 && pixel[1] == 255);
+    CHECK(glGetError() == GL_NO_ERROR);
+
+    oriBindFramebuffer(NULL);
+    oriFreeShader(bound);
+    oriFreeShader(shader);
+    oriFreeVertexArray(empty);
+    oriFreeFramebuffer(framebuffer);
+    oriFreeTexture(target);
+}
+
+// ======================================================================================
+// *****                               UNIFORM HANDLES                              *****
+// ======================================================================================
+
+const char *weightsFragment =
+    "#version 330 core\n"
+    "uniform vec4 colour;\n"
+    "uniform float weights[32];\n"
+    "out vec4 fragColour;\n"
+    "void main() {\n"
+    "    float sum = 0.0;\n"
+    "    for (int i = 0; i < 32; i++) sum += weights[i];\n"
+    "    fragColour = colour * sum;\n"
+    "}\n";
+
+void testUniformHandles() {
+    oriShader *shader = oriCreateShader();
+    oriAddShaderSource(shader, GL_VERTEX_SHADER, coverVertex);
+    oriAddShaderSource(shader, GL_FRAGMENT_SHADER, weightsFragment);
+    unsigned int program = oriGetShaderHandle(shader);
+
+    // every array element gets its own handle, and each one sets the uniform with the matching name
+    oriUniformHandle weights[32];
+    bool distinct = true;
+    for (unsigned int i = 0; i < 32; i++) {
+        char name[16];
+        snprintf(name, sizeof(name), "weights[%u]", i);
+        weights[i] = oriGetUniformHandle(shader, name);
+        for (unsigned int j = 0; j < i; j++) {
+            distinct = distinct && weights[i] != weights[j];
+        }
+
+        oriSetUniformByHandle1f(shader, weights[i], (float) i);
+    }
+    CHECK(distinct && weights[0] != -1 && weights[31] != -1);
+
+    float value = -1.0f;
+    glGetUniformfv(program, glGetUniformLocation(program, "weights[0]"), &value);
+    CHECK(value == 0.0f);
+    glGetUniformfv(program, glGetUniformLocation(program, "weights[31]"), &value);
+    CHECK(value == 31.0f);
+
+    // "weights" is the same uniform as "weights[0]"
+    CHECK(oriGetUniformHandle(shader, "weights") == weights[0]);
+
+    // unknown names have no handle, and setting no uniform does nothing
+    oriUniformHandle missing = oriGetUniformHandle(shader, "missing");
+    CHECK(missing == -1);
+    oriSetUniformByHandle1f(shader, missing, 1.0f);
+
+    // uploads that don't change the uniform are skipped
+    oriUniformHandle colour = oriGetUniformHandle(shader, "colour");
+    unsigned long issued, skipped;
+    oriResetUniformUploadStats();
+    oriSetUniformByHandle4f(shader, colour, 1.0f, 0.5f, 0.25f, 1.0f);
+    oriSetUniformByHandle4f(shader, colour, 1.0f, 0.5f, 0.25f, 1.0f);
+    oriSetUniform4f(shader, "colour", 1.0f, 0.5f, 0.25f, 1.0f);
+    oriGetUniformUploadStats(&issued, &skipped);
+    CHECK(issued == 1 && skipped == 2);
+
+    float colourValue[4] = { 0.0f };
+    glGetUniformfv(program, glGetUniformLocation(program, "colour"), colourValue);
+    CHECK(colourValue[1] == 0.5f && colourValue[2] == 0.25f);
+    CHECK(glGetError() == GL_NO_ERROR);
+
+    oriFreeShader(shader);
+}
+
+// ======================================================================================
+// *****                               VERTEX LAYOUTS                               *****
+// ======================================================================================
+
+const char *layoutVertex =
+    "#version 330 core\n"
+    "layout (location = 3) in vec2 positionIn;\n"
+    "layout (location = 1) in vec4 colourIn;\n"
+    "out vec4 colour;\n"
+    "void main() { colour = colourIn; gl_Position = vec4(positionIn, 0.0, 1.0); }\n";
+
+const char *layoutFragment =
+    "#version 330 core\n"
+    "in vec4 colour;\n"
+    "out vec4 fragColour;\n"
+    "void main() { fragColour = colour; }\n";
+
+void testVertexLayouts() {
+    oriShader *shader = oriCreateShader();
+    oriAddShaderSource(shader, GL_VERTEX_SHADER, layoutVertex);
+    oriAddShaderSource(shader, GL_FRAGMENT_SHADER, layoutFragment);
+
+    // the attributes are declared in a different order to the shader's locations, and one isn't read by the shader
+    oriVertexLayout *layout = oriCreateVertexLayout();
+    oriVertexLayoutBinding(layout, 0, 8 * sizeof(float), 0);
+    oriVertexLayoutNamedAttribute(layout, "colourIn", 0, 4, GL_FLOAT, false, 2 * sizeof(float));
+    oriVertexLayoutNamedAttribute(layout, "positionIn", 0, 2, GL_FLOAT, false, 0);
+    oriVertexLayoutAttribute(layout, 5, 0, 2, GL_FLOAT, false, 6 * sizeof(float));
+    oriBindVertexLayoutToShader(layout, shader);
+
+    oriBuffer *vbo = oriCreateBufferImmutable(NULL, 3 * 8 * sizeof(float), 0);
+
+    // attribute 0 was enabled before the layout is applied, so it should be disabled by it
+    oriVertexArray *vao = oriCreateVertexArray();
+    oriSpecifyVertexData(vao, vbo, 0, 2, GL_FLOAT, false, 8 * sizeof(float), 0);
+    oriApplyVertexLayout(vao, layout);
+    oriBindVertexBuffer(vao, 0, vbo, 0);
+
+    unsigned int handle = oriGetVertexArrayHandle(vao);
+    int enabled[6], size[6];
+    for (unsigned int i = 0; i < 6; i++) {
+        glGetVertexArrayIndexediv(handle, i, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &enabled[i]);
+        glGetVertexArrayIndexediv(handle, i, GL_VERTEX_ATTRIB_ARRAY_SIZE, &size[i]);
+    }
+
+    CHECK(oriShaderGetInputLocation(shader, "positionIn") == 3);
+    CHECK(enabled[3] && size[3] == 2);
+    CHECK(enabled[1] && size[1] == 4);
+    CHECK(!enabled[0] && !enabled[2] && !enabled[4] && !enabled[5]);
+    CHECK(glGetError() == GL_NO_ERROR);
+
+    oriFreeVertexLayout(layout);
+    oriFreeVertexArray(vao);
+    oriFreeBuffer(vbo);
+    oriFreeShader(shader);
+}
+
+// ======================================================================================
+// *****                           ASYNCHRONOUS TEXTURE LOADS                       *****
+// ======================================================================================
+
+void textureLoaded(oriTexture *texture, const char *path, void *userData) {
+    // each callback is given the path of its own load
+    CHECK(!strcmp(path, texture ? "resources/onions.jpg" : "resources/missing.png"));
+    *(oriTexture **) userData = texture;
+}
+
+void testTextureLoads() {
+    oriTexture *onions = NULL, *missing = (oriTexture *) &onions;
+
+    oriLoadTextureAsync("resources/onions.jpg", 4, ORION_TEXTURE_LOAD_FLIP | ORION_TEXTURE_LOAD_MIPMAPS, textureLoaded, &onions);
+    oriLoadTextureAsync("resources/missing.png", 4, 0, textureLoaded, &missing); // warns, and the callback is given NULL
+
+    // give up after ten seconds
+    for (unsigned int i = 0; i < 1000 && oriPollTextureLoads(); i++) {
+        usleep(10000);
+    }
+
+    CHECK(onions != NULL);
+    CHECK(missing == NULL);
+
+    if (onions) {
+        unsigned int type, width, height, format, levels;
+        oriGetTextureProperty(onions, &type, &width, &height, NULL, &format, &levels, NULL);
+        CHECK(type == GL_TEXTURE_2D && format == GL_RGBA8);
+        CHECK(width > 1 && height > 1 && levels == oriMipmapLevelCount(width, height));
+
+        oriFreeTexture(onions);
+    }
+
+    CHECK(glGetError() == GL_NO_ERROR);
+}
+
+// ======================================================================================
+// *****                                PROGRAM CACHE                               *****
+// ======================================================================================
+
+void testProgramCache() {
+    // the cache is kept in a temporary directory, not the working directory
+    char dir[] = "/tmp/orion-test-XXXXXX";
+    if (!mkdtemp(dir)) {
+        printf("[Orion test] Skipped the program cache (no temporary directory).\n");
+        return;
+    }
+
+    int formats;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+
+    oriEnableProgramCache(dir, 1024 * 1024);
+
+    // the second build of the same sources is loaded from the cache
+    unsigned int hits[2], misses[2];
+    for (unsigned int i = 0; i < 2; i++) {
+        oriShader *shader = oriCreateShader();
+        oriAddShaderSource(shader, GL_VERTEX_SHADER, flatVertex);
+        oriAddShaderSource(shader, GL_FRAGMENT_SHADER, flatFragment);
+        oriLinkShader(shader);
+        CHECK(oriGetShaderHandle(shader) != 0);
+        oriFreeShader(shader);
+
+        oriGetProgramCacheStats(&hits[i], &misses[i]);
+    }
+
+    if (formats > 0) {
+        CHECK(misses[0] == 1 && hits[0] == 0);
+        CHECK(misses[1] == 1 && hits[1] == 1);
+    } else {
+        printf("[Orion test] Skipped program cache hits (no program binary formats).\n");
+    }
+
+    oriDisableProgramCache();
+
+    DIR *d = opendir(dir);
+    struct dirent *entry;
+    while (d && (entry = readdir(d))) {
+        if (entry->d_name[0] != '.') {
+            removeFile(dir, entry->d_name);
+        }
+    }
+    if (d) {
+        closedir(d);
+    }
+    rmdir(dir);
+}
+
+// ======================================================================================
+// *****                              HEADLESS CONTEXTS                             *****
+// ======================================================================================
+
+void testHeadlessContexts(oriHeadlessContext *context) {
+    // an unrecognised backend is warned about, and every backend is tried
+    setenv("ORION_HEADLESS_BACKEND", "unknown", 1);
+    oriHeadlessContext *second = oriCreateHeadlessContext(450, 16, 16);
+    unsetenv("ORION_HEADLESS_BACKEND");
+    CHECK(second != NULL);
+
+    // freeing one context leaves the others (which may share its EGL display) usable
+    if (second) {
+        oriFreeHeadlessContext(second);
+    }
+    oriMakeHeadlessContextCurrent(context);
+
+    CHECK(glGetString(GL_VERSION) != NULL);
+    CHECK(glGetError() == GL_NO_ERROR);
+}
+
+// ======================================================================================
+// *****                                    MAIN()                                  *****
+// ======================================================================================
+
+int main() {
+    oriInitialise(450);
+
+    oriHeadlessContext *context = oriCreateHeadlessContext(450, 64, 64);
+    if (!context) {
+        printf("[Orion test] Skipped: a headless context could not be created.\n");
+        oriTerminate();
+        return 0;
+    }
+
+    testImmutableBuffers();
+    testBufferHeap();
+    testFramebufferTargets();
+    testDepthStencilAttachments();
+    testTextureUploader();
+    testTextureBinding();
+    testSamplers();
+    testDrawBatch();
+    testShaderHotReload();
+    testShaderVariants();
+    testLazyLinking();
+    testUniformHandles();
+    testVertexLayouts();
+    testTextureLoads();
+    testProgramCache();
+    testHeadlessContexts(context);
+
+    oriTerminate();
+
+    if (failures) {
+        printf("[Orion test] %u check(s) failed.\n", failures);
+        return 1;
+    }
+
+    printf("[Orion test] All checks passed.\n");
+    return 0;
+}